@@ -1,21 +1,15 @@
 #include "../../ssp.hpp"
-#include <filesystem>
 #include <iostream>
-#include <unistd.h>
 
 template <typename... Ts>
 void test_ssp_file_mode(const uint8_t* data, size_t size,
                         std::string delim = ss::default_delimiter) {
-    std::string file_name = std::filesystem::temp_directory_path().append(
-        "ss_fuzzer" + std::to_string(getpid()) + ".csv");
-    FILE* file = std::fopen(file_name.c_str(), "wb");
+    FILE* file = fmemopen(const_cast<uint8_t*>(data), size, "rb");
     if (!file) {
-        std::exit(1);
+        return;
     }
-    std::fwrite(data, size, 1, file);
-    std::fclose(file);
 
-    ss::parser<Ts...> p{file_name.c_str(), delim};
+    ss::parser<Ts...> p{file, delim};
     while (!p.eof()) {
         try {
             const auto& [s0, s1] =
@@ -28,7 +22,7 @@ void test_ssp_file_mode(const uint8_t* data, size_t size,
         }
     }
 
-    std::remove(file_name.c_str());
+    std::fclose(file);
 }
 
 template <typename... Ts>
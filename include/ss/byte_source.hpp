@@ -0,0 +1,785 @@
+#pragma once
+
+#include "common.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if !defined(SSP_DISABLE_ZLIB) && __has_include(<zlib.h>)
+#include <zlib.h>
+#define SSP_ZLIB_ENABLED
+#endif
+
+#if !defined(SSP_DISABLE_ZSTD) && __has_include(<zstd.h>)
+#include <zstd.h>
+#define SSP_ZSTD_ENABLED
+#endif
+
+#if !defined(SSP_DISABLE_IO_URING) && defined(__linux__) &&                    \
+    __has_include(<linux/io_uring.h>)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define SSP_IO_URING_ENABLED
+#endif
+
+namespace ss {
+
+////////////////
+// byte source
+////////////////
+
+// the data read by a parser, 'read' fills the given buffer and returns the
+// number of bytes written into it, 0 at the end of the data, or -1 if the
+// data could not be read, 'name' is used within error messages
+struct byte_source {
+    std::function<ssize_t(char* data, size_t size)> read;
+    std::string name{"byte source"};
+};
+
+////////////////
+// read ahead
+////////////////
+
+// reads blocks from a source on a separate thread, at most two blocks are
+// read ahead of the block being consumed
+class read_ahead_state {
+    struct block {
+        std::vector<char> data;
+        ssize_t size{0};
+    };
+
+public:
+    read_ahead_state(byte_source source, size_t block_size)
+        : source_{std::move(source)} {
+        for (size_t i = 0; i < 2; ++i) {
+            free_.emplace_back(std::max<size_t>(block_size, 1));
+        }
+        thread_ = std::thread{[this] { produce(); }};
+    }
+
+    ~read_ahead_state() {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+        condition_.notify_all();
+        thread_.join();
+    }
+
+    read_ahead_state(const read_ahead_state& other) = delete;
+    read_ahead_state& operator=(const read_ahead_state& other) = delete;
+
+    [[nodiscard]] ssize_t read(char* data, size_t size) {
+        if (end_) {
+            return current_.size;
+        }
+
+        while (position_ == static_cast<size_t>(current_.size)) {
+            std::unique_lock lock{mutex_};
+            if (!current_.data.empty()) {
+                free_.push_back(std::move(current_.data));
+                condition_.notify_all();
+            }
+
+            condition_.wait(lock, [this] { return !ready_.empty(); });
+            current_ = std::move(ready_.front());
+            ready_.pop_front();
+            position_ = 0;
+
+            if (current_.size <= 0) {
+                end_ = true;
+                if (exception_) {
+                    std::rethrow_exception(std::exchange(exception_, nullptr));
+                }
+                return current_.size;
+            }
+        }
+
+        const auto n =
+            std::min(size, static_cast<size_t>(current_.size) - position_);
+        std::memcpy(data, current_.data.data() + position_, n);
+        position_ += n;
+        return static_cast<ssize_t>(n);
+    }
+
+private:
+    void produce() {
+        while (true) {
+            std::vector<char> data;
+            {
+                std::unique_lock lock{mutex_};
+                condition_.wait(lock, [this] { return stop_ || !free_.empty(); });
+                if (stop_) {
+                    return;
+                }
+                data = std::move(free_.back());
+                free_.pop_back();
+            }
+
+            ssize_t last = 1;
+            size_t size = 0;
+            try {
+                while (size < data.size()) {
+                    last = source_.read(data.data() + size, data.size() - size);
+                    if (last <= 0) {
+                        break;
+                    }
+                    size += static_cast<size_t>(last);
+                }
+            } catch (...) {
+                std::lock_guard lock{mutex_};
+                exception_ = std::current_exception();
+                last = -1;
+            }
+
+            {
+                std::lock_guard lock{mutex_};
+                if (size > 0) {
+                    ready_.push_back({std::move(data), static_cast<ssize_t>(size)});
+                }
+                if (last <= 0) {
+                    // the end, or the error, is given as an empty block
+                    ready_.push_back({{}, last < 0 ? -1 : 0});
+                }
+            }
+            condition_.notify_all();
+
+            if (last <= 0) {
+                return;
+            }
+        }
+    }
+
+    byte_source source_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<block> ready_;
+    std::vector<std::vector<char>> free_;
+    std::exception_ptr exception_;
+    bool stop_{false};
+
+    block current_;
+    size_t position_{0};
+    bool end_{false};
+
+    std::thread thread_;
+};
+
+// the returned source reads the given one on a separate thread, so the
+// next block is produced, for example decompressed, while the previous
+// one is being parsed, copies of the returned source share its state
+[[nodiscard]] inline byte_source read_ahead(
+    byte_source source, size_t block_size = file_buffer_size) {
+    if (!source.read) {
+        return source;
+    }
+
+    auto name = source.name;
+    auto state = std::make_shared<read_ahead_state>(std::move(source),
+                                                            block_size);
+    return {[state](char* data, size_t size) {
+                return state->read(data, size);
+            },
+            std::move(name)};
+}
+
+////////////////
+// compressed sources
+////////////////
+
+#ifdef SSP_ZLIB_ENABLED
+
+// reads a gzip compressed file, or an uncompressed one, the data is
+// decompressed on a separate thread, the returned source has no 'read'
+// function if the file could not be opened
+[[nodiscard]] inline byte_source gzip_source(const std::string& file_name) {
+    std::shared_ptr<gzFile_s> file{gzopen(file_name.c_str(), "rb"),
+                                   [](gzFile file) {
+                                       if (file) {
+                                           std::ignore = gzclose(file);
+                                       }
+                                   }};
+    if (!file) {
+        return {nullptr, file_name};
+    }
+
+    std::ignore = gzbuffer(file.get(), file_buffer_size);
+
+    byte_source source{[file](char* data, size_t size) -> ssize_t {
+                           constexpr size_t max_size = 1 << 30;
+                           const auto n = gzread(file.get(), data,
+                                                 static_cast<unsigned>(std::min(
+                                                     size, max_size)));
+                           if (n == 0) {
+                               int error = Z_OK;
+                               std::ignore = gzerror(file.get(), &error);
+                               // truncated data
+                               return error == Z_OK ? 0 : -1;
+                           }
+                           return n;
+                       },
+                       file_name};
+
+    return read_ahead(std::move(source));
+}
+
+#endif
+
+#ifdef SSP_ZSTD_ENABLED
+
+struct zstd_state {
+    zstd_state(FILE* file)
+        : file{file}, context{ZSTD_createDCtx()},
+          input_data(ZSTD_DStreamInSize()) {
+    }
+
+    ~zstd_state() {
+        std::ignore = std::fclose(file);
+        std::ignore = ZSTD_freeDCtx(context);
+    }
+
+    zstd_state(const zstd_state& other) = delete;
+    zstd_state& operator=(const zstd_state& other) = delete;
+
+    [[nodiscard]] ssize_t read(char* data, size_t size) {
+        ZSTD_outBuffer output{data, size, 0};
+        while (output.pos < output.size) {
+            // the data left within the context is flushed first
+            if (input.pos == input.size && !flush) {
+                input.size = std::fread(input_data.data(), 1,
+                                        input_data.size(), file);
+                input.pos = 0;
+                if (input.size == 0) {
+                    break;
+                }
+            }
+
+            last = ZSTD_decompressStream(context, &output, &input);
+            if (ZSTD_isError(last)) {
+                return -1;
+            }
+            flush = output.pos == output.size;
+        }
+
+        if (output.pos == 0 && (last != 0 || std::ferror(file))) {
+            // truncated or unreadable data
+            return -1;
+        }
+        return static_cast<ssize_t>(output.pos);
+    }
+
+    FILE* file;
+    ZSTD_DCtx* context;
+    std::vector<char> input_data;
+    ZSTD_inBuffer input{input_data.data(), 0, 0};
+    size_t last{0};
+    bool flush{false};
+};
+
+// reads a zstd compressed file, the data is decompressed on a separate
+// thread, the returned source has no 'read' function if the file could not
+// be opened
+[[nodiscard]] inline byte_source zstd_source(const std::string& file_name) {
+    FILE* file = std::fopen(file_name.c_str(), "rb");
+    if (!file) {
+        return {nullptr, file_name};
+    }
+
+    auto state = std::make_shared<zstd_state>(file);
+    if (!state->context) {
+        return {nullptr, file_name};
+    }
+
+    byte_source source{[state](char* data, size_t size) {
+                           return state->read(data, size);
+                       },
+                       file_name};
+
+    return read_ahead(std::move(source));
+}
+
+#endif
+
+////////////////
+// io_uring source
+////////////////
+
+#ifdef SSP_IO_URING_ENABLED
+
+// options of 'ss::uring_source'
+struct uring_options {
+    // size of each read, rounded up to a multiple of 4096
+    size_t block_size{1 << 20};
+
+    // number of reads kept in flight, 0 reads the file using 'pread'
+    unsigned queue_depth{4};
+
+    // the page cache is bypassed using 'O_DIRECT' if the file system
+    // supports it
+    bool direct{false};
+
+    // the file is read once, the blocks which were consumed are dropped
+    // from the page cache
+    bool sequential_scan{false};
+};
+
+// reads the blocks of a file in order while keeping the reads of the
+// following blocks in flight, each block has its own buffer which is
+// registered with the ring if possible, if the ring could not be set up the
+// blocks are read using 'pread'
+class uring_state {
+    constexpr static size_t alignment = 4096;
+
+public:
+    uring_state(int fd, const uring_options& options)
+        : fd_{fd}, block_size_{(std::max<size_t>(options.block_size, 1) +
+                                alignment - 1) /
+                               alignment * alignment},
+          depth_{std::max(options.queue_depth, 1u)},
+          sequential_scan_{options.sequential_scan} {
+        if (sequential_scan_) {
+            advise_sequential_file(fd_);
+        }
+
+        struct stat status {};
+        if (fstat(fd_, &status) == 0 && status.st_size > 0) {
+            file_size_ = static_cast<size_t>(status.st_size);
+        }
+
+        buffers_.reserve(depth_);
+        for (unsigned i = 0; i < depth_; ++i) {
+            void* buffer = std::aligned_alloc(alignment, block_size_);
+            if (!buffer) {
+                free_buffers();
+                std::ignore = close(fd_);
+                throw std::bad_alloc{};
+            }
+            buffers_.push_back(static_cast<char*>(buffer));
+            iovecs_.push_back({buffer, block_size_});
+        }
+
+        results_.resize(depth_);
+        done_.resize(depth_);
+
+        if (options.queue_depth > 0 && setup_ring()) {
+            for (unsigned i = 0; i < depth_; ++i) {
+                submit(i);
+            }
+        }
+    }
+
+    ~uring_state() {
+        // the buffers may not be freed while reads into them are in flight
+        while (in_flight_ > 0 && reap()) {
+        }
+
+        close_ring();
+        free_buffers();
+        std::ignore = close(fd_);
+    }
+
+    uring_state(const uring_state& other) = delete;
+    uring_state& operator=(const uring_state& other) = delete;
+
+    [[nodiscard]] ssize_t read(char* data, size_t size) {
+        while (position_ == current_size_) {
+            if (end_ || !next_block()) {
+                return status_;
+            }
+        }
+
+        const auto n = std::min(size, current_size_ - position_);
+        std::memcpy(data, buffers_[current_block_ % depth_] + position_, n);
+        position_ += n;
+        return static_cast<ssize_t>(n);
+    }
+
+private:
+    ////////////////
+    // blocks
+    ////////////////
+
+    // makes the next block current, short reads are completed using
+    // 'pread', returns false at the end of the file or on error
+    [[nodiscard]] bool next_block() {
+        if (loaded_) {
+            if (last_) {
+                end_ = true;
+                return false;
+            }
+
+            if (sequential_scan_) {
+                const auto begin = current_block_ * block_size_;
+                advise_dont_need_file(fd_, begin, begin + current_size_);
+            }
+
+            // the buffer of the consumed block is used for the block which
+            // is 'depth_' blocks ahead
+            submit(current_block_ + depth_);
+            ++current_block_;
+        }
+        loaded_ = true;
+
+        const auto buffer = current_block_ % depth_;
+        const auto offset = current_block_ * block_size_;
+
+        ssize_t result = ring_fd_ != -1 ? wait(buffer) : 0;
+        size_t size = result > 0 ? static_cast<size_t>(result) : 0;
+
+        while (result >= 0 && size < block_size_ && offset + size < file_size_) {
+            const auto n = pread(fd_, buffers_[buffer] + size,
+                                 block_size_ - size, offset + size);
+            if (n == 0 || (n < 0 && errno != EINTR)) {
+                result = n;
+                break;
+            }
+            size += n > 0 ? static_cast<size_t>(n) : 0;
+        }
+
+        position_ = current_size_ = 0;
+        if (result < 0) {
+            status_ = -1;
+            end_ = true;
+            return false;
+        }
+
+        current_size_ = size;
+        last_ = size < block_size_;
+        if (size == 0) {
+            end_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    ////////////////
+    // ring
+    ////////////////
+
+    [[nodiscard]] bool setup_ring() {
+        io_uring_params params{};
+        ring_fd_ = static_cast<int>(
+            syscall(__NR_io_uring_setup, depth_, &params));
+        if (ring_fd_ < 0) {
+            ring_fd_ = -1;
+            return false;
+        }
+
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        }
+
+        sq_ = map(sq_size_, IORING_OFF_SQ_RING);
+        cq_ = single_mmap ? sq_ : map(cq_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+
+        if (!sq_ || !cq_ || !sqes_) {
+            close_ring();
+            return false;
+        }
+
+        auto* sq = static_cast<char*>(sq_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        auto* cq = static_cast<char*>(cq_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        fixed_ = syscall(__NR_io_uring_register, ring_fd_,
+                         IORING_REGISTER_BUFFERS, iovecs_.data(),
+                         depth_) == 0;
+        return true;
+    }
+
+    [[nodiscard]] void* map(size_t size, off_t offset) const {
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    void close_ring() {
+        if (ring_fd_ == -1) {
+            return;
+        }
+
+        if (sqes_) {
+            std::ignore = munmap(sqes_, sqes_size_);
+        }
+        if (cq_ && cq_ != sq_) {
+            std::ignore = munmap(cq_, cq_size_);
+        }
+        if (sq_) {
+            std::ignore = munmap(sq_, sq_size_);
+        }
+        std::ignore = close(ring_fd_);
+        ring_fd_ = -1;
+    }
+
+    void submit(size_t block) {
+        const auto buffer = block % depth_;
+        const auto offset = block * block_size_;
+        done_[buffer] = false;
+
+        if (ring_fd_ == -1) {
+            return;
+        }
+
+        if (offset >= file_size_) {
+            complete(buffer, 0);
+            return;
+        }
+
+        const unsigned tail = *sq_tail_;
+        const unsigned index = tail & sq_mask_;
+
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.fd = fd_;
+        sqe.off = offset;
+        sqe.user_data = buffer;
+        if (fixed_) {
+            sqe.opcode = IORING_OP_READ_FIXED;
+            sqe.addr = reinterpret_cast<uintptr_t>(buffers_[buffer]);
+            sqe.len = static_cast<unsigned>(block_size_);
+            sqe.buf_index = static_cast<uint16_t>(buffer);
+        } else {
+            sqe.opcode = IORING_OP_READV;
+            sqe.addr = reinterpret_cast<uintptr_t>(&iovecs_[buffer]);
+            sqe.len = 1;
+        }
+
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+        long submitted = -1;
+        do {
+            submitted =
+                syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0);
+        } while (submitted < 0 && errno == EINTR);
+
+        if (submitted == 1) {
+            ++in_flight_;
+        } else {
+            complete(buffer, -1);
+        }
+    }
+
+    void complete(size_t buffer, ssize_t result) {
+        results_[buffer] = result;
+        done_[buffer] = true;
+    }
+
+    // waits for the read into the given buffer
+    [[nodiscard]] ssize_t wait(size_t buffer) {
+        while (!done_[buffer]) {
+            if (!reap()) {
+                return -1;
+            }
+        }
+        return results_[buffer];
+    }
+
+    // takes the available completions, or waits for one
+    [[nodiscard]] bool reap() {
+        unsigned head = *cq_head_;
+        const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+        if (head == tail) {
+            const auto result = syscall(__NR_io_uring_enter, ring_fd_, 0, 1,
+                                        IORING_ENTER_GETEVENTS, nullptr, 0);
+            return result >= 0 || errno == EINTR;
+        }
+
+        for (; head != tail; ++head) {
+            const auto& cqe = cqes_[head & cq_mask_];
+            complete(cqe.user_data, cqe.res);
+            --in_flight_;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    void free_buffers() {
+        for (auto* buffer : buffers_) {
+            std::free(buffer);
+        }
+        buffers_.clear();
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    int fd_;
+    size_t file_size_{0};
+    size_t block_size_;
+    unsigned depth_;
+    bool sequential_scan_;
+
+    std::vector<char*> buffers_;
+    std::vector<iovec> iovecs_;
+    std::vector<ssize_t> results_;
+    std::vector<bool> done_;
+
+    size_t current_block_{0};
+    size_t current_size_{0};
+    size_t position_{0};
+    ssize_t status_{0};
+    bool loaded_{false};
+    bool last_{false};
+    bool end_{false};
+
+    int ring_fd_{-1};
+    bool fixed_{false};
+    size_t in_flight_{0};
+
+    void* sq_{nullptr};
+    void* cq_{nullptr};
+    io_uring_sqe* sqes_{nullptr};
+    size_t sq_size_{0};
+    size_t cq_size_{0};
+    size_t sqes_size_{0};
+
+    unsigned* sq_tail_{nullptr};
+    unsigned* sq_array_{nullptr};
+    unsigned sq_mask_{0};
+    unsigned* cq_head_{nullptr};
+    unsigned* cq_tail_{nullptr};
+    unsigned cq_mask_{0};
+    io_uring_cqe* cqes_{nullptr};
+};
+
+// reads a file using io_uring on Linux, several blocks are read ahead, the
+// returned source has no 'read' function if the file could not be opened
+[[nodiscard]] inline byte_source uring_source(const std::string& file_name,
+                                              uring_options options = {}) {
+    int fd = -1;
+    if (options.direct) {
+        fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    }
+    if (fd == -1) {
+        fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if (fd == -1) {
+        return {nullptr, file_name};
+    }
+
+    auto state = std::make_shared<uring_state>(fd, options);
+    return {[state](char* data, size_t size) {
+                return state->read(data, size);
+            },
+            file_name};
+}
+
+#endif
+
+////////////////
+// line reader
+////////////////
+
+// splits the data of a byte source into lines
+class byte_source_reader {
+public:
+    byte_source_reader() = default;
+
+    byte_source_reader(byte_source source) : source_{std::move(source)} {
+    }
+
+    [[nodiscard]] explicit operator bool() const {
+        return static_cast<bool>(source_.read);
+    }
+
+    // returns true once if the source reported an error
+    [[nodiscard]] bool take_error() {
+        return std::exchange(failed_, false);
+    }
+
+    // same as 'get_line_file', the line is written after the first 'offset'
+    // characters of 'lineptr', at most 'max_size' characters are kept, the
+    // number of dropped characters is added to 'dropped'
+    [[nodiscard]] ssize_t get_line(
+        char*& lineptr, size_t& n, size_t offset, size_t max_size,
+        size_t& dropped, std::pmr::memory_resource* resource = nullptr) {
+        reserve_buffer(lineptr, n, offset + 1, resource);
+
+        size_t line_used = 0;
+        while (begin_ < end_ || fill()) {
+            const char* begin = block_.data() + begin_;
+            const auto* new_line = static_cast<const char*>(
+                std::memchr(begin, '\n', end_ - begin_));
+            const size_t read =
+                new_line ? new_line - begin + 1 : end_ - begin_;
+            const size_t size = std::min(read, max_size - line_used);
+            dropped += read - size;
+
+            reserve_buffer(lineptr, n, offset + line_used + size + 1,
+                           resource);
+            std::memcpy(lineptr + offset + line_used, begin, size);
+            line_used += size;
+            begin_ += read;
+
+            if (new_line) {
+                break;
+            }
+        }
+
+        lineptr[offset + line_used] = '\0';
+        return line_used != 0 ? static_cast<ssize_t>(line_used) : -1;
+    }
+
+private:
+    [[nodiscard]] bool fill() {
+        if (done_) {
+            return false;
+        }
+
+        if (block_.empty()) {
+            block_.resize(file_buffer_size);
+        }
+
+        begin_ = end_ = 0;
+        const auto size = source_.read(block_.data(), block_.size());
+        if (size <= 0) {
+            failed_ = size < 0;
+            done_ = true;
+            return false;
+        }
+
+        end_ = static_cast<size_t>(size);
+        return true;
+    }
+
+    byte_source source_;
+    std::vector<char> block_;
+    size_t begin_{0};
+    size_t end_{0};
+    bool done_{false};
+    bool failed_{false};
+};
+
+} /* namespace ss */
@@ -1,13 +1,22 @@
 #pragma once
+#include <algorithm>
+#include <array>
 #include <cerrno>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <tuple>
 #include <vector>
 
-#if !__unix__
-#include <array>
-#include <cstdint>
+#if __unix__ || __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#elif _WIN32
+#include <io.h>
 #endif
 
 namespace ss {
@@ -15,10 +24,15 @@ namespace ss {
 struct none {};
 
 using string_range = std::pair<const char*, const char*>;
-using split_data = std::vector<string_range>;
+using split_data = std::pmr::vector<string_range>;
 
 constexpr inline auto default_delimiter = ",";
 constexpr inline auto get_line_initial_buffer_size = 128;
+constexpr inline auto writer_buffer_size = 1 << 18;
+constexpr inline size_t file_buffer_size = 1 << 18;
+constexpr inline size_t page_cache_drop_size = 1 << 24;
+constexpr inline size_t default_arena_block_size = 1 << 16;
+constexpr inline size_t quote_resync_lines = 64;
 
 template <bool StringError>
 void assert_string_error_defined() {
@@ -41,6 +55,56 @@ void assert_throw_on_error_not_defined() {
     return ptr;
 }
 
+[[nodiscard]] inline std::pmr::memory_resource* resource_or_default(
+    std::pmr::memory_resource* resource) {
+    return resource ? resource : std::pmr::get_default_resource();
+}
+
+// resizes the buffer of 'n' characters to 'new_n' characters keeping its
+// content, the buffer is allocated with 'std::realloc' unless a memory
+// resource is given
+[[nodiscard]] inline char* reallocate_buffer(
+    char* buffer, size_t n, size_t new_n,
+    std::pmr::memory_resource* resource = nullptr) {
+    if (resource == nullptr) {
+        return static_cast<char*>(strict_realloc(buffer, new_n));
+    }
+
+    auto* new_buffer = static_cast<char*>(resource->allocate(new_n, 1));
+    if (buffer != nullptr) {
+        std::memcpy(new_buffer, buffer, std::min(n, new_n));
+        resource->deallocate(buffer, n, 1);
+    }
+    return new_buffer;
+}
+
+inline void free_buffer(char* buffer, size_t n,
+                        std::pmr::memory_resource* resource = nullptr) {
+    if (resource == nullptr) {
+        std::free(buffer);
+    } else if (buffer != nullptr) {
+        resource->deallocate(buffer, n, 1);
+    }
+}
+
+// makes sure the buffer can hold 'size' characters, the buffer grows
+// geometrically, so appending to it has an amortized constant cost
+inline void reserve_buffer(char*& buffer, size_t& n, size_t size,
+                           std::pmr::memory_resource* resource = nullptr) {
+    if (buffer != nullptr && n >= size) {
+        return;
+    }
+
+    const size_t old_n = buffer != nullptr ? n : 0;
+    size_t new_n = std::max<size_t>(n, get_line_initial_buffer_size);
+    while (new_n < size) {
+        new_n *= 2;
+    }
+
+    buffer = reallocate_buffer(buffer, old_n, new_n, resource);
+    n = new_n;
+}
+
 #if __unix__
 [[nodiscard]] inline ssize_t get_line_file(char*& lineptr, size_t& n,
                                            FILE* file) {
@@ -87,55 +151,128 @@ using ssize_t = intptr_t;
 
 #endif
 
-[[nodiscard]] inline ssize_t get_line_buffer(char*& lineptr, size_t& n,
-                                             const char* const csv_data_buffer,
-                                             size_t csv_data_size,
-                                             size_t& curr_char) {
-    if (curr_char >= csv_data_size) {
-        return -1;
+// locks the file while it is read by characters without locking it for each
+// of them
+class file_lock {
+public:
+    explicit file_lock(FILE* file) : file_{file} {
+#if __unix__ || __APPLE__
+        flockfile(file_);
+#elif _WIN32
+        _lock_file(file_);
+#endif
     }
 
-    if (lineptr == nullptr || n < get_line_initial_buffer_size) {
-        auto* new_lineptr = static_cast<char*>(
-            strict_realloc(lineptr, get_line_initial_buffer_size));
-        lineptr = new_lineptr;
-        n = get_line_initial_buffer_size;
+    ~file_lock() {
+#if __unix__ || __APPLE__
+        funlockfile(file_);
+#elif _WIN32
+        _unlock_file(file_);
+#endif
+    }
+
+    file_lock(const file_lock&) = delete;
+    file_lock& operator=(const file_lock&) = delete;
+
+    [[nodiscard]] int get() {
+#if __unix__ || __APPLE__
+        return getc_unlocked(file_);
+#elif _WIN32
+        return _getc_nolock(file_);
+#else
+        return std::getc(file_);
+#endif
     }
 
+private:
+    FILE* file_;
+};
+
+// same as 'get_line_file', but the line is written after the first 'offset'
+// characters of 'lineptr', at most 'max_size' characters of the line are
+// written, the rest of the line is read and dropped, the number of dropped
+// characters is added to 'dropped', returns the number of written characters,
+// 'lineptr' is allocated from 'resource' if one is given, the characters are
+// counted as they are read, so null characters within the line are kept
+[[nodiscard]] inline ssize_t get_line_file(
+    char*& lineptr, size_t& n, FILE* file, size_t offset, size_t max_size,
+    size_t& dropped, std::pmr::memory_resource* resource = nullptr) {
+    reserve_buffer(lineptr, n, offset + 1, resource);
+
     size_t line_used = 0;
-    while (curr_char < csv_data_size) {
-        if (line_used + 1 >= n) {
-            const size_t new_n = n * 2;
+    {
+        file_lock lock{file};
+        for (int c = lock.get(); c != EOF; c = lock.get()) {
+            if (line_used < max_size) {
+                reserve_buffer(lineptr, n, offset + line_used + 2, resource);
+                lineptr[offset + line_used++] = static_cast<char>(c);
+            } else {
+                ++dropped;
+            }
 
-            char* new_lineptr =
-                static_cast<char*>(strict_realloc(lineptr, new_n));
-            n = new_n;
-            lineptr = new_lineptr;
+            if (c == '\n') {
+                break;
+            }
         }
+    }
 
-        auto c = csv_data_buffer[curr_char++];
-        lineptr[line_used++] = c;
-        if (c == '\n') {
-            lineptr[line_used] = '\0';
-            return line_used;
-        }
+    lineptr[offset + line_used] = '\0';
+    return (line_used != 0) ? line_used : -1;
+}
+
+// the line is written after the first 'offset' characters of 'lineptr', at
+// most 'max_size' characters of the line are written and the rest is dropped
+[[nodiscard]] inline ssize_t get_line_buffer(
+    char*& lineptr, size_t& n, const char* const csv_data_buffer,
+    size_t csv_data_size, size_t& curr_char, size_t offset = 0,
+    size_t max_size = std::numeric_limits<size_t>::max(),
+    std::pmr::memory_resource* resource = nullptr) {
+    if (curr_char >= csv_data_size) {
+        return -1;
     }
 
-    lineptr[line_used] = '\0';
-    return line_used;
+    const char* const begin = csv_data_buffer + curr_char;
+    const size_t left = csv_data_size - curr_char;
+    const auto* new_line =
+        static_cast<const char*>(std::memchr(begin, '\n', left));
+    const size_t read = new_line ? new_line - begin + 1 : left;
+    const size_t size = std::min(read, max_size);
+
+    reserve_buffer(lineptr, n, offset + size + 1, resource);
+    std::memcpy(lineptr + offset, begin, size);
+    lineptr[offset + size] = '\0';
+
+    curr_char += read;
+    return size;
 }
 
+// the line is written after the first 'offset' characters of 'buffer', at
+// most 'max_size' characters of the line are kept, the rest is dropped, the
+// buffer is allocated from 'resource' if one is given
 [[nodiscard]] inline std::tuple<ssize_t, bool> get_line(
     char*& buffer, size_t& buffer_size, FILE* file,
     const char* const csv_data_buffer, size_t csv_data_size,
-    size_t& curr_char) {
+    size_t& curr_char, size_t offset = 0,
+    size_t max_size = std::numeric_limits<size_t>::max(),
+    std::pmr::memory_resource* resource = nullptr) {
     ssize_t ssize = 0;
     if (file) {
-        ssize = get_line_file(buffer, buffer_size, file);
-        curr_char += ssize;
+        size_t dropped = 0;
+        if (offset == 0 && max_size == std::numeric_limits<size_t>::max() &&
+            resource == nullptr) {
+            ssize = get_line_file(buffer, buffer_size, file);
+        } else {
+            ssize = get_line_file(buffer, buffer_size, file, offset, max_size,
+                                  dropped, resource);
+        }
+
+        if (ssize > 0) {
+            curr_char += ssize + dropped;
+        }
     } else {
         ssize = get_line_buffer(buffer, buffer_size, csv_data_buffer,
-                                csv_data_size, curr_char);
+                                csv_data_size, curr_char, offset, max_size,
+                                resource);
     }
 
     if (ssize == -1) {
@@ -148,4 +285,133 @@ using ssize_t = intptr_t;
     return {ssize, false};
 }
 
+// opens a duplicate of the file descriptor, so closing the returned file
+// does not close the given descriptor
+[[nodiscard]] inline FILE* open_file_descriptor(int fd) {
+#if __unix__ || __APPLE__
+    const int copy = dup(fd);
+    if (copy == -1) {
+        return nullptr;
+    }
+
+    FILE* file = fdopen(copy, "rb");
+    if (!file) {
+        std::ignore = close(copy);
+    }
+    return file;
+#elif _WIN32
+    const int copy = _dup(fd);
+    if (copy == -1) {
+        return nullptr;
+    }
+
+    FILE* file = _fdopen(copy, "rb");
+    if (!file) {
+        std::ignore = _close(copy);
+    }
+    return file;
+#else
+    std::ignore = fd;
+    return nullptr;
+#endif
+}
+
+////////////////
+// access hints
+////////////////
+
+// the hints are only given where they are supported, they do not change
+// the read data
+
+inline void advise_sequential_file(int fd) {
+#ifdef POSIX_FADV_SEQUENTIAL
+    std::ignore = posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    std::ignore = fd;
+#endif
+}
+
+inline void advise_sequential_file(FILE* file) {
+#ifdef POSIX_FADV_SEQUENTIAL
+    advise_sequential_file(fileno(file));
+#else
+    std::ignore = file;
+#endif
+}
+
+// the pages of [begin, end) are dropped from the page cache
+inline void advise_dont_need_file(int fd, size_t begin, size_t end) {
+#ifdef POSIX_FADV_DONTNEED
+    if (end > begin) {
+        std::ignore = posix_fadvise(fd, static_cast<off_t>(begin),
+                                    static_cast<off_t>(end - begin),
+                                    POSIX_FADV_DONTNEED);
+    }
+#else
+    std::ignore = fd;
+    std::ignore = begin;
+    std::ignore = end;
+#endif
+}
+
+inline void advise_dont_need_file(FILE* file, size_t begin, size_t end) {
+#ifdef POSIX_FADV_DONTNEED
+    advise_dont_need_file(fileno(file), begin, end);
+#else
+    std::ignore = file;
+    std::ignore = begin;
+    std::ignore = end;
+#endif
+}
+
+// the pages of a memory mapped file are read ahead aggressively, and backed
+// by huge pages if possible, the hints apply to whole pages, so it is not
+// used by the parser, which does not know how a given buffer was allocated,
+// it needs to be called explicitly with the mapped memory
+inline void advise_sequential_buffer(const char* buffer, size_t size) {
+#if __unix__ || __APPLE__
+    const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    if (!buffer || size == 0 || page_size == 0) {
+        return;
+    }
+
+    const auto begin =
+        reinterpret_cast<uintptr_t>(buffer) / page_size * page_size;
+    const auto end = reinterpret_cast<uintptr_t>(buffer) + size;
+    auto* address = reinterpret_cast<void*>(begin);
+
+    std::ignore = madvise(address, end - begin, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    std::ignore = madvise(address, end - begin, MADV_HUGEPAGE);
+#endif
+#else
+    std::ignore = buffer;
+    std::ignore = size;
+#endif
+}
+
+[[nodiscard]] inline bool seek_file(FILE* file, size_t position) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(position), SEEK_SET) == 0;
+#else
+    return std::fseek(file, static_cast<long>(position), SEEK_SET) == 0;
+#endif
+}
+
+// the position within the file is kept
+[[nodiscard]] inline size_t file_size(FILE* file) {
+#ifdef _WIN32
+    const auto position = _ftelli64(file);
+    std::ignore = _fseeki64(file, 0, SEEK_END);
+    const auto size = _ftelli64(file);
+    std::ignore = _fseeki64(file, position, SEEK_SET);
+#else
+    const auto position = std::ftell(file);
+    std::ignore = std::fseek(file, 0, SEEK_END);
+    const auto size = std::ftell(file);
+    std::ignore = std::fseek(file, position, SEEK_SET);
+#endif
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
 } /* namespace ss */
@@ -5,8 +5,17 @@
 #include "restrictions.hpp"
 #include "splitter.hpp"
 #include "type_traits.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <type_traits>
+#include <variant>
 #include <vector>
 
 namespace ss {
@@ -92,6 +101,48 @@ struct tied_class {
 template <typename... Ts>
 constexpr bool tied_class_v = tied_class<Ts...>::value;
 
+////////////////
+// column types
+////////////////
+
+// each type has a unique address, used to compare column types at runtime
+template <typename T>
+struct type_tag {
+    constexpr static char id{};
+};
+
+template <typename... Ts>
+constexpr inline const void* column_type_ids[] = {&type_tag<Ts>::id...};
+
+////////////////
+// pmr string
+////////////////
+
+template <typename T>
+struct is_pmr_string : std::is_same<T, std::pmr::string> {};
+
+template <typename T>
+constexpr bool is_pmr_string_v = is_pmr_string<T>::value;
+
+////////////////
+// category
+////////////////
+
+// categories need the string pool of the converter, also when they are
+// wrapped into an optional or a variant
+template <typename T>
+struct has_category : std::is_same<T, category> {};
+
+template <typename T>
+struct has_category<std::optional<T>> : has_category<T> {};
+
+template <typename... Ts>
+struct has_category<std::variant<Ts...>>
+    : std::disjunction<has_category<Ts>...> {};
+
+template <typename T>
+constexpr bool has_category_v = has_category<T>::value;
+
 ////////////////
 // converter
 ////////////////
@@ -102,11 +153,20 @@ class converter {
 
     constexpr static auto string_error = setup<Options...>::string_error;
     constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
+    constexpr static auto arena_views = setup<Options...>::arena_views;
     constexpr static auto default_delimiter = ",";
 
     using error_type = std::conditional_t<string_error, std::string, bool>;
 
 public:
+    converter() = default;
+
+    // the split data and the converted 'std::pmr::string' values are
+    // allocated from the given memory resource
+    explicit converter(std::pmr::memory_resource* resource)
+        : splitter_{resource}, resource_{resource_or_default(resource)} {
+    }
+
     // parses line with given delimiter, returns a 'T' object created with
     // extracted values of type 'Ts'
     template <typename T, typename... Ts>
@@ -186,10 +246,40 @@ public:
         return splitter_.unterminated_quote();
     }
 
+    // pool used to store the values converted to 'ss::category'
+    [[nodiscard]] ss::string_pool& get_string_pool() {
+        if (!string_pool_) {
+            string_pool_ = std::make_shared<ss::string_pool>();
+        }
+        return *string_pool_;
+    }
+
+    // the given pool is not owned by the converter, it needs to outlive it
+    void set_string_pool(ss::string_pool& pool) {
+        string_pool_ = std::shared_ptr<ss::string_pool>{
+            std::shared_ptr<ss::string_pool>{}, &pool};
+    }
+
+    // arena used to store the converted 'std::string_view' values if
+    // 'arena_views' is enabled
+    [[nodiscard]] ss::arena& get_arena() {
+        if (!arena_) {
+            arena_ = std::make_shared<ss::arena>();
+        }
+        return *arena_;
+    }
+
+    // the given arena is not owned by the converter, it needs to outlive it
+    void set_arena(ss::arena& arena) {
+        arena_ = std::shared_ptr<ss::arena>{std::shared_ptr<ss::arena>{},
+                                            &arena};
+    }
+
     // 'splits' string by given delimiter, returns vector of pairs which
     // contain the beginnings and the ends of each column of the string
     const split_data& split(line_ptr_type line,
                             const std::string& delim = default_delimiter) {
+        clear_conversions();
         splitter_.clear_split_data();
         if (line[0] == '\0') {
             return splitter_.get_split_data();
@@ -205,6 +295,7 @@ private:
 
     const split_data& resplit(line_ptr_type new_line, ssize_t new_size,
                               const std::string& delim) {
+        clear_conversions();
         return splitter_.resplit(new_line, new_size, delim);
     }
 
@@ -284,6 +375,20 @@ private:
         }
     }
 
+    void handle_error_record_size_limit_reached() {
+        constexpr static auto error_msg = "record size limit reached";
+        splitter_.unterminated_quote_ = false;
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
     void handle_error_invalid_conversion(const string_range msg, size_t pos) {
         constexpr static auto error_msg = "invalid conversion for parameter ";
 
@@ -381,7 +486,25 @@ private:
             }
         }
 
-        return extract_tuple<Ts...>(elems);
+        // the cached split data may have already failed to convert with
+        // the same column types, in which case only the failed column is
+        // converted again to report the same error, the columns which were
+        // converted successfully may be remembered (see below)
+        const bool cached = (&elems == &splitter_.get_split_data());
+        remembering_values_ = cached && remember_values_;
+        if (cached) {
+            if (const auto column = known_failed_column<Ts...>();
+                column != no_column) {
+                return extract_tuple<Ts...>(elems, column);
+            }
+        }
+
+        failed_column_ = no_column;
+        auto value = extract_tuple<Ts...>(elems);
+        if (cached && failed_column_ != no_column) {
+            remember_failed_conversion<Ts...>(failed_column_);
+        }
+        return value;
     }
 
     template <typename... Ts>
@@ -408,15 +531,110 @@ private:
     // assumes positions are valid and the vector is not empty
     void set_column_mapping(std::vector<size_t> positions,
                             size_t number_of_columns) {
+        clear_conversions();
         column_mappings_ = std::move(positions);
         number_of_columns_ = number_of_columns;
     }
 
     void clear_column_positions() {
+        clear_conversions();
         column_mappings_.clear();
         number_of_columns_ = 0;
     }
 
+    ////////////////
+    // failed conversions
+    ////////////////
+
+    // a conversion which failed at 'column', the conversion of the same
+    // split data fails at the same column if the types of all the columns
+    // up to and including it are the same
+    struct failed_conversion {
+        const void* const* column_types;
+        size_t column;
+    };
+
+    template <typename... Ts>
+    [[nodiscard]] size_t known_failed_column() const {
+        const void* const* column_types = column_type_ids<Ts...>;
+        for (size_t i = 0; i < failed_conversions_size_; ++i) {
+            const auto& failed = failed_conversions_[i];
+            if (failed.column < sizeof...(Ts) &&
+                std::equal(failed.column_types,
+                           failed.column_types + failed.column + 1,
+                           column_types)) {
+                return failed.column;
+            }
+        }
+        return no_column;
+    }
+
+    template <typename... Ts>
+    void remember_failed_conversion(size_t column) {
+        if (failed_conversions_size_ < failed_conversions_.size()) {
+            failed_conversions_[failed_conversions_size_++] = {
+                column_type_ids<Ts...>, column};
+        }
+    }
+
+    void clear_conversions() {
+        failed_conversions_size_ = 0;
+        converted_values_.clear();
+    }
+
+    ////////////////
+    // converted values
+    ////////////////
+
+    constexpr static size_t max_converted_value_size = 32;
+
+    // a value converted from a column of the cached split data, only values
+    // which can be copied as bytes and fit into 'data' are remembered
+    struct converted_value {
+        const void* type{nullptr};
+        alignas(std::max_align_t) unsigned char data[max_converted_value_size];
+    };
+
+    template <typename T>
+    constexpr static bool can_remember_value =
+        std::is_trivially_copyable_v<no_validator_t<T>> &&
+        sizeof(no_validator_t<T>) <= max_converted_value_size &&
+        alignof(no_validator_t<T>) <= alignof(std::max_align_t);
+
+    // the value is looked up by the type given to the conversion, including
+    // its validator, so the validation of the value is not repeated either
+    template <typename T>
+    [[nodiscard]] bool converted_value_of(no_validator_t<T>& dst,
+                                          size_t pos) const {
+        const size_t column = column_position(pos);
+        if (column >= converted_values_.size() ||
+            converted_values_[column].type != &type_tag<T>::id) {
+            return false;
+        }
+
+        std::memcpy(&dst, converted_values_[column].data, sizeof(dst));
+        return true;
+    }
+
+    template <typename T>
+    void remember_converted_value(const no_validator_t<T>& value, size_t pos) {
+        const size_t column = column_position(pos);
+        if (column >= converted_values_.size()) {
+            converted_values_.resize(column + 1);
+        }
+
+        converted_values_[column].type = &type_tag<T>::id;
+        std::memcpy(converted_values_[column].data, &value, sizeof(value));
+    }
+
+    // the values converted from the cached split data are remembered, so
+    // a later conversion of the same line with a column of the same type
+    // copies its value instead of converting it again, used by the parser
+    // while it tries the alternative conversions of a line
+    void remember_converted_values(bool remember) {
+        remember_values_ = remember;
+    }
+
     ////////////////
     // conversion
     ////////////////
@@ -428,18 +646,30 @@ private:
             return;
         }
 
-        if constexpr (std::is_same_v<T, std::string>) {
+        if constexpr (std::is_same_v<T, std::string> || is_pmr_string_v<T>) {
             static_cast<void>(extract(msg.first, msg.second, dst));
             return;
         }
 
-        if (!extract(msg.first, msg.second, dst)) {
+        if constexpr (can_remember_value<T>) {
+            if (remembering_values_ && converted_value_of<T>(dst, pos)) {
+                return;
+            }
+        }
+
+        if (!extract_value(msg, dst)) {
+            failed_column_ = pos;
             handle_error_invalid_conversion(msg, pos);
             return;
         }
 
+        if constexpr (arena_views) {
+            store_in_arena(dst);
+        }
+
         if constexpr (has_m_ss_valid_t<T>) {
             if (T validator; !validator.ss_valid(dst)) {
+                failed_column_ = pos;
                 if constexpr (has_m_error_t<T>) {
                     handle_error_validation_failed(validator.error(), msg, pos);
                 } else {
@@ -449,41 +679,130 @@ private:
                 return;
             }
         }
+
+        if constexpr (can_remember_value<T>) {
+            if (remembering_values_) {
+                remember_converted_value<T>(dst, pos);
+            }
+        }
     }
 
+    // some types need additional resources owned by the converter, the
+    // optionals and variants containing them are unwrapped the same way
+    // 'extract' unwraps them
+    template <typename T>
+    [[nodiscard]] bool extract_value(const string_range msg, T& dst) {
+        if constexpr (std::is_same_v<T, category>) {
+            return extract(msg.first, msg.second, dst, get_string_pool());
+        } else if constexpr (has_category_v<T> &&
+                             is_instance_of_v<std::optional, T>) {
+            typename T::value_type value;
+            if (extract_value(msg, value)) {
+                dst = std::move(value);
+            } else {
+                dst = std::nullopt;
+            }
+            return true;
+        } else if constexpr (has_category_v<T>) {
+            return extract_variant_value<T, 0>(msg, dst,
+                                               classify_field(msg.first,
+                                                              msg.second));
+        } else {
+            return extract(msg.first, msg.second, dst);
+        }
+    }
+
+    template <typename T, size_t I>
+    [[nodiscard]] bool extract_variant_value(const string_range msg, T& dst,
+                                             const field_class& field) {
+        using IthType = std::variant_alternative_t<I, T>;
+        if (may_extract<IthType>(field)) {
+            IthType value;
+            if (extract_value(msg, value)) {
+                dst.template emplace<I>(std::move(value));
+                return true;
+            }
+        }
+
+        if constexpr (I + 1 < std::variant_size_v<T>) {
+            return extract_variant_value<T, I + 1>(msg, dst, field);
+        }
+        return false;
+    }
+
+    // moves the views pointing to the line into the arena
+    template <typename T>
+    void store_in_arena(T& value) {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            value = get_arena().store(value);
+        } else if constexpr (is_instance_of_v<std::optional, T>) {
+            if (value.has_value()) {
+                store_in_arena(*value);
+            }
+        } else if constexpr (is_instance_of_v<std::variant, T>) {
+            std::visit(
+                [this](auto& alternative) { store_in_arena(alternative); },
+                value);
+        }
+    }
+
+    // extracts all the columns, or only the given one
     template <size_t ArgN, size_t TupN, typename... Ts>
     void extract_multiple(no_void_validator_tup_t<Ts...>& tup,
-                          const split_data& elems) {
+                          const split_data& elems, size_t only_column) {
         using elem_t = std::tuple_element_t<ArgN, std::tuple<Ts...>>;
 
         constexpr bool not_void = !std::is_void_v<elem_t>;
         constexpr bool one_element = count_not_v<std::is_void, Ts...> == 1;
 
         if constexpr (not_void) {
-            if constexpr (one_element) {
-                extract_one<elem_t>(tup, elems[column_position(ArgN)], ArgN);
-            } else {
-                auto& el = std::get<TupN>(tup);
-                extract_one<elem_t>(el, elems[column_position(ArgN)], ArgN);
+            if (only_column == no_column || only_column == ArgN) {
+                if constexpr (one_element) {
+                    extract_one<elem_t>(tup, elems[column_position(ArgN)],
+                                        ArgN);
+                } else {
+                    auto& el = std::get<TupN>(tup);
+                    extract_one<elem_t>(el, elems[column_position(ArgN)],
+                                        ArgN);
+                }
             }
         }
 
         if constexpr (sizeof...(Ts) > ArgN + 1) {
             constexpr size_t NewTupN = (not_void) ? TupN + 1 : TupN;
-            extract_multiple<ArgN + 1, NewTupN, Ts...>(tup, elems);
+            extract_multiple<ArgN + 1, NewTupN, Ts...>(tup, elems,
+                                                      only_column);
         }
     }
 
     template <typename... Ts>
     [[nodiscard]] no_void_validator_tup_t<Ts...> extract_tuple(
-        const split_data& elems) {
+        const split_data& elems, size_t only_column = no_column) {
         static_assert(!all_of_v<std::is_void, Ts...>,
                       "at least one parameter must be non void");
-        no_void_validator_tup_t<Ts...> ret{};
-        extract_multiple<0, 0, Ts...>(ret, elems);
+        auto ret = make_result<no_void_validator_tup_t<Ts...>>();
+        extract_multiple<0, 0, Ts...>(ret, elems, only_column);
         return ret;
     }
 
+    // the 'std::pmr::string' values are created with the memory resource of
+    // the converter, assigning to them keeps their resource
+    template <typename T>
+    [[nodiscard]] T make_result() const {
+        if constexpr (is_pmr_string_v<T>) {
+            return T{resource_};
+        } else if constexpr (is_instance_of_v<std::tuple, T>) {
+            if constexpr (any_of_v<is_pmr_string, T>) {
+                return T{std::allocator_arg,
+                         std::pmr::polymorphic_allocator<char>{resource_}};
+            } else {
+                return T{};
+            }
+        } else {
+            return T{};
+        }
+    }
+
     ////////////////
     // members
     ////////////////
@@ -496,6 +815,23 @@ private:
 
     std::vector<size_t> column_mappings_;
     size_t number_of_columns_{0};
+
+    constexpr static auto no_column = std::numeric_limits<size_t>::max();
+    constexpr static auto max_failed_conversions = 8;
+
+    size_t failed_column_{no_column};
+    std::array<failed_conversion, max_failed_conversions> failed_conversions_{};
+    size_t failed_conversions_size_{0};
+
+    std::vector<converted_value> converted_values_;
+    bool remember_values_{false};
+    bool remembering_values_{false};
+
+    // shared between the converters of the same parser
+    std::shared_ptr<ss::string_pool> string_pool_;
+    std::shared_ptr<ss::arena> arena_;
+
+    std::pmr::memory_resource* resource_{std::pmr::get_default_resource()};
 };
 
 } /* namespace ss */
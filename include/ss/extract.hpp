@@ -1,13 +1,25 @@
 #pragma once
 
+#include "common.hpp"
 #include "type_traits.hpp"
+#include <algorithm>
+#include <array>
 #include <charconv>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 #ifndef SSP_DISABLE_FAST_FLOAT
 #include <fast_float/fast_float.h>
@@ -138,6 +150,1022 @@ to_num(const char* const begin, const char* const end) {
     return ret;
 }
 
+////////////////
+// digit parsing
+////////////////
+
+// the bytes are assembled in little endian order independent of the
+// platform, compilers turn this into a single load where possible
+[[nodiscard]] inline uint64_t load_eight_bytes(const char* const begin) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(begin[i]))
+                 << (8 * i);
+    }
+    return value;
+}
+
+[[nodiscard]] inline bool is_eight_digits(const uint64_t value) {
+    return !(((value + 0x4646464646464646) | (value - 0x3030303030303030)) &
+             0x8080808080808080);
+}
+
+// converts eight digits at once, the value needs to be checked with
+// 'is_eight_digits' first
+[[nodiscard]] inline uint32_t parse_eight_digits(uint64_t value) {
+    constexpr uint64_t mask = 0x000000FF000000FF;
+    constexpr uint64_t mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+    constexpr uint64_t mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+
+    value -= 0x3030303030303030;
+    value = (value * 10) + (value >> 8);
+    value = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(value);
+}
+
+template <size_t N>
+[[nodiscard]] bool parse_digits(const char* const begin, uint32_t& value) {
+    value = 0;
+    for (size_t i = 0; i < N; ++i) {
+        const auto digit = static_cast<unsigned char>(begin[i] - '0');
+        if (digit > 9) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+////////////////
+// date and time
+////////////////
+
+// days since 1970-01-01 of a proleptic gregorian calendar date
+[[nodiscard]] constexpr int64_t days_from_civil(int64_t year, unsigned month,
+                                                unsigned day) {
+    year -= (month <= 2);
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+                         day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+[[nodiscard]] constexpr bool is_leap_year(int64_t year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+[[nodiscard]] constexpr unsigned days_in_month(int64_t year, unsigned month) {
+    constexpr unsigned days[] = {31, 28, 31, 30, 31, 30,
+                                 31, 31, 30, 31, 30, 31};
+    return (month == 2 && is_leap_year(year)) ? 29 : days[month - 1];
+}
+
+// calendar date, converted from 'YYYY-MM-DD'
+struct date {
+    int32_t year{1970};
+    uint8_t month{1};
+    uint8_t day{1};
+
+    [[nodiscard]] int64_t days_since_epoch() const {
+        return days_from_civil(year, month, day);
+    }
+
+    [[nodiscard]] static date from_days_since_epoch(int64_t days) {
+        days += 719468;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const auto doe = static_cast<unsigned>(days - era * 146097);
+        const unsigned yoe =
+            (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        const int64_t year = static_cast<int64_t>(yoe) + era * 400 +
+                             (month <= 2);
+
+        return date{static_cast<int32_t>(year), static_cast<uint8_t>(month),
+                    static_cast<uint8_t>(day)};
+    }
+
+    [[nodiscard]] friend bool operator==(const date& lhs, const date& rhs) {
+        return lhs.tied() == rhs.tied();
+    }
+
+    [[nodiscard]] friend bool operator!=(const date& lhs, const date& rhs) {
+        return lhs.tied() != rhs.tied();
+    }
+
+    [[nodiscard]] friend bool operator<(const date& lhs, const date& rhs) {
+        return lhs.tied() < rhs.tied();
+    }
+
+    [[nodiscard]] friend bool operator<=(const date& lhs, const date& rhs) {
+        return lhs.tied() <= rhs.tied();
+    }
+
+    [[nodiscard]] friend bool operator>(const date& lhs, const date& rhs) {
+        return lhs.tied() > rhs.tied();
+    }
+
+    [[nodiscard]] friend bool operator>=(const date& lhs, const date& rhs) {
+        return lhs.tied() >= rhs.tied();
+    }
+
+private:
+    [[nodiscard]] std::tuple<int32_t, uint8_t, uint8_t> tied() const {
+        return {year, month, day};
+    }
+};
+
+// point in time stored as nanoseconds since 1970-01-01T00:00:00Z,
+// converted from 'YYYY-MM-DD[THH:MM:SS[.fffffffff][Z|+hh:mm|-hh:mm]]',
+// the supported years are 1678 to 2261
+struct timestamp {
+    using time_point_type =
+        std::chrono::time_point<std::chrono::system_clock,
+                                std::chrono::nanoseconds>;
+
+    std::chrono::nanoseconds since_epoch{0};
+
+    [[nodiscard]] time_point_type time_point() const {
+        return time_point_type{since_epoch};
+    }
+
+    [[nodiscard]] friend bool operator==(const timestamp& lhs,
+                                         const timestamp& rhs) {
+        return lhs.since_epoch == rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator!=(const timestamp& lhs,
+                                         const timestamp& rhs) {
+        return lhs.since_epoch != rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator<(const timestamp& lhs,
+                                        const timestamp& rhs) {
+        return lhs.since_epoch < rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator<=(const timestamp& lhs,
+                                         const timestamp& rhs) {
+        return lhs.since_epoch <= rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator>(const timestamp& lhs,
+                                        const timestamp& rhs) {
+        return lhs.since_epoch > rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator>=(const timestamp& lhs,
+                                         const timestamp& rhs) {
+        return lhs.since_epoch >= rhs.since_epoch;
+    }
+};
+
+// point in time converted from an integer count of 'Duration' units since
+// 1970-01-01T00:00:00Z, eg. unix time in seconds or milliseconds
+template <typename Duration>
+struct epoch {
+    using duration = Duration;
+    using time_point_type =
+        std::chrono::time_point<std::chrono::system_clock, Duration>;
+
+    Duration since_epoch{0};
+
+    [[nodiscard]] time_point_type time_point() const {
+        return time_point_type{since_epoch};
+    }
+
+    [[nodiscard]] friend bool operator==(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch == rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator!=(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch != rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator<(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch < rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator<=(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch <= rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator>(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch > rhs.since_epoch;
+    }
+
+    [[nodiscard]] friend bool operator>=(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch >= rhs.since_epoch;
+    }
+};
+
+using epoch_seconds = epoch<std::chrono::seconds>;
+using epoch_milliseconds = epoch<std::chrono::milliseconds>;
+using epoch_microseconds = epoch<std::chrono::microseconds>;
+using epoch_nanoseconds = epoch<std::chrono::nanoseconds>;
+
+// parses 'YYYY-MM-DD', the year, month and day digits are gathered into
+// one word and converted at once
+[[nodiscard]] inline bool parse_date(const char* const begin, date& value) {
+    if (begin[4] != '-' || begin[7] != '-') {
+        return false;
+    }
+
+    char digits[8];
+    std::memcpy(digits, begin, 4);
+    std::memcpy(digits + 4, begin + 5, 2);
+    std::memcpy(digits + 6, begin + 8, 2);
+
+    const uint64_t word = load_eight_bytes(digits);
+    if (!is_eight_digits(word)) {
+        return false;
+    }
+
+    const uint32_t ymd = parse_eight_digits(word);
+    const uint32_t year = ymd / 10000;
+    const uint32_t month = ymd / 100 % 100;
+    const uint32_t day = ymd % 100;
+
+    if (month < 1 || month > 12 || day < 1 ||
+        day > days_in_month(year, month)) {
+        return false;
+    }
+
+    value = date{static_cast<int32_t>(year), static_cast<uint8_t>(month),
+                 static_cast<uint8_t>(day)};
+    return true;
+}
+
+// parses 'HH:MM:SS', returns the number of seconds since midnight
+[[nodiscard]] inline bool parse_time_of_day(const char* const begin,
+                                            int64_t& seconds) {
+    if (begin[2] != ':' || begin[5] != ':') {
+        return false;
+    }
+
+    uint32_t hours = 0;
+    uint32_t minutes = 0;
+    uint32_t secs = 0;
+    if (!parse_digits<2>(begin, hours) || !parse_digits<2>(begin + 3, minutes) ||
+        !parse_digits<2>(begin + 6, secs)) {
+        return false;
+    }
+
+    if (hours > 23 || minutes > 59 || secs > 59) {
+        return false;
+    }
+
+    seconds = hours * 3600 + minutes * 60 + secs;
+    return true;
+}
+
+// parses up to nine fraction digits, returns the number of nanoseconds
+[[nodiscard]] inline bool parse_fraction(const char*& begin,
+                                         const char* const end,
+                                         int64_t& nanoseconds) {
+    constexpr static uint32_t scale[] = {1000000000, 100000000, 10000000,
+                                         1000000,    100000,    10000,
+                                         1000,       100,       10,
+                                         1};
+
+    const char* curr = begin;
+    uint32_t value = 0;
+
+    if (end - curr >= 8) {
+        if (const uint64_t word = load_eight_bytes(curr);
+            is_eight_digits(word)) {
+            value = parse_eight_digits(word);
+            curr += 8;
+        }
+    }
+
+    while (curr != end && curr - begin < 9) {
+        const auto digit = static_cast<unsigned char>(*curr - '0');
+        if (digit > 9) {
+            break;
+        }
+        value = value * 10 + digit;
+        ++curr;
+    }
+
+    const auto digits = curr - begin;
+    if (digits == 0) {
+        return false;
+    }
+
+    nanoseconds = static_cast<int64_t>(value) * scale[digits];
+    begin = curr;
+    return true;
+}
+
+// parses 'Z', '+hh:mm', '-hh:mm', '+hhmm', '-hhmm', '+hh' or '-hh', returns
+// the offset from utc in seconds
+[[nodiscard]] inline bool parse_utc_offset(const char* begin,
+                                           const char* const end,
+                                           int64_t& seconds) {
+    const auto size = end - begin;
+    if (size == 1 && (*begin == 'Z' || *begin == 'z')) {
+        seconds = 0;
+        return true;
+    }
+
+    if (size != 3 && size != 5 && size != 6) {
+        return false;
+    }
+
+    if (*begin != '+' && *begin != '-') {
+        return false;
+    }
+    const bool negative = (*begin == '-');
+    ++begin;
+
+    uint32_t hours = 0;
+    uint32_t minutes = 0;
+    if (!parse_digits<2>(begin, hours)) {
+        return false;
+    }
+
+    if (size == 5 && !parse_digits<2>(begin + 2, minutes)) {
+        return false;
+    }
+
+    if (size == 6 && (begin[2] != ':' || !parse_digits<2>(begin + 3, minutes))) {
+        return false;
+    }
+
+    if (hours > 23 || minutes > 59) {
+        return false;
+    }
+
+    seconds = hours * 3600 + minutes * 60;
+    if (negative) {
+        seconds = -seconds;
+    }
+    return true;
+}
+
+[[nodiscard]] inline bool parse_timestamp(const char* begin,
+                                          const char* const end,
+                                          timestamp& value) {
+    constexpr static auto date_size = 10;
+    constexpr static auto time_size = 8;
+    constexpr static int64_t min_year = 1678;
+    constexpr static int64_t max_year = 2261;
+    constexpr static int64_t seconds_per_day = 86400;
+    constexpr static int64_t nanoseconds_per_second = 1000000000;
+
+    if (end - begin < date_size) {
+        return false;
+    }
+
+    date d;
+    if (!parse_date(begin, d) || d.year < min_year || d.year > max_year) {
+        return false;
+    }
+    begin += date_size;
+
+    int64_t seconds = 0;
+    int64_t nanoseconds = 0;
+    int64_t offset = 0;
+
+    if (begin != end) {
+        if (*begin != 'T' && *begin != 't' && *begin != ' ') {
+            return false;
+        }
+        ++begin;
+
+        if (end - begin < time_size || !parse_time_of_day(begin, seconds)) {
+            return false;
+        }
+        begin += time_size;
+
+        if (begin != end && (*begin == '.' || *begin == ',')) {
+            ++begin;
+            if (!parse_fraction(begin, end, nanoseconds)) {
+                return false;
+            }
+        }
+
+        if (begin != end && !parse_utc_offset(begin, end, offset)) {
+            return false;
+        }
+    }
+
+    seconds += d.days_since_epoch() * seconds_per_day - offset;
+    value.since_epoch = std::chrono::nanoseconds{
+        seconds * nanoseconds_per_second + nanoseconds};
+    return true;
+}
+
+////////////////
+// decimal
+////////////////
+
+// digits beyond the scale are rounded half away from zero
+class decimal_round {};
+
+// digits beyond the scale are dropped
+class decimal_truncate {};
+
+// allows the integral digits to be grouped by the given character,
+// eg. '1,234,567.89', each group after the first needs to have 3 digits
+template <char C>
+class thousands_separator {};
+
+template <typename T>
+struct is_decimal_round : std::is_same<T, decimal_round> {};
+
+template <typename T>
+struct is_decimal_truncate : std::is_same<T, decimal_truncate> {};
+
+template <typename T>
+struct is_thousands_separator : std::false_type {};
+
+template <char C>
+struct is_thousands_separator<thousands_separator<C>> : std::true_type {};
+
+template <typename... Options>
+struct get_thousands_separator {
+    constexpr static bool enabled = false;
+    constexpr static char value = '\0';
+};
+
+template <char C, typename... Options>
+struct get_thousands_separator<thousands_separator<C>, Options...> {
+    constexpr static bool enabled = true;
+    constexpr static char value = C;
+};
+
+template <typename T, typename... Options>
+struct get_thousands_separator<T, Options...>
+    : get_thousands_separator<Options...> {};
+
+// fixed point number holding 'value / 10^Scale', converted exactly from its
+// decimal representation, by default conversions of values with more
+// non zero fraction digits than 'Scale' fail, 'decimal_round' or
+// 'decimal_truncate' can be given as options to change that
+template <size_t Scale, typename Rep = int64_t, typename... Options>
+struct decimal {
+    static_assert(std::is_integral_v<Rep> && !std::is_same_v<Rep, bool>,
+                  "decimal representation needs to be an integral type");
+    static_assert(Scale <= std::numeric_limits<Rep>::digits10,
+                  "decimal scale too big for the representation");
+
+    using rep = Rep;
+    constexpr static size_t scale = Scale;
+
+    constexpr static bool round = count_v<is_decimal_round, Options...> == 1;
+    constexpr static bool truncate =
+        count_v<is_decimal_truncate, Options...> == 1;
+    constexpr static bool thousands_separator =
+        get_thousands_separator<Options...>::enabled;
+    constexpr static char separator =
+        get_thousands_separator<Options...>::value;
+
+    static_assert(count_v<is_decimal_round, Options...> +
+                          count_v<is_decimal_truncate, Options...> <=
+                      1,
+                  "decimal rounding defined multiple times");
+    static_assert(count_v<is_thousands_separator, Options...> <= 1,
+                  "thousands separator defined multiple times");
+    static_assert(count_v<is_decimal_round, Options...> +
+                          count_v<is_decimal_truncate, Options...> +
+                          count_v<is_thousands_separator, Options...> ==
+                      sizeof...(Options),
+                  "one or multiple invalid decimal options defined");
+
+    constexpr static Rep denominator = [] {
+        Rep ret = 1;
+        for (size_t i = 0; i < Scale; ++i) {
+            ret *= 10;
+        }
+        return ret;
+    }();
+
+    Rep value{0};
+
+    [[nodiscard]] Rep integral_part() const {
+        return value / denominator;
+    }
+
+    [[nodiscard]] Rep fractional_part() const {
+        return value % denominator;
+    }
+
+    [[nodiscard]] double to_double() const {
+        return static_cast<double>(value) / static_cast<double>(denominator);
+    }
+
+    [[nodiscard]] friend bool operator==(const decimal& lhs,
+                                         const decimal& rhs) {
+        return lhs.value == rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator!=(const decimal& lhs,
+                                         const decimal& rhs) {
+        return lhs.value != rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator<(const decimal& lhs,
+                                        const decimal& rhs) {
+        return lhs.value < rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator<=(const decimal& lhs,
+                                         const decimal& rhs) {
+        return lhs.value <= rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator>(const decimal& lhs,
+                                        const decimal& rhs) {
+        return lhs.value > rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator>=(const decimal& lhs,
+                                         const decimal& rhs) {
+        return lhs.value >= rhs.value;
+    }
+
+};
+
+template <typename T>
+struct is_decimal : std::false_type {};
+
+template <size_t Scale, typename Rep, typename... Options>
+struct is_decimal<decimal<Scale, Rep, Options...>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_decimal_v = is_decimal<T>::value;
+
+// appends one digit to the value, fails on overflow
+template <typename U>
+[[nodiscard]] bool push_digit(U& value, unsigned digit, const U max) {
+    if (value > (max - digit) / 10) {
+        return false;
+    }
+    value = value * 10 + digit;
+    return true;
+}
+
+// appends a run of digits to the value, eight digits are converted at once
+// while possible, returns the end of the run or nullptr on overflow
+template <typename U>
+[[nodiscard]] const char* push_digit_run(const char* begin,
+                                         const char* const end, U& value,
+                                         const U max) {
+    if constexpr (std::numeric_limits<U>::digits10 >= 8) {
+        constexpr static U eight_digits_scale = 100000000;
+        while (end - begin >= 8) {
+            const uint64_t word = load_eight_bytes(begin);
+            if (!is_eight_digits(word)) {
+                break;
+            }
+
+            const U chunk = parse_eight_digits(word);
+            if (value > (max - chunk) / eight_digits_scale) {
+                return nullptr;
+            }
+            value = value * eight_digits_scale + chunk;
+            begin += 8;
+        }
+    }
+
+    for (; begin != end; ++begin) {
+        const auto digit = static_cast<unsigned char>(*begin - '0');
+        if (digit > 9) {
+            break;
+        }
+        if (!push_digit(value, digit, max)) {
+            return nullptr;
+        }
+    }
+
+    return begin;
+}
+
+template <typename T>
+[[nodiscard]] bool parse_decimal(const char* begin, const char* const end,
+                                 T& dst) {
+    using rep = typename T::rep;
+    using U = std::make_unsigned_t<rep>;
+
+    if (begin == end) {
+        return false;
+    }
+
+    bool negative = false;
+    if (*begin == '-' || *begin == '+') {
+        negative = (*begin == '-');
+        ++begin;
+        if constexpr (std::is_unsigned_v<rep>) {
+            if (negative) {
+                return false;
+            }
+        }
+    }
+
+    // the magnitude of the minimum value is one bigger than the maximum
+    const U max = static_cast<U>(std::numeric_limits<rep>::max()) +
+                  static_cast<U>(negative);
+    U value = 0;
+
+    const char* const integral_begin = begin;
+    begin = push_digit_run(begin, end, value, max);
+    if (!begin) {
+        return false;
+    }
+
+    if constexpr (T::thousands_separator) {
+        if (begin != end && *begin == T::separator) {
+            const auto first_group_size = begin - integral_begin;
+            if (first_group_size == 0 || first_group_size > 3) {
+                return false;
+            }
+
+            while (begin != end && *begin == T::separator) {
+                ++begin;
+                const char* const group_end =
+                    push_digit_run(begin, end, value, max);
+                if (!group_end || group_end - begin != 3) {
+                    return false;
+                }
+                begin = group_end;
+            }
+        }
+    }
+
+    bool has_digits = (begin != integral_begin);
+    size_t fraction_digits = 0;
+    bool round_up = false;
+
+    if (begin != end && *begin == '.') {
+        ++begin;
+        const char* const fraction_begin = begin;
+
+        const auto scaled_size =
+            std::min(T::scale, static_cast<size_t>(end - begin));
+        begin = push_digit_run(begin, begin + scaled_size, value, max);
+        if (!begin) {
+            return false;
+        }
+        fraction_digits = static_cast<size_t>(begin - fraction_begin);
+
+        // digits beyond the scale
+        for (const char* curr = begin; curr != end; ++curr) {
+            const auto digit = static_cast<unsigned char>(*curr - '0');
+            if (digit > 9) {
+                return false;
+            }
+            if constexpr (T::round) {
+                round_up = round_up || (curr == begin && digit >= 5);
+            } else if constexpr (!T::truncate) {
+                if (digit != 0) {
+                    return false;
+                }
+            }
+        }
+        begin = end;
+
+        has_digits = has_digits || (fraction_begin != end);
+    }
+
+    if (begin != end || !has_digits) {
+        return false;
+    }
+
+    for (; fraction_digits < T::scale; ++fraction_digits) {
+        if (!push_digit(value, 0, max)) {
+            return false;
+        }
+    }
+
+    if (round_up) {
+        if (value == max) {
+            return false;
+        }
+        ++value;
+    }
+
+    if (negative) {
+        // computed within the unsigned type to support the minimum value
+        dst.value = static_cast<rep>(U{0} - value);
+    } else {
+        dst.value = static_cast<rep>(value);
+    }
+    return true;
+}
+
+////////////////
+// enum map
+////////////////
+
+// maps strings to enum values, needs to be specialized for an enum with a
+// static constexpr array of name and value pairs named 'values', eg.
+// template <>
+// struct ss::enum_map<side> {
+//     constexpr static std::pair<std::string_view, side> values[] = {
+//         {"BUY", side::buy}, {"SELL", side::sell}};
+// };
+template <typename E>
+struct enum_map {};
+
+template <typename T, typename = void>
+struct has_enum_map : std::false_type {};
+
+template <typename T>
+struct has_enum_map<T, std::void_t<decltype(enum_map<T>::values)>>
+    : std::true_type {};
+
+template <typename T>
+constexpr bool has_enum_map_v = has_enum_map<T>::value;
+
+constexpr inline uint16_t enum_hash_empty_slot = 0xFFFF;
+constexpr inline uint32_t enum_hash_max_seeds = 64;
+
+[[nodiscard]] constexpr uint32_t enum_hash(std::string_view key,
+                                           uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (const char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// at least four slots per key, the number of slots is a power of two
+[[nodiscard]] constexpr size_t enum_hash_slots(size_t size) {
+    size_t slots = 1;
+    while (slots < size * 4) {
+        slots *= 2;
+    }
+    return slots;
+}
+
+template <size_t Slots>
+struct enum_hash_table {
+    uint32_t seed{0};
+    size_t max_probe{0};
+    std::array<uint16_t, Slots> slots{};
+};
+
+template <typename E>
+[[nodiscard]] constexpr bool enum_map_unique() {
+    constexpr size_t size = std::size(enum_map<E>::values);
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t j = i + 1; j < size; ++j) {
+            if (enum_map<E>::values[i].first == enum_map<E>::values[j].first) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// open addressing table built at compile time, the seed with the shortest
+// maximum probe length is chosen, with a probe length of zero the table is
+// a perfect hash and each lookup needs at most one string comparison
+template <typename E>
+[[nodiscard]] constexpr auto make_enum_hash_table() {
+    constexpr size_t size = std::size(enum_map<E>::values);
+    constexpr size_t slots = enum_hash_slots(size);
+    constexpr size_t mask = slots - 1;
+    static_assert(size < enum_hash_empty_slot, "enum map too big");
+
+    enum_hash_table<slots> best{};
+    best.max_probe = slots;
+
+    for (uint32_t seed = 0; seed < enum_hash_max_seeds && best.max_probe > 0;
+         ++seed) {
+        enum_hash_table<slots> table{};
+        table.seed = seed;
+        for (auto& slot : table.slots) {
+            slot = enum_hash_empty_slot;
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            size_t slot = enum_hash(enum_map<E>::values[i].first, seed) & mask;
+            size_t probe = 0;
+            while (table.slots[slot] != enum_hash_empty_slot) {
+                slot = (slot + 1) & mask;
+                ++probe;
+            }
+            table.slots[slot] = static_cast<uint16_t>(i);
+            table.max_probe = std::max(table.max_probe, probe);
+        }
+
+        if (table.max_probe < best.max_probe) {
+            best = table;
+        }
+    }
+
+    return best;
+}
+
+template <typename E>
+constexpr inline auto enum_hash_table_v = make_enum_hash_table<E>();
+
+template <typename E>
+[[nodiscard]] bool extract_enum(const char* begin, const char* end,
+                                E& value) {
+    static_assert(enum_map_unique<E>(), "enum map has duplicate names");
+
+    constexpr auto& table = enum_hash_table_v<E>;
+    constexpr size_t mask = table.slots.size() - 1;
+
+    const std::string_view key{begin, static_cast<size_t>(end - begin)};
+    size_t slot = enum_hash(key, table.seed) & mask;
+
+    for (size_t probe = 0; probe <= table.max_probe; ++probe) {
+        const auto index = table.slots[slot];
+        if (index == enum_hash_empty_slot) {
+            return false;
+        }
+
+        const auto& [name, enum_value] = enum_map<E>::values[index];
+        if (name == key) {
+            value = enum_value;
+            return true;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return false;
+}
+
+////////////////
+// string pool
+////////////////
+
+// stores each distinct string only once, the stored strings are never moved
+// so views to them stay valid until the pool is cleared, the code of a
+// string is the order in which it was first interned
+class string_pool {
+public:
+    [[nodiscard]] std::pair<std::string_view, size_t> intern(
+        const char* begin, const char* end) {
+        const std::string_view value{begin, static_cast<size_t>(end - begin)};
+        if (auto it = codes_.find(value); it != codes_.end()) {
+            return {it->first, it->second};
+        }
+
+        const size_t code = strings_.size();
+        const std::string_view stored = strings_.emplace_back(value);
+        codes_.emplace(stored, code);
+        return {stored, code};
+    }
+
+    [[nodiscard]] std::string_view at(size_t code) const {
+        return strings_.at(code);
+    }
+
+    [[nodiscard]] size_t size() const {
+        return strings_.size();
+    }
+
+    void clear() {
+        codes_.clear();
+        strings_.clear();
+    }
+
+private:
+    std::deque<std::string> strings_;
+    std::unordered_map<std::string_view, size_t> codes_;
+};
+
+////////////////
+// arena
+////////////////
+
+// bump allocator for string data, bytes are copied into large blocks which
+// are never moved, so views to them stay valid until the arena is reset,
+// reset blocks are reused instead of being freed
+class arena {
+public:
+    explicit arena(size_t block_size = default_arena_block_size)
+        : block_size_{block_size > 0 ? block_size : 1} {
+    }
+
+    arena(arena&& other) = default;
+    arena& operator=(arena&& other) = default;
+
+    arena(const arena& other) = delete;
+    arena& operator=(const arena& other) = delete;
+
+    [[nodiscard]] std::string_view store(const char* begin, const char* end) {
+        const auto size = static_cast<size_t>(end - begin);
+        if (size == 0) {
+            return {};
+        }
+
+        if (curr_ == blocks_.size() || blocks_[curr_].size - used_ < size) {
+            next_block(size);
+        }
+
+        char* const dst = blocks_[curr_].data.get() + used_;
+        std::memcpy(dst, begin, size);
+        used_ += size;
+        size_ += size;
+        return {dst, size};
+    }
+
+    [[nodiscard]] std::string_view store(std::string_view value) {
+        return store(value.data(), value.data() + value.size());
+    }
+
+    // invalidates all stored views, keeps the allocated blocks
+    void reset() {
+        curr_ = blocks_.size();
+        used_ = 0;
+        size_ = 0;
+        reused_ = 0;
+    }
+
+    // invalidates all stored views, frees the allocated blocks
+    void release() {
+        blocks_.clear();
+        curr_ = 0;
+        used_ = 0;
+        size_ = 0;
+        reused_ = 0;
+    }
+
+    // number of bytes stored since the last reset
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    // number of bytes allocated
+    [[nodiscard]] size_t capacity() const {
+        size_t capacity = 0;
+        for (const auto& block : blocks_) {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+
+private:
+    struct block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    void next_block(size_t size) {
+        // after a reset the blocks are reused in the same order
+        while (reused_ < blocks_.size()) {
+            const size_t i = reused_++;
+            if (blocks_[i].size >= size) {
+                curr_ = i;
+                used_ = 0;
+                return;
+            }
+        }
+
+        const size_t block_size = std::max(block_size_, size);
+        blocks_.push_back(block{std::unique_ptr<char[]>{new char[block_size]},
+                                block_size});
+        curr_ = blocks_.size() - 1;
+        reused_ = blocks_.size();
+        used_ = 0;
+    }
+
+    size_t block_size_;
+    std::vector<block> blocks_;
+    size_t curr_{0};
+    size_t used_{0};
+    size_t size_{0};
+    size_t reused_{0};
+};
+
+////////////////
+// category
+////////////////
+
+// interned string, holds a view to the string stored within a pool and
+// its code which is unique within that pool
+struct category {
+    std::string_view value;
+    size_t code{0};
+
+    operator std::string_view() const {
+        return value;
+    }
+
+    [[nodiscard]] friend bool operator==(const category& lhs,
+                                         const category& rhs) {
+        return lhs.value == rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator!=(const category& lhs,
+                                         const category& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
 ////////////////
 // extract
 ////////////////
@@ -154,7 +1182,9 @@ template <typename T>
                                    !std::is_floating_point_v<T> &&
                                    !is_instance_of_v<std::optional, T> &&
                                    !is_instance_of_v<std::variant, T> &&
-                                   !is_instance_of_v<numeric_wrapper, T>,
+                                   !is_instance_of_v<numeric_wrapper, T> &&
+                                   !is_instance_of_v<epoch, T> &&
+                                   !is_decimal_v<T> && !has_enum_map_v<T>,
                                bool>
 extract(const char*, const char*, T&) {
     static_assert(error::unsupported_type<T>::value,
@@ -176,6 +1206,29 @@ extract(const char* begin, const char* end, T& value) {
     return true;
 }
 
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<epoch, T>, bool> extract(
+    const char* begin, const char* end, T& value) {
+    auto count = to_num<typename T::duration::rep>(begin, end);
+    if (!count) {
+        return false;
+    }
+    value.since_epoch = typename T::duration{count.value()};
+    return true;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_decimal_v<T>, bool> extract(
+    const char* begin, const char* end, T& value) {
+    return parse_decimal(begin, end, value);
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<has_enum_map_v<T>, bool> extract(
+    const char* begin, const char* end, T& value) {
+    return extract_enum(begin, end, value);
+}
+
 template <typename T>
 [[nodiscard]] std::enable_if_t<is_instance_of_v<std::optional, T>, bool>
 extract(const char* begin, const char* end, T& value) {
@@ -188,16 +1241,66 @@ extract(const char* begin, const char* end, T& value) {
     return true;
 }
 
+// result of a single scan of a field, used to skip the numeric variant
+// alternatives which can not be converted
+struct field_class {
+    // optional minus followed by digits only
+    bool integer{false};
+    // has a digit or could be 'inf' or 'nan'
+    bool floating_point{false};
+};
+
+[[nodiscard]] inline field_class classify_field(const char* const begin,
+                                                const char* const end) {
+    if (begin == end) {
+        return {};
+    }
+
+    const char* curr = begin + (*begin == '-');
+    bool all_digits = (curr != end);
+    bool has_digit = false;
+    bool may_be_special = false;
+
+    // bitwise operations instead of logical ones keep the loop branchless
+    for (; curr != end; ++curr) {
+        const bool digit = static_cast<unsigned char>(*curr - '0') <= 9;
+        const char lower = static_cast<char>(*curr | 0x20);
+        all_digits &= digit;
+        has_digit |= digit;
+        may_be_special |= (lower == 'i') | (lower == 'n');
+    }
+
+    return {all_digits, has_digit || may_be_special};
+}
+
+// false only if the conversion of the field to T would certainly fail
+template <typename T>
+[[nodiscard]] bool may_extract(const field_class& field) {
+    if constexpr ((std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                   !std::is_same_v<T, char>) ||
+                  is_instance_of_v<numeric_wrapper, T>) {
+        return field.integer;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return field.floating_point;
+    } else {
+        return true;
+    }
+}
+
 template <typename T, size_t I>
 [[nodiscard]] bool extract_variant(const char* begin, const char* end,
-                                   T& value) {
+                                   T& value, const field_class& field) {
     using IthType = std::variant_alternative_t<I, std::decay_t<T>>;
-    IthType ithValue;
-    if (extract<IthType>(begin, end, ithValue)) {
-        value = ithValue;
-        return true;
-    } else if constexpr (I + 1 < std::variant_size_v<T>) {
-        return extract_variant<T, I + 1>(begin, end, value);
+    if (may_extract<IthType>(field)) {
+        IthType ithValue;
+        if (extract<IthType>(begin, end, ithValue)) {
+            value.template emplace<I>(std::move(ithValue));
+            return true;
+        }
+    }
+
+    if constexpr (I + 1 < std::variant_size_v<T>) {
+        return extract_variant<T, I + 1>(begin, end, value, field);
     }
     return false;
 }
@@ -205,7 +1308,8 @@ template <typename T, size_t I>
 template <typename T>
 [[nodiscard]] std::enable_if_t<is_instance_of_v<std::variant, T>, bool> extract(
     const char* begin, const char* end, T& value) {
-    return extract_variant<T, 0>(begin, end, value);
+    return extract_variant<T, 0>(begin, end, value,
+                                 classify_field(begin, end));
 }
 
 ////////////////
@@ -250,7 +1354,14 @@ template <>
 template <>
 [[nodiscard]] inline bool extract(const char* begin, const char* end,
                                   std::string& value) {
-    value = std::string{begin, end};
+    value.assign(begin, end);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  std::pmr::string& value) {
+    value.assign(begin, end);
     return true;
 }
 
@@ -261,4 +1372,23 @@ template <>
     return true;
 }
 
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  date& value) {
+    constexpr static auto date_size = 10;
+    return end - begin == date_size && parse_date(begin, value);
+}
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  timestamp& value) {
+    return parse_timestamp(begin, end, value);
+}
+
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  category& value, string_pool& pool) {
+    std::tie(value.value, value.code) = pool.intern(begin, end);
+    return true;
+}
+
 } /* namespace ss */
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define SSP_COROUTINES_ENABLED
+#endif
+
+#ifdef SSP_COROUTINES_ENABLED
+
+namespace ss {
+
+////////////////
+// generator
+////////////////
+
+// a lazy sequence of values produced by a coroutine, the coroutine is only
+// resumed when the next value is requested, so the consumer decides when the
+// next value is produced, the yielded value is valid until then
+template <typename T>
+class generator {
+public:
+    struct promise_type {
+        [[nodiscard]] generator get_return_object() {
+            return generator{handle::from_promise(*this)};
+        }
+
+        [[nodiscard]] std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        [[nodiscard]] std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always yield_value(T& value) noexcept {
+            value_ = std::addressof(value);
+            return {};
+        }
+
+        // the temporary lives within the coroutine frame until the
+        // coroutine is resumed
+        std::suspend_always yield_value(T&& value) noexcept {
+            value_ = std::addressof(value);
+            return {};
+        }
+
+        void return_void() noexcept {
+        }
+
+        void unhandled_exception() {
+            exception_ = std::current_exception();
+        }
+
+        // coroutines which only produce values may not await anything
+        template <typename U>
+        std::suspend_never await_transform(U&& value) = delete;
+
+        void rethrow_if_exception() {
+            if (exception_) {
+                std::rethrow_exception(std::exchange(exception_, nullptr));
+            }
+        }
+
+        T* value_{nullptr};
+        std::exception_ptr exception_;
+    };
+
+    using handle = std::coroutine_handle<promise_type>;
+
+    struct sentinel {};
+
+    class iterator {
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using reference = T&;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::input_iterator_tag;
+
+        iterator() = default;
+
+        explicit iterator(handle coroutine) : coroutine_{coroutine} {
+        }
+
+        [[nodiscard]] reference operator*() const {
+            return *coroutine_.promise().value_;
+        }
+
+        [[nodiscard]] T* operator->() const {
+            return coroutine_.promise().value_;
+        }
+
+        iterator& operator++() {
+            coroutine_.resume();
+            coroutine_.promise().rethrow_if_exception();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        [[nodiscard]] friend bool operator==(const iterator& it, sentinel) {
+            return !it.coroutine_ || it.coroutine_.done();
+        }
+
+    private:
+        handle coroutine_{nullptr};
+    };
+
+    generator() = default;
+
+    generator(const generator& other) = delete;
+    generator& operator=(const generator& other) = delete;
+
+    generator(generator&& other) noexcept
+        : coroutine_{std::exchange(other.coroutine_, nullptr)} {
+    }
+
+    generator& operator=(generator&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            coroutine_ = std::exchange(other.coroutine_, nullptr);
+        }
+        return *this;
+    }
+
+    ~generator() {
+        destroy();
+    }
+
+    // the first value is produced when 'begin' is called, the sequence can
+    // only be iterated once
+    [[nodiscard]] iterator begin() {
+        if (coroutine_) {
+            coroutine_.resume();
+            coroutine_.promise().rethrow_if_exception();
+        }
+        return iterator{coroutine_};
+    }
+
+    [[nodiscard]] sentinel end() const noexcept {
+        return {};
+    }
+
+private:
+    explicit generator(handle coroutine) : coroutine_{coroutine} {
+    }
+
+    void destroy() {
+        if (coroutine_) {
+            coroutine_.destroy();
+            coroutine_ = nullptr;
+        }
+    }
+
+    handle coroutine_{nullptr};
+};
+
+} /* namespace ss */
+
+#endif
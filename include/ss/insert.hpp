@@ -0,0 +1,291 @@
+#pragma once
+
+#include "extract.hpp"
+#include "type_traits.hpp"
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace ss {
+
+////////////////
+// number formatters
+////////////////
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_integral_v<T>, bool> from_num(
+    std::string& out, T value) {
+    constexpr static auto buff_max = std::numeric_limits<T>::digits10 + 3;
+    std::array<char, buff_max> buff;
+
+    auto [ptr, ec] = std::to_chars(buff.data(), buff.data() + buff_max, value);
+    if (ec != std::errc()) {
+        return false;
+    }
+
+    out.append(buff.data(), ptr);
+    return true;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_floating_point_v<T>, bool> from_num(
+    std::string& out, T value) {
+    constexpr static auto buff_max = 128;
+    std::array<char, buff_max> buff;
+
+#ifdef __cpp_lib_to_chars
+    auto [ptr, ec] = std::to_chars(buff.data(), buff.data() + buff_max, value);
+    if (ec != std::errc()) {
+        return false;
+    }
+
+    out.append(buff.data(), ptr);
+#else
+    // floating point std::to_chars is not supported by older standard
+    // libraries, max_digits10 guarantees the value survives a round trip
+    constexpr static auto digits = std::numeric_limits<T>::max_digits10;
+
+    int size = 0;
+    if constexpr (std::is_same_v<T, long double>) {
+        size = std::snprintf(buff.data(), buff_max, "%.*Lg", digits, value);
+    } else {
+        size = std::snprintf(buff.data(), buff_max, "%.*g", digits,
+                             static_cast<double>(value));
+    }
+
+    if (size < 0 || size >= buff_max) {
+        return false;
+    }
+
+    out.append(buff.data(), size);
+#endif
+
+    return true;
+}
+
+template <size_t N>
+void append_digits(std::string& out, uint64_t value) {
+    char buff[N];
+    for (size_t i = N; i > 0; --i) {
+        buff[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    out.append(buff, N);
+}
+
+////////////////
+// insert
+////////////////
+
+namespace error {
+template <typename T>
+struct unsupported_insert_type {
+    constexpr static bool value = false;
+};
+} /* namespace error */
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<!std::is_integral_v<T> &&
+                                   !std::is_floating_point_v<T> &&
+                                   !is_instance_of_v<std::optional, T> &&
+                                   !is_instance_of_v<std::variant, T> &&
+                                   !is_instance_of_v<numeric_wrapper, T> &&
+                                   !is_instance_of_v<epoch, T> &&
+                                   !is_decimal_v<T> && !has_enum_map_v<T>,
+                               bool>
+insert(std::string&, const T&) {
+    static_assert(error::unsupported_insert_type<T>::value,
+                  "Conversion for given type is not defined, an "
+                  "\'insert\' function needs to be defined!");
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_integral_v<T> ||
+                                   std::is_floating_point_v<T>,
+                               bool>
+insert(std::string& out, const T& value) {
+    return from_num(out, value);
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<numeric_wrapper, T>, bool>
+insert(std::string& out, const T& value) {
+    return from_num(out, value.value);
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<epoch, T>, bool> insert(
+    std::string& out, const T& value) {
+    return from_num(out, value.since_epoch.count());
+}
+
+// all 'Scale' fraction digits are written, eg. 'decimal<2>' as '-12.50'
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_decimal_v<T>, bool> insert(std::string& out,
+                                                            const T& value) {
+    using U = std::make_unsigned_t<typename T::rep>;
+
+    U magnitude = static_cast<U>(value.value);
+    if constexpr (std::is_signed_v<typename T::rep>) {
+        if (value.value < 0) {
+            out.push_back('-');
+            magnitude = static_cast<U>(U{0} - magnitude);
+        }
+    }
+
+    const auto denominator = static_cast<U>(T::denominator);
+    if (!from_num(out, static_cast<U>(magnitude / denominator))) {
+        return false;
+    }
+
+    if constexpr (T::scale > 0) {
+        out.push_back('.');
+        const size_t fraction_begin = out.size();
+        out.append(T::scale, '0');
+
+        U fraction = magnitude % denominator;
+        for (size_t i = out.size(); i > fraction_begin; --i) {
+            out[i - 1] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<has_enum_map_v<T>, bool> insert(
+    std::string& out, const T& value) {
+    for (const auto& [name, enum_value] : enum_map<T>::values) {
+        if (enum_value == value) {
+            out.append(name);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<std::optional, T>, bool>
+insert(std::string& out, const T& value) {
+    if (!value.has_value()) {
+        return true;
+    }
+    return insert(out, value.value());
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<std::variant, T>, bool> insert(
+    std::string& out, const T& value) {
+    return std::visit(
+        [&out](const auto& alternative) { return insert(out, alternative); },
+        value);
+}
+
+////////////////
+// insert specialization
+////////////////
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const bool& value) {
+    out.append(value ? "true" : "false");
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const char& value) {
+    out.push_back(value);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const std::string& value) {
+    out.append(value);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out,
+                                 const std::string_view& value) {
+    out.append(value);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const char* const& value) {
+    out.append(value);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const category& value) {
+    out.append(value.value);
+    return true;
+}
+
+// YYYY-MM-DD
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const date& value) {
+    if (value.year < 0 || value.year > 9999) {
+        return false;
+    }
+
+    append_digits<4>(out, value.year);
+    out.push_back('-');
+    append_digits<2>(out, value.month);
+    out.push_back('-');
+    append_digits<2>(out, value.day);
+    return true;
+}
+
+// YYYY-MM-DDTHH:MM:SS[.fffffffff]Z, trailing zeros of the fraction are
+// omitted
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const timestamp& value) {
+    constexpr static int64_t seconds_per_day = 86400;
+    constexpr static int64_t nanoseconds_per_second = 1000000000;
+
+    const auto count = value.since_epoch.count();
+    int64_t seconds = count / nanoseconds_per_second;
+    int64_t nanoseconds = count % nanoseconds_per_second;
+    if (nanoseconds < 0) {
+        nanoseconds += nanoseconds_per_second;
+        --seconds;
+    }
+
+    int64_t days = seconds / seconds_per_day;
+    int64_t seconds_of_day = seconds % seconds_per_day;
+    if (seconds_of_day < 0) {
+        seconds_of_day += seconds_per_day;
+        --days;
+    }
+
+    if (!insert(out, date::from_days_since_epoch(days))) {
+        return false;
+    }
+
+    out.push_back('T');
+    append_digits<2>(out, seconds_of_day / 3600);
+    out.push_back(':');
+    append_digits<2>(out, seconds_of_day / 60 % 60);
+    out.push_back(':');
+    append_digits<2>(out, seconds_of_day % 60);
+
+    if (nanoseconds != 0) {
+        out.push_back('.');
+        append_digits<9>(out, nanoseconds);
+        while (out.back() == '0') {
+            out.pop_back();
+        }
+    }
+
+    out.push_back('Z');
+    return true;
+}
+
+} /* namespace ss */
@@ -0,0 +1,605 @@
+#pragma once
+
+#include "common.hpp"
+#include "exception.hpp"
+#include "parser.hpp"
+#include "setup.hpp"
+#include "type_traits.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ss {
+
+// reads multiple files with the same header as if they were one, the header
+// of each file is skipped, the next file is opened while the current one is
+// being read
+template <typename... Options>
+class multi_parser {
+    using parser_type = parser<Options...>;
+
+    constexpr static auto string_error = setup<Options...>::string_error;
+    constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
+    constexpr static auto ignore_header = setup<Options...>::ignore_header;
+    constexpr static auto arena_views = setup<Options...>::arena_views;
+
+    using error_type = std::conditional_t<string_error, std::string, bool>;
+
+public:
+    // the first file is opened right away, each following one is opened in
+    // the background while the one before it is being read
+    multi_parser(std::vector<std::string> file_names,
+                 std::string delim = ss::default_delimiter)
+        : file_names_{std::move(file_names)}, delim_{std::move(delim)} {
+        open_first_file();
+    }
+
+    multi_parser(multi_parser&& other) = default;
+    multi_parser& operator=(multi_parser&& other) = default;
+    ~multi_parser() = default;
+
+    multi_parser() = delete;
+    multi_parser(const multi_parser& other) = delete;
+    multi_parser& operator=(const multi_parser& other) = delete;
+
+    [[nodiscard]] bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else if constexpr (throw_on_error) {
+            return true;
+        } else {
+            return !error_;
+        }
+    }
+
+    [[nodiscard]] const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    [[nodiscard]] bool eof() const {
+        return eof_;
+    }
+
+    // name of the file the last record was read from, empty if no file
+    // was given
+    [[nodiscard]] const std::string& file_name() const {
+        const static std::string no_file;
+        return record_file_ < file_names_.size() ? file_names_[record_file_]
+                                                 : no_file;
+    }
+
+    // index of the file the last record was read from
+    [[nodiscard]] size_t file_index() const {
+        return record_file_;
+    }
+
+    // line of the last record within its file
+    [[nodiscard]] size_t line() const {
+        return record_line_;
+    }
+
+    // pool used by the parsers of all the files to store the values
+    // converted to 'ss::category', so the values stay valid after their
+    // file is closed, and equal values have equal codes in every file
+    [[nodiscard]] ss::string_pool& get_string_pool() {
+        return *string_pool_;
+    }
+
+    // arena used by the parsers of all the files to store the converted
+    // 'std::string_view' values, the values stay valid until it is reset
+    [[nodiscard]] ss::arena& get_arena() {
+        assert_arena_views_defined();
+        return *arena_;
+    }
+
+    // uses the given arena instead of the one owned by the multi_parser,
+    // the arena needs to outlive it
+    void set_arena(ss::arena& arena) {
+        assert_arena_views_defined();
+        arena_ = std::shared_ptr<ss::arena>{std::shared_ptr<ss::arena>{},
+                                            &arena};
+        if (parser_) {
+            parser_->set_arena(arena);
+        }
+    }
+
+    // header of the first file
+    [[nodiscard]] std::string raw_header() const {
+        assert_ignore_header_not_defined();
+        return raw_header_.value_or("");
+    }
+
+    // the fields are looked up in the header of every file, so the files
+    // do not need to have the same header, the files are opened again
+    // from the first one, so this should be called before reading
+    template <typename... Ts>
+    void use_fields(const Ts&... fields) {
+        assert_ignore_header_not_defined();
+        use_fields_ = [fields...](parser_type& p) { p.use_fields(fields...); };
+        open_first_file();
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<T, Ts...> get_next() {
+        clear_error();
+        if (eof_) {
+            handle_error_eof_reached();
+            return {};
+        }
+
+        record_file_ = file_ - 1;
+        if (!parser_) {
+            auto exception = std::exchange(file_exception_, nullptr);
+            auto error = std::exchange(file_error_, error_type{});
+            open_next_file();
+            handle_error_file_not_valid(exception, std::move(error));
+            return {};
+        }
+
+        auto value = parser_->template get_next<T, Ts...>();
+        record_line_ = parser_->line();
+        copy_error(*parser_);
+
+        if (parser_->eof()) {
+            open_next_file();
+        }
+        return value;
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] T get_object() {
+        return to_object<T>(get_next<Ts...>());
+    }
+
+    ////////////////
+    // iterator
+    ////////////////
+
+    template <bool get_object, typename T, typename... Ts>
+    struct iterable {
+        struct iterator {
+            using value = std::conditional_t<get_object, T,
+                                             no_void_validator_tup_t<T, Ts...>>;
+
+            iterator() : parser_{nullptr}, value_{} {
+            }
+
+            iterator(multi_parser<Options...>* parser)
+                : parser_{parser}, value_{} {
+            }
+
+            [[nodiscard]] value& operator*() {
+                return value_;
+            }
+
+            [[nodiscard]] value* operator->() {
+                return &value_;
+            }
+
+            iterator& operator++() {
+                if (!parser_ || parser_->eof()) {
+                    parser_ = nullptr;
+                } else {
+                    if constexpr (get_object) {
+                        value_ = parser_->template get_object<T, Ts...>();
+                    } else {
+                        value_ = parser_->template get_next<T, Ts...>();
+                    }
+                }
+                return *this;
+            }
+
+            [[nodiscard]] friend bool operator==(const iterator& lhs,
+                                                 const iterator& rhs) {
+                return (lhs.parser_ == nullptr && rhs.parser_ == nullptr) ||
+                       (lhs.parser_ == rhs.parser_ &&
+                        &lhs.value_ == &rhs.value_);
+            }
+
+            [[nodiscard]] friend bool operator!=(const iterator& lhs,
+                                                 const iterator& rhs) {
+                return !(lhs == rhs);
+            }
+
+        private:
+            multi_parser<Options...>* parser_;
+            value value_;
+        };
+
+        iterable(multi_parser<Options...>* parser) : parser_{parser} {
+        }
+
+        [[nodiscard]] iterator begin() {
+            return ++iterator{parser_};
+        }
+
+        [[nodiscard]] iterator end() {
+            return iterator{};
+        }
+
+    private:
+        multi_parser<Options...>* parser_;
+    };
+
+    template <typename... Ts>
+    [[nodiscard]] auto iterate() {
+        return iterable<false, Ts...>{this};
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] auto iterate_object() {
+        return iterable<true, Ts...>{this};
+    }
+
+#ifdef SSP_COROUTINES_ENABLED
+    ////////////////
+    // rows
+    ////////////////
+
+    // same as 'iterate', but the records are produced by a coroutine which
+    // reads the next record only once it is requested
+    template <typename... Ts>
+    [[nodiscard]] generator<no_void_validator_tup_t<Ts...>> rows() {
+        while (!eof()) {
+            co_yield get_next<Ts...>();
+        }
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] generator<T> rows_object() {
+        while (!eof()) {
+            co_yield get_object<T, Ts...>();
+        }
+    }
+#endif
+
+    ////////////////
+    // concurrent reading
+    ////////////////
+
+    // reads the remaining files on the given number of threads, each file
+    // is read by a single thread, 'fun' is invoked with the converted values
+    // of every record, either as a whole or unpacked, and may be invoked
+    // concurrently for records of different files, records which could not
+    // be converted are skipped, the error of the first one is kept, in
+    // 'throw_on_error' mode the first exception is rethrown after all the
+    // threads have stopped, the files read by the other threads use their
+    // own string pool and arena, so the values converted to 'ss::category'
+    // and the views stored in the arena are only valid within 'fun'
+    template <typename T, typename... Ts, typename Fun>
+    void for_each_concurrent(Fun&& fun, size_t threads) {
+        clear_error();
+        if (eof_) {
+            return;
+        }
+
+        std::atomic<size_t> next_file{file_};
+        if (next_parser_.valid()) {
+            // the prefetched file is opened again by one of the threads
+            next_parser_.wait();
+            next_parser_ = {};
+        }
+
+        std::mutex mutex;
+        std::exception_ptr exception;
+
+        if (!parser_) {
+            exception = std::exchange(file_exception_, nullptr);
+            error_ = std::exchange(file_error_, error_type{});
+            if (exception) {
+                next_file = file_names_.size();
+            }
+        }
+
+        auto read_file = [&](parser_type& p) {
+            while (!p.eof()) {
+                auto value = p.template get_next<T, Ts...>();
+                if (!p.valid()) {
+                    std::lock_guard lock{mutex};
+                    if (valid()) {
+                        copy_error(p);
+                    }
+                    continue;
+                }
+                invoke(fun, value);
+            }
+        };
+
+        auto read_files = [&] {
+            try {
+                for (auto i = next_file++; i < file_names_.size();
+                     i = next_file++) {
+                    parser_type p{file_names_[i], delim_};
+
+                    std::unique_lock lock{mutex};
+                    if (!prepare(p, file_names_[i])) {
+                        if (valid()) {
+                            error_ = file_error_;
+                        }
+                        continue;
+                    }
+                    lock.unlock();
+
+                    read_file(p);
+                }
+            } catch (...) {
+                std::lock_guard lock{mutex};
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+                next_file = file_names_.size();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < threads; ++i) {
+            workers.emplace_back(read_files);
+        }
+
+        try {
+            if (parser_) {
+                read_file(*parser_);
+            }
+        } catch (...) {
+            std::lock_guard lock{mutex};
+            if (!exception) {
+                exception = std::current_exception();
+            }
+            next_file = file_names_.size();
+        }
+        read_files();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        parser_.reset();
+        file_ = file_names_.size();
+        eof_ = true;
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    template <typename Fun, typename Value>
+    static void invoke(Fun& fun, Value& value) {
+        if constexpr (std::is_invocable_v<Fun&, Value&>) {
+            fun(value);
+        } else {
+            std::apply(fun, value);
+        }
+    }
+
+    ////////////////
+    // files
+    ////////////////
+
+    void prefetch(size_t index) {
+        if (index >= file_names_.size()) {
+            return;
+        }
+
+        next_parser_ = std::async(std::launch::async,
+                                  [name = file_names_[index], delim = delim_] {
+                                      return std::optional<parser_type>{
+                                          std::in_place, name, delim};
+                                  });
+    }
+
+    void open_first_file() {
+        if (next_parser_.valid()) {
+            next_parser_.wait();
+        }
+
+        clear_error();
+        parser_.reset();
+        file_error_ = error_type{};
+        file_exception_ = nullptr;
+        file_ = 0;
+        eof_ = false;
+
+        prefetch(0);
+        open_next_file();
+    }
+
+    // opens the next file which has records, if a file could not be
+    // opened or its header is not valid the error is reported by the
+    // next call to 'get_next'
+    void open_next_file() {
+        parser_.reset();
+
+        while (file_ < file_names_.size()) {
+            const auto& name = file_names_[file_];
+            std::optional<parser_type> next;
+
+            try {
+                next = next_parser_.get();
+            } catch (...) {
+                file_exception_ = std::current_exception();
+            }
+
+            ++file_;
+            prefetch(file_);
+
+            if (file_exception_) {
+                return;
+            }
+
+            share_resources(*next);
+
+            try {
+                if (!prepare(*next, name)) {
+                    return;
+                }
+            } catch (...) {
+                file_exception_ = std::current_exception();
+                return;
+            }
+
+            if (!next->eof()) {
+                parser_ = std::move(next);
+                return;
+            }
+        }
+
+        eof_ = true;
+    }
+
+    // the parsers read one after another use the same pool and arena
+    void share_resources(parser_type& p) {
+        p.set_string_pool(*string_pool_);
+        if constexpr (arena_views) {
+            p.set_arena(*arena_);
+        }
+    }
+
+    // the header is checked against the header of the first file and
+    // skipped, or used to map the fields given to 'use_fields'
+    [[nodiscard]] bool prepare(parser_type& p, const std::string& name) {
+        if (!p.valid()) {
+            copy_file_error(p);
+            return false;
+        }
+
+        if constexpr (!ignore_header) {
+            if (p.eof()) {
+                // empty file, there is no header
+                return true;
+            }
+
+            if (!raw_header_) {
+                raw_header_ = p.raw_header();
+            }
+
+            if (use_fields_) {
+                use_fields_(p);
+                if (!p.valid()) {
+                    copy_file_error(p);
+                    return false;
+                }
+                return true;
+            }
+
+            if (p.raw_header() != *raw_header_) {
+                handle_error_header_mismatch(name);
+                return false;
+            }
+
+            p.ignore_next();
+        }
+
+        return true;
+    }
+
+    ////////////////
+    // error
+    ////////////////
+
+    void assert_ignore_header_not_defined() const {
+        static_assert(!ignore_header,
+                      "cannot use this method when 'ignore_header' is defined");
+    }
+
+    void assert_arena_views_defined() const {
+        static_assert(arena_views,
+                      "'arena_views' needs to be enabled to use the arena");
+    }
+
+    void clear_error() {
+        if constexpr (string_error) {
+            error_.clear();
+        } else {
+            error_ = false;
+        }
+    }
+
+    void copy_error(const parser_type& p) {
+        if constexpr (string_error) {
+            if (!p.valid()) {
+                error_ = p.error_msg();
+            }
+        } else if constexpr (!throw_on_error) {
+            error_ = !p.valid();
+        }
+    }
+
+    void copy_file_error(const parser_type& p) {
+        if constexpr (string_error) {
+            file_error_ = p.error_msg();
+        } else {
+            file_error_ = true;
+        }
+    }
+
+    // reports the error of a file which could not be opened
+    void handle_error_file_not_valid(std::exception_ptr exception,
+                                     error_type error) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        error_ = std::move(error);
+    }
+
+    void handle_error_eof_reached() {
+        constexpr static auto error_msg = "read on end of all files";
+
+        if constexpr (string_error) {
+            error_ = error_msg;
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_header_mismatch(const std::string& name) {
+        constexpr static auto error_msg =
+            ": header does not match the header of the first file";
+
+        if constexpr (string_error) {
+            file_error_.clear();
+            file_error_.append(name).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{name + error_msg};
+        } else {
+            file_error_ = true;
+        }
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::vector<std::string> file_names_;
+    std::string delim_;
+    std::optional<parser_type> parser_;
+    std::future<std::optional<parser_type>> next_parser_;
+    std::function<void(parser_type&)> use_fields_;
+    std::optional<std::string> raw_header_;
+    std::shared_ptr<ss::string_pool> string_pool_{
+        std::make_shared<ss::string_pool>()};
+    std::shared_ptr<ss::arena> arena_{std::make_shared<ss::arena>()};
+    error_type error_{};
+    error_type file_error_{};
+    std::exception_ptr file_exception_;
+    size_t file_{0};
+    size_t record_file_{0};
+    size_t record_line_{0};
+    bool eof_{false};
+};
+
+} /* namespace ss */
@@ -1,18 +1,270 @@
 #pragma once
 
+#include "byte_source.hpp"
 #include "common.hpp"
 #include "converter.hpp"
 #include "exception.hpp"
 #include "extract.hpp"
+#include "generator.hpp"
 #include "restrictions.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <limits>
+#include <memory_resource>
 #include <optional>
+#include <random>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#define SSP_RANGES_ENABLED
+#endif
+
 namespace ss {
 
+////////////////
+// record handler
+////////////////
+
+// converts a record using the types 'Ts' and invokes 'fun' with the result,
+// used by 'parser::dispatch' for records whose discriminator equals 'key'
+template <typename Fun, typename... Ts>
+struct record_handler {
+    static_assert(sizeof...(Ts) > 0, "at least one type must be given");
+
+    std::string_view key;
+    Fun fun;
+};
+
+template <typename... Ts, typename Fun>
+[[nodiscard]] record_handler<std::decay_t<Fun>, Ts...> handler(
+    std::string_view key, Fun&& fun) {
+    return {key, std::forward<Fun>(fun)};
+}
+
+////////////////
+// column condition
+////////////////
+
+// condition on the value of a column before it is converted, created by
+// comparing an 'ss::column' with a string, used by 'parser::where'
+struct column_condition {
+    enum class comparison { equal, not_equal, prefix };
+
+    std::optional<std::string> field;
+    size_t index{0};
+    comparison op{comparison::equal};
+    std::string value;
+
+    [[nodiscard]] bool matches(const split_data& fields) const {
+        if (index >= fields.size()) {
+            return false;
+        }
+
+        const auto& [begin, end] = fields[index];
+        const std::string_view field_value{begin,
+                                           static_cast<size_t>(end - begin)};
+
+        switch (op) {
+        case comparison::equal:
+            return field_value == value;
+        case comparison::not_equal:
+            return field_value != value;
+        case comparison::prefix:
+            return field_value.substr(0, value.size()) == value;
+        }
+        return false;
+    }
+};
+
+// column given by its header field or by its index
+class column {
+public:
+    column(std::string field) : field_{std::move(field)} {
+    }
+
+    column(size_t index) : index_{index} {
+    }
+
+    [[nodiscard]] column_condition operator==(std::string_view value) const {
+        return make_condition(column_condition::comparison::equal, value);
+    }
+
+    [[nodiscard]] column_condition operator!=(std::string_view value) const {
+        return make_condition(column_condition::comparison::not_equal, value);
+    }
+
+    [[nodiscard]] column_condition starts_with(std::string_view value) const {
+        return make_condition(column_condition::comparison::prefix, value);
+    }
+
+private:
+    [[nodiscard]] column_condition make_condition(
+        column_condition::comparison op, std::string_view value) const {
+        return {field_, index_, op, std::string{value}};
+    }
+
+    std::optional<std::string> field_;
+    size_t index_{0};
+};
+
+////////////////
+// follow
+////////////////
+
+// wait time between two checks for new data in follow mode, it is doubled
+// after each check which found nothing
+struct follow_backoff {
+    std::chrono::milliseconds min{10};
+    std::chrono::milliseconds max{1000};
+};
+
+////////////////
+// checkpoint
+////////////////
+
+// state needed to continue reading a file from the record after the last
+// one which was read, see 'parser::checkpoint'
+struct checkpoint {
+    size_t position{0};
+    size_t line{0};
+    bool crlf{false};
+    std::string raw_header;
+    std::vector<std::string> header;
+    std::vector<size_t> column_mapping;
+    size_t number_of_columns{0};
+
+    // the checkpoint as one line of text, numbers are separated by spaces
+    // and strings are prefixed by their length
+    [[nodiscard]] std::string to_string() const {
+        std::string out;
+        auto append_number = [&out](size_t value) {
+            out.append(std::to_string(value)).push_back(' ');
+        };
+        auto append_string = [&](const std::string& value) {
+            append_number(value.size());
+            out.append(value).push_back(' ');
+        };
+
+        append_number(position);
+        append_number(line);
+        append_number(crlf);
+        append_string(raw_header);
+        append_number(header.size());
+        for (const auto& field : header) {
+            append_string(field);
+        }
+        append_number(column_mapping.size());
+        for (const auto column : column_mapping) {
+            append_number(column);
+        }
+        append_number(number_of_columns);
+
+        out.pop_back();
+        return out;
+    }
+
+    [[nodiscard]] static std::optional<checkpoint> from_string(
+        std::string_view in) {
+        const char* curr = in.data();
+        const char* const end = in.data() + in.size();
+
+        auto read_number = [&](size_t& value) {
+            auto [ptr, ec] = std::from_chars(curr, end, value);
+            if (ec != std::errc() || (ptr != end && *ptr != ' ')) {
+                return false;
+            }
+            curr = (ptr == end) ? end : ptr + 1;
+            return true;
+        };
+        auto read_string = [&](std::string& value) {
+            size_t size = 0;
+            if (!read_number(size) || static_cast<size_t>(end - curr) < size) {
+                return false;
+            }
+            value.assign(curr, size);
+            curr += size;
+            if (curr != end) {
+                ++curr;
+            }
+            return true;
+        };
+
+        checkpoint result;
+        size_t crlf = 0;
+        size_t header_size = 0;
+        size_t column_mapping_size = 0;
+
+        if (!read_number(result.position) || !read_number(result.line) ||
+            !read_number(crlf) || crlf > 1 ||
+            !read_string(result.raw_header) || !read_number(header_size) ||
+            header_size > in.size()) {
+            return std::nullopt;
+        }
+
+        result.crlf = crlf;
+        result.header.resize(header_size);
+        for (auto& field : result.header) {
+            if (!read_string(field)) {
+                return std::nullopt;
+            }
+        }
+
+        if (!read_number(column_mapping_size) ||
+            column_mapping_size > in.size()) {
+            return std::nullopt;
+        }
+
+        result.column_mapping.resize(column_mapping_size);
+        for (auto& column : result.column_mapping) {
+            if (!read_number(column)) {
+                return std::nullopt;
+            }
+        }
+
+        if (!read_number(result.number_of_columns) || curr != end) {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+};
+
+////////////////
+// byte range
+////////////////
+
+// part of a file, [begin, end), read by a parser, each record belongs to the
+// range in which it begins, so adjacent ranges read every record once
+struct byte_range {
+    size_t begin{0};
+    size_t end{0};
+};
+
+////////////////
+// file descriptor
+////////////////
+
+// an open file descriptor, such as one end of a pipe, read by a parser
+struct file_descriptor {
+    int value{-1};
+};
+
+inline constexpr file_descriptor standard_input{0};
+
 template <typename... Options>
 class parser {
     constexpr static auto string_error = setup<Options...>::string_error;
@@ -31,19 +283,55 @@ class parser {
 
     constexpr static bool ignore_empty = setup<Options...>::ignore_empty;
 
+    constexpr static bool arena_views = setup<Options...>::arena_views;
+    constexpr static bool sequential_scan =
+        setup<Options...>::sequential_scan;
+    constexpr static size_t max_record_bytes =
+        setup<Options...>::max_record_bytes;
+
     using header_splitter = ss::splitter<
         ss::filter_not_t<ss::is_instance_of_multiline, Options...>>;
 
 public:
     parser(std::string file_name, std::string delim = ss::default_delimiter)
-        : file_name_{std::move(file_name)}, reader_{file_name_, delim} {
+        : parser{std::move(file_name), nullptr, std::move(delim)} {
+    }
+
+    parser(const char* const csv_data_buffer, size_t csv_data_size,
+           const std::string& delim = ss::default_delimiter)
+        : parser{csv_data_buffer, csv_data_size, nullptr, delim} {
+    }
+
+    // reads from an open file which is not closed by the parser, the file
+    // does not need to support seeking
+    parser(FILE* file, std::string delim = ss::default_delimiter)
+        : parser{file, nullptr, std::move(delim)} {
+    }
+
+    // reads from a duplicate of the file descriptor using large reads, so
+    // pipes and 'ss::standard_input' can be read directly
+    parser(ss::file_descriptor fd, std::string delim = ss::default_delimiter)
+        : parser{fd, nullptr, std::move(delim)} {
+    }
+
+    // reads the data given by the source, such as 'ss::gzip_source', the
+    // source is not assumed to support seeking
+    parser(ss::byte_source source, std::string delim = ss::default_delimiter)
+        : parser{std::move(source), nullptr, std::move(delim)} {
+    }
+
+    // same as above, but the line buffers, the split data, the header and
+    // the converted 'std::pmr::string' values are allocated from the given
+    // memory resource, which needs to outlive the parser, the line buffers
+    // are allocated with 'std::realloc' if it is null
+    parser(std::string file_name, std::pmr::memory_resource* resource,
+           std::string delim = ss::default_delimiter)
+        : file_name_{std::move(file_name)},
+          reader_{file_name_, delim, resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
         if (reader_.file_) {
-            read_line();
-            if constexpr (ignore_header) {
-                ignore_next();
-            } else {
-                raw_header_ = reader_.get_buffer();
-            }
+            read_header();
         } else {
             handle_error_file_not_open();
             eof_ = true;
@@ -51,22 +339,109 @@ public:
     }
 
     parser(const char* const csv_data_buffer, size_t csv_data_size,
+           std::pmr::memory_resource* resource,
            const std::string& delim = ss::default_delimiter)
         : file_name_{"CSV data buffer"},
-          reader_{csv_data_buffer, csv_data_size, delim} {
+          reader_{csv_data_buffer, csv_data_size, delim, resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
         if (csv_data_buffer) {
-            read_line();
-            if constexpr (ignore_header) {
-                ignore_next();
-            } else {
-                raw_header_ = reader_.get_buffer();
-            }
+            read_header();
+        } else {
+            handle_error_null_buffer();
+            eof_ = true;
+        }
+    }
+
+    parser(FILE* file, std::pmr::memory_resource* resource,
+           std::string delim = ss::default_delimiter)
+        : file_name_{"file stream"},
+          reader_{file, false, std::move(delim), resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
+        if (reader_.file_) {
+            read_header();
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    parser(ss::file_descriptor fd, std::pmr::memory_resource* resource,
+           std::string delim = ss::default_delimiter)
+        : file_name_{"file descriptor " + std::to_string(fd.value)},
+          reader_{open_file_descriptor(fd.value), true, std::move(delim),
+                  resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
+        if (reader_.file_) {
+            read_header();
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    parser(ss::byte_source source, std::pmr::memory_resource* resource,
+           std::string delim = ss::default_delimiter)
+        : file_name_{source.name},
+          reader_{std::move(source), std::move(delim), resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
+        if (reader_.source_) {
+            read_header();
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    // continues reading from the given checkpoint, the header is not read
+    // again
+    parser(std::string file_name, const ss::checkpoint& checkpoint,
+           std::string delim = ss::default_delimiter)
+        : file_name_{std::move(file_name)},
+          reader_{file_name_, delim, nullptr} {
+        if (reader_.file_) {
+            resume(checkpoint);
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    parser(const char* const csv_data_buffer, size_t csv_data_size,
+           const ss::checkpoint& checkpoint,
+           const std::string& delim = ss::default_delimiter)
+        : file_name_{"CSV data buffer"},
+          reader_{csv_data_buffer, csv_data_size, delim, nullptr} {
+        if (csv_data_buffer) {
+            resume(checkpoint);
         } else {
             handle_error_null_buffer();
             eof_ = true;
         }
     }
 
+    // reads only the records which begin within the given range, the
+    // header is still read from the beginning of the file
+    parser(std::string file_name, const ss::byte_range& range,
+           std::string delim = ss::default_delimiter)
+        : parser{std::move(file_name), std::move(delim)} {
+        if (reader_.file_) {
+            read_range(range);
+        }
+    }
+
+    parser(const char* const csv_data_buffer, size_t csv_data_size,
+           const ss::byte_range& range,
+           const std::string& delim = ss::default_delimiter)
+        : parser{csv_data_buffer, csv_data_size, delim} {
+        if (csv_data_buffer) {
+            read_range(range);
+        }
+    }
+
     parser(parser&& other) noexcept = default;
     parser& operator=(parser&& other) noexcept = default;
     ~parser() = default;
@@ -94,8 +469,67 @@ public:
         return eof_;
     }
 
+    // in follow mode the next line is read only once it is needed, so this
+    // waits until it is written
+    [[nodiscard]] bool eof() {
+        read_deferred_line();
+        return eof_;
+    }
+
     bool ignore_next() {
-        return reader_.read_next();
+        if (next_line_deferred_) {
+            next_line_deferred_ = false;
+            std::ignore = reader_.read_next();
+        }
+
+        next_line_parsed_ = false;
+        next_line_error_.reset();
+        const bool read = reader_.read_next();
+        line_number_ = reader_.line_number_;
+        eof_ = eof_ || !read;
+        return read;
+    }
+
+    // skips the next 'n' records without splitting them unless conditions
+    // are given to 'where', the ends of multiline records are found by
+    // scanning only the quotes and escapes, returns the number of skipped
+    // records
+    size_t skip(size_t n) {
+        size_t skipped = 0;
+        while (skipped < n) {
+            skip_filtered_lines();
+            if (eof_) {
+                break;
+            }
+
+            if (!next_line_parsed_) {
+                reader_.skip_continuation();
+            }
+
+            next_line();
+            ++skipped;
+        }
+        return skipped;
+    }
+
+    // at most 'n' more records are read, 'eof' is reached afterwards
+    void limit(size_t n) {
+        records_left_ = n;
+        if (n == 0) {
+            eof_ = true;
+        }
+    }
+
+    // continues reading from the first line which begins at or after the
+    // given byte offset, the offset needs not be at a line boundary,
+    // 'position' returns the offset of the next line
+    void skip_to(size_t position) {
+        if (!reader_.file_ && !reader_.csv_data_buffer_) {
+            return;
+        }
+
+        reader_.seek(position);
+        next_line();
     }
 
     template <typename T, typename... Ts>
@@ -104,27 +538,81 @@ public:
     }
 
     [[nodiscard]] size_t line() const {
-        return reader_.line_number_ > 0 ? reader_.line_number_ - 1
-                                        : reader_.line_number_;
+        return line_number_ > 0 ? line_number_ - 1 : line_number_;
     }
 
     [[nodiscard]] size_t position() const {
-        return reader_.chars_read_;
+        return next_line_deferred_ ? reader_.curr_char_ : reader_.chars_read_;
+    }
+
+    // the state needed to continue reading from the next record, together
+    // with the header and the fields given to 'use_fields', the conditions
+    // given to 'where' and the limit are not included
+    [[nodiscard]] ss::checkpoint checkpoint() const {
+        const auto& converter = reader_.converter_;
+        return {next_line_deferred_ || eof_ ? reader_.curr_char_
+                                            : reader_.record_begin_,
+                line(),
+                reader_.crlf_,
+                std::string{raw_header_},
+                std::vector<std::string>(header_.begin(), header_.end()),
+                converter.column_mappings_,
+                converter.number_of_columns_};
+    }
+
+    // instead of reaching eof, the parser waits for new lines to be
+    // appended to the file, a line is held until its new line character is
+    // written, as is a multiline record until it is terminated, 'eof' is
+    // reached once 'stop' returns true and no more data is found, has no
+    // effect in buffer mode
+    template <typename Stop>
+    void follow(Stop&& stop, follow_backoff backoff = {}) {
+        if (!reader_.file_) {
+            return;
+        }
+
+        reader_.follow_stop_ = std::forward<Stop>(stop);
+        reader_.follow_backoff_ = backoff;
+
+        if (eof_ && !records_left_) {
+            // the failed read counted a line
+            --reader_.line_number_;
+            eof_ = false;
+            next_line_deferred_ = true;
+        }
+    }
+
+    // pool used to store the values converted to 'ss::category'
+    [[nodiscard]] ss::string_pool& get_string_pool() {
+        return reader_.converter_.get_string_pool();
+    }
+
+    // uses the given pool instead of the one owned by the parser, the pool
+    // needs to outlive the parser and the values converted to it
+    void set_string_pool(ss::string_pool& pool) {
+        reader_.converter_.set_string_pool(pool);
+        reader_.next_line_converter_.set_string_pool(pool);
+    }
+
+    // arena used to store the converted 'std::string_view' values, the
+    // values stay valid until the arena is reset
+    [[nodiscard]] ss::arena& get_arena() {
+        assert_arena_views_defined();
+        return reader_.converter_.get_arena();
+    }
+
+    // uses the given arena instead of the one owned by the parser, the
+    // arena needs to outlive the parser
+    void set_arena(ss::arena& arena) {
+        assert_arena_views_defined();
+        reader_.converter_.set_arena(arena);
+        reader_.next_line_converter_.set_arena(arena);
     }
 
     template <typename T, typename... Ts>
     [[nodiscard]] no_void_validator_tup_t<T, Ts...> get_next() {
         if (!eof_) {
-            if constexpr (throw_on_error) {
-                try {
-                    reader_.parse();
-                } catch (const ss::exception& e) {
-                    read_line();
-                    decorate_rethrow(e);
-                }
-            } else {
-                reader_.parse();
-            }
+            parse_next_line();
         }
 
         reader_.update();
@@ -162,17 +650,120 @@ public:
         return value;
     }
 
+    // reads the next line and converts it with the types of the handler
+    // whose key equals the value of the given column, the function of the
+    // handler is invoked with the converted values, returns false if no
+    // handler matched, or the conversion or the invocation failed
+    template <typename... Handlers>
+    bool dispatch(size_t column, Handlers&&... handlers) {
+        static_assert(sizeof...(Handlers) > 0,
+                      "at least one handler must be given");
+
+        if (!eof_) {
+            parse_next_line();
+        }
+
+        reader_.update();
+        if (!reader_.converter_.valid()) {
+            handle_error_invalid_conversion();
+            read_line();
+            return false;
+        }
+
+        clear_error();
+
+        if (eof_) {
+            handle_error_eof_reached();
+            return false;
+        }
+
+        const auto& elems = reader_.converter_.splitter_.get_split_data();
+        if (column >= elems.size()) {
+            read_line();
+            handle_error_invalid_discriminator_column(column);
+            return false;
+        }
+
+        const auto& [begin, end] = elems[column];
+        const std::string_view key{begin, static_cast<size_t>(end - begin)};
+
+        if (!(try_handler(key, handlers) || ...)) {
+            read_line();
+            handle_error_no_handler(key);
+            return false;
+        }
+
+        return valid();
+    }
+
+    // lines whose split values do not satisfy the given condition are
+    // skipped without being converted, the condition can be made using
+    // 'ss::column', eg. 'ss::column("status") == "active"', or it can be
+    // anything callable with the split values of a line, 'ss::split_data',
+    // multiple conditions all need to be satisfied
+    template <typename Condition>
+    void where(Condition&& condition) {
+        clear_error();
+
+        if constexpr (std::is_same_v<std::decay_t<Condition>,
+                                     column_condition>) {
+            column_condition resolved = std::forward<Condition>(condition);
+            if (resolved.field) {
+                if (header_.empty() && !eof_) {
+                    split_header_data();
+                }
+
+                if (!valid()) {
+                    return;
+                }
+
+                auto index = header_index(*resolved.field);
+                if (!index) {
+                    handle_error_invalid_field(*resolved.field);
+                    return;
+                }
+                resolved.index = *index;
+            }
+
+            filters_.emplace_back(
+                [resolved = std::move(resolved)](const split_data& fields) {
+                    return resolved.matches(fields);
+                });
+        } else {
+            static_assert(std::is_invocable_r_v<bool, Condition,
+                                                const split_data&>,
+                          "the condition needs to be callable with "
+                          "'ss::split_data' and return a boolean");
+            filters_.emplace_back(std::forward<Condition>(condition));
+        }
+
+        // the next line may have already been accepted by the previous
+        // conditions
+        const auto& next = reader_.next_line_converter_;
+        if (next_line_parsed_ && !next_line_error_ && next.valid() &&
+            next.splitter_.valid() &&
+            !filters_.back()(next.splitter_.get_split_data())) {
+            next_line();
+        }
+    }
+
+    // removes all the conditions given to 'where'
+    void clear_filters() {
+        filters_.clear();
+    }
+
     [[nodiscard]] std::string raw_header() const {
         assert_ignore_header_not_defined();
-        return raw_header_;
+        return std::string{raw_header_};
     }
 
     [[nodiscard]] std::vector<std::string> header() {
         assert_ignore_header_not_defined();
         clear_error();
 
-        header_splitter splitter;
-        std::string raw_header_copy = raw_header_;
+        header_splitter splitter{reader_.resource_};
+        std::pmr::string raw_header_copy{raw_header_,
+                                         raw_header_.get_allocator()};
 
         if (!strict_split(splitter, raw_header_copy)) {
             return {};
@@ -261,7 +852,12 @@ public:
             iterator() : parser_{nullptr}, value_{} {
             }
 
-            iterator(parser<Options...>* parser) : parser_{parser}, value_{} {
+            // the value is assigned for each record, so it is created with
+            // the memory resource of the parser
+            iterator(parser<Options...>* parser)
+                : parser_{parser},
+                  value_{parser->reader_.converter_
+                             .template make_result<value>()} {
             }
 
             iterator(const iterator& other) = default;
@@ -320,8 +916,12 @@ public:
         iterable(parser<Options...>* parser) : parser_{parser} {
         }
 
+        // the iterator is moved instead of copied, so its value keeps the
+        // memory resource
         [[nodiscard]] iterator begin() {
-            return ++iterator{parser_};
+            iterator it{parser_};
+            ++it;
+            return it;
         }
 
         [[nodiscard]] iterator end() {
@@ -342,24 +942,160 @@ public:
         return iterable<true, Ts...>{this};
     }
 
+#ifdef SSP_RANGES_ENABLED
     ////////////////
-    // composite conversion
+    // view
     ////////////////
-    template <typename... Ts>
-    class composite {
+
+    // an input range of the remaining records, a record is only converted
+    // once its iterator is dereferenced, records which are passed without
+    // being dereferenced are skipped without being split, and no record is
+    // read before it is needed, the value is kept within the range and is
+    // valid until the iterator is incremented
+    template <bool get_object, typename T, typename... Ts>
+    class record_range
+        : public std::ranges::view_interface<
+              record_range<get_object, T, Ts...>> {
     public:
-        composite(std::tuple<Ts...>&& values, parser& parser)
-            : values_{std::move(values)}, parser_{parser} {
-        }
+        using value = std::conditional_t<get_object, T,
+                                         no_void_validator_tup_t<T, Ts...>>;
 
-        // tries to convert the same line with a different output type
-        // only if the previous conversion was not successful,
-        // returns composite containing itself and the new output
-        // as optional, additionally, if a parameter is passed, and
-        // that parameter can be invoked using the converted value,
-        // than it will be invoked in the case of a valid conversion
-        template <typename... Us, typename Fun = none>
-        composite<Ts..., std::optional<no_void_validator_tup_t<Us...>>> or_else(
+        class iterator {
+        public:
+            using value_type = value;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(record_range* range) : range_{range} {
+            }
+
+            [[nodiscard]] value& operator*() const {
+                return range_->current();
+            }
+
+            [[nodiscard]] value* operator->() const {
+                return &range_->current();
+            }
+
+            iterator& operator++() {
+                range_->next();
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            [[nodiscard]] friend bool operator==(const iterator& it,
+                                                 std::default_sentinel_t) {
+                return it.done();
+            }
+
+        private:
+            [[nodiscard]] bool done() const {
+                return !range_ || range_->done();
+            }
+
+            record_range* range_{nullptr};
+        };
+
+        record_range() = default;
+
+        explicit record_range(parser<Options...>* parser)
+            : parser_{parser},
+              value_{parser->reader_.converter_
+                         .template make_result<value>()} {
+        }
+
+        [[nodiscard]] iterator begin() {
+            return iterator{this};
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+    private:
+        value& current() {
+            if (!loaded_) {
+                if constexpr (get_object) {
+                    value_ = parser_->template get_object<T, Ts...>();
+                } else {
+                    value_ = parser_->template get_next<T, Ts...>();
+                }
+                loaded_ = true;
+            }
+            return value_;
+        }
+
+        void next() {
+            if (!loaded_) {
+                std::ignore = parser_->skip(1);
+            }
+            loaded_ = false;
+        }
+
+        [[nodiscard]] bool done() {
+            return !loaded_ && parser_->eof();
+        }
+
+        parser<Options...>* parser_{nullptr};
+        value value_{};
+        bool loaded_{false};
+    };
+
+    template <typename... Ts>
+    [[nodiscard]] auto view() {
+        return record_range<false, Ts...>{this};
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] auto view_object() {
+        return record_range<true, Ts...>{this};
+    }
+#endif
+
+#ifdef SSP_COROUTINES_ENABLED
+    ////////////////
+    // rows
+    ////////////////
+
+    // same as 'iterate', but the records are produced by a coroutine which
+    // reads the next record only once it is requested
+    template <typename... Ts>
+    [[nodiscard]] generator<no_void_validator_tup_t<Ts...>> rows() {
+        while (!eof()) {
+            co_yield get_next<Ts...>();
+        }
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] generator<T> rows_object() {
+        while (!eof()) {
+            co_yield get_object<T, Ts...>();
+        }
+    }
+#endif
+
+    ////////////////
+    // composite conversion
+    ////////////////
+    template <typename... Ts>
+    class composite {
+    public:
+        composite(std::tuple<Ts...>&& values, parser& parser)
+            : values_{std::move(values)}, parser_{parser} {
+        }
+
+        // tries to convert the same line with a different output type
+        // only if the previous conversion was not successful,
+        // returns composite containing itself and the new output
+        // as optional, additionally, if a parameter is passed, and
+        // that parameter can be invoked using the converted value,
+        // than it will be invoked in the case of a valid conversion
+        template <typename... Us, typename Fun = none>
+        composite<Ts..., std::optional<no_void_validator_tup_t<Us...>>> or_else(
             Fun&& fun = none{}) {
             using Value = no_void_validator_tup_t<Us...>;
             std::optional<Value> value;
@@ -425,92 +1161,489 @@ public:
                 value = std::move(tuple_output);
             }
 
-            parser_.try_invoke(*value, std::forward<Fun>(fun));
+            parser_.try_invoke(*value, std::forward<Fun>(fun));
+        }
+
+        template <typename U, typename... Us>
+        [[nodiscard]] no_void_validator_tup_t<U, Us...> try_same() {
+            parser_.clear_error();
+            parser_.remember_converted_values(true);
+            auto value =
+                parser_.reader_.converter_.template convert<U, Us...>();
+            parser_.remember_converted_values(false);
+            if (!parser_.reader_.converter_.valid()) {
+                parser_.handle_error_invalid_conversion();
+            }
+            return value;
+        }
+
+        ////////////////
+        // members
+        ////////////////
+
+        std::tuple<Ts...> values_;
+        parser& parser_;
+    };
+
+    // tries to convert a line and returns a composite which is
+    // able to try additional conversions in case of failure
+    template <typename... Ts, typename Fun = none>
+    [[nodiscard]] composite<std::optional<no_void_validator_tup_t<Ts...>>>
+    try_next(Fun&& fun = none{}) {
+        assert_throw_on_error_not_defined<throw_on_error>();
+        using Ret = no_void_validator_tup_t<Ts...>;
+        remember_converted_values(true);
+        auto value = get_next<Ts...>();
+        remember_converted_values(false);
+        return try_invoke_and_make_composite<std::optional<Ret>>(
+            std::move(value), std::forward<Fun>(fun));
+    }
+
+    // identical to try_next but returns composite with object instead of a
+    // tuple
+    template <typename T, typename... Ts, typename Fun = none>
+    [[nodiscard]] composite<std::optional<T>> try_object(Fun&& fun = none{}) {
+        assert_throw_on_error_not_defined<throw_on_error>();
+        remember_converted_values(true);
+        auto value = get_object<T, Ts...>();
+        remember_converted_values(false);
+        return try_invoke_and_make_composite<std::optional<T>>(
+            std::move(value), std::forward<Fun>(fun));
+    }
+
+    ////////////////
+    // sampling
+    ////////////////
+
+    // converts every 'stride'-th record until the end of file, the records
+    // in between are skipped, records which could not be converted are not
+    // sampled
+    template <typename T, typename... Ts>
+    [[nodiscard]] std::vector<no_void_validator_tup_t<T, Ts...>> sample_stride(
+        size_t stride) {
+        std::vector<no_void_validator_tup_t<T, Ts...>> samples;
+        while (!eof_) {
+            if (auto value = try_get_next<T, Ts...>()) {
+                samples.push_back(std::move(*value));
+            }
+            std::ignore = skip(std::max<size_t>(stride, 1) - 1);
+        }
+
+        clear_error();
+        return samples;
+    }
+
+    // converts 'count' records chosen uniformly from all the records until
+    // the end of file, the gaps between the chosen records are computed
+    // up front (algorithm L) so the rest of the records are only skipped
+    template <typename T, typename... Ts, typename Generator>
+    [[nodiscard]] std::vector<no_void_validator_tup_t<T, Ts...>>
+    sample_reservoir(size_t count, Generator&& generator) {
+        std::vector<no_void_validator_tup_t<T, Ts...>> samples;
+        if (count == 0) {
+            return samples;
+        }
+
+        while (!eof_ && samples.size() < count) {
+            if (auto value = try_get_next<T, Ts...>()) {
+                samples.push_back(std::move(*value));
+            }
+        }
+
+        std::uniform_real_distribution<double> uniform{
+            std::nextafter(0.0, 1.0), 1.0};
+        std::uniform_int_distribution<size_t> slot{0, count - 1};
+
+        auto weight = std::exp(std::log(uniform(generator)) / count);
+        while (!eof_) {
+            const auto gap =
+                std::floor(std::log(uniform(generator)) / std::log1p(-weight));
+            constexpr static auto max_gap =
+                static_cast<double>(std::numeric_limits<size_t>::max() / 2);
+            std::ignore = skip(static_cast<size_t>(std::min(gap, max_gap)));
+
+            if (eof_) {
+                break;
+            }
+
+            if (auto value = try_get_next<T, Ts...>()) {
+                samples[slot(generator)] = std::move(*value);
+                weight *= std::exp(std::log(uniform(generator)) / count);
+            }
+        }
+
+        clear_error();
+        return samples;
+    }
+
+    // converts the records found after up to 'count' random byte offsets
+    // between the current position and the end of file, the reading
+    // continues from the first record after each offset, lines which could
+    // not be converted are dropped until a valid record is found, the
+    // records are returned in the order of the file, each one at most
+    // once, longer records are more likely to precede an offset
+    template <typename T, typename... Ts, typename Generator>
+    [[nodiscard]] std::vector<no_void_validator_tup_t<T, Ts...>>
+    sample_offsets(size_t count, Generator&& generator) {
+        std::vector<no_void_validator_tup_t<T, Ts...>> samples;
+
+        const size_t begin = position();
+        const size_t end = reader_.data_size();
+        if (eof_ || count == 0 || begin >= end) {
+            return samples;
+        }
+
+        std::uniform_int_distribution<size_t> uniform{begin, end - 1};
+        std::vector<size_t> offsets(count);
+        for (auto& offset : offsets) {
+            offset = uniform(generator);
+        }
+        std::sort(offsets.begin(), offsets.end());
+
+        size_t sampled_end = 0;
+        for (const auto offset : offsets) {
+            if (offset < sampled_end) {
+                continue;
+            }
+
+            skip_to(offset);
+            if constexpr (quoted_multiline_enabled) {
+                skip_quoted_continuation();
+            }
+
+            while (!eof_) {
+                if (auto value = try_get_next<T, Ts...>()) {
+                    samples.push_back(std::move(*value));
+                    break;
+                }
+            }
+            sampled_end = position();
+        }
+
+        clear_error();
+        return samples;
+    }
+
+private:
+    // tries to invoke the given function (see below), if the function
+    // returns a value which can be used as a conditional, and it returns
+    // false, the function sets an error, and allows the invoke of the
+    // next possible conversion as if the validation of the current one
+    // failed
+    template <typename Arg, typename Fun = none>
+    void try_invoke(Arg&& arg, Fun&& fun) {
+        constexpr bool is_none = std::is_same_v<std::decay_t<Fun>, none>;
+        if constexpr (!is_none) {
+            using Ret = decltype(try_invoke_impl(arg, std::forward<Fun>(fun)));
+            constexpr bool returns_void = std::is_same_v<Ret, void>;
+            if constexpr (!returns_void) {
+                if (!try_invoke_impl(std::forward<Arg>(arg),
+                                     std::forward<Fun>(fun))) {
+                    handle_error_failed_check();
+                }
+            } else {
+                try_invoke_impl(arg, std::forward<Fun>(fun));
+            }
+        }
+    }
+
+    // tries to invoke the function if not none
+    // it first tries to invoke the function without arguments,
+    // than with one argument if the function accepts the whole tuple
+    // as an argument, and finally tries to invoke it with the tuple
+    // laid out as a parameter pack
+    template <typename Arg, typename Fun = none>
+    auto try_invoke_impl(Arg&& arg, Fun&& fun) {
+        constexpr bool is_none = std::is_same_v<std::decay_t<Fun>, none>;
+        if constexpr (!is_none) {
+            if constexpr (std::is_invocable_v<Fun>) {
+                return fun();
+            } else if constexpr (std::is_invocable_v<Fun, Arg>) {
+                return std::invoke(std::forward<Fun>(fun),
+                                   std::forward<Arg>(arg));
+            } else {
+                return std::apply(std::forward<Fun>(fun),
+                                  std::forward<Arg>(arg));
+            }
+        }
+    }
+
+    void read_header() {
+        read_line();
+        if constexpr (ignore_header) {
+            ignore_next();
+        } else {
+            raw_header_ = reader_.get_buffer();
+        }
+    }
+
+    ////////////////
+    // checkpoint
+    ////////////////
+
+    void resume(const ss::checkpoint& checkpoint) {
+        raw_header_ = checkpoint.raw_header;
+        header_.assign(checkpoint.header.begin(), checkpoint.header.end());
+
+        if (!checkpoint.column_mapping.empty()) {
+            reader_.converter_.set_column_mapping(
+                checkpoint.column_mapping, checkpoint.number_of_columns);
+            reader_.next_line_converter_.set_column_mapping(
+                checkpoint.column_mapping, checkpoint.number_of_columns);
+        }
+
+        reader_.crlf_ = checkpoint.crlf;
+        reader_.line_number_ = checkpoint.line;
+        reader_.seek(checkpoint.position);
+        next_line();
+    }
+
+    ////////////////
+    // byte range
+    ////////////////
+
+    void read_range(const ss::byte_range& range) {
+        reader_.range_end_ = range.end;
+
+        if (range.begin == 0) {
+            eof_ = eof_ || reader_.record_begin_ >= range.end;
+            return;
+        }
+
+        skip_to(range.begin);
+        if constexpr (quoted_multiline_enabled) {
+            skip_quoted_continuation();
+        }
+    }
+
+    // the line found after an offset may continue a quoted field of a
+    // multiline record, all the lines up to the end of such a record are
+    // skipped
+    void skip_quoted_continuation() {
+        if (eof_ || !continues_quoted_field()) {
+            return;
+        }
+
+        bool ignored = false;
+        bool in_quotes = reader_.scan_quotes(true, ignored).value_or(false);
+        while (in_quotes) {
+            next_line();
+            if (eof_) {
+                return;
+            }
+
+            const auto state = reader_.scan_quotes(true, ignored);
+            in_quotes = state.value_or(false);
+        }
+
+        next_line();
+    }
+
+    // the next line is scanned from both an unquoted and a quoted state, a
+    // state is rejected if a closing quote is not followed by a delimiter,
+    // or if a quote is found within an unquoted field, if neither state is
+    // rejected the following lines are scanned with both states until one
+    // of them is, after which the lines are read again from the first one,
+    // the line is assumed to begin a record if this cannot be decided
+    [[nodiscard]] bool continues_quoted_field() {
+        std::optional<bool> unquoted = false;
+        std::optional<bool> quoted = true;
+
+        auto scan = [&](std::optional<bool>& state) {
+            bool literal_quote = false;
+            state = reader_.scan_quotes(*state, literal_quote);
+            if (literal_quote) {
+                state.reset();
+            }
+        };
+
+        scan(unquoted);
+        scan(quoted);
+        if (!quoted || !unquoted || reader_.following()) {
+            return !unquoted && quoted;
+        }
+
+        const size_t begin = reader_.record_begin_;
+        const size_t line_number = reader_.line_number_;
+        const size_t range_end = std::exchange(
+            reader_.range_end_, std::numeric_limits<size_t>::max());
+
+        for (size_t i = 0; i < quote_resync_lines && quoted && unquoted; ++i) {
+            if (!reader_.read_next()) {
+                break;
+            }
+            scan(unquoted);
+            scan(quoted);
+        }
+
+        reader_.range_end_ = range_end;
+        reader_.seek(begin);
+        reader_.line_number_ = line_number - 1;
+        next_line();
+
+        return !unquoted && quoted;
+    }
+
+    ////////////////
+    // filter
+    ////////////////
+
+    void parse_line() {
+        if constexpr (throw_on_error) {
+            try {
+                reader_.parse();
+            } catch (const ss::exception& e) {
+                read_line();
+                decorate_rethrow(e);
+            }
+        } else {
+            reader_.parse();
+        }
+    }
+
+    // the next line may have already been parsed while skipping the lines
+    // rejected by the filters, in which case only the error of the parsing
+    // is reported
+    void parse_next_line() {
+        skip_filtered_lines();
+        if (eof_) {
+            return;
+        }
+
+        if (!next_line_parsed_) {
+            parse_line();
+            return;
+        }
+
+        next_line_parsed_ = false;
+        if constexpr (throw_on_error) {
+            if (next_line_error_) {
+                auto e = std::move(*next_line_error_);
+                next_line_error_.reset();
+                read_line();
+                decorate_rethrow(e);
+            }
+        }
+    }
+
+    // lines are parsed ahead so that 'eof' is known right after the last
+    // accepted line is read, lines which could not be parsed are not
+    // skipped, their error is reported when they are read
+    void skip_filtered_lines() {
+        read_deferred_line();
+
+        while (!eof_ && !filters_.empty() && !next_line_parsed_) {
+            next_line_parsed_ = true;
+
+            if constexpr (throw_on_error) {
+                try {
+                    reader_.parse();
+                } catch (const ss::exception& e) {
+                    next_line_error_ = e;
+                    return;
+                }
+            } else {
+                reader_.parse();
+            }
+
+            const auto& next = reader_.next_line_converter_;
+            if (!next.valid() || !next.splitter_.valid() ||
+                accepted(next.splitter_.get_split_data())) {
+                return;
+            }
+
+            next_line_parsed_ = false;
+            eof_ = !reader_.read_next();
         }
+    }
 
-        template <typename U, typename... Us>
-        [[nodiscard]] no_void_validator_tup_t<U, Us...> try_same() {
-            parser_.clear_error();
-            auto value =
-                parser_.reader_.converter_.template convert<U, Us...>();
-            if (!parser_.reader_.converter_.valid()) {
-                parser_.handle_error_invalid_conversion();
-            }
-            return value;
+    void read_deferred_line() {
+        if (next_line_deferred_) {
+            next_line_deferred_ = false;
+            eof_ = !reader_.read_next();
+            skip_filtered_lines();
         }
+    }
 
-        ////////////////
-        // members
-        ////////////////
+    [[nodiscard]] bool accepted(const split_data& fields) const {
+        return std::all_of(filters_.begin(), filters_.end(),
+                           [&fields](const auto& filter) {
+                               return filter(fields);
+                           });
+    }
 
-        std::tuple<Ts...> values_;
-        parser& parser_;
-    };
+    ////////////////
+    // dispatch
+    ////////////////
 
-    // tries to convert a line and returns a composite which is
-    // able to try additional conversions in case of failure
-    template <typename... Ts, typename Fun = none>
-    [[nodiscard]] composite<std::optional<no_void_validator_tup_t<Ts...>>>
-    try_next(Fun&& fun = none{}) {
-        assert_throw_on_error_not_defined<throw_on_error>();
-        using Ret = no_void_validator_tup_t<Ts...>;
-        return try_invoke_and_make_composite<
-            std::optional<Ret>>(get_next<Ts...>(), std::forward<Fun>(fun));
+    template <typename Handler>
+    [[nodiscard]] bool try_handler(std::string_view key, Handler& handler) {
+        if (handler.key != key) {
+            return false;
+        }
+
+        auto value = convert_for(handler);
+        read_line();
+
+        if (valid()) {
+            try_invoke(value, handler.fun);
+        }
+        return true;
     }
 
-    // identical to try_next but returns composite with object instead of a
-    // tuple
-    template <typename T, typename... Ts, typename Fun = none>
-    [[nodiscard]] composite<std::optional<T>> try_object(Fun&& fun = none{}) {
-        assert_throw_on_error_not_defined<throw_on_error>();
-        return try_invoke_and_make_composite<
-            std::optional<T>>(get_object<T, Ts...>(), std::forward<Fun>(fun));
+    template <typename Fun, typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<Ts...> convert_for(
+        const record_handler<Fun, Ts...>&) {
+        return convert_current<Ts...>();
     }
 
-private:
-    // tries to invoke the given function (see below), if the function
-    // returns a value which can be used as a conditional, and it returns
-    // false, the function sets an error, and allows the invoke of the
-    // next possible conversion as if the validation of the current one
-    // failed
-    template <typename Arg, typename Fun = none>
-    void try_invoke(Arg&& arg, Fun&& fun) {
-        constexpr bool is_none = std::is_same_v<std::decay_t<Fun>, none>;
-        if constexpr (!is_none) {
-            using Ret = decltype(try_invoke_impl(arg, std::forward<Fun>(fun)));
-            constexpr bool returns_void = std::is_same_v<Ret, void>;
-            if constexpr (!returns_void) {
-                if (!try_invoke_impl(std::forward<Arg>(arg),
-                                     std::forward<Fun>(fun))) {
-                    handle_error_failed_check();
-                }
-            } else {
-                try_invoke_impl(arg, std::forward<Fun>(fun));
+    template <typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<Ts...> convert_current() {
+        if constexpr (throw_on_error) {
+            try {
+                return reader_.converter_.template convert<Ts...>();
+            } catch (const ss::exception& e) {
+                read_line();
+                decorate_rethrow(e);
             }
         }
+
+        auto value = reader_.converter_.template convert<Ts...>();
+        if (!reader_.converter_.valid()) {
+            handle_error_invalid_conversion();
+        }
+        return value;
     }
 
-    // tries to invoke the function if not none
-    // it first tries to invoke the function without arguments,
-    // than with one argument if the function accepts the whole tuple
-    // as an argument, and finally tries to invoke it with the tuple
-    // laid out as a parameter pack
-    template <typename Arg, typename Fun = none>
-    auto try_invoke_impl(Arg&& arg, Fun&& fun) {
-        constexpr bool is_none = std::is_same_v<std::decay_t<Fun>, none>;
-        if constexpr (!is_none) {
-            if constexpr (std::is_invocable_v<Fun>) {
-                return fun();
-            } else if constexpr (std::is_invocable_v<Fun, Arg>) {
-                return std::invoke(std::forward<Fun>(fun),
-                                   std::forward<Arg>(arg));
-            } else {
-                return std::apply(std::forward<Fun>(fun),
-                                  std::forward<Arg>(arg));
+    ////////////////
+    // sampling
+    ////////////////
+
+    template <typename... Ts>
+    [[nodiscard]] std::optional<no_void_validator_tup_t<Ts...>> try_get_next() {
+        if constexpr (throw_on_error) {
+            try {
+                return get_next<Ts...>();
+            } catch (const ss::exception&) {
+                return std::nullopt;
+            }
+        } else {
+            auto value = get_next<Ts...>();
+            if (!valid()) {
+                return std::nullopt;
             }
+            return value;
         }
     }
 
+    // the columns converted by the first conversion of a composite are
+    // remembered by the converter, so the alternative conversions of the
+    // same line do not convert the columns of the same type again
+    void remember_converted_values(bool remember) {
+        reader_.converter_.remember_converted_values(remember);
+        reader_.next_line_converter_.remember_converted_values(remember);
+    }
+
     template <typename T, typename Fun = none>
     [[nodiscard]] composite<T> try_invoke_and_make_composite(T&& value,
                                                              Fun&& fun) {
@@ -524,13 +1657,18 @@ private:
     // header
     ////////////////
 
+    void assert_arena_views_defined() const {
+        static_assert(arena_views,
+                      "'arena_views' needs to be enabled to use the arena");
+    }
+
     void assert_ignore_header_not_defined() const {
         static_assert(!ignore_header,
                       "cannot use this method when 'ignore_header' is defined");
     }
 
     [[nodiscard]] bool strict_split(header_splitter& splitter,
-                                    std::string& header) {
+                                    std::pmr::string& header) {
         if constexpr (throw_on_error) {
             try {
                 splitter.split(header.data(), reader_.delim_);
@@ -549,26 +1687,28 @@ private:
     }
 
     void split_header_data() {
-        header_splitter splitter;
-        std::string raw_header_copy = raw_header_;
+        header_splitter splitter{reader_.resource_};
+        std::pmr::string raw_header_copy{raw_header_,
+                                         raw_header_.get_allocator()};
 
         if (!strict_split(splitter, raw_header_copy)) {
             return;
         }
 
         for (const auto& [begin, end] : splitter.get_split_data()) {
-            std::string field{begin, end};
+            const std::string_view field{begin,
+                                         static_cast<size_t>(end - begin)};
             if (std::find(header_.begin(), header_.end(), field) !=
                 header_.end()) {
-                handle_error_duplicate_header_field(field);
+                handle_error_duplicate_header_field(std::string{field});
                 header_.clear();
                 return;
             }
-            header_.push_back(std::move(field));
+            header_.emplace_back(field);
         }
     }
 
-    [[nodiscard]] std::optional<size_t> header_index(const std::string& field) {
+    [[nodiscard]] std::optional<size_t> header_index(std::string_view field) {
         auto it = std::find(header_.begin(), header_.end(), field);
 
         if (it == header_.end()) {
@@ -629,6 +1769,19 @@ private:
         }
     }
 
+    void handle_error_source_not_readable() {
+        constexpr static auto error_msg = ": could not be read";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
     void handle_error_eof_reached() {
         constexpr static auto error_msg = ": read on end of file";
 
@@ -655,6 +1808,51 @@ private:
         }
     }
 
+    void handle_error_invalid_discriminator_column(size_t column) {
+        constexpr static auto error_msg =
+            ": invalid discriminator column, number of columns: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_)
+                .append(" ")
+                .append(std::to_string(line()))
+                .append(error_msg)
+                .append(std::to_string(
+                    reader_.converter_.splitter_.get_split_data().size()))
+                .append(", given column: ")
+                .append(std::to_string(column + 1));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{
+                file_name_ + " " + std::to_string(line()) + error_msg +
+                std::to_string(
+                    reader_.converter_.splitter_.get_split_data().size()) +
+                ", given column: " + std::to_string(column + 1)};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_no_handler(std::string_view key) {
+        constexpr static auto error_msg = ": no handler for discriminator: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_)
+                .append(" ")
+                .append(std::to_string(line()))
+                .append(error_msg)
+                .append("\'")
+                .append(key)
+                .append("\'");
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + " " + std::to_string(line()) +
+                                error_msg + "\'" + std::string{key} + "\'"};
+        } else {
+            error_ = true;
+        }
+    }
+
     void handle_error_invalid_field(const std::string& field) {
         constexpr static auto error_msg =
             ": header does not contain given field: ";
@@ -757,40 +1955,110 @@ private:
     // line reading
     ////////////////
 
+    // the limit counts only the lines which were read, not the skipped
+    // ones
     void read_line() {
+        if (records_left_ && --*records_left_ == 0) {
+            eof_ = true;
+            return;
+        }
+
+        next_line();
+    }
+
+    void next_line() {
+        next_line_parsed_ = false;
+        next_line_error_.reset();
+
+        // in follow mode the current line would otherwise be held back
+        // until the next one is written
+        if (reader_.following()) {
+            next_line_deferred_ = true;
+            line_number_ = reader_.line_number_ + 1;
+            return;
+        }
+
         eof_ = !reader_.read_next();
+        line_number_ = reader_.line_number_;
+        if (eof_ && reader_.source_.take_error()) {
+            handle_error_source_not_readable();
+        }
+        skip_filtered_lines();
     }
 
     struct reader {
-        reader(const std::string& file_name_, std::string delim)
-            : delim_{std::move(delim)},
-              file_{std::fopen(file_name_.c_str(), "rb")} {
+        // the buffers are allocated from 'resource', or with 'std::realloc'
+        // if it is null
+        reader(const std::string& file_name_, std::string delim,
+               std::pmr::memory_resource* resource)
+            : reader{std::fopen(file_name_.c_str(), "rb"), true,
+                     std::move(delim), resource} {
+        }
+
+        // files which are not owned are read with their own buffering
+        reader(FILE* file, bool owns_file, std::string delim,
+               std::pmr::memory_resource* resource)
+            : converter_{resource}, next_line_converter_{resource},
+              delim_{std::move(delim)}, file_{file}, owns_file_{owns_file},
+              resource_{resource} {
+            share_converter_resources();
+
+            if (file_ && owns_file_) {
+                file_buffer_ = reallocate_buffer(nullptr, 0, file_buffer_size,
+                                                 resource_);
+                std::ignore = std::setvbuf(file_, file_buffer_, _IOFBF,
+                                           file_buffer_size);
+            }
+
+            if constexpr (sequential_scan) {
+                if (file_) {
+                    advise_sequential_file(file_);
+                }
+            }
+        }
+
+        reader(byte_source source, std::string delim,
+               std::pmr::memory_resource* resource)
+            : converter_{resource}, next_line_converter_{resource},
+              delim_{std::move(delim)}, source_{std::move(source)},
+              resource_{resource} {
+            share_converter_resources();
         }
 
         reader(const char* const buffer, size_t csv_data_size,
-               std::string delim)
-            : delim_{std::move(delim)}, csv_data_buffer_{buffer},
-              csv_data_size_{csv_data_size} {
+               std::string delim, std::pmr::memory_resource* resource)
+            : converter_{resource}, next_line_converter_{resource},
+              delim_{std::move(delim)}, csv_data_buffer_{buffer},
+              csv_data_size_{csv_data_size}, resource_{resource} {
+            share_converter_resources();
         }
 
         reader(reader&& other) noexcept
             : buffer_{other.buffer_},
               next_line_buffer_{other.next_line_buffer_},
               helper_buffer_{other.helper_buffer_},
+              file_buffer_{other.file_buffer_},
               converter_{std::move(other.converter_)},
               next_line_converter_{std::move(other.next_line_converter_)},
               buffer_size_{other.buffer_size_},
               next_line_buffer_size_{other.next_line_buffer_size_},
               helper_buffer_size{other.helper_buffer_size},
               delim_{std::move(other.delim_)}, file_{other.file_},
+              owns_file_{other.owns_file_}, source_{std::move(other.source_)},
               csv_data_buffer_{other.csv_data_buffer_},
               csv_data_size_{other.csv_data_size_},
-              curr_char_{other.curr_char_}, crlf_{other.crlf_},
+              resource_{other.resource_}, curr_char_{other.curr_char_},
+              dropped_until_{other.dropped_until_}, crlf_{other.crlf_},
               line_number_{other.line_number_}, chars_read_{other.chars_read_},
-              next_line_size_{other.next_line_size_} {
+              record_begin_{other.record_begin_},
+              range_end_{other.range_end_},
+              next_line_size_{other.next_line_size_},
+              follow_stop_{std::move(other.follow_stop_)},
+              follow_backoff_{other.follow_backoff_} {
             other.buffer_ = nullptr;
             other.next_line_buffer_ = nullptr;
             other.helper_buffer_ = nullptr;
+            other.file_buffer_ = nullptr;
             other.file_ = nullptr;
         }
 
@@ -799,6 +2067,7 @@ private:
                 buffer_ = other.buffer_;
                 next_line_buffer_ = other.next_line_buffer_;
                 helper_buffer_ = other.helper_buffer_;
+                file_buffer_ = other.file_buffer_;
                 converter_ = std::move(other.converter_);
                 next_line_converter_ = std::move(other.next_line_converter_);
                 buffer_size_ = other.buffer_size_;
@@ -806,17 +2075,26 @@ private:
                 helper_buffer_size = other.helper_buffer_size;
                 delim_ = std::move(other.delim_);
                 file_ = other.file_;
+                owns_file_ = other.owns_file_;
+                source_ = std::move(other.source_);
                 csv_data_buffer_ = other.csv_data_buffer_;
                 csv_data_size_ = other.csv_data_size_;
+                resource_ = other.resource_;
                 curr_char_ = other.curr_char_;
+                dropped_until_ = other.dropped_until_;
                 crlf_ = other.crlf_;
                 line_number_ = other.line_number_;
                 chars_read_ = other.chars_read_;
+                record_begin_ = other.record_begin_;
+                range_end_ = other.range_end_;
                 next_line_size_ = other.next_line_size_;
+                follow_stop_ = std::move(other.follow_stop_);
+                follow_backoff_ = other.follow_backoff_;
 
                 other.buffer_ = nullptr;
                 other.next_line_buffer_ = nullptr;
                 other.helper_buffer_ = nullptr;
+                other.file_buffer_ = nullptr;
                 other.file_ = nullptr;
                 other.csv_data_buffer_ = nullptr;
             }
@@ -825,19 +2103,33 @@ private:
         }
 
         ~reader() {
-            std::free(buffer_);
-            std::free(next_line_buffer_);
-            std::free(helper_buffer_);
+            free_buffer(buffer_, buffer_size_, resource_);
+            free_buffer(next_line_buffer_, next_line_buffer_size_, resource_);
+            free_buffer(helper_buffer_, helper_buffer_size, resource_);
 
-            if (file_) {
+            if (file_ && owns_file_) {
                 std::ignore = std::fclose(file_);
             }
+            free_buffer(file_buffer_, file_buffer_size, resource_);
         }
 
         reader() = delete;
         reader(const reader& other) = delete;
         reader& operator=(const reader& other) = delete;
 
+        // the converters are swapped after each line, so they need to
+        // intern values into the same pool and store views into the same
+        // arena
+        void share_converter_resources() {
+            std::ignore = converter_.get_string_pool();
+            next_line_converter_.string_pool_ = converter_.string_pool_;
+
+            if constexpr (arena_views) {
+                std::ignore = converter_.get_arena();
+                next_line_converter_.arena_ = converter_.arena_;
+            }
+        }
+
         // read next line each time in order to set eof_
         [[nodiscard]] bool read_next() {
             next_line_converter_.clear_error();
@@ -849,9 +2141,13 @@ private:
                 }
 
                 chars_read_ = curr_char_;
+                record_begin_ = curr_char_;
+                if (record_begin_ >= range_end_) {
+                    return false;
+                }
+
                 auto [ssize, eof] =
-                    get_line(next_line_buffer_, next_line_buffer_size_, file_,
-                             csv_data_buffer_, csv_data_size_, curr_char_);
+                    get_next_line(next_line_buffer_, next_line_buffer_size_);
 
                 if (eof) {
                     return false;
@@ -868,9 +2164,249 @@ private:
             return true;
         }
 
+        // reads the lines which belong to the record in the next line buffer
+        // without splitting it, the quotes are only counted, so the record
+        // is assumed to be well formed
+        void skip_continuation() {
+            if constexpr (multiline::enabled) {
+                using quote = typename setup<Options...>::quote;
+                using escape = typename setup<Options...>::escape;
+
+                bool quoted = false;
+                size_t limit = 0;
+
+                while (true) {
+                    bool escaped_eol = false;
+                    for (size_t i = 0; i < next_line_size_; ++i) {
+                        const char c = next_line_buffer_[i];
+                        if constexpr (escape::enabled) {
+                            if (escape::match(c)) {
+                                escaped_eol = (i + 1 == next_line_size_);
+                                ++i;
+                                continue;
+                            }
+                        }
+                        if constexpr (quote::enabled) {
+                            quoted ^= quote::match(c);
+                        }
+                    }
+
+                    if (!(quoted && quoted_multiline_enabled) &&
+                        !(escaped_eol && escaped_multiline_enabled)) {
+                        return;
+                    }
+
+                    if constexpr (multiline::size > 0) {
+                        if (limit++ >= multiline::size) {
+                            return;
+                        }
+                    }
+
+                    chars_read_ = curr_char_;
+                    auto [ssize, eof] = get_next_line(next_line_buffer_,
+                                                      next_line_buffer_size_);
+
+                    if (eof) {
+                        return;
+                    }
+
+                    ++line_number_;
+                    next_line_size_ = remove_eol(next_line_buffer_, ssize);
+                }
+            }
+        }
+
+        // scans the next line with the given initial quote state, returns
+        // whether the line ends within a quoted field, or nothing if a
+        // closing quote is not followed by a delimiter, quotes which are
+        // not at the beginning of a field are not treated as errors, but
+        // are reported through 'literal_quote'
+        [[nodiscard]] std::optional<bool> scan_quotes(
+            bool quoted, bool& literal_quote) const {
+            using quote = typename setup<Options...>::quote;
+            using escape = typename setup<Options...>::escape;
+            using trim_right = typename setup<Options...>::trim_right;
+
+            const char* curr = next_line_buffer_;
+            const char* const end = next_line_buffer_ + next_line_size_;
+            auto at_delimiter = [&] {
+                return static_cast<size_t>(end - curr) >= delim_.size() &&
+                       std::equal(delim_.begin(), delim_.end(), curr);
+            };
+
+            bool field_begin = !quoted;
+            while (curr != end) {
+                if constexpr (escape::enabled) {
+                    if (escape::match(*curr)) {
+                        curr += (end - curr > 1) ? 2 : 1;
+                        field_begin = false;
+                        continue;
+                    }
+                }
+
+                if (quoted) {
+                    if (quote::match(*curr)) {
+                        if (curr + 1 != end && quote::match(*(curr + 1))) {
+                            curr += 2;
+                            continue;
+                        }
+
+                        quoted = false;
+                        ++curr;
+                        if constexpr (trim_right::enabled) {
+                            while (curr != end && trim_right::match(*curr)) {
+                                ++curr;
+                            }
+                        }
+                        if (curr != end && !at_delimiter()) {
+                            return std::nullopt;
+                        }
+                        continue;
+                    }
+                    ++curr;
+                    continue;
+                }
+
+                if (at_delimiter()) {
+                    curr += delim_.size();
+                    field_begin = true;
+                    continue;
+                }
+
+                if (quote::match(*curr)) {
+                    if (field_begin) {
+                        quoted = true;
+                    } else {
+                        literal_quote = true;
+                    }
+                }
+
+                field_begin = false;
+                ++curr;
+            }
+
+            return quoted;
+        }
+
+        // lines longer than the record size limit are cut, the line ending
+        // is kept, so the cut lines are longer than the limit
+        constexpr static size_t line_size_limit =
+            max_record_bytes > 0 ? max_record_bytes + 2
+                                 : std::numeric_limits<size_t>::max();
+
+        // the line is written after the first 'offset' characters of the
+        // buffer, the returned size does not include them
+        [[nodiscard]] std::tuple<ssize_t, bool> get_data_line(
+            char*& buffer, size_t& buffer_size, size_t offset = 0) {
+            if (!source_) {
+                auto result = get_line(
+                    buffer, buffer_size, file_, csv_data_buffer_,
+                    csv_data_size_, curr_char_, offset, line_size_limit,
+                    resource_);
+                if constexpr (sequential_scan) {
+                    drop_read_pages();
+                }
+                return result;
+            }
+
+            size_t dropped = 0;
+            const auto ssize =
+                source_.get_line(buffer, buffer_size, offset,
+                                 line_size_limit, dropped, resource_);
+            if (ssize == -1) {
+                return {ssize, true};
+            }
+
+            curr_char_ += ssize + dropped;
+            return {ssize, false};
+        }
+
+        // the pages which were read are dropped in large steps, the page
+        // the reading position is in is kept since it is still buffered
+        void drop_read_pages() {
+            if (!file_ || curr_char_ < dropped_until_ + page_cache_drop_size) {
+                return;
+            }
+
+            const auto end = curr_char_ / page_cache_drop_size *
+                             page_cache_drop_size;
+            advise_dont_need_file(file_, dropped_until_, end);
+            dropped_until_ = end;
+        }
+
+        [[nodiscard]] bool following() const {
+            return file_ && follow_stop_;
+        }
+
+        // same as 'get_line', but in follow mode it waits until a whole
+        // line is written into the file
+        [[nodiscard]] std::tuple<ssize_t, bool> get_next_line(
+            char*& buffer, size_t& buffer_size, size_t offset = 0) {
+            auto [ssize, eof] = get_data_line(buffer, buffer_size, offset);
+            if (!following()) {
+                return {ssize, eof};
+            }
+
+            auto wait = follow_backoff_.min;
+            while (eof || buffer[offset + ssize - 1] != '\n') {
+                // the file is read once more after stopping, since the
+                // data may have been written before the stop
+                const bool stop = follow_stop_();
+                if (!stop) {
+                    std::this_thread::sleep_for(wait);
+                    wait = std::min(wait * 2, follow_backoff_.max);
+                }
+
+                // the rest of the line is appended to the part of it which
+                // was already read
+                std::clearerr(file_);
+                const size_t read = eof ? 0 : static_cast<size_t>(ssize);
+                auto [next_ssize, next_eof] =
+                    get_data_line(buffer, buffer_size, offset + read);
+
+                if (next_eof) {
+                    if (stop) {
+                        break;
+                    }
+                    continue;
+                }
+
+                wait = follow_backoff_.min;
+                ssize = static_cast<ssize_t>(read) + next_ssize;
+                eof = false;
+            }
+
+            return {ssize, eof};
+        }
+
+        [[nodiscard]] size_t data_size() const {
+            return file_ ? file_size(file_) : csv_data_size_;
+        }
+
+        // moves to the given byte offset and drops the rest of the line
+        // the offset is in, unless the offset is at the beginning of a line
+        void seek(size_t position) {
+            const size_t offset = position > 0 ? position - 1 : 0;
+            if (file_ && !seek_file(file_, offset)) {
+                return;
+            }
+
+            curr_char_ = file_ ? offset : std::min(offset, csv_data_size_);
+            dropped_until_ = curr_char_;
+            if (position == 0) {
+                return;
+            }
+
+            std::ignore = get_data_line(helper_buffer_, helper_buffer_size);
+        }
+
         void parse() {
             size_t limit = 0;
 
+            if (record_size_limit_reached()) {
+                return;
+            }
+
             if constexpr (escaped_multiline_enabled) {
                 while (escaped_eol(next_line_size_)) {
                     if (multiline_limit_reached(limit)) {
@@ -923,6 +2459,8 @@ private:
                                                  next_line_size_, delim_);
                 }
             }
+
+            std::ignore = record_size_limit_reached();
         }
 
         void update() {
@@ -931,7 +2469,22 @@ private:
             std::swap(converter_, next_line_converter_);
         }
 
+        [[nodiscard]] bool record_size_limit_reached() {
+            if constexpr (max_record_bytes > 0) {
+                if (next_line_size_ > max_record_bytes) {
+                    next_line_converter_
+                        .handle_error_record_size_limit_reached();
+                    return true;
+                }
+            }
+            return false;
+        }
+
         [[nodiscard]] bool multiline_limit_reached(size_t& limit) {
+            if (record_size_limit_reached()) {
+                return true;
+            }
+
             if constexpr (multiline::size > 0) {
                 if (limit++ >= multiline::size) {
                     next_line_converter_.handle_error_multiline_limit_reached();
@@ -984,41 +2537,29 @@ private:
             return size;
         }
 
-        void realloc_concat(char*& first, size_t& first_size,
-                            size_t& buffer_size, const char* const second,
-                            size_t second_size) {
-            buffer_size = first_size + second_size + 3;
-            auto* new_first = static_cast<char*>(
-                strict_realloc(static_cast<void*>(first), buffer_size));
-
-            first = new_first;
-            std::copy_n(second, second_size + 1, first + first_size);
-            first_size += second_size;
-        }
-
+        // the next line is read directly after the record within the
+        // buffer, which grows geometrically, so a record of many lines is
+        // not copied again for each of them
         [[nodiscard]] bool append_next_line_to_buffer(char*& buffer,
                                                       size_t& line_size,
-                                                      size_t buffer_size) {
+                                                      size_t& buffer_size) {
             undo_remove_eol(buffer, line_size, buffer_size);
 
             chars_read_ = curr_char_;
             auto [next_ssize, eof] =
-                get_line(helper_buffer_, helper_buffer_size, file_,
-                         csv_data_buffer_, csv_data_size_, curr_char_);
+                get_next_line(buffer, buffer_size, line_size);
 
             if (eof) {
                 return false;
             }
 
             ++line_number_;
-            size_t next_size = remove_eol(helper_buffer_, next_ssize);
-            realloc_concat(buffer, line_size, next_line_buffer_size_,
-                           helper_buffer_, next_size);
+            line_size = remove_eol(buffer, line_size + next_ssize);
             return true;
         }
 
-        [[nodiscard]] std::string get_buffer() {
-            return std::string{next_line_buffer_, next_line_size_};
+        [[nodiscard]] std::string_view get_buffer() const {
+            return std::string_view{next_line_buffer_, next_line_size_};
         }
 
         ////////////////
@@ -1027,6 +2568,7 @@ private:
         char* buffer_{nullptr};
         char* next_line_buffer_{nullptr};
         char* helper_buffer_{nullptr};
+        char* file_buffer_{nullptr};
 
         converter<Options...> converter_;
         converter<Options...> next_line_converter_;
@@ -1037,16 +2579,25 @@ private:
 
         std::string delim_;
         FILE* file_{nullptr};
+        bool owns_file_{true};
+        byte_source_reader source_;
 
         const char* csv_data_buffer_{nullptr};
         size_t csv_data_size_{0};
+        std::pmr::memory_resource* resource_{nullptr};
         size_t curr_char_{0};
+        size_t dropped_until_{0};
 
         bool crlf_{false};
         size_t line_number_{0};
         size_t chars_read_{0};
+        size_t record_begin_{0};
+        size_t range_end_{std::numeric_limits<size_t>::max()};
 
         size_t next_line_size_{0};
+
+        std::function<bool()> follow_stop_;
+        follow_backoff follow_backoff_;
     };
 
     ////////////////
@@ -1056,8 +2607,14 @@ private:
     std::string file_name_;
     error_type error_{};
     reader reader_;
-    std::vector<std::string> header_;
-    std::string raw_header_;
+    std::pmr::vector<std::pmr::string> header_;
+    std::pmr::string raw_header_;
+    std::vector<std::function<bool(const split_data&)>> filters_;
+    std::optional<ss::exception> next_line_error_;
+    std::optional<size_t> records_left_;
+    size_t line_number_{0};
+    bool next_line_parsed_{false};
+    bool next_line_deferred_{false};
     bool eof_{false};
 };
 
@@ -161,6 +161,43 @@ struct get_multiline<> {
 template <typename... Ts>
 using get_multiline_t = typename get_multiline<Ts...>::type;
 
+////////////////
+// max_record_bytes
+////////////////
+
+// records longer than 'S' bytes, without the new line at their end, are not
+// read into memory, they are reported as errors and the reading continues
+// from the line which follows them
+template <size_t S>
+struct max_record_bytes {
+    constexpr static auto size = S;
+};
+
+template <typename T>
+struct is_instance_of_max_record_bytes : std::false_type {};
+
+template <size_t S>
+struct is_instance_of_max_record_bytes<max_record_bytes<S>> : std::true_type {
+};
+
+template <typename... Ts>
+struct get_max_record_bytes;
+
+template <typename T, typename... Ts>
+struct get_max_record_bytes<T, Ts...> {
+    using type =
+        std::conditional_t<is_instance_of_max_record_bytes<T>::value, T,
+                           typename get_max_record_bytes<Ts...>::type>;
+};
+
+template <>
+struct get_max_record_bytes<> {
+    using type = max_record_bytes<0>;
+};
+
+template <typename... Ts>
+using get_max_record_bytes_t = typename get_max_record_bytes<Ts...>::type;
+
 ////////////////
 // string_error
 ////////////////
@@ -185,6 +222,29 @@ class ignore_empty {};
 
 class throw_on_error {};
 
+////////////////
+// crlf
+////////////////
+
+class crlf {};
+
+////////////////
+// arena_views
+////////////////
+
+// converted std::string_view values are copied into an arena owned by the
+// parser instead of pointing to the line buffer
+class arena_views {};
+
+////////////////
+// sequential_scan
+////////////////
+
+// the file is read once from the beginning to the end, the kernel is told to
+// read ahead aggressively and the pages which were already read are dropped
+// from the page cache
+class sequential_scan {};
+
 ////////////////
 // setup implementation
 ////////////////
@@ -212,11 +272,23 @@ private:
     template <typename T>
     struct is_throw_on_error : std::is_same<T, throw_on_error> {};
 
+    template <typename T>
+    struct is_crlf : std::is_same<T, crlf> {};
+
+    template <typename T>
+    struct is_arena_views : std::is_same<T, arena_views> {};
+
+    template <typename T>
+    struct is_sequential_scan : std::is_same<T, sequential_scan> {};
+
     constexpr static auto count_matcher = count_v<is_matcher, Options...>;
 
     constexpr static auto count_multiline =
         count_v<is_instance_of_multiline, Options...>;
 
+    constexpr static auto count_max_record_bytes =
+        count_v<is_instance_of_max_record_bytes, Options...>;
+
     constexpr static auto count_string_error =
         count_v<is_string_error, Options...>;
 
@@ -229,9 +301,19 @@ private:
     constexpr static auto count_ignore_empty =
         count_v<is_ignore_empty, Options...>;
 
+    constexpr static auto count_crlf = count_v<is_crlf, Options...>;
+
+    constexpr static auto count_arena_views =
+        count_v<is_arena_views, Options...>;
+
+    constexpr static auto count_sequential_scan =
+        count_v<is_sequential_scan, Options...>;
+
     constexpr static auto number_of_valid_setup_types =
-        count_matcher + count_multiline + count_string_error +
-        count_ignore_header + count_ignore_empty + count_throw_on_error;
+        count_matcher + count_multiline + count_max_record_bytes +
+        count_string_error + count_ignore_header + count_ignore_empty +
+        count_throw_on_error + count_crlf + count_arena_views +
+        count_sequential_scan;
 
     using trim_left_only = get_matcher_t<trim_left, Options...>;
     using trim_right_only = get_matcher_t<trim_right, Options...>;
@@ -247,10 +329,15 @@ public:
         std::conditional_t<trim_all::enabled, trim_all, trim_right_only>;
 
     using multiline = get_multiline_t<Options...>;
+    constexpr static size_t max_record_bytes =
+        get_max_record_bytes_t<Options...>::size;
     constexpr static bool string_error = (count_string_error == 1);
     constexpr static bool ignore_header = (count_ignore_header == 1);
     constexpr static bool ignore_empty = (count_ignore_empty == 1);
     constexpr static bool throw_on_error = (count_throw_on_error == 1);
+    constexpr static bool crlf = (count_crlf == 1);
+    constexpr static bool arena_views = (count_arena_views == 1);
+    constexpr static bool sequential_scan = (count_sequential_scan == 1);
 
 private:
 #define ASSERT_MSG "cannot have the same match character in multiple matchers"
@@ -277,12 +364,23 @@ private:
 
     static_assert(count_multiline <= 1, "mutliline defined multiple times");
 
+    static_assert(count_max_record_bytes <= 1,
+                  "max_record_bytes defined multiple times");
+
     static_assert(count_string_error <= 1,
                   "string_error defined multiple times");
 
     static_assert(count_throw_on_error <= 1,
                   "throw_on_error defined multiple times");
 
+    static_assert(count_crlf <= 1, "crlf defined multiple times");
+
+    static_assert(count_arena_views <= 1,
+                  "arena_views defined multiple times");
+
+    static_assert(count_sequential_scan <= 1,
+                  "sequential_scan defined multiple times");
+
     static_assert(count_throw_on_error + count_string_error <= 1,
                   "cannot define both throw_on_error and string_error");
 
@@ -28,6 +28,13 @@ private:
 public:
     using line_ptr_type = std::conditional_t<is_const_line, const char*, char*>;
 
+    splitter() = default;
+
+    // the split data is allocated from the given memory resource
+    explicit splitter(std::pmr::memory_resource* resource)
+        : split_data_{resource_or_default(resource)} {
+    }
+
     [[nodiscard]] bool valid() const {
         if constexpr (string_error) {
             return error_.empty();
@@ -103,8 +110,12 @@ private:
         // if unterminated quote, the last element is junk
         split_data_.pop_back();
 
+        // the ranges only need to be moved if the buffer was reallocated,
+        // which is rare since it grows geometrically
         line_ = new_line;
-        adjust_ranges(old_line);
+        if (line_ != old_line) {
+            adjust_ranges(old_line);
+        }
 
         begin_ = line_ + begin;
         end_ = line_ - old_line + end_ - escaped_;
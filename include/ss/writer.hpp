@@ -0,0 +1,461 @@
+#pragma once
+
+#include "common.hpp"
+#include "converter.hpp"
+#include "exception.hpp"
+#include "insert.hpp"
+#include "setup.hpp"
+#include "type_traits.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace ss {
+
+template <typename... Options>
+class writer {
+    using quote = typename setup<Options...>::quote;
+    using escape = typename setup<Options...>::escape;
+    using trim_left = typename setup<Options...>::trim_left;
+    using trim_right = typename setup<Options...>::trim_right;
+
+    constexpr static auto string_error = setup<Options...>::string_error;
+    constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
+    constexpr static auto crlf = setup<Options...>::crlf;
+
+    using error_type = std::conditional_t<string_error, std::string, bool>;
+
+public:
+    writer(std::string file_name, std::string delim = ss::default_delimiter)
+        : file_name_{std::move(file_name)}, delim_{std::move(delim)},
+          file_{std::fopen(file_name_.c_str(), "wb")} {
+        if (!file_) {
+            handle_error_file_not_open();
+            return;
+        }
+
+        buffer_.reserve(writer_buffer_size);
+        check_delimiter();
+    }
+
+    // rows are appended to the given string instead of a file
+    writer(std::string* csv_data_buffer,
+           std::string delim = ss::default_delimiter)
+        : file_name_{"CSV data buffer"}, delim_{std::move(delim)},
+          csv_data_buffer_{csv_data_buffer} {
+        if (!csv_data_buffer_) {
+            handle_error_null_buffer();
+            return;
+        }
+
+        check_delimiter();
+    }
+
+    writer(writer&& other) noexcept
+        : file_name_{std::move(other.file_name_)},
+          error_{std::move(other.error_)}, delim_{std::move(other.delim_)},
+          file_{other.file_}, csv_data_buffer_{other.csv_data_buffer_},
+          buffer_{std::move(other.buffer_)},
+          field_buffer_{std::move(other.field_buffer_)} {
+        other.file_ = nullptr;
+        other.csv_data_buffer_ = nullptr;
+    }
+
+    writer& operator=(writer&& other) noexcept {
+        if (this != &other) {
+            close();
+            file_name_ = std::move(other.file_name_);
+            error_ = std::move(other.error_);
+            delim_ = std::move(other.delim_);
+            file_ = other.file_;
+            csv_data_buffer_ = other.csv_data_buffer_;
+            buffer_ = std::move(other.buffer_);
+            field_buffer_ = std::move(other.field_buffer_);
+
+            other.file_ = nullptr;
+            other.csv_data_buffer_ = nullptr;
+        }
+
+        return *this;
+    }
+
+    ~writer() {
+        close();
+    }
+
+    writer() = delete;
+    writer(const writer& other) = delete;
+    writer& operator=(const writer& other) = delete;
+
+    [[nodiscard]] bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else if constexpr (throw_on_error) {
+            return true;
+        } else {
+            return !error_;
+        }
+    }
+
+    [[nodiscard]] const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    // writes one row, the values can be given as separate arguments, as
+    // a tuple, or as one object which has a 'tied' method, the row is not
+    // written if any of the values could not be inserted
+    template <typename T, typename... Ts>
+    void write(T&& value, Ts&&... values) {
+        using U = std::decay_t<T>;
+
+        if constexpr (sizeof...(Ts) == 0 && is_instance_of_v<std::tuple, U>) {
+            std::apply([this](auto&&... elems) { write_row(elems...); },
+                       std::forward<T>(value));
+        } else if constexpr (tied_class_v<U, Ts...>) {
+            std::apply([this](auto&&... elems) { write_row(elems...); },
+                       value.tied());
+        } else {
+            write_row(value, values...);
+        }
+    }
+
+    // writes the buffered rows into the file
+    void flush() {
+        if (!file_ || buffer_.empty()) {
+            return;
+        }
+
+        const auto written =
+            std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        const auto size = buffer_.size();
+        buffer_.clear();
+
+        if (written != size) {
+            handle_error_write_failed();
+        }
+    }
+
+private:
+    ////////////////
+    // output
+    ////////////////
+
+    [[nodiscard]] std::string& output() {
+        return file_ ? buffer_ : *csv_data_buffer_;
+    }
+
+    void close() {
+        if (file_) {
+            try {
+                flush();
+            } catch (...) {
+            }
+            std::ignore = std::fclose(file_);
+            file_ = nullptr;
+        }
+    }
+
+    ////////////////
+    // error
+    ////////////////
+
+    void clear_error() {
+        if constexpr (string_error) {
+            error_.clear();
+        } else {
+            error_ = false;
+        }
+    }
+
+    void handle_error_file_not_open() {
+        constexpr static auto error_msg = ": could not be opened";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_null_buffer() {
+        constexpr static auto error_msg = ": received null data buffer";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_write_failed() {
+        constexpr static auto error_msg = ": failed writing to file";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_empty_delimiter() {
+        constexpr static auto error_msg = "empty delimiter";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_invalid_insertion(size_t pos) {
+        constexpr static auto error_msg =
+            "invalid insertion for parameter at column ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg).append(std::to_string(pos + 1));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg + std::to_string(pos + 1)};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_unescapable_field(size_t pos) {
+        constexpr static auto error_msg =
+            "field needs to be quoted or escaped, but neither quote nor "
+            "escape is enabled, at column ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg).append(std::to_string(pos + 1));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg + std::to_string(pos + 1)};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void check_delimiter() {
+        if (delim_.empty()) {
+            handle_error_empty_delimiter();
+        }
+    }
+
+    ////////////////
+    // writing
+    ////////////////
+
+    template <typename... Ts>
+    void write_row(const Ts&... values) {
+        static_assert(sizeof...(Ts) > 0, "at least one value must be given");
+
+        if (!file_ && !csv_data_buffer_) {
+            handle_error_file_not_open();
+            return;
+        }
+
+        clear_error();
+        if (delim_.empty()) {
+            handle_error_empty_delimiter();
+            return;
+        }
+
+        auto& out = output();
+        const size_t row_begin = out.size();
+
+        // rows are written whole or not at all
+        if constexpr (throw_on_error) {
+            try {
+                size_t pos = 0;
+                std::ignore = (write_field(out, values, pos++) && ...);
+            } catch (const ss::exception&) {
+                out.resize(row_begin);
+                throw;
+            }
+        } else {
+            size_t pos = 0;
+            if (!(write_field(out, values, pos++) && ...)) {
+                out.resize(row_begin);
+                return;
+            }
+        }
+
+        if constexpr (crlf) {
+            out.append("\r\n");
+        } else {
+            out.push_back('\n');
+        }
+
+        if (file_ && buffer_.size() >= writer_buffer_size) {
+            flush();
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] bool write_field(std::string& out, const T& value,
+                                   size_t pos) {
+        if (pos != 0) {
+            out.append(delim_);
+        }
+
+        const size_t field_begin = out.size();
+
+        bool inserted = false;
+        if constexpr (std::is_array_v<T>) {
+            inserted = insert(out, std::string_view{value});
+        } else {
+            inserted = insert(out, value);
+        }
+
+        if (!inserted) {
+            handle_error_invalid_insertion(pos);
+            return false;
+        }
+
+        if (needs_escaping(out.data() + field_begin, out.data() + out.size())) {
+            if (!escape_field(out, field_begin)) {
+                handle_error_unescapable_field(pos);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    ////////////////
+    // quoting and escaping
+    ////////////////
+
+    [[nodiscard]] bool is_special(char c) const {
+        // bitwise or instead of logical or, keeps the loop branchless
+        bool special = (c == delim_.front()) | (c == '\n') | (c == '\r');
+        if constexpr (quote::enabled) {
+            for (const char q : quote::matches) {
+                special |= (c == q);
+            }
+        }
+        if constexpr (escape::enabled) {
+            for (const char e : escape::matches) {
+                special |= (c == e);
+            }
+        }
+        return special;
+    }
+
+    // a field needs to be quoted or escaped if it contains the delimiter,
+    // a new line, a quote or an escape character, or if it has leading or
+    // trailing characters which would be trimmed
+    [[nodiscard]] bool needs_escaping(const char* begin,
+                                      const char* end) const {
+        if (begin == end) {
+            return false;
+        }
+
+        if constexpr (trim_left::enabled) {
+            if (trim_left::match(*begin)) {
+                return true;
+            }
+        }
+
+        if constexpr (trim_right::enabled) {
+            if (trim_right::match(*(end - 1))) {
+                return true;
+            }
+        }
+
+        // the scan has no early exit so it can be vectorized
+        bool special = false;
+        for (const char* curr = begin; curr != end; ++curr) {
+            special |= is_special(*curr);
+        }
+        return special;
+    }
+
+    [[nodiscard]] bool escape_field(std::string& out, size_t field_begin) {
+        field_buffer_.assign(out, field_begin);
+        out.resize(field_begin);
+
+        if constexpr (quote::enabled) {
+            // "a"b\c -> """a""b\\c"
+            out.push_back(quote::matches[0]);
+            for (const char c : field_buffer_) {
+                if constexpr (escape::enabled) {
+                    if (escape::match(c)) {
+                        out.push_back(c);
+                    }
+                }
+                if (quote::match(c)) {
+                    out.push_back(c);
+                }
+                out.push_back(c);
+            }
+            out.push_back(quote::matches[0]);
+            return true;
+        } else if constexpr (escape::enabled) {
+            const char* const begin = field_buffer_.data();
+            const char* const end = begin + field_buffer_.size();
+            for (const char* curr = begin; curr != end; ++curr) {
+                if (is_special(*curr) || is_trimmed(begin, end, curr)) {
+                    out.push_back(escape::matches[0]);
+                }
+                out.push_back(*curr);
+            }
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    [[nodiscard]] bool is_trimmed(const char* begin, const char* end,
+                                  const char* curr) const {
+        if constexpr (trim_left::enabled) {
+            if (trim_left::match(*curr) &&
+                std::all_of(begin, curr, [](char c) {
+                    return trim_left::match(c);
+                })) {
+                return true;
+            }
+        }
+
+        if constexpr (trim_right::enabled) {
+            if (trim_right::match(*curr) &&
+                std::all_of(curr, end, [](char c) {
+                    return trim_right::match(c);
+                })) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::string file_name_;
+    error_type error_{};
+    std::string delim_;
+    FILE* file_{nullptr};
+    std::string* csv_data_buffer_{nullptr};
+    std::string buffer_;
+    std::string field_buffer_;
+};
+
+} /* namespace ss */
@@ -6,11 +6,16 @@ headers = ['type_traits.hpp',
            'function_traits.hpp',
            'restrictions.hpp',
            'common.hpp',
+           'byte_source.hpp',
            'setup.hpp',
            'splitter.hpp',
            'extract.hpp',
            'converter.hpp',
-           'parser.hpp']
+           'generator.hpp',
+           'parser.hpp',
+           'multi_parser.hpp',
+           'insert.hpp',
+           'writer.hpp']
 
 combined_file = []
 includes = []
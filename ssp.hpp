@@ -1,19 +1,35 @@
 #pragma once
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cerrno>
 #include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <exception>
 #include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
+#include <random>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 #define SSP_DISABLE_FAST_FLOAT
@@ -622,9 +638,12 @@ struct ne {
 
 } /* namespace ss */
 
-#if !__unix__
-#include <array>
-#include <cstdint>
+#if __unix__ || __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#elif _WIN32
+#include <io.h>
 #endif
 
 namespace ss {
@@ -632,10 +651,15 @@ namespace ss {
 struct none {};
 
 using string_range = std::pair<const char*, const char*>;
-using split_data = std::vector<string_range>;
+using split_data = std::pmr::vector<string_range>;
 
 constexpr inline auto default_delimiter = ",";
 constexpr inline auto get_line_initial_buffer_size = 128;
+constexpr inline auto writer_buffer_size = 1 << 18;
+constexpr inline size_t file_buffer_size = 1 << 18;
+constexpr inline size_t page_cache_drop_size = 1 << 24;
+constexpr inline size_t default_arena_block_size = 1 << 16;
+constexpr inline size_t quote_resync_lines = 64;
 
 template <bool StringError>
 void assert_string_error_defined() {
@@ -658,6 +682,56 @@ void assert_throw_on_error_not_defined() {
     return ptr;
 }
 
+[[nodiscard]] inline std::pmr::memory_resource* resource_or_default(
+    std::pmr::memory_resource* resource) {
+    return resource ? resource : std::pmr::get_default_resource();
+}
+
+// resizes the buffer of 'n' characters to 'new_n' characters keeping its
+// content, the buffer is allocated with 'std::realloc' unless a memory
+// resource is given
+[[nodiscard]] inline char* reallocate_buffer(
+    char* buffer, size_t n, size_t new_n,
+    std::pmr::memory_resource* resource = nullptr) {
+    if (resource == nullptr) {
+        return static_cast<char*>(strict_realloc(buffer, new_n));
+    }
+
+    auto* new_buffer = static_cast<char*>(resource->allocate(new_n, 1));
+    if (buffer != nullptr) {
+        std::memcpy(new_buffer, buffer, std::min(n, new_n));
+        resource->deallocate(buffer, n, 1);
+    }
+    return new_buffer;
+}
+
+inline void free_buffer(char* buffer, size_t n,
+                        std::pmr::memory_resource* resource = nullptr) {
+    if (resource == nullptr) {
+        std::free(buffer);
+    } else if (buffer != nullptr) {
+        resource->deallocate(buffer, n, 1);
+    }
+}
+
+// makes sure the buffer can hold 'size' characters, the buffer grows
+// geometrically, so appending to it has an amortized constant cost
+inline void reserve_buffer(char*& buffer, size_t& n, size_t size,
+                           std::pmr::memory_resource* resource = nullptr) {
+    if (buffer != nullptr && n >= size) {
+        return;
+    }
+
+    const size_t old_n = buffer != nullptr ? n : 0;
+    size_t new_n = std::max<size_t>(n, get_line_initial_buffer_size);
+    while (new_n < size) {
+        new_n *= 2;
+    }
+
+    buffer = reallocate_buffer(buffer, old_n, new_n, resource);
+    n = new_n;
+}
+
 #if __unix__
 [[nodiscard]] inline ssize_t get_line_file(char*& lineptr, size_t& n,
                                            FILE* file) {
@@ -704,55 +778,128 @@ using ssize_t = intptr_t;
 
 #endif
 
-[[nodiscard]] inline ssize_t get_line_buffer(char*& lineptr, size_t& n,
-                                             const char* const csv_data_buffer,
-                                             size_t csv_data_size,
-                                             size_t& curr_char) {
-    if (curr_char >= csv_data_size) {
-        return -1;
+// locks the file while it is read by characters without locking it for each
+// of them
+class file_lock {
+public:
+    explicit file_lock(FILE* file) : file_{file} {
+#if __unix__ || __APPLE__
+        flockfile(file_);
+#elif _WIN32
+        _lock_file(file_);
+#endif
+    }
+
+    ~file_lock() {
+#if __unix__ || __APPLE__
+        funlockfile(file_);
+#elif _WIN32
+        _unlock_file(file_);
+#endif
     }
 
-    if (lineptr == nullptr || n < get_line_initial_buffer_size) {
-        auto* new_lineptr = static_cast<char*>(
-            strict_realloc(lineptr, get_line_initial_buffer_size));
-        lineptr = new_lineptr;
-        n = get_line_initial_buffer_size;
+    file_lock(const file_lock&) = delete;
+    file_lock& operator=(const file_lock&) = delete;
+
+    [[nodiscard]] int get() {
+#if __unix__ || __APPLE__
+        return getc_unlocked(file_);
+#elif _WIN32
+        return _getc_nolock(file_);
+#else
+        return std::getc(file_);
+#endif
     }
 
+private:
+    FILE* file_;
+};
+
+// same as 'get_line_file', but the line is written after the first 'offset'
+// characters of 'lineptr', at most 'max_size' characters of the line are
+// written, the rest of the line is read and dropped, the number of dropped
+// characters is added to 'dropped', returns the number of written characters,
+// 'lineptr' is allocated from 'resource' if one is given, the characters are
+// counted as they are read, so null characters within the line are kept
+[[nodiscard]] inline ssize_t get_line_file(
+    char*& lineptr, size_t& n, FILE* file, size_t offset, size_t max_size,
+    size_t& dropped, std::pmr::memory_resource* resource = nullptr) {
+    reserve_buffer(lineptr, n, offset + 1, resource);
+
     size_t line_used = 0;
-    while (curr_char < csv_data_size) {
-        if (line_used + 1 >= n) {
-            const size_t new_n = n * 2;
+    {
+        file_lock lock{file};
+        for (int c = lock.get(); c != EOF; c = lock.get()) {
+            if (line_used < max_size) {
+                reserve_buffer(lineptr, n, offset + line_used + 2, resource);
+                lineptr[offset + line_used++] = static_cast<char>(c);
+            } else {
+                ++dropped;
+            }
 
-            char* new_lineptr =
-                static_cast<char*>(strict_realloc(lineptr, new_n));
-            n = new_n;
-            lineptr = new_lineptr;
+            if (c == '\n') {
+                break;
+            }
         }
+    }
 
-        auto c = csv_data_buffer[curr_char++];
-        lineptr[line_used++] = c;
-        if (c == '\n') {
-            lineptr[line_used] = '\0';
-            return line_used;
-        }
+    lineptr[offset + line_used] = '\0';
+    return (line_used != 0) ? line_used : -1;
+}
+
+// the line is written after the first 'offset' characters of 'lineptr', at
+// most 'max_size' characters of the line are written and the rest is dropped
+[[nodiscard]] inline ssize_t get_line_buffer(
+    char*& lineptr, size_t& n, const char* const csv_data_buffer,
+    size_t csv_data_size, size_t& curr_char, size_t offset = 0,
+    size_t max_size = std::numeric_limits<size_t>::max(),
+    std::pmr::memory_resource* resource = nullptr) {
+    if (curr_char >= csv_data_size) {
+        return -1;
     }
 
-    lineptr[line_used] = '\0';
-    return line_used;
+    const char* const begin = csv_data_buffer + curr_char;
+    const size_t left = csv_data_size - curr_char;
+    const auto* new_line =
+        static_cast<const char*>(std::memchr(begin, '\n', left));
+    const size_t read = new_line ? new_line - begin + 1 : left;
+    const size_t size = std::min(read, max_size);
+
+    reserve_buffer(lineptr, n, offset + size + 1, resource);
+    std::memcpy(lineptr + offset, begin, size);
+    lineptr[offset + size] = '\0';
+
+    curr_char += read;
+    return size;
 }
 
+// the line is written after the first 'offset' characters of 'buffer', at
+// most 'max_size' characters of the line are kept, the rest is dropped, the
+// buffer is allocated from 'resource' if one is given
 [[nodiscard]] inline std::tuple<ssize_t, bool> get_line(
     char*& buffer, size_t& buffer_size, FILE* file,
     const char* const csv_data_buffer, size_t csv_data_size,
-    size_t& curr_char) {
+    size_t& curr_char, size_t offset = 0,
+    size_t max_size = std::numeric_limits<size_t>::max(),
+    std::pmr::memory_resource* resource = nullptr) {
     ssize_t ssize = 0;
     if (file) {
-        ssize = get_line_file(buffer, buffer_size, file);
-        curr_char += ssize;
+        size_t dropped = 0;
+        if (offset == 0 && max_size == std::numeric_limits<size_t>::max() &&
+            resource == nullptr) {
+            ssize = get_line_file(buffer, buffer_size, file);
+        } else {
+            ssize = get_line_file(buffer, buffer_size, file, offset, max_size,
+                                  dropped, resource);
+        }
+
+        if (ssize > 0) {
+            curr_char += ssize + dropped;
+        }
     } else {
         ssize = get_line_buffer(buffer, buffer_size, csv_data_buffer,
-                                csv_data_size, curr_char);
+                                csv_data_size, curr_char, offset, max_size,
+                                resource);
     }
 
     if (ssize == -1) {
@@ -765,1190 +912,1326 @@ using ssize_t = intptr_t;
     return {ssize, false};
 }
 
-} /* namespace ss */
+// opens a duplicate of the file descriptor, so closing the returned file
+// does not close the given descriptor
+[[nodiscard]] inline FILE* open_file_descriptor(int fd) {
+#if __unix__ || __APPLE__
+    const int copy = dup(fd);
+    if (copy == -1) {
+        return nullptr;
+    }
 
-namespace ss {
+    FILE* file = fdopen(copy, "rb");
+    if (!file) {
+        std::ignore = close(copy);
+    }
+    return file;
+#elif _WIN32
+    const int copy = _dup(fd);
+    if (copy == -1) {
+        return nullptr;
+    }
+
+    FILE* file = _fdopen(copy, "rb");
+    if (!file) {
+        std::ignore = _close(copy);
+    }
+    return file;
+#else
+    std::ignore = fd;
+    return nullptr;
+#endif
+}
 
 ////////////////
-// matcher
+// access hints
 ////////////////
 
-template <char... Cs>
-struct matcher {
-private:
-    template <char X, char... Xs>
-    static bool match_impl(char c) {
-        if constexpr (sizeof...(Xs) != 0) {
-            return (c == X) || match_impl<Xs...>(c);
-        }
-        return (c == X);
-    }
+// the hints are only given where they are supported, they do not change
+// the read data
 
-    constexpr static bool contains_string_terminator() {
-        for (const auto& match : matches) {
-            if (match == '\0') {
-                return false;
-            }
-        }
-        return true;
-    }
+inline void advise_sequential_file(int fd) {
+#ifdef POSIX_FADV_SEQUENTIAL
+    std::ignore = posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    std::ignore = fd;
+#endif
+}
 
-public:
-    static bool match(char c) {
-        return match_impl<Cs...>(c);
+inline void advise_sequential_file(FILE* file) {
+#ifdef POSIX_FADV_SEQUENTIAL
+    advise_sequential_file(fileno(file));
+#else
+    std::ignore = file;
+#endif
+}
+
+// the pages of [begin, end) are dropped from the page cache
+inline void advise_dont_need_file(int fd, size_t begin, size_t end) {
+#ifdef POSIX_FADV_DONTNEED
+    if (end > begin) {
+        std::ignore = posix_fadvise(fd, static_cast<off_t>(begin),
+                                    static_cast<off_t>(end - begin),
+                                    POSIX_FADV_DONTNEED);
     }
+#else
+    std::ignore = fd;
+    std::ignore = begin;
+    std::ignore = end;
+#endif
+}
 
-    constexpr static bool enabled = true;
-    constexpr static std::array<char, sizeof...(Cs)> matches{Cs...};
-    static_assert(contains_string_terminator(),
-                  "string terminator cannot be used as a match character");
-};
+inline void advise_dont_need_file(FILE* file, size_t begin, size_t end) {
+#ifdef POSIX_FADV_DONTNEED
+    advise_dont_need_file(fileno(file), begin, end);
+#else
+    std::ignore = file;
+    std::ignore = begin;
+    std::ignore = end;
+#endif
+}
 
-template <typename FirstMatcher, typename SecondMatcher>
-inline constexpr bool matches_intersect() {
-    for (const auto& first_match : FirstMatcher::matches) {
-        for (const auto& second_match : SecondMatcher::matches) {
-            if (first_match != '\0' && first_match == second_match) {
-                return true;
-            }
-        }
-    }
-    return false;
+// the pages of a memory mapped file are read ahead aggressively, and backed
+// by huge pages if possible, the hints apply to whole pages, so it is not
+// used by the parser, which does not know how a given buffer was allocated,
+// it needs to be called explicitly with the mapped memory
+inline void advise_sequential_buffer(const char* buffer, size_t size) {
+#if __unix__ || __APPLE__
+    const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    if (!buffer || size == 0 || page_size == 0) {
+        return;
+    }
+
+    const auto begin =
+        reinterpret_cast<uintptr_t>(buffer) / page_size * page_size;
+    const auto end = reinterpret_cast<uintptr_t>(buffer) + size;
+    auto* address = reinterpret_cast<void*>(begin);
+
+    std::ignore = madvise(address, end - begin, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    std::ignore = madvise(address, end - begin, MADV_HUGEPAGE);
+#endif
+#else
+    std::ignore = buffer;
+    std::ignore = size;
+#endif
 }
 
-template <typename FirstMatcher, typename SecondMatcher1,
-          typename SecondMatcher2>
-inline constexpr bool matches_intersect_union() {
-    return matches_intersect<FirstMatcher, SecondMatcher1>() ||
-           matches_intersect<FirstMatcher, SecondMatcher2>();
+[[nodiscard]] inline bool seek_file(FILE* file, size_t position) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(position), SEEK_SET) == 0;
+#else
+    return std::fseek(file, static_cast<long>(position), SEEK_SET) == 0;
+#endif
 }
 
-template <>
-class matcher<'\0'> {
-public:
-    constexpr static bool enabled = false;
-    constexpr static std::array<char, 1> matches{'\0'};
-    static bool match(char c) = delete;
-};
+// the position within the file is kept
+[[nodiscard]] inline size_t file_size(FILE* file) {
+#ifdef _WIN32
+    const auto position = _ftelli64(file);
+    std::ignore = _fseeki64(file, 0, SEEK_END);
+    const auto size = _ftelli64(file);
+    std::ignore = _fseeki64(file, position, SEEK_SET);
+#else
+    const auto position = std::ftell(file);
+    std::ignore = std::fseek(file, 0, SEEK_END);
+    const auto size = std::ftell(file);
+    std::ignore = std::fseek(file, position, SEEK_SET);
+#endif
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
 
-////////////////
-// setup
-////////////////
+} /* namespace ss */
 
-////////////////
-// matcher
-////////////////
 
-template <char C>
-struct quote : matcher<C> {};
+#if !defined(SSP_DISABLE_ZLIB) && __has_include(<zlib.h>)
+#include <zlib.h>
+#define SSP_ZLIB_ENABLED
+#endif
 
-template <char... Cs>
-struct trim : matcher<Cs...> {};
+#if !defined(SSP_DISABLE_ZSTD) && __has_include(<zstd.h>)
+#include <zstd.h>
+#define SSP_ZSTD_ENABLED
+#endif
 
-template <char... Cs>
-struct trim_left : matcher<Cs...> {};
+#if !defined(SSP_DISABLE_IO_URING) && defined(__linux__) &&                    \
+    __has_include(<linux/io_uring.h>)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define SSP_IO_URING_ENABLED
+#endif
 
-template <char... Cs>
-struct trim_right : matcher<Cs...> {};
+namespace ss {
 
-template <char... Cs>
-struct escape : matcher<Cs...> {};
+////////////////
+// byte source
+////////////////
 
-template <typename T, template <char...> class Template>
-struct is_instance_of_matcher : std::false_type {};
+// the data read by a parser, 'read' fills the given buffer and returns the
+// number of bytes written into it, 0 at the end of the data, or -1 if the
+// data could not be read, 'name' is used within error messages
+struct byte_source {
+    std::function<ssize_t(char* data, size_t size)> read;
+    std::string name{"byte source"};
+};
 
-template <char... Ts, template <char...> class Template>
-struct is_instance_of_matcher<Template<Ts...>, Template> : std::true_type {};
+////////////////
+// read ahead
+////////////////
 
-template <typename T, template <char...> class Template>
-using is_instance_of_matcher_t =
-    typename is_instance_of_matcher<T, Template>::type;
+// reads blocks from a source on a separate thread, at most two blocks are
+// read ahead of the block being consumed
+class read_ahead_state {
+    struct block {
+        std::vector<char> data;
+        ssize_t size{0};
+    };
 
-template <template <char...> class Matcher, typename... Ts>
-struct get_matcher;
+public:
+    read_ahead_state(byte_source source, size_t block_size)
+        : source_{std::move(source)} {
+        for (size_t i = 0; i < 2; ++i) {
+            free_.emplace_back(std::max<size_t>(block_size, 1));
+        }
+        thread_ = std::thread{[this] { produce(); }};
+    }
 
-template <template <char...> class Matcher, typename T, typename... Ts>
-struct get_matcher<Matcher, T, Ts...> {
+    ~read_ahead_state() {
+        {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+        }
+        condition_.notify_all();
+        thread_.join();
+    }
 
-    template <typename U>
-    struct is_matcher : is_instance_of_matcher<U, Matcher> {};
+    read_ahead_state(const read_ahead_state& other) = delete;
+    read_ahead_state& operator=(const read_ahead_state& other) = delete;
 
-    static_assert(count_v<is_matcher, T, Ts...> <= 1,
-                  "the same matcher cannot "
-                  "be defined multiple times");
-    using type = std::conditional_t<is_matcher<T>::value, T,
-                                    typename get_matcher<Matcher, Ts...>::type>;
-};
+    [[nodiscard]] ssize_t read(char* data, size_t size) {
+        if (end_) {
+            return current_.size;
+        }
 
-template <template <char...> class Matcher>
-struct get_matcher<Matcher> {
-    using type = Matcher<'\0'>;
-};
+        while (position_ == static_cast<size_t>(current_.size)) {
+            std::unique_lock lock{mutex_};
+            if (!current_.data.empty()) {
+                free_.push_back(std::move(current_.data));
+                condition_.notify_all();
+            }
 
-template <template <char...> class Matcher, typename... Ts>
-using get_matcher_t = typename get_matcher<Matcher, Ts...>::type;
+            condition_.wait(lock, [this] { return !ready_.empty(); });
+            current_ = std::move(ready_.front());
+            ready_.pop_front();
+            position_ = 0;
 
-////////////////
-// multiline
-////////////////
+            if (current_.size <= 0) {
+                end_ = true;
+                if (exception_) {
+                    std::rethrow_exception(std::exchange(exception_, nullptr));
+                }
+                return current_.size;
+            }
+        }
 
-template <size_t S, bool B = true>
-struct multiline_restricted {
-    constexpr static auto size = S;
-    constexpr static auto enabled = B;
-};
+        const auto n =
+            std::min(size, static_cast<size_t>(current_.size) - position_);
+        std::memcpy(data, current_.data.data() + position_, n);
+        position_ += n;
+        return static_cast<ssize_t>(n);
+    }
 
-using multiline = multiline_restricted<0>;
+private:
+    void produce() {
+        while (true) {
+            std::vector<char> data;
+            {
+                std::unique_lock lock{mutex_};
+                condition_.wait(lock, [this] { return stop_ || !free_.empty(); });
+                if (stop_) {
+                    return;
+                }
+                data = std::move(free_.back());
+                free_.pop_back();
+            }
 
-template <typename T>
-struct is_instance_of_multiline : std::false_type {};
+            ssize_t last = 1;
+            size_t size = 0;
+            try {
+                while (size < data.size()) {
+                    last = source_.read(data.data() + size, data.size() - size);
+                    if (last <= 0) {
+                        break;
+                    }
+                    size += static_cast<size_t>(last);
+                }
+            } catch (...) {
+                std::lock_guard lock{mutex_};
+                exception_ = std::current_exception();
+                last = -1;
+            }
 
-template <size_t S, bool B>
-struct is_instance_of_multiline<multiline_restricted<S, B>> : std::true_type {};
+            {
+                std::lock_guard lock{mutex_};
+                if (size > 0) {
+                    ready_.push_back({std::move(data), static_cast<ssize_t>(size)});
+                }
+                if (last <= 0) {
+                    // the end, or the error, is given as an empty block
+                    ready_.push_back({{}, last < 0 ? -1 : 0});
+                }
+            }
+            condition_.notify_all();
 
-template <typename T>
-using is_instance_of_multiline_t = typename is_instance_of_multiline<T>::type;
+            if (last <= 0) {
+                return;
+            }
+        }
+    }
 
-template <typename... Ts>
-struct get_multiline;
+    byte_source source_;
 
-template <typename T, typename... Ts>
-struct get_multiline<T, Ts...> {
-    using type = std::conditional_t<is_instance_of_multiline<T>::value, T,
-                                    typename get_multiline<Ts...>::type>;
-};
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<block> ready_;
+    std::vector<std::vector<char>> free_;
+    std::exception_ptr exception_;
+    bool stop_{false};
 
-template <>
-struct get_multiline<> {
-    using type = multiline_restricted<0, false>;
+    block current_;
+    size_t position_{0};
+    bool end_{false};
+
+    std::thread thread_;
 };
 
-template <typename... Ts>
-using get_multiline_t = typename get_multiline<Ts...>::type;
+// the returned source reads the given one on a separate thread, so the
+// next block is produced, for example decompressed, while the previous
+// one is being parsed, copies of the returned source share its state
+[[nodiscard]] inline byte_source read_ahead(
+    byte_source source, size_t block_size = file_buffer_size) {
+    if (!source.read) {
+        return source;
+    }
+
+    auto name = source.name;
+    auto state = std::make_shared<read_ahead_state>(std::move(source),
+                                                            block_size);
+    return {[state](char* data, size_t size) {
+                return state->read(data, size);
+            },
+            std::move(name)};
+}
 
 ////////////////
-// string_error
+// compressed sources
 ////////////////
 
-class string_error {};
+#ifdef SSP_ZLIB_ENABLED
+
+// reads a gzip compressed file, or an uncompressed one, the data is
+// decompressed on a separate thread, the returned source has no 'read'
+// function if the file could not be opened
+[[nodiscard]] inline byte_source gzip_source(const std::string& file_name) {
+    std::shared_ptr<gzFile_s> file{gzopen(file_name.c_str(), "rb"),
+                                   [](gzFile file) {
+                                       if (file) {
+                                           std::ignore = gzclose(file);
+                                       }
+                                   }};
+    if (!file) {
+        return {nullptr, file_name};
+    }
+
+    std::ignore = gzbuffer(file.get(), file_buffer_size);
+
+    byte_source source{[file](char* data, size_t size) -> ssize_t {
+                           constexpr size_t max_size = 1 << 30;
+                           const auto n = gzread(file.get(), data,
+                                                 static_cast<unsigned>(std::min(
+                                                     size, max_size)));
+                           if (n == 0) {
+                               int error = Z_OK;
+                               std::ignore = gzerror(file.get(), &error);
+                               // truncated data
+                               return error == Z_OK ? 0 : -1;
+                           }
+                           return n;
+                       },
+                       file_name};
+
+    return read_ahead(std::move(source));
+}
 
-////////////////
-// ignore_header
-////////////////
+#endif
 
-class ignore_header {};
+#ifdef SSP_ZSTD_ENABLED
 
-////////////////
-// ignore_empty
-////////////////
+struct zstd_state {
+    zstd_state(FILE* file)
+        : file{file}, context{ZSTD_createDCtx()},
+          input_data(ZSTD_DStreamInSize()) {
+    }
 
-class ignore_empty {};
+    ~zstd_state() {
+        std::ignore = std::fclose(file);
+        std::ignore = ZSTD_freeDCtx(context);
+    }
 
-////////////////
-// throw_on_error
-////////////////
+    zstd_state(const zstd_state& other) = delete;
+    zstd_state& operator=(const zstd_state& other) = delete;
 
-class throw_on_error {};
+    [[nodiscard]] ssize_t read(char* data, size_t size) {
+        ZSTD_outBuffer output{data, size, 0};
+        while (output.pos < output.size) {
+            // the data left within the context is flushed first
+            if (input.pos == input.size && !flush) {
+                input.size = std::fread(input_data.data(), 1,
+                                        input_data.size(), file);
+                input.pos = 0;
+                if (input.size == 0) {
+                    break;
+                }
+            }
 
-////////////////
-// setup implementation
-////////////////
+            last = ZSTD_decompressStream(context, &output, &input);
+            if (ZSTD_isError(last)) {
+                return -1;
+            }
+            flush = output.pos == output.size;
+        }
 
-template <typename... Options>
-struct setup {
-private:
-    template <typename Option>
-    struct is_matcher
-        : std::disjunction<is_instance_of_matcher_t<Option, quote>,
-                           is_instance_of_matcher_t<Option, escape>,
-                           is_instance_of_matcher_t<Option, trim>,
-                           is_instance_of_matcher_t<Option, trim_left>,
-                           is_instance_of_matcher_t<Option, trim_right>> {};
+        if (output.pos == 0 && (last != 0 || std::ferror(file))) {
+            // truncated or unreadable data
+            return -1;
+        }
+        return static_cast<ssize_t>(output.pos);
+    }
 
-    template <typename T>
-    struct is_string_error : std::is_same<T, string_error> {};
+    FILE* file;
+    ZSTD_DCtx* context;
+    std::vector<char> input_data;
+    ZSTD_inBuffer input{input_data.data(), 0, 0};
+    size_t last{0};
+    bool flush{false};
+};
 
-    template <typename T>
-    struct is_ignore_header : std::is_same<T, ignore_header> {};
+// reads a zstd compressed file, the data is decompressed on a separate
+// thread, the returned source has no 'read' function if the file could not
+// be opened
+[[nodiscard]] inline byte_source zstd_source(const std::string& file_name) {
+    FILE* file = std::fopen(file_name.c_str(), "rb");
+    if (!file) {
+        return {nullptr, file_name};
+    }
 
-    template <typename T>
-    struct is_ignore_empty : std::is_same<T, ignore_empty> {};
+    auto state = std::make_shared<zstd_state>(file);
+    if (!state->context) {
+        return {nullptr, file_name};
+    }
 
-    template <typename T>
-    struct is_throw_on_error : std::is_same<T, throw_on_error> {};
+    byte_source source{[state](char* data, size_t size) {
+                           return state->read(data, size);
+                       },
+                       file_name};
 
-    constexpr static auto count_matcher = count_v<is_matcher, Options...>;
+    return read_ahead(std::move(source));
+}
 
-    constexpr static auto count_multiline =
-        count_v<is_instance_of_multiline, Options...>;
+#endif
 
-    constexpr static auto count_string_error =
-        count_v<is_string_error, Options...>;
+////////////////
+// io_uring source
+////////////////
 
-    constexpr static auto count_ignore_header =
-        count_v<is_ignore_header, Options...>;
+#ifdef SSP_IO_URING_ENABLED
 
-    constexpr static auto count_throw_on_error =
-        count_v<is_throw_on_error, Options...>;
+// options of 'ss::uring_source'
+struct uring_options {
+    // size of each read, rounded up to a multiple of 4096
+    size_t block_size{1 << 20};
 
-    constexpr static auto count_ignore_empty =
-        count_v<is_ignore_empty, Options...>;
+    // number of reads kept in flight, 0 reads the file using 'pread'
+    unsigned queue_depth{4};
 
-    constexpr static auto number_of_valid_setup_types =
-        count_matcher + count_multiline + count_string_error +
-        count_ignore_header + count_ignore_empty + count_throw_on_error;
+    // the page cache is bypassed using 'O_DIRECT' if the file system
+    // supports it
+    bool direct{false};
 
-    using trim_left_only = get_matcher_t<trim_left, Options...>;
-    using trim_right_only = get_matcher_t<trim_right, Options...>;
-    using trim_all = get_matcher_t<trim, Options...>;
+    // the file is read once, the blocks which were consumed are dropped
+    // from the page cache
+    bool sequential_scan{false};
+};
 
-public:
-    using quote = get_matcher_t<quote, Options...>;
-    using escape = get_matcher_t<escape, Options...>;
+// reads the blocks of a file in order while keeping the reads of the
+// following blocks in flight, each block has its own buffer which is
+// registered with the ring if possible, if the ring could not be set up the
+// blocks are read using 'pread'
+class uring_state {
+    constexpr static size_t alignment = 4096;
 
-    using trim_left =
-        std::conditional_t<trim_all::enabled, trim_all, trim_left_only>;
-    using trim_right =
-        std::conditional_t<trim_all::enabled, trim_all, trim_right_only>;
+public:
+    uring_state(int fd, const uring_options& options)
+        : fd_{fd}, block_size_{(std::max<size_t>(options.block_size, 1) +
+                                alignment - 1) /
+                               alignment * alignment},
+          depth_{std::max(options.queue_depth, 1u)},
+          sequential_scan_{options.sequential_scan} {
+        if (sequential_scan_) {
+            advise_sequential_file(fd_);
+        }
 
-    using multiline = get_multiline_t<Options...>;
-    constexpr static bool string_error = (count_string_error == 1);
-    constexpr static bool ignore_header = (count_ignore_header == 1);
-    constexpr static bool ignore_empty = (count_ignore_empty == 1);
-    constexpr static bool throw_on_error = (count_throw_on_error == 1);
+        struct stat status {};
+        if (fstat(fd_, &status) == 0 && status.st_size > 0) {
+            file_size_ = static_cast<size_t>(status.st_size);
+        }
 
-private:
-#define ASSERT_MSG "cannot have the same match character in multiple matchers"
-    static_assert(!matches_intersect<escape, quote>(), ASSERT_MSG);
+        buffers_.reserve(depth_);
+        for (unsigned i = 0; i < depth_; ++i) {
+            void* buffer = std::aligned_alloc(alignment, block_size_);
+            if (!buffer) {
+                free_buffers();
+                std::ignore = close(fd_);
+                throw std::bad_alloc{};
+            }
+            buffers_.push_back(static_cast<char*>(buffer));
+            iovecs_.push_back({buffer, block_size_});
+        }
 
-    constexpr static auto quote_trim_intersect =
-        matches_intersect_union<quote, trim_left, trim_right>();
-    static_assert(!quote_trim_intersect, ASSERT_MSG);
+        results_.resize(depth_);
+        done_.resize(depth_);
 
-    constexpr static auto escape_trim_intersect =
-        matches_intersect_union<escape, trim_left, trim_right>();
-    static_assert(!escape_trim_intersect, ASSERT_MSG);
+        if (options.queue_depth > 0 && setup_ring()) {
+            for (unsigned i = 0; i < depth_; ++i) {
+                submit(i);
+            }
+        }
+    }
 
-#undef ASSERT_MSG
+    ~uring_state() {
+        // the buffers may not be freed while reads into them are in flight
+        while (in_flight_ > 0 && reap()) {
+        }
 
-    static_assert(
-        !multiline::enabled ||
-            (multiline::enabled && (quote::enabled || escape::enabled)),
-        "to enable multiline either quote or escape needs to be enabled");
+        close_ring();
+        free_buffers();
+        std::ignore = close(fd_);
+    }
 
-    static_assert(!(trim_all::enabled && trim_left_only::enabled) &&
-                      !(trim_all::enabled && trim_right_only::enabled),
-                  "ambiguous trim setup");
+    uring_state(const uring_state& other) = delete;
+    uring_state& operator=(const uring_state& other) = delete;
 
-    static_assert(count_multiline <= 1, "mutliline defined multiple times");
+    [[nodiscard]] ssize_t read(char* data, size_t size) {
+        while (position_ == current_size_) {
+            if (end_ || !next_block()) {
+                return status_;
+            }
+        }
 
-    static_assert(count_string_error <= 1,
-                  "string_error defined multiple times");
+        const auto n = std::min(size, current_size_ - position_);
+        std::memcpy(data, buffers_[current_block_ % depth_] + position_, n);
+        position_ += n;
+        return static_cast<ssize_t>(n);
+    }
 
-    static_assert(count_throw_on_error <= 1,
-                  "throw_on_error defined multiple times");
+private:
+    ////////////////
+    // blocks
+    ////////////////
 
-    static_assert(count_throw_on_error + count_string_error <= 1,
-                  "cannot define both throw_on_error and string_error");
+    // makes the next block current, short reads are completed using
+    // 'pread', returns false at the end of the file or on error
+    [[nodiscard]] bool next_block() {
+        if (loaded_) {
+            if (last_) {
+                end_ = true;
+                return false;
+            }
 
-    static_assert(number_of_valid_setup_types == sizeof...(Options),
-                  "one or multiple invalid setup parameters defined");
-};
+            if (sequential_scan_) {
+                const auto begin = current_block_ * block_size_;
+                advise_dont_need_file(fd_, begin, begin + current_size_);
+            }
 
-template <typename... Options>
-struct setup<setup<Options...>> : setup<Options...> {};
+            // the buffer of the consumed block is used for the block which
+            // is 'depth_' blocks ahead
+            submit(current_block_ + depth_);
+            ++current_block_;
+        }
+        loaded_ = true;
 
-template <typename... Options>
-struct setup<std::tuple<Options...>> : setup<Options...> {};
+        const auto buffer = current_block_ % depth_;
+        const auto offset = current_block_ * block_size_;
 
-} /* namespace ss */
+        ssize_t result = ring_fd_ != -1 ? wait(buffer) : 0;
+        size_t size = result > 0 ? static_cast<size_t>(result) : 0;
 
-namespace ss {
+        while (result >= 0 && size < block_size_ && offset + size < file_size_) {
+            const auto n = pread(fd_, buffers_[buffer] + size,
+                                 block_size_ - size, offset + size);
+            if (n == 0 || (n < 0 && errno != EINTR)) {
+                result = n;
+                break;
+            }
+            size += n > 0 ? static_cast<size_t>(n) : 0;
+        }
 
-template <typename... Options>
-class splitter {
-private:
-    using quote = typename setup<Options...>::quote;
-    using trim_left = typename setup<Options...>::trim_left;
-    using trim_right = typename setup<Options...>::trim_right;
-    using escape = typename setup<Options...>::escape;
-    using multiline = typename setup<Options...>::multiline;
+        position_ = current_size_ = 0;
+        if (result < 0) {
+            status_ = -1;
+            end_ = true;
+            return false;
+        }
 
-    constexpr static auto string_error = setup<Options...>::string_error;
-    constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
-    constexpr static auto is_const_line = !quote::enabled && !escape::enabled;
+        current_size_ = size;
+        last_ = size < block_size_;
+        if (size == 0) {
+            end_ = true;
+            return false;
+        }
+        return true;
+    }
 
-    using error_type = std::conditional_t<string_error, std::string, bool>;
+    ////////////////
+    // ring
+    ////////////////
 
-public:
-    using line_ptr_type = std::conditional_t<is_const_line, const char*, char*>;
+    [[nodiscard]] bool setup_ring() {
+        io_uring_params params{};
+        ring_fd_ = static_cast<int>(
+            syscall(__NR_io_uring_setup, depth_, &params));
+        if (ring_fd_ < 0) {
+            ring_fd_ = -1;
+            return false;
+        }
 
-    [[nodiscard]] bool valid() const {
-        if constexpr (string_error) {
-            return error_.empty();
-        } else if constexpr (throw_on_error) {
-            return true;
-        } else {
-            return !error_;
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
         }
-    }
 
-    [[nodiscard]] const std::string& error_msg() const {
-        assert_string_error_defined<string_error>();
-        return error_;
-    }
+        sq_ = map(sq_size_, IORING_OFF_SQ_RING);
+        cq_ = single_mmap ? sq_ : map(cq_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
 
-    [[nodiscard]] bool unterminated_quote() const {
-        return unterminated_quote_;
-    }
+        if (!sq_ || !cq_ || !sqes_) {
+            close_ring();
+            return false;
+        }
 
-    const split_data& split(line_ptr_type new_line,
-                            const std::string& delimiter = default_delimiter) {
-        split_data_.clear();
-        line_ = new_line;
-        begin_ = line_;
-        return split_impl_select_delim(delimiter);
-    }
+        auto* sq = static_cast<char*>(sq_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
 
-    [[nodiscard]] const split_data& get_split_data() const {
-        return split_data_;
-    }
+        auto* cq = static_cast<char*>(cq_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
 
-    void clear_split_data() {
-        split_data_.clear();
+        fixed_ = syscall(__NR_io_uring_register, ring_fd_,
+                         IORING_REGISTER_BUFFERS, iovecs_.data(),
+                         depth_) == 0;
+        return true;
     }
 
-private:
-    ////////////////
-    // resplit
-    ////////////////
-
-    // number of characters the end of line is shifted backwards
-    [[nodiscard]] size_t size_shifted() const {
-        return escaped_;
+    [[nodiscard]] void* map(size_t size, off_t offset) const {
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
     }
 
-    void adjust_ranges(const char* old_line) {
-        for (auto& [begin, end] : split_data_) {
-            begin = begin - old_line + line_;
-            end = end - old_line + line_;
+    void close_ring() {
+        if (ring_fd_ == -1) {
+            return;
         }
-    }
-
-    const split_data& resplit(
-        line_ptr_type new_line, ssize_t new_size,
-        const std::string& delimiter = default_delimiter) {
 
-        // resplitting, continue from last slice
-        if (!quote::enabled || !multiline::enabled || split_data_.empty() ||
-            !unterminated_quote()) {
-            handle_error_invalid_resplit();
-            return split_data_;
+        if (sqes_) {
+            std::ignore = munmap(sqes_, sqes_size_);
         }
+        if (cq_ && cq_ != sq_) {
+            std::ignore = munmap(cq_, cq_size_);
+        }
+        if (sq_) {
+            std::ignore = munmap(sq_, sq_size_);
+        }
+        std::ignore = close(ring_fd_);
+        ring_fd_ = -1;
+    }
 
-        const auto [old_line, old_begin] = *std::prev(split_data_.end());
-        const size_t begin = old_begin - old_line - 1;
+    void submit(size_t block) {
+        const auto buffer = block % depth_;
+        const auto offset = block * block_size_;
+        done_[buffer] = false;
 
-        // safety measure
-        if (new_size != -1 && static_cast<size_t>(new_size) < begin) {
-            handle_error_invalid_resplit();
-            return split_data_;
+        if (ring_fd_ == -1) {
+            return;
         }
 
-        // if unterminated quote, the last element is junk
-        split_data_.pop_back();
+        if (offset >= file_size_) {
+            complete(buffer, 0);
+            return;
+        }
 
-        line_ = new_line;
-        adjust_ranges(old_line);
+        const unsigned tail = *sq_tail_;
+        const unsigned index = tail & sq_mask_;
+
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.fd = fd_;
+        sqe.off = offset;
+        sqe.user_data = buffer;
+        if (fixed_) {
+            sqe.opcode = IORING_OP_READ_FIXED;
+            sqe.addr = reinterpret_cast<uintptr_t>(buffers_[buffer]);
+            sqe.len = static_cast<unsigned>(block_size_);
+            sqe.buf_index = static_cast<uint16_t>(buffer);
+        } else {
+            sqe.opcode = IORING_OP_READV;
+            sqe.addr = reinterpret_cast<uintptr_t>(&iovecs_[buffer]);
+            sqe.len = 1;
+        }
 
-        begin_ = line_ + begin;
-        end_ = line_ - old_line + end_ - escaped_;
-        curr_ = end_;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
 
-        resplitting_ = true;
+        long submitted = -1;
+        do {
+            submitted =
+                syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0);
+        } while (submitted < 0 && errno == EINTR);
 
-        return split_impl_select_delim(delimiter);
+        if (submitted == 1) {
+            ++in_flight_;
+        } else {
+            complete(buffer, -1);
+        }
     }
 
-    ////////////////
-    // error
-    ////////////////
+    void complete(size_t buffer, ssize_t result) {
+        results_[buffer] = result;
+        done_[buffer] = true;
+    }
 
-    void clear_error() {
-        if constexpr (string_error) {
-            error_.clear();
-        } else if constexpr (!throw_on_error) {
-            error_ = false;
+    // waits for the read into the given buffer
+    [[nodiscard]] ssize_t wait(size_t buffer) {
+        while (!done_[buffer]) {
+            if (!reap()) {
+                return -1;
+            }
         }
-        unterminated_quote_ = false;
+        return results_[buffer];
     }
 
-    void handle_error_empty_delimiter() {
-        constexpr static auto error_msg = "empty delimiter";
+    // takes the available completions, or waits for one
+    [[nodiscard]] bool reap() {
+        unsigned head = *cq_head_;
+        const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(error_msg);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg};
-        } else {
-            error_ = true;
+        if (head == tail) {
+            const auto result = syscall(__NR_io_uring_enter, ring_fd_, 0, 1,
+                                        IORING_ENTER_GETEVENTS, nullptr, 0);
+            return result >= 0 || errno == EINTR;
         }
-    }
-
-    void handle_error_mismatched_quote(size_t n) {
-        constexpr static auto error_msg = "mismatched quote at position: ";
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(error_msg + std::to_string(n));
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg + std::to_string(n)};
-        } else {
-            error_ = true;
+        for (; head != tail; ++head) {
+            const auto& cqe = cqes_[head & cq_mask_];
+            complete(cqe.user_data, cqe.res);
+            --in_flight_;
         }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return true;
     }
 
-    void handle_error_unterminated_escape() {
-        constexpr static auto error_msg =
-            "unterminated escape at the end of the line";
-
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(error_msg);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg};
-        } else {
-            error_ = true;
+    void free_buffers() {
+        for (auto* buffer : buffers_) {
+            std::free(buffer);
         }
+        buffers_.clear();
     }
 
-    void handle_error_unterminated_quote() {
-        constexpr static auto error_msg = "unterminated quote";
-
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(error_msg);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg};
-        } else {
-            error_ = true;
-        }
-    }
+    ////////////////
+    // members
+    ////////////////
 
-    void handle_error_invalid_resplit() {
-        constexpr static auto error_msg =
-            "invalid resplit, new line must be longer"
-            "than the end of the last slice";
+    int fd_;
+    size_t file_size_{0};
+    size_t block_size_;
+    unsigned depth_;
+    bool sequential_scan_;
+
+    std::vector<char*> buffers_;
+    std::vector<iovec> iovecs_;
+    std::vector<ssize_t> results_;
+    std::vector<bool> done_;
+
+    size_t current_block_{0};
+    size_t current_size_{0};
+    size_t position_{0};
+    ssize_t status_{0};
+    bool loaded_{false};
+    bool last_{false};
+    bool end_{false};
+
+    int ring_fd_{-1};
+    bool fixed_{false};
+    size_t in_flight_{0};
+
+    void* sq_{nullptr};
+    void* cq_{nullptr};
+    io_uring_sqe* sqes_{nullptr};
+    size_t sq_size_{0};
+    size_t cq_size_{0};
+    size_t sqes_size_{0};
+
+    unsigned* sq_tail_{nullptr};
+    unsigned* sq_array_{nullptr};
+    unsigned sq_mask_{0};
+    unsigned* cq_head_{nullptr};
+    unsigned* cq_tail_{nullptr};
+    unsigned cq_mask_{0};
+    io_uring_cqe* cqes_{nullptr};
+};
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(error_msg);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg};
-        } else {
-            error_ = true;
-        }
+// reads a file using io_uring on Linux, several blocks are read ahead, the
+// returned source has no 'read' function if the file could not be opened
+[[nodiscard]] inline byte_source uring_source(const std::string& file_name,
+                                              uring_options options = {}) {
+    int fd = -1;
+    if (options.direct) {
+        fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    }
+    if (fd == -1) {
+        fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if (fd == -1) {
+        return {nullptr, file_name};
     }
 
-    ////////////////
-    // matching
-    ////////////////
+    auto state = std::make_shared<uring_state>(fd, options);
+    return {[state](char* data, size_t size) {
+                return state->read(data, size);
+            },
+            file_name};
+}
 
-    [[nodiscard]] bool match(const char* const curr, char delim) {
-        return *curr == delim;
-    };
+#endif
 
-    [[nodiscard]] bool match(const char* const curr, const std::string& delim) {
-        return std::strncmp(curr, delim.c_str(), delim.size()) == 0;
-    };
+////////////////
+// line reader
+////////////////
 
-    [[nodiscard]] size_t delimiter_size(char) {
-        return 1;
+// splits the data of a byte source into lines
+class byte_source_reader {
+public:
+    byte_source_reader() = default;
+
+    byte_source_reader(byte_source source) : source_{std::move(source)} {
     }
 
-    [[nodiscard]] size_t delimiter_size(const std::string& delim) {
-        return delim.size();
+    [[nodiscard]] explicit operator bool() const {
+        return static_cast<bool>(source_.read);
     }
 
-    void trim_left_if_enabled(line_ptr_type& curr) {
-        if constexpr (trim_left::enabled) {
-            while (trim_left::match(*curr)) {
-                ++curr;
-            }
-        }
+    // returns true once if the source reported an error
+    [[nodiscard]] bool take_error() {
+        return std::exchange(failed_, false);
     }
 
-    void trim_right_if_enabled(line_ptr_type& curr) {
-        if constexpr (trim_right::enabled) {
-            while (trim_right::match(*curr)) {
-                ++curr;
+    // same as 'get_line_file', the line is written after the first 'offset'
+    // characters of 'lineptr', at most 'max_size' characters are kept, the
+    // number of dropped characters is added to 'dropped'
+    [[nodiscard]] ssize_t get_line(
+        char*& lineptr, size_t& n, size_t offset, size_t max_size,
+        size_t& dropped, std::pmr::memory_resource* resource = nullptr) {
+        reserve_buffer(lineptr, n, offset + 1, resource);
+
+        size_t line_used = 0;
+        while (begin_ < end_ || fill()) {
+            const char* begin = block_.data() + begin_;
+            const auto* new_line = static_cast<const char*>(
+                std::memchr(begin, '\n', end_ - begin_));
+            const size_t read =
+                new_line ? new_line - begin + 1 : end_ - begin_;
+            const size_t size = std::min(read, max_size - line_used);
+            dropped += read - size;
+
+            reserve_buffer(lineptr, n, offset + line_used + size + 1,
+                           resource);
+            std::memcpy(lineptr + offset + line_used, begin, size);
+            line_used += size;
+            begin_ += read;
+
+            if (new_line) {
+                break;
             }
         }
-    }
-
-    template <typename Delim>
-    [[nodiscard]] std::tuple<size_t, bool> match_delimiter(line_ptr_type begin,
-                                                           const Delim& delim) {
-        line_ptr_type end = begin;
 
-        trim_right_if_enabled(end);
+        lineptr[offset + line_used] = '\0';
+        return line_used != 0 ? static_cast<ssize_t>(line_used) : -1;
+    }
 
-        // just spacing
-        if (*end == '\0') {
-            return {0, false};
+private:
+    [[nodiscard]] bool fill() {
+        if (done_) {
+            return false;
         }
 
-        // not a delimiter
-        if (!match(end, delim)) {
-            shift_if_escaped(end);
-            return {1 + end - begin, false};
+        if (block_.empty()) {
+            block_.resize(file_buffer_size);
         }
 
-        end += delimiter_size(delim);
-        trim_left_if_enabled(end);
+        begin_ = end_ = 0;
+        const auto size = source_.read(block_.data(), block_.size());
+        if (size <= 0) {
+            failed_ = size < 0;
+            done_ = true;
+            return false;
+        }
 
-        // delimiter
-        return {end - begin, true};
+        end_ = static_cast<size_t>(size);
+        return true;
     }
 
-    ////////////////
-    // shifting
-    ////////////////
+    byte_source source_;
+    std::vector<char> block_;
+    size_t begin_{0};
+    size_t end_{0};
+    bool done_{false};
+    bool failed_{false};
+};
 
-    void shift_if_escaped(line_ptr_type& curr) {
-        if constexpr (escape::enabled) {
-            if (escape::match(*curr)) {
-                if (curr[1] == '\0') {
-                    if constexpr (!multiline::enabled) {
-                        handle_error_unterminated_escape();
-                    }
-                    done_ = true;
-                    return;
-                }
-                shift_and_jump_escape();
-            }
+} /* namespace ss */
+
+namespace ss {
+
+////////////////
+// matcher
+////////////////
+
+template <char... Cs>
+struct matcher {
+private:
+    template <char X, char... Xs>
+    static bool match_impl(char c) {
+        if constexpr (sizeof...(Xs) != 0) {
+            return (c == X) || match_impl<Xs...>(c);
         }
+        return (c == X);
     }
 
-    void shift_and_jump_escape() {
-        shift_and_set_current();
-        if constexpr (!is_const_line) {
-            ++escaped_;
+    constexpr static bool contains_string_terminator() {
+        for (const auto& match : matches) {
+            if (match == '\0') {
+                return false;
+            }
         }
-        ++end_;
+        return true;
     }
 
-    void shift_push_and_start_next(size_t n) {
-        shift_and_push();
-        begin_ = end_ + n;
+public:
+    static bool match(char c) {
+        return match_impl<Cs...>(c);
     }
 
-    void shift_and_push() {
-        shift_and_set_current();
-        split_data_.emplace_back(begin_, curr_);
-    }
+    constexpr static bool enabled = true;
+    constexpr static std::array<char, sizeof...(Cs)> matches{Cs...};
+    static_assert(contains_string_terminator(),
+                  "string terminator cannot be used as a match character");
+};
 
-    void shift_and_set_current() {
-        if constexpr (!is_const_line) {
-            if (escaped_ > 0) {
-                std::copy_n(curr_ + escaped_, end_ - curr_ - escaped_, curr_);
-                curr_ = end_ - escaped_;
-                return;
+template <typename FirstMatcher, typename SecondMatcher>
+inline constexpr bool matches_intersect() {
+    for (const auto& first_match : FirstMatcher::matches) {
+        for (const auto& second_match : SecondMatcher::matches) {
+            if (first_match != '\0' && first_match == second_match) {
+                return true;
             }
         }
-        curr_ = end_;
     }
+    return false;
+}
 
-    ////////////////
-    // split impl
-    ////////////////
+template <typename FirstMatcher, typename SecondMatcher1,
+          typename SecondMatcher2>
+inline constexpr bool matches_intersect_union() {
+    return matches_intersect<FirstMatcher, SecondMatcher1>() ||
+           matches_intersect<FirstMatcher, SecondMatcher2>();
+}
 
-    const split_data& split_impl_select_delim(
-        const std::string& delimiter = default_delimiter) {
-        clear_error();
-        switch (delimiter.size()) {
-        case 0:
-            handle_error_empty_delimiter();
-            return split_data_;
-        case 1:
-            return split_impl(delimiter[0]);
-        default:
-            return split_impl(delimiter);
-        }
-    }
+template <>
+class matcher<'\0'> {
+public:
+    constexpr static bool enabled = false;
+    constexpr static std::array<char, 1> matches{'\0'};
+    static bool match(char c) = delete;
+};
 
-    template <typename Delim>
-    const split_data& split_impl(const Delim& delim) {
+////////////////
+// setup
+////////////////
 
-        trim_left_if_enabled(begin_);
+////////////////
+// matcher
+////////////////
 
-        for (done_ = false; !done_;) {
-            read(delim);
-        }
+template <char C>
+struct quote : matcher<C> {};
 
-        return split_data_;
-    }
+template <char... Cs>
+struct trim : matcher<Cs...> {};
 
-    ////////////////
-    // reading
-    ////////////////
+template <char... Cs>
+struct trim_left : matcher<Cs...> {};
 
-    template <typename Delim>
-    void read(const Delim& delim) {
-        escaped_ = 0;
-        if constexpr (quote::enabled) {
-            if constexpr (multiline::enabled) {
-                if (resplitting_) {
-                    resplitting_ = false;
-                    ++begin_;
-                    read_quoted(delim);
-                    return;
-                }
-            }
-            if (quote::match(*begin_)) {
-                curr_ = end_ = ++begin_;
-                read_quoted(delim);
-                return;
-            }
-        }
-        curr_ = end_ = begin_;
-        read_normal(delim);
-    }
+template <char... Cs>
+struct trim_right : matcher<Cs...> {};
 
-    template <typename Delim>
-    void read_normal(const Delim& delim) {
-        while (true) {
-            auto [width, valid] = match_delimiter(end_, delim);
+template <char... Cs>
+struct escape : matcher<Cs...> {};
 
-            if (!valid) {
-                // not a delimiter
-                if (width == 0) {
-                    // eol
-                    shift_and_push();
-                    done_ = true;
-                    break;
-                } else {
-                    end_ += width;
-                    continue;
-                }
-            } else {
-                // found delimiter
-                shift_push_and_start_next(width);
-                break;
-            }
-        }
-    }
+template <typename T, template <char...> class Template>
+struct is_instance_of_matcher : std::false_type {};
 
-    template <typename Delim>
-    void read_quoted(const Delim& delim) {
-        if constexpr (quote::enabled) {
-            while (true) {
-                if (!quote::match(*end_)) {
-                    if constexpr (escape::enabled) {
-                        if (escape::match(*end_)) {
-                            if (end_[1] == '\0') {
-                                // eol, unterminated escape
-                                // eg: ... "hel\\0
-                                if constexpr (!multiline::enabled) {
-                                    handle_error_unterminated_escape();
-                                }
-                                done_ = true;
-                                break;
-                            }
-                            // not eol
+template <char... Ts, template <char...> class Template>
+struct is_instance_of_matcher<Template<Ts...>, Template> : std::true_type {};
 
-                            shift_and_jump_escape();
-                            ++end_;
-                            continue;
-                        }
-                    }
-                    // not escaped
+template <typename T, template <char...> class Template>
+using is_instance_of_matcher_t =
+    typename is_instance_of_matcher<T, Template>::type;
 
-                    // eol, unterminated quote error
-                    // eg: ..."hell\0 -> quote not terminated
-                    if (*end_ == '\0') {
-                        shift_and_set_current();
-                        unterminated_quote_ = true;
-                        if constexpr (!multiline::enabled) {
-                            handle_error_unterminated_quote();
-                        }
-                        split_data_.emplace_back(line_, begin_);
-                        done_ = true;
-                        break;
-                    }
-                    // not eol
+template <template <char...> class Matcher, typename... Ts>
+struct get_matcher;
 
-                    ++end_;
-                    continue;
-                }
-                // quote found
-                // ...
+template <template <char...> class Matcher, typename T, typename... Ts>
+struct get_matcher<Matcher, T, Ts...> {
 
-                auto [width, valid] = match_delimiter(end_ + 1, delim);
+    template <typename U>
+    struct is_matcher : is_instance_of_matcher<U, Matcher> {};
 
-                // delimiter
-                if (valid) {
-                    shift_push_and_start_next(width + 1);
-                    break;
-                }
-                // not delimiter
+    static_assert(count_v<is_matcher, T, Ts...> <= 1,
+                  "the same matcher cannot "
+                  "be defined multiple times");
+    using type = std::conditional_t<is_matcher<T>::value, T,
+                                    typename get_matcher<Matcher, Ts...>::type>;
+};
 
-                // double quote
-                // eg: ...,"hel""lo",... -> hel"lo
-                if (quote::match(end_[1])) {
-                    shift_and_jump_escape();
-                    ++end_;
-                    continue;
-                }
-                // not double quote
+template <template <char...> class Matcher>
+struct get_matcher<Matcher> {
+    using type = Matcher<'\0'>;
+};
 
-                if (width == 0) {
-                    // eol
-                    // eg: ...,"hello"   \0 -> hello
-                    // eg no trim: ...,"hello"\0 -> hello
-                    shift_and_push();
-                } else {
-                    // mismatched quote
-                    // eg: ...,"hel"lo,... -> error
-                    handle_error_mismatched_quote(end_ - line_);
-                    split_data_.emplace_back(line_, begin_);
-                }
-                done_ = true;
-                break;
-            }
-        }
-    }
+template <template <char...> class Matcher, typename... Ts>
+using get_matcher_t = typename get_matcher<Matcher, Ts...>::type;
 
-    ////////////////
-    // members
-    ////////////////
+////////////////
+// multiline
+////////////////
 
-    error_type error_{};
-    bool unterminated_quote_{false};
-    bool done_{true};
-    bool resplitting_{false};
-    size_t escaped_{0};
-    split_data split_data_;
+template <size_t S, bool B = true>
+struct multiline_restricted {
+    constexpr static auto size = S;
+    constexpr static auto enabled = B;
+};
 
-    line_ptr_type begin_;
-    line_ptr_type curr_;
-    line_ptr_type end_;
-    line_ptr_type line_;
+using multiline = multiline_restricted<0>;
 
-    template <typename...>
-    friend class converter;
-};
+template <typename T>
+struct is_instance_of_multiline : std::false_type {};
 
-} /* namespace ss */
+template <size_t S, bool B>
+struct is_instance_of_multiline<multiline_restricted<S, B>> : std::true_type {};
 
+template <typename T>
+using is_instance_of_multiline_t = typename is_instance_of_multiline<T>::type;
 
-#ifndef SSP_DISABLE_FAST_FLOAT
-#else
-#endif
+template <typename... Ts>
+struct get_multiline;
 
-namespace ss {
+template <typename T, typename... Ts>
+struct get_multiline<T, Ts...> {
+    using type = std::conditional_t<is_instance_of_multiline<T>::value, T,
+                                    typename get_multiline<Ts...>::type>;
+};
+
+template <>
+struct get_multiline<> {
+    using type = multiline_restricted<0, false>;
+};
+
+template <typename... Ts>
+using get_multiline_t = typename get_multiline<Ts...>::type;
 
 ////////////////
-// number converters
+// max_record_bytes
 ////////////////
 
-#ifndef SSP_DISABLE_FAST_FLOAT
+// records longer than 'S' bytes, without the new line at their end, are not
+// read into memory, they are reported as errors and the reading continues
+// from the line which follows them
+template <size_t S>
+struct max_record_bytes {
+    constexpr static auto size = S;
+};
 
 template <typename T>
-[[nodiscard]] std::enable_if_t<std::is_floating_point_v<T>, std::optional<T>>
-to_num(const char* const begin, const char* const end) {
-    T ret;
-    auto [ptr, ec] = fast_float::from_chars(begin, end, ret);
+struct is_instance_of_max_record_bytes : std::false_type {};
 
-    if (ec != std::errc() || ptr != end) {
-        return std::nullopt;
-    }
-    return ret;
-}
+template <size_t S>
+struct is_instance_of_max_record_bytes<max_record_bytes<S>> : std::true_type {
+};
 
-#else
+template <typename... Ts>
+struct get_max_record_bytes;
 
-template <typename T>
-[[nodiscard]] std::enable_if_t<std::is_floating_point_v<T>, std::optional<T>>
-to_num(const char* const begin, const char* const end) {
-    static_assert(!std::is_same_v<T, long double>,
-                  "Conversion to long double is disabled");
+template <typename T, typename... Ts>
+struct get_max_record_bytes<T, Ts...> {
+    using type =
+        std::conditional_t<is_instance_of_max_record_bytes<T>::value, T,
+                           typename get_max_record_bytes<Ts...>::type>;
+};
 
-    constexpr static auto buff_max = 64;
-    std::array<char, buff_max> short_buff;
+template <>
+struct get_max_record_bytes<> {
+    using type = max_record_bytes<0>;
+};
 
-    const size_t string_range = std::distance(begin, end);
-    std::string long_buff;
+template <typename... Ts>
+using get_max_record_bytes_t = typename get_max_record_bytes<Ts...>::type;
 
-    char* buff = nullptr;
-    if (string_range > buff_max) {
-        long_buff = std::string{begin, end};
-        buff = long_buff.data();
-    } else {
-        buff = short_buff.data();
-        buff[string_range] = '\0';
-        std::copy_n(begin, string_range, buff);
-    }
+////////////////
+// string_error
+////////////////
 
-    T ret;
-    char* parse_end = nullptr;
+class string_error {};
 
-    if constexpr (std::is_same_v<T, float>) {
-        ret = std::strtof(buff, &parse_end);
-    } else if constexpr (std::is_same_v<T, double>) {
-        ret = std::strtod(buff, &parse_end);
-    }
+////////////////
+// ignore_header
+////////////////
 
-    if (parse_end != buff + string_range) {
-        return std::nullopt;
-    }
+class ignore_header {};
 
-    return ret;
-}
+////////////////
+// ignore_empty
+////////////////
 
-#endif
+class ignore_empty {};
 
 ////////////////
-// numeric_wrapper
+// throw_on_error
 ////////////////
 
-template <typename T>
-struct numeric_wrapper {
-    using type = T;
-
-    numeric_wrapper() = default;
-    numeric_wrapper(numeric_wrapper&&) noexcept = default;
-    numeric_wrapper(const numeric_wrapper&) = default;
+class throw_on_error {};
 
-    numeric_wrapper& operator=(numeric_wrapper&&) noexcept = default;
-    numeric_wrapper& operator=(const numeric_wrapper&) = default;
+////////////////
+// crlf
+////////////////
 
-    ~numeric_wrapper() = default;
+class crlf {};
 
-    numeric_wrapper(T other) : value{other} {
-    }
+////////////////
+// arena_views
+////////////////
 
-    operator T() {
-        return value;
-    }
+// converted std::string_view values are copied into an arena owned by the
+// parser instead of pointing to the line buffer
+class arena_views {};
 
-    operator T() const {
-        return value;
-    }
+////////////////
+// sequential_scan
+////////////////
 
-    T value;
-};
+// the file is read once from the beginning to the end, the kernel is told to
+// read ahead aggressively and the pages which were already read are dropped
+// from the page cache
+class sequential_scan {};
 
-using int8 = numeric_wrapper<int8_t>;
-using uint8 = numeric_wrapper<uint8_t>;
+////////////////
+// setup implementation
+////////////////
 
-template <typename T>
-[[nodiscard]] std::enable_if_t<std::is_integral_v<T>, std::optional<T>> to_num(
-    const char* const begin, const char* const end) {
-    T ret;
-    auto [ptr, ec] = std::from_chars(begin, end, ret);
+template <typename... Options>
+struct setup {
+private:
+    template <typename Option>
+    struct is_matcher
+        : std::disjunction<is_instance_of_matcher_t<Option, quote>,
+                           is_instance_of_matcher_t<Option, escape>,
+                           is_instance_of_matcher_t<Option, trim>,
+                           is_instance_of_matcher_t<Option, trim_left>,
+                           is_instance_of_matcher_t<Option, trim_right>> {};
 
-    if (ec != std::errc() || ptr != end) {
-        return std::nullopt;
-    }
-    return ret;
-}
+    template <typename T>
+    struct is_string_error : std::is_same<T, string_error> {};
 
-template <typename T>
-[[nodiscard]] std::enable_if_t<is_instance_of_v<numeric_wrapper, T>,
-                               std::optional<T>>
-to_num(const char* const begin, const char* const end) {
-    T ret;
-    auto [ptr, ec] = std::from_chars(begin, end, ret.value);
+    template <typename T>
+    struct is_ignore_header : std::is_same<T, ignore_header> {};
 
-    if (ec != std::errc() || ptr != end) {
-        return std::nullopt;
-    }
-    return ret;
-}
+    template <typename T>
+    struct is_ignore_empty : std::is_same<T, ignore_empty> {};
 
-////////////////
-// extract
-////////////////
+    template <typename T>
+    struct is_throw_on_error : std::is_same<T, throw_on_error> {};
 
-namespace error {
-template <typename T>
-struct unsupported_type {
-    constexpr static bool value = false;
-};
-} /* namespace errors */
+    template <typename T>
+    struct is_crlf : std::is_same<T, crlf> {};
 
-template <typename T>
-[[nodiscard]] std::enable_if_t<!std::is_integral_v<T> &&
-                                   !std::is_floating_point_v<T> &&
-                                   !is_instance_of_v<std::optional, T> &&
-                                   !is_instance_of_v<std::variant, T> &&
-                                   !is_instance_of_v<numeric_wrapper, T>,
-                               bool>
-extract(const char*, const char*, T&) {
-    static_assert(error::unsupported_type<T>::value,
-                  "Conversion for given type is not defined, an "
-                  "\'extract\' function needs to be defined!");
-}
+    template <typename T>
+    struct is_arena_views : std::is_same<T, arena_views> {};
 
-template <typename T>
-[[nodiscard]] std::enable_if_t<std::is_integral_v<T> ||
-                                   std::is_floating_point_v<T> ||
-                                   is_instance_of_v<numeric_wrapper, T>,
-                               bool>
-extract(const char* begin, const char* end, T& value) {
-    auto optional_value = to_num<T>(begin, end);
-    if (!optional_value) {
-        return false;
-    }
-    value = optional_value.value();
-    return true;
-}
+    template <typename T>
+    struct is_sequential_scan : std::is_same<T, sequential_scan> {};
 
-template <typename T>
-[[nodiscard]] std::enable_if_t<is_instance_of_v<std::optional, T>, bool>
-extract(const char* begin, const char* end, T& value) {
-    typename T::value_type raw_value;
-    if (extract(begin, end, raw_value)) {
-        value = raw_value;
-    } else {
-        value = std::nullopt;
-    }
-    return true;
-}
+    constexpr static auto count_matcher = count_v<is_matcher, Options...>;
 
-template <typename T, size_t I>
-[[nodiscard]] bool extract_variant(const char* begin, const char* end,
-                                   T& value) {
-    using IthType = std::variant_alternative_t<I, std::decay_t<T>>;
-    IthType ithValue;
-    if (extract<IthType>(begin, end, ithValue)) {
-        value = ithValue;
-        return true;
-    } else if constexpr (I + 1 < std::variant_size_v<T>) {
-        return extract_variant<T, I + 1>(begin, end, value);
-    }
-    return false;
-}
+    constexpr static auto count_multiline =
+        count_v<is_instance_of_multiline, Options...>;
 
-template <typename T>
-[[nodiscard]] std::enable_if_t<is_instance_of_v<std::variant, T>, bool> extract(
-    const char* begin, const char* end, T& value) {
-    return extract_variant<T, 0>(begin, end, value);
-}
+    constexpr static auto count_max_record_bytes =
+        count_v<is_instance_of_max_record_bytes, Options...>;
 
-////////////////
-// extract specialization
-////////////////
+    constexpr static auto count_string_error =
+        count_v<is_string_error, Options...>;
 
-template <>
-[[nodiscard]] inline bool extract(const char* begin, const char* end,
-                                  bool& value) {
-    if (end == begin + 1) {
-        if (*begin == '1') {
-            value = true;
-        } else if (*begin == '0') {
-            value = false;
-        } else {
-            return false;
-        }
-    } else {
-        constexpr static auto true_size = 4;
-        constexpr static auto false_size = 5;
-        const size_t size = end - begin;
-        if (size == true_size && std::strncmp(begin, "true", size) == 0) {
-            value = true;
-        } else if (size == false_size &&
-                   std::strncmp(begin, "false", size) == 0) {
-            value = false;
-        } else {
-            return false;
-        }
-    }
+    constexpr static auto count_ignore_header =
+        count_v<is_ignore_header, Options...>;
 
-    return true;
-}
+    constexpr static auto count_throw_on_error =
+        count_v<is_throw_on_error, Options...>;
 
-template <>
-[[nodiscard]] inline bool extract(const char* begin, const char* end,
-                                  char& value) {
-    value = *begin;
-    return (end == begin + 1);
-}
+    constexpr static auto count_ignore_empty =
+        count_v<is_ignore_empty, Options...>;
 
-template <>
-[[nodiscard]] inline bool extract(const char* begin, const char* end,
-                                  std::string& value) {
-    value = std::string{begin, end};
-    return true;
-}
+    constexpr static auto count_crlf = count_v<is_crlf, Options...>;
 
-template <>
-[[nodiscard]] inline bool extract(const char* begin, const char* end,
-                                  std::string_view& value) {
-    value = std::string_view{begin, static_cast<size_t>(end - begin)};
-    return true;
-}
+    constexpr static auto count_arena_views =
+        count_v<is_arena_views, Options...>;
 
-} /* namespace ss */
+    constexpr static auto count_sequential_scan =
+        count_v<is_sequential_scan, Options...>;
 
-namespace ss {
-INIT_HAS_METHOD(tied)
-INIT_HAS_METHOD(ss_valid)
-INIT_HAS_METHOD(error)
+    constexpr static auto number_of_valid_setup_types =
+        count_matcher + count_multiline + count_max_record_bytes +
+        count_string_error + count_ignore_header + count_ignore_empty +
+        count_throw_on_error + count_crlf + count_arena_views +
+        count_sequential_scan;
 
-////////////////
-// replace validator
-////////////////
+    using trim_left_only = get_matcher_t<trim_left, Options...>;
+    using trim_right_only = get_matcher_t<trim_right, Options...>;
+    using trim_all = get_matcher_t<trim, Options...>;
 
-// replace 'validator' types with elements they operate on
-// eg. no_validator_tup_t<int, ss::nx<char, 'A', 'B'>> <=> std::tuple<int, char>
-// where ss::nx<char, 'A', 'B'> is a validator '(n)one e(x)cept' which
-// checks if the returned character is either 'A' or 'B', returns error if not
-// additionally if one element is left in the pack, it will be unwrapped from
-// the tuple eg. no_void_validator_tup_t<int> <=> int instead of std::tuple<int>
-template <typename T, typename U = void>
-struct no_validator;
+public:
+    using quote = get_matcher_t<quote, Options...>;
+    using escape = get_matcher_t<escape, Options...>;
 
-template <typename T>
-struct no_validator<T, typename std::enable_if_t<has_m_ss_valid_t<T>>> {
-    using type = typename member_wrapper<decltype(&T::ss_valid)>::arg_type;
-};
+    using trim_left =
+        std::conditional_t<trim_all::enabled, trim_all, trim_left_only>;
+    using trim_right =
+        std::conditional_t<trim_all::enabled, trim_all, trim_right_only>;
 
-template <typename T, typename U>
-struct no_validator {
-    using type = T;
-};
+    using multiline = get_multiline_t<Options...>;
+    constexpr static size_t max_record_bytes =
+        get_max_record_bytes_t<Options...>::size;
+    constexpr static bool string_error = (count_string_error == 1);
+    constexpr static bool ignore_header = (count_ignore_header == 1);
+    constexpr static bool ignore_empty = (count_ignore_empty == 1);
+    constexpr static bool throw_on_error = (count_throw_on_error == 1);
+    constexpr static bool crlf = (count_crlf == 1);
+    constexpr static bool arena_views = (count_arena_views == 1);
+    constexpr static bool sequential_scan = (count_sequential_scan == 1);
 
-template <typename T>
-using no_validator_t = typename no_validator<T>::type;
+private:
+#define ASSERT_MSG "cannot have the same match character in multiple matchers"
+    static_assert(!matches_intersect<escape, quote>(), ASSERT_MSG);
 
-template <typename... Ts>
-struct no_validator_tup : apply_trait<no_validator, std::tuple<Ts...>> {};
+    constexpr static auto quote_trim_intersect =
+        matches_intersect_union<quote, trim_left, trim_right>();
+    static_assert(!quote_trim_intersect, ASSERT_MSG);
 
-template <typename... Ts>
-struct no_validator_tup<std::tuple<Ts...>> : no_validator_tup<Ts...> {};
+    constexpr static auto escape_trim_intersect =
+        matches_intersect_union<escape, trim_left, trim_right>();
+    static_assert(!escape_trim_intersect, ASSERT_MSG);
 
-template <typename T>
-struct no_validator_tup<std::tuple<T>> : no_validator<T> {};
+#undef ASSERT_MSG
 
-template <typename... Ts>
-using no_validator_tup_t = typename no_validator_tup<Ts...>::type;
+    static_assert(
+        !multiline::enabled ||
+            (multiline::enabled && (quote::enabled || escape::enabled)),
+        "to enable multiline either quote or escape needs to be enabled");
 
-////////////////
-// no void tuple
-////////////////
+    static_assert(!(trim_all::enabled && trim_left_only::enabled) &&
+                      !(trim_all::enabled && trim_right_only::enabled),
+                  "ambiguous trim setup");
 
-template <typename... Ts>
-struct no_void_tup : filter_not<std::is_void, no_validator_tup_t<Ts...>> {};
+    static_assert(count_multiline <= 1, "mutliline defined multiple times");
 
-template <typename... Ts>
-using no_void_tup_t = filter_not_t<std::is_void, Ts...>;
+    static_assert(count_max_record_bytes <= 1,
+                  "max_record_bytes defined multiple times");
 
-////////////////
-// no void or validator
-////////////////
+    static_assert(count_string_error <= 1,
+                  "string_error defined multiple times");
 
-// replace 'validators' and remove void from tuple
-template <typename... Ts>
-struct no_void_validator_tup : no_validator_tup<no_void_tup_t<Ts...>> {};
+    static_assert(count_throw_on_error <= 1,
+                  "throw_on_error defined multiple times");
 
-template <typename... Ts>
-struct no_void_validator_tup<std::tuple<Ts...>>
-    : no_validator_tup<no_void_tup_t<Ts...>> {};
+    static_assert(count_crlf <= 1, "crlf defined multiple times");
 
-template <typename... Ts>
-using no_void_validator_tup_t = typename no_void_validator_tup<Ts...>::type;
+    static_assert(count_arena_views <= 1,
+                  "arena_views defined multiple times");
 
-////////////////
-// tied class
-////////////////
+    static_assert(count_sequential_scan <= 1,
+                  "sequential_scan defined multiple times");
 
-// check if the parameter pack is only one element which is a class and has
-// the 'tied' method which is to be used for type deduction when converting
-template <typename T, typename... Ts>
-struct tied_class {
-    constexpr static bool value =
-        (sizeof...(Ts) == 0 && std::is_class_v<T> && has_m_tied<T>::value);
+    static_assert(count_throw_on_error + count_string_error <= 1,
+                  "cannot define both throw_on_error and string_error");
+
+    static_assert(number_of_valid_setup_types == sizeof...(Options),
+                  "one or multiple invalid setup parameters defined");
 };
 
-template <typename... Ts>
-constexpr bool tied_class_v = tied_class<Ts...>::value;
+template <typename... Options>
+struct setup<setup<Options...>> : setup<Options...> {};
 
-////////////////
-// converter
-////////////////
+template <typename... Options>
+struct setup<std::tuple<Options...>> : setup<Options...> {};
+
+} /* namespace ss */
+
+namespace ss {
 
 template <typename... Options>
-class converter {
-    using line_ptr_type = typename splitter<Options...>::line_ptr_type;
+class splitter {
+private:
+    using quote = typename setup<Options...>::quote;
+    using trim_left = typename setup<Options...>::trim_left;
+    using trim_right = typename setup<Options...>::trim_right;
+    using escape = typename setup<Options...>::escape;
+    using multiline = typename setup<Options...>::multiline;
 
     constexpr static auto string_error = setup<Options...>::string_error;
     constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
-    constexpr static auto default_delimiter = ",";
+    constexpr static auto is_const_line = !quote::enabled && !escape::enabled;
 
     using error_type = std::conditional_t<string_error, std::string, bool>;
 
 public:
-    // parses line with given delimiter, returns a 'T' object created with
-    // extracted values of type 'Ts'
-    template <typename T, typename... Ts>
-    [[nodiscard]] T convert_object(
-        line_ptr_type line, const std::string& delim = default_delimiter) {
-        return to_object<T>(convert<Ts...>(line, delim));
-    }
-
-    // parses line with given delimiter, returns tuple of objects with
-    // extracted values of type 'Ts'
-    template <typename... Ts>
-    [[nodiscard]] no_void_validator_tup_t<Ts...> convert(
-        line_ptr_type line, const std::string& delim = default_delimiter) {
-        split(line, delim);
-        if (splitter_.valid()) {
-            return convert<Ts...>(splitter_.get_split_data());
-        } else {
-            handle_error_bad_split();
-            return {};
-        }
-    }
-
-    // parses already split line, returns 'T' object with extracted values
-    template <typename T, typename... Ts>
-    [[nodiscard]] T convert_object(const split_data& elems) {
-        return to_object<T>(convert<Ts...>(elems));
-    }
-
-    // same as above, but uses cached split line
-    template <typename T, typename... Ts>
-    [[nodiscard]] T convert_object() {
-        return to_object<T>(convert<Ts...>());
-    }
-
-    // parses already split line, returns either a tuple of objects with
-    // parsed values (returns raw element (no tuple) if Ts is empty), or if
-    // one argument is given which is a class which has a tied
-    // method which returns a tuple, returns that type
-    template <typename T, typename... Ts>
-    [[nodiscard]] no_void_validator_tup_t<T, Ts...> convert(
-        const split_data& elems) {
-        if constexpr (sizeof...(Ts) == 0 && is_instance_of_v<std::tuple, T>) {
-            return convert_impl(elems, static_cast<T*>(nullptr));
-        } else if constexpr (tied_class_v<T, Ts...>) {
-            using arg_ref_tuple = std::invoke_result_t<decltype(&T::tied), T>;
-            using arg_tuple = apply_trait_t<std::decay, arg_ref_tuple>;
+    using line_ptr_type = std::conditional_t<is_const_line, const char*, char*>;
 
-            return to_object<T>(
-                convert_impl(elems, static_cast<arg_tuple*>(nullptr)));
-        } else {
-            return convert_impl<T, Ts...>(elems);
-        }
-    }
+    splitter() = default;
 
-    // same as above, but uses cached split line
-    template <typename T, typename... Ts>
-    [[nodiscard]] no_void_validator_tup_t<T, Ts...> convert() {
-        return convert<T, Ts...>(splitter_.get_split_data());
+    // the split data is allocated from the given memory resource
+    explicit splitter(std::pmr::memory_resource* resource)
+        : split_data_{resource_or_default(resource)} {
     }
 
     [[nodiscard]] bool valid() const {
@@ -1967,19 +2250,23 @@ public:
     }
 
     [[nodiscard]] bool unterminated_quote() const {
-        return splitter_.unterminated_quote();
+        return unterminated_quote_;
     }
 
-    // 'splits' string by given delimiter, returns vector of pairs which
-    // contain the beginnings and the ends of each column of the string
-    const split_data& split(line_ptr_type line,
-                            const std::string& delim = default_delimiter) {
-        splitter_.clear_split_data();
-        if (line[0] == '\0') {
-            return splitter_.get_split_data();
-        }
+    const split_data& split(line_ptr_type new_line,
+                            const std::string& delimiter = default_delimiter) {
+        split_data_.clear();
+        line_ = new_line;
+        begin_ = line_;
+        return split_impl_select_delim(delimiter);
+    }
 
-        return splitter_.split(line, delim);
+    [[nodiscard]] const split_data& get_split_data() const {
+        return split_data_;
+    }
+
+    void clear_split_data() {
+        split_data_.clear();
     }
 
 private:
@@ -1987,13 +2274,55 @@ private:
     // resplit
     ////////////////
 
-    const split_data& resplit(line_ptr_type new_line, ssize_t new_size,
-                              const std::string& delim) {
-        return splitter_.resplit(new_line, new_size, delim);
+    // number of characters the end of line is shifted backwards
+    [[nodiscard]] size_t size_shifted() const {
+        return escaped_;
     }
 
-    [[nodiscard]] size_t size_shifted() {
-        return splitter_.size_shifted();
+    void adjust_ranges(const char* old_line) {
+        for (auto& [begin, end] : split_data_) {
+            begin = begin - old_line + line_;
+            end = end - old_line + line_;
+        }
+    }
+
+    const split_data& resplit(
+        line_ptr_type new_line, ssize_t new_size,
+        const std::string& delimiter = default_delimiter) {
+
+        // resplitting, continue from last slice
+        if (!quote::enabled || !multiline::enabled || split_data_.empty() ||
+            !unterminated_quote()) {
+            handle_error_invalid_resplit();
+            return split_data_;
+        }
+
+        const auto [old_line, old_begin] = *std::prev(split_data_.end());
+        const size_t begin = old_begin - old_line - 1;
+
+        // safety measure
+        if (new_size != -1 && static_cast<size_t>(new_size) < begin) {
+            handle_error_invalid_resplit();
+            return split_data_;
+        }
+
+        // if unterminated quote, the last element is junk
+        split_data_.pop_back();
+
+        // the ranges only need to be moved if the buffer was reallocated,
+        // which is rare since it grows geometrically
+        line_ = new_line;
+        if (line_ != old_line) {
+            adjust_ranges(old_line);
+        }
+
+        begin_ = line_ + begin;
+        end_ = line_ - old_line + end_ - escaped_;
+        curr_ = end_;
+
+        resplitting_ = true;
+
+        return split_impl_select_delim(delimiter);
     }
 
     ////////////////
@@ -2003,60 +2332,41 @@ private:
     void clear_error() {
         if constexpr (string_error) {
             error_.clear();
-        } else {
+        } else if constexpr (!throw_on_error) {
             error_ = false;
         }
+        unterminated_quote_ = false;
     }
 
-    [[nodiscard]] std::string error_sufix(const string_range msg,
-                                          size_t pos) const {
-        constexpr static auto reserve_size = 32;
-        std::string error;
-        error.reserve(reserve_size);
-        error.append("at column ")
-            .append(std::to_string(pos + 1))
-            .append(": \'")
-            .append(msg.first, msg.second)
-            .append("\'");
-        return error;
-    }
-
-    void handle_error_bad_split() {
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(splitter_.error_msg());
-        } else if constexpr (!throw_on_error) {
-            error_ = true;
-        }
-    }
+    void handle_error_empty_delimiter() {
+        constexpr static auto error_msg = "empty delimiter";
 
-    void handle_error_unterminated_escape() {
         if constexpr (string_error) {
             error_.clear();
-            splitter_.handle_error_unterminated_escape();
-            error_.append(splitter_.error_msg());
+            error_.append(error_msg);
         } else if constexpr (throw_on_error) {
-            splitter_.handle_error_unterminated_escape();
+            throw ss::exception{error_msg};
         } else {
             error_ = true;
         }
     }
 
-    void handle_error_unterminated_quote() {
+    void handle_error_mismatched_quote(size_t n) {
+        constexpr static auto error_msg = "mismatched quote at position: ";
+
         if constexpr (string_error) {
             error_.clear();
-            splitter_.handle_error_unterminated_quote();
-            error_.append(splitter_.error_msg());
+            error_.append(error_msg + std::to_string(n));
         } else if constexpr (throw_on_error) {
-            splitter_.handle_error_unterminated_quote();
+            throw ss::exception{error_msg + std::to_string(n)};
         } else {
             error_ = true;
         }
     }
 
-    void handle_error_multiline_limit_reached() {
-        constexpr static auto error_msg = "multiline limit reached";
-        splitter_.unterminated_quote_ = false;
+    void handle_error_unterminated_escape() {
+        constexpr static auto error_msg =
+            "unterminated escape at the end of the line";
 
         if constexpr (string_error) {
             error_.clear();
@@ -2068,910 +2378,6296 @@ private:
         }
     }
 
-    void handle_error_invalid_conversion(const string_range msg, size_t pos) {
-        constexpr static auto error_msg = "invalid conversion for parameter ";
+    void handle_error_unterminated_quote() {
+        constexpr static auto error_msg = "unterminated quote";
 
         if constexpr (string_error) {
             error_.clear();
-            error_.append(error_msg).append(error_sufix(msg, pos));
+            error_.append(error_msg);
         } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg + error_sufix(msg, pos)};
+            throw ss::exception{error_msg};
         } else {
             error_ = true;
         }
     }
 
-    void handle_error_validation_failed(const char* const error,
-                                        const string_range msg, size_t pos) {
+    void handle_error_invalid_resplit() {
+        constexpr static auto error_msg =
+            "invalid resplit, new line must be longer"
+            "than the end of the last slice";
+
         if constexpr (string_error) {
             error_.clear();
-            error_.append(error).append(" ").append(error_sufix(msg, pos));
+            error_.append(error_msg);
         } else if constexpr (throw_on_error) {
-            throw ss::exception{error + (" " + error_sufix(msg, pos))};
+            throw ss::exception{error_msg};
         } else {
             error_ = true;
         }
     }
 
-    void handle_error_number_of_columns(size_t expected_pos, size_t pos) {
-        constexpr static auto error_msg1 =
-            "invalid number of columns, expected: ";
-        constexpr static auto error_msg2 = ", got: ";
+    ////////////////
+    // matching
+    ////////////////
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(error_msg1)
-                .append(std::to_string(expected_pos))
-                .append(error_msg2)
-                .append(std::to_string(pos));
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg1 + std::to_string(expected_pos) +
-                                error_msg2 + std::to_string(pos)};
-        } else {
-            error_ = true;
-        }
+    [[nodiscard]] bool match(const char* const curr, char delim) {
+        return *curr == delim;
+    };
+
+    [[nodiscard]] bool match(const char* const curr, const std::string& delim) {
+        return std::strncmp(curr, delim.c_str(), delim.size()) == 0;
+    };
+
+    [[nodiscard]] size_t delimiter_size(char) {
+        return 1;
     }
 
-    void handle_error_incompatible_mapping(size_t argument_size,
-                                           size_t mapping_size) {
-        constexpr static auto error_msg1 =
-            "number of arguments does not match mapping, expected: ";
-        constexpr static auto error_msg2 = ", got: ";
+    [[nodiscard]] size_t delimiter_size(const std::string& delim) {
+        return delim.size();
+    }
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(error_msg1)
-                .append(std::to_string(mapping_size))
-                .append(error_msg2)
-                .append(std::to_string(argument_size));
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg1 + std::to_string(mapping_size) +
-                                error_msg2 + std::to_string(argument_size)};
-        } else {
-            error_ = true;
+    void trim_left_if_enabled(line_ptr_type& curr) {
+        if constexpr (trim_left::enabled) {
+            while (trim_left::match(*curr)) {
+                ++curr;
+            }
         }
     }
 
-    ////////////////
-    // convert implementation
-    ////////////////
+    void trim_right_if_enabled(line_ptr_type& curr) {
+        if constexpr (trim_right::enabled) {
+            while (trim_right::match(*curr)) {
+                ++curr;
+            }
+        }
+    }
 
-    template <typename... Ts>
-    [[nodiscard]] no_void_validator_tup_t<Ts...> convert_impl(
-        const split_data& elems) {
-        clear_error();
+    template <typename Delim>
+    [[nodiscard]] std::tuple<size_t, bool> match_delimiter(line_ptr_type begin,
+                                                           const Delim& delim) {
+        line_ptr_type end = begin;
 
-        if (!splitter_.valid()) {
-            handle_error_bad_split();
-            return {};
-        }
+        trim_right_if_enabled(end);
 
-        if (!columns_mapped()) {
-            if (sizeof...(Ts) != elems.size()) {
-                handle_error_number_of_columns(sizeof...(Ts), elems.size());
-                return {};
-            }
-        } else {
-            if (sizeof...(Ts) != column_mappings_.size()) {
-                handle_error_incompatible_mapping(sizeof...(Ts),
-                                                  column_mappings_.size());
-                return {};
-            }
+        // just spacing
+        if (*end == '\0') {
+            return {0, false};
+        }
 
-            if (elems.size() != number_of_columns_) {
-                handle_error_number_of_columns(number_of_columns_,
-                                               elems.size());
-                return {};
-            }
+        // not a delimiter
+        if (!match(end, delim)) {
+            shift_if_escaped(end);
+            return {1 + end - begin, false};
         }
 
-        return extract_tuple<Ts...>(elems);
-    }
+        end += delimiter_size(delim);
+        trim_left_if_enabled(end);
 
-    template <typename... Ts>
-    [[nodiscard]] no_void_validator_tup_t<std::tuple<Ts...>> convert_impl(
-        const split_data& elems, const std::tuple<Ts...>*) {
-        return convert_impl<Ts...>(elems);
+        // delimiter
+        return {end - begin, true};
     }
 
     ////////////////
-    // column mapping
+    // shifting
     ////////////////
 
-    [[nodiscard]] bool columns_mapped() const {
-        return !column_mappings_.empty();
+    void shift_if_escaped(line_ptr_type& curr) {
+        if constexpr (escape::enabled) {
+            if (escape::match(*curr)) {
+                if (curr[1] == '\0') {
+                    if constexpr (!multiline::enabled) {
+                        handle_error_unterminated_escape();
+                    }
+                    done_ = true;
+                    return;
+                }
+                shift_and_jump_escape();
+            }
+        }
     }
 
-    [[nodiscard]] size_t column_position(size_t tuple_position) const {
-        if (!columns_mapped()) {
-            return tuple_position;
+    void shift_and_jump_escape() {
+        shift_and_set_current();
+        if constexpr (!is_const_line) {
+            ++escaped_;
         }
-        return column_mappings_[tuple_position];
+        ++end_;
     }
 
-    // assumes positions are valid and the vector is not empty
-    void set_column_mapping(std::vector<size_t> positions,
-                            size_t number_of_columns) {
-        column_mappings_ = std::move(positions);
-        number_of_columns_ = number_of_columns;
+    void shift_push_and_start_next(size_t n) {
+        shift_and_push();
+        begin_ = end_ + n;
     }
 
-    void clear_column_positions() {
-        column_mappings_.clear();
-        number_of_columns_ = 0;
+    void shift_and_push() {
+        shift_and_set_current();
+        split_data_.emplace_back(begin_, curr_);
+    }
+
+    void shift_and_set_current() {
+        if constexpr (!is_const_line) {
+            if (escaped_ > 0) {
+                std::copy_n(curr_ + escaped_, end_ - curr_ - escaped_, curr_);
+                curr_ = end_ - escaped_;
+                return;
+            }
+        }
+        curr_ = end_;
     }
 
     ////////////////
-    // conversion
+    // split impl
     ////////////////
 
-    template <typename T>
-    void extract_one(no_validator_t<T>& dst, const string_range msg,
-                     size_t pos) {
-        if (!valid()) {
-            return;
+    const split_data& split_impl_select_delim(
+        const std::string& delimiter = default_delimiter) {
+        clear_error();
+        switch (delimiter.size()) {
+        case 0:
+            handle_error_empty_delimiter();
+            return split_data_;
+        case 1:
+            return split_impl(delimiter[0]);
+        default:
+            return split_impl(delimiter);
         }
+    }
 
-        if constexpr (std::is_same_v<T, std::string>) {
-            static_cast<void>(extract(msg.first, msg.second, dst));
-            return;
-        }
+    template <typename Delim>
+    const split_data& split_impl(const Delim& delim) {
 
-        if (!extract(msg.first, msg.second, dst)) {
-            handle_error_invalid_conversion(msg, pos);
-            return;
+        trim_left_if_enabled(begin_);
+
+        for (done_ = false; !done_;) {
+            read(delim);
         }
 
-        if constexpr (has_m_ss_valid_t<T>) {
-            if (T validator; !validator.ss_valid(dst)) {
-                if constexpr (has_m_error_t<T>) {
-                    handle_error_validation_failed(validator.error(), msg, pos);
-                } else {
-                    handle_error_validation_failed("validation error", msg,
-                                                   pos);
+        return split_data_;
+    }
+
+    ////////////////
+    // reading
+    ////////////////
+
+    template <typename Delim>
+    void read(const Delim& delim) {
+        escaped_ = 0;
+        if constexpr (quote::enabled) {
+            if constexpr (multiline::enabled) {
+                if (resplitting_) {
+                    resplitting_ = false;
+                    ++begin_;
+                    read_quoted(delim);
+                    return;
                 }
+            }
+            if (quote::match(*begin_)) {
+                curr_ = end_ = ++begin_;
+                read_quoted(delim);
                 return;
             }
         }
+        curr_ = end_ = begin_;
+        read_normal(delim);
     }
 
-    template <size_t ArgN, size_t TupN, typename... Ts>
-    void extract_multiple(no_void_validator_tup_t<Ts...>& tup,
-                          const split_data& elems) {
-        using elem_t = std::tuple_element_t<ArgN, std::tuple<Ts...>>;
-
-        constexpr bool not_void = !std::is_void_v<elem_t>;
-        constexpr bool one_element = count_not_v<std::is_void, Ts...> == 1;
+    template <typename Delim>
+    void read_normal(const Delim& delim) {
+        while (true) {
+            auto [width, valid] = match_delimiter(end_, delim);
 
-        if constexpr (not_void) {
-            if constexpr (one_element) {
-                extract_one<elem_t>(tup, elems[column_position(ArgN)], ArgN);
+            if (!valid) {
+                // not a delimiter
+                if (width == 0) {
+                    // eol
+                    shift_and_push();
+                    done_ = true;
+                    break;
+                } else {
+                    end_ += width;
+                    continue;
+                }
             } else {
-                auto& el = std::get<TupN>(tup);
-                extract_one<elem_t>(el, elems[column_position(ArgN)], ArgN);
+                // found delimiter
+                shift_push_and_start_next(width);
+                break;
             }
         }
-
-        if constexpr (sizeof...(Ts) > ArgN + 1) {
-            constexpr size_t NewTupN = (not_void) ? TupN + 1 : TupN;
-            extract_multiple<ArgN + 1, NewTupN, Ts...>(tup, elems);
-        }
-    }
-
-    template <typename... Ts>
-    [[nodiscard]] no_void_validator_tup_t<Ts...> extract_tuple(
-        const split_data& elems) {
-        static_assert(!all_of_v<std::is_void, Ts...>,
-                      "at least one parameter must be non void");
-        no_void_validator_tup_t<Ts...> ret{};
-        extract_multiple<0, 0, Ts...>(ret, elems);
-        return ret;
     }
 
-    ////////////////
-    // members
-    ////////////////
+    template <typename Delim>
+    void read_quoted(const Delim& delim) {
+        if constexpr (quote::enabled) {
+            while (true) {
+                if (!quote::match(*end_)) {
+                    if constexpr (escape::enabled) {
+                        if (escape::match(*end_)) {
+                            if (end_[1] == '\0') {
+                                // eol, unterminated escape
+                                // eg: ... "hel\\0
+                                if constexpr (!multiline::enabled) {
+                                    handle_error_unterminated_escape();
+                                }
+                                done_ = true;
+                                break;
+                            }
+                            // not eol
 
-    error_type error_{};
-    splitter<Options...> splitter_;
+                            shift_and_jump_escape();
+                            ++end_;
+                            continue;
+                        }
+                    }
+                    // not escaped
 
-    template <typename...>
-    friend class parser;
+                    // eol, unterminated quote error
+                    // eg: ..."hell\0 -> quote not terminated
+                    if (*end_ == '\0') {
+                        shift_and_set_current();
+                        unterminated_quote_ = true;
+                        if constexpr (!multiline::enabled) {
+                            handle_error_unterminated_quote();
+                        }
+                        split_data_.emplace_back(line_, begin_);
+                        done_ = true;
+                        break;
+                    }
+                    // not eol
 
-    std::vector<size_t> column_mappings_;
-    size_t number_of_columns_{0};
-};
+                    ++end_;
+                    continue;
+                }
+                // quote found
+                // ...
 
-} /* namespace ss */
+                auto [width, valid] = match_delimiter(end_ + 1, delim);
 
+                // delimiter
+                if (valid) {
+                    shift_push_and_start_next(width + 1);
+                    break;
+                }
+                // not delimiter
 
-namespace ss {
+                // double quote
+                // eg: ...,"hel""lo",... -> hel"lo
+                if (quote::match(end_[1])) {
+                    shift_and_jump_escape();
+                    ++end_;
+                    continue;
+                }
+                // not double quote
 
-template <typename... Options>
-class parser {
-    constexpr static auto string_error = setup<Options...>::string_error;
-    constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
+                if (width == 0) {
+                    // eol
+                    // eg: ...,"hello"   \0 -> hello
+                    // eg no trim: ...,"hello"\0 -> hello
+                    shift_and_push();
+                } else {
+                    // mismatched quote
+                    // eg: ...,"hel"lo,... -> error
+                    handle_error_mismatched_quote(end_ - line_);
+                    split_data_.emplace_back(line_, begin_);
+                }
+                done_ = true;
+                break;
+            }
+        }
+    }
 
-    using multiline = typename setup<Options...>::multiline;
-    using error_type = std::conditional_t<string_error, std::string, bool>;
+    ////////////////
+    // members
+    ////////////////
 
-    constexpr static bool escaped_multiline_enabled =
-        multiline::enabled && setup<Options...>::escape::enabled;
+    error_type error_{};
+    bool unterminated_quote_{false};
+    bool done_{true};
+    bool resplitting_{false};
+    size_t escaped_{0};
+    split_data split_data_;
 
-    constexpr static bool quoted_multiline_enabled =
-        multiline::enabled && setup<Options...>::quote::enabled;
+    line_ptr_type begin_;
+    line_ptr_type curr_;
+    line_ptr_type end_;
+    line_ptr_type line_;
 
-    constexpr static bool ignore_header = setup<Options...>::ignore_header;
+    template <typename...>
+    friend class converter;
+};
 
-    constexpr static bool ignore_empty = setup<Options...>::ignore_empty;
+} /* namespace ss */
 
-    using header_splitter = ss::splitter<
-        ss::filter_not_t<ss::is_instance_of_multiline, Options...>>;
 
-public:
-    parser(std::string file_name, std::string delim = ss::default_delimiter)
-        : file_name_{std::move(file_name)}, reader_{file_name_, delim} {
-        if (reader_.file_) {
-            read_line();
-            if constexpr (ignore_header) {
-                ignore_next();
-            } else {
-                raw_header_ = reader_.get_buffer();
-            }
-        } else {
-            handle_error_file_not_open();
-            eof_ = true;
-        }
-    }
+#ifndef SSP_DISABLE_FAST_FLOAT
+#else
+#endif
 
-    parser(const char* const csv_data_buffer, size_t csv_data_size,
-           const std::string& delim = ss::default_delimiter)
-        : file_name_{"CSV data buffer"},
-          reader_{csv_data_buffer, csv_data_size, delim} {
-        if (csv_data_buffer) {
-            read_line();
-            if constexpr (ignore_header) {
-                ignore_next();
-            } else {
-                raw_header_ = reader_.get_buffer();
-            }
-        } else {
-            handle_error_null_buffer();
-            eof_ = true;
-        }
-    }
+namespace ss {
 
-    parser(parser&& other) noexcept = default;
-    parser& operator=(parser&& other) noexcept = default;
-    ~parser() = default;
+////////////////
+// number converters
+////////////////
 
-    parser() = delete;
-    parser(const parser& other) = delete;
-    parser& operator=(const parser& other) = delete;
+#ifndef SSP_DISABLE_FAST_FLOAT
 
-    [[nodiscard]] bool valid() const {
-        if constexpr (string_error) {
-            return error_.empty();
-        } else if constexpr (throw_on_error) {
-            return true;
-        } else {
-            return !error_;
-        }
-    }
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_floating_point_v<T>, std::optional<T>>
+to_num(const char* const begin, const char* const end) {
+    T ret;
+    auto [ptr, ec] = fast_float::from_chars(begin, end, ret);
 
-    [[nodiscard]] const std::string& error_msg() const {
-        assert_string_error_defined<string_error>();
-        return error_;
+    if (ec != std::errc() || ptr != end) {
+        return std::nullopt;
     }
+    return ret;
+}
 
-    [[nodiscard]] bool eof() const {
-        return eof_;
-    }
+#else
 
-    bool ignore_next() {
-        return reader_.read_next();
-    }
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_floating_point_v<T>, std::optional<T>>
+to_num(const char* const begin, const char* const end) {
+    static_assert(!std::is_same_v<T, long double>,
+                  "Conversion to long double is disabled");
 
-    template <typename T, typename... Ts>
-    [[nodiscard]] T get_object() {
-        return to_object<T>(get_next<Ts...>());
+    constexpr static auto buff_max = 64;
+    std::array<char, buff_max> short_buff;
+
+    const size_t string_range = std::distance(begin, end);
+    std::string long_buff;
+
+    char* buff = nullptr;
+    if (string_range > buff_max) {
+        long_buff = std::string{begin, end};
+        buff = long_buff.data();
+    } else {
+        buff = short_buff.data();
+        buff[string_range] = '\0';
+        std::copy_n(begin, string_range, buff);
     }
 
-    [[nodiscard]] size_t line() const {
-        return reader_.line_number_ > 0 ? reader_.line_number_ - 1
-                                        : reader_.line_number_;
+    T ret;
+    char* parse_end = nullptr;
+
+    if constexpr (std::is_same_v<T, float>) {
+        ret = std::strtof(buff, &parse_end);
+    } else if constexpr (std::is_same_v<T, double>) {
+        ret = std::strtod(buff, &parse_end);
     }
 
-    [[nodiscard]] size_t position() const {
-        return reader_.chars_read_;
+    if (parse_end != buff + string_range) {
+        return std::nullopt;
     }
 
-    template <typename T, typename... Ts>
-    [[nodiscard]] no_void_validator_tup_t<T, Ts...> get_next() {
-        if (!eof_) {
-            if constexpr (throw_on_error) {
-                try {
-                    reader_.parse();
-                } catch (const ss::exception& e) {
-                    read_line();
-                    decorate_rethrow(e);
-                }
-            } else {
-                reader_.parse();
-            }
-        }
+    return ret;
+}
 
-        reader_.update();
-        if (!reader_.converter_.valid()) {
-            handle_error_invalid_conversion();
-            read_line();
-            return {};
-        }
+#endif
 
-        clear_error();
+////////////////
+// numeric_wrapper
+////////////////
 
-        if (eof_) {
-            handle_error_eof_reached();
-            return {};
-        }
+template <typename T>
+struct numeric_wrapper {
+    using type = T;
 
-        if constexpr (throw_on_error) {
-            try {
-                auto value = reader_.converter_.template convert<T, Ts...>();
-                read_line();
-                return value;
-            } catch (const ss::exception& e) {
-                read_line();
-                decorate_rethrow(e);
-            }
-        }
+    numeric_wrapper() = default;
+    numeric_wrapper(numeric_wrapper&&) noexcept = default;
+    numeric_wrapper(const numeric_wrapper&) = default;
 
-        auto value = reader_.converter_.template convert<T, Ts...>();
+    numeric_wrapper& operator=(numeric_wrapper&&) noexcept = default;
+    numeric_wrapper& operator=(const numeric_wrapper&) = default;
 
-        if (!reader_.converter_.valid()) {
-            handle_error_invalid_conversion();
-        }
+    ~numeric_wrapper() = default;
 
-        read_line();
-        return value;
+    numeric_wrapper(T other) : value{other} {
     }
 
-    [[nodiscard]] std::string raw_header() const {
-        assert_ignore_header_not_defined();
-        return raw_header_;
+    operator T() {
+        return value;
     }
 
-    [[nodiscard]] std::vector<std::string> header() {
-        assert_ignore_header_not_defined();
-        clear_error();
+    operator T() const {
+        return value;
+    }
 
-        header_splitter splitter;
-        std::string raw_header_copy = raw_header_;
+    T value;
+};
 
-        if (!strict_split(splitter, raw_header_copy)) {
-            return {};
-        }
+using int8 = numeric_wrapper<int8_t>;
+using uint8 = numeric_wrapper<uint8_t>;
 
-        std::vector<std::string> split_header;
-        for (const auto& [begin, end] : splitter.get_split_data()) {
-            split_header.emplace_back(begin, end);
-        }
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_integral_v<T>, std::optional<T>> to_num(
+    const char* const begin, const char* const end) {
+    T ret;
+    auto [ptr, ec] = std::from_chars(begin, end, ret);
 
-        return split_header;
+    if (ec != std::errc() || ptr != end) {
+        return std::nullopt;
     }
+    return ret;
+}
 
-    [[nodiscard]] bool field_exists(const std::string& field) {
-        assert_ignore_header_not_defined();
-        clear_error();
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<numeric_wrapper, T>,
+                               std::optional<T>>
+to_num(const char* const begin, const char* const end) {
+    T ret;
+    auto [ptr, ec] = std::from_chars(begin, end, ret.value);
 
-        if (header_.empty()) {
-            split_header_data();
-        }
+    if (ec != std::errc() || ptr != end) {
+        return std::nullopt;
+    }
+    return ret;
+}
 
-        if (!valid()) {
-            return false;
-        }
+////////////////
+// digit parsing
+////////////////
 
-        return header_index(field).has_value();
+// the bytes are assembled in little endian order independent of the
+// platform, compilers turn this into a single load where possible
+[[nodiscard]] inline uint64_t load_eight_bytes(const char* const begin) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(begin[i]))
+                 << (8 * i);
     }
+    return value;
+}
 
-    template <typename... Ts>
-    void use_fields(const Ts&... fields_args) {
-        assert_ignore_header_not_defined();
-        clear_error();
+[[nodiscard]] inline bool is_eight_digits(const uint64_t value) {
+    return !(((value + 0x4646464646464646) | (value - 0x3030303030303030)) &
+             0x8080808080808080);
+}
 
-        if (header_.empty() && !eof()) {
-            split_header_data();
-        }
+// converts eight digits at once, the value needs to be checked with
+// 'is_eight_digits' first
+[[nodiscard]] inline uint32_t parse_eight_digits(uint64_t value) {
+    constexpr uint64_t mask = 0x000000FF000000FF;
+    constexpr uint64_t mul1 = 0x000F424000000064; // 100 + (1000000 << 32)
+    constexpr uint64_t mul2 = 0x0000271000000001; // 1 + (10000 << 32)
+
+    value -= 0x3030303030303030;
+    value = (value * 10) + (value >> 8);
+    value = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+    return static_cast<uint32_t>(value);
+}
 
-        if (!valid()) {
-            return;
+template <size_t N>
+[[nodiscard]] bool parse_digits(const char* const begin, uint32_t& value) {
+    value = 0;
+    for (size_t i = 0; i < N; ++i) {
+        const auto digit = static_cast<unsigned char>(begin[i] - '0');
+        if (digit > 9) {
+            return false;
         }
+        value = value * 10 + digit;
+    }
+    return true;
+}
 
-        auto fields = std::vector<std::string>{fields_args...};
+////////////////
+// date and time
+////////////////
 
-        if (fields.empty()) {
-            handle_error_invalid_use_fields_argument();
-            return;
-        }
+// days since 1970-01-01 of a proleptic gregorian calendar date
+[[nodiscard]] constexpr int64_t days_from_civil(int64_t year, unsigned month,
+                                                unsigned day) {
+    year -= (month <= 2);
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+                         day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
 
-        std::vector<size_t> column_mappings;
+[[nodiscard]] constexpr bool is_leap_year(int64_t year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
 
-        for (const auto& field : fields) {
-            if (std::count(fields.begin(), fields.end(), field) != 1) {
-                handle_error_field_used_multiple_times(field);
-                return;
-            }
+[[nodiscard]] constexpr unsigned days_in_month(int64_t year, unsigned month) {
+    constexpr unsigned days[] = {31, 28, 31, 30, 31, 30,
+                                 31, 31, 30, 31, 30, 31};
+    return (month == 2 && is_leap_year(year)) ? 29 : days[month - 1];
+}
 
-            auto index = header_index(field);
+// calendar date, converted from 'YYYY-MM-DD'
+struct date {
+    int32_t year{1970};
+    uint8_t month{1};
+    uint8_t day{1};
 
-            if (!index) {
-                handle_error_invalid_field(field);
-                return;
-            }
+    [[nodiscard]] int64_t days_since_epoch() const {
+        return days_from_civil(year, month, day);
+    }
 
-            column_mappings.push_back(*index);
-        }
+    [[nodiscard]] static date from_days_since_epoch(int64_t days) {
+        days += 719468;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const auto doe = static_cast<unsigned>(days - era * 146097);
+        const unsigned yoe =
+            (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        const int64_t year = static_cast<int64_t>(yoe) + era * 400 +
+                             (month <= 2);
 
-        reader_.converter_.set_column_mapping(column_mappings, header_.size());
-        reader_.next_line_converter_.set_column_mapping(column_mappings,
-                                                        header_.size());
+        return date{static_cast<int32_t>(year), static_cast<uint8_t>(month),
+                    static_cast<uint8_t>(day)};
+    }
 
-        if (line() == 0) {
-            ignore_next();
-        }
+    [[nodiscard]] friend bool operator==(const date& lhs, const date& rhs) {
+        return lhs.tied() == rhs.tied();
     }
 
-    ////////////////
-    // iterator
-    ////////////////
+    [[nodiscard]] friend bool operator!=(const date& lhs, const date& rhs) {
+        return lhs.tied() != rhs.tied();
+    }
 
-    template <bool get_object, typename T, typename... Ts>
-    struct iterable {
-        struct iterator {
-            using value = std::conditional_t<get_object, T,
-                                             no_void_validator_tup_t<T, Ts...>>;
+    [[nodiscard]] friend bool operator<(const date& lhs, const date& rhs) {
+        return lhs.tied() < rhs.tied();
+    }
 
-            iterator() : parser_{nullptr}, value_{} {
-            }
+    [[nodiscard]] friend bool operator<=(const date& lhs, const date& rhs) {
+        return lhs.tied() <= rhs.tied();
+    }
 
-            iterator(parser<Options...>* parser) : parser_{parser}, value_{} {
-            }
+    [[nodiscard]] friend bool operator>(const date& lhs, const date& rhs) {
+        return lhs.tied() > rhs.tied();
+    }
 
-            iterator(const iterator& other) = default;
-            iterator(iterator&& other) noexcept = default;
-            ~iterator() = default;
+    [[nodiscard]] friend bool operator>=(const date& lhs, const date& rhs) {
+        return lhs.tied() >= rhs.tied();
+    }
 
-            iterator& operator=(const iterator& other) = delete;
-            iterator& operator=(iterator&& other) noexcept = delete;
+private:
+    [[nodiscard]] std::tuple<int32_t, uint8_t, uint8_t> tied() const {
+        return {year, month, day};
+    }
+};
 
-            [[nodiscard]] value& operator*() {
-                return value_;
-            }
+// point in time stored as nanoseconds since 1970-01-01T00:00:00Z,
+// converted from 'YYYY-MM-DD[THH:MM:SS[.fffffffff][Z|+hh:mm|-hh:mm]]',
+// the supported years are 1678 to 2261
+struct timestamp {
+    using time_point_type =
+        std::chrono::time_point<std::chrono::system_clock,
+                                std::chrono::nanoseconds>;
 
-            [[nodiscard]] value* operator->() {
-                return &value_;
-            }
+    std::chrono::nanoseconds since_epoch{0};
 
-            iterator& operator++() {
-                if (!parser_ || parser_->eof()) {
-                    parser_ = nullptr;
-                } else {
-                    if constexpr (get_object) {
-                        value_ =
-                            std::move(parser_->template get_object<T, Ts...>());
-                    } else {
-                        value_ =
-                            std::move(parser_->template get_next<T, Ts...>());
-                    }
-                }
-                return *this;
-            }
+    [[nodiscard]] time_point_type time_point() const {
+        return time_point_type{since_epoch};
+    }
 
-            iterator operator++(int) {
-                auto result = *this;
-                ++*this;
-                return result;
-            }
+    [[nodiscard]] friend bool operator==(const timestamp& lhs,
+                                         const timestamp& rhs) {
+        return lhs.since_epoch == rhs.since_epoch;
+    }
 
-            [[nodiscard]] friend bool operator==(const iterator& lhs,
-                                                 const iterator& rhs) {
-                return (lhs.parser_ == nullptr && rhs.parser_ == nullptr) ||
-                       (lhs.parser_ == rhs.parser_ &&
-                        &lhs.value_ == &rhs.value_);
-            }
+    [[nodiscard]] friend bool operator!=(const timestamp& lhs,
+                                         const timestamp& rhs) {
+        return lhs.since_epoch != rhs.since_epoch;
+    }
 
-            [[nodiscard]] friend bool operator!=(const iterator& lhs,
-                                                 const iterator& rhs) {
-                return !(lhs == rhs);
-            }
+    [[nodiscard]] friend bool operator<(const timestamp& lhs,
+                                        const timestamp& rhs) {
+        return lhs.since_epoch < rhs.since_epoch;
+    }
 
-        private:
-            parser<Options...>* parser_;
-            value value_;
-        };
+    [[nodiscard]] friend bool operator<=(const timestamp& lhs,
+                                         const timestamp& rhs) {
+        return lhs.since_epoch <= rhs.since_epoch;
+    }
 
-        iterable(parser<Options...>* parser) : parser_{parser} {
-        }
+    [[nodiscard]] friend bool operator>(const timestamp& lhs,
+                                        const timestamp& rhs) {
+        return lhs.since_epoch > rhs.since_epoch;
+    }
 
-        [[nodiscard]] iterator begin() {
-            return ++iterator{parser_};
-        }
+    [[nodiscard]] friend bool operator>=(const timestamp& lhs,
+                                         const timestamp& rhs) {
+        return lhs.since_epoch >= rhs.since_epoch;
+    }
+};
 
-        [[nodiscard]] iterator end() {
-            return iterator{};
-        }
+// point in time converted from an integer count of 'Duration' units since
+// 1970-01-01T00:00:00Z, eg. unix time in seconds or milliseconds
+template <typename Duration>
+struct epoch {
+    using duration = Duration;
+    using time_point_type =
+        std::chrono::time_point<std::chrono::system_clock, Duration>;
 
-    private:
-        parser<Options...>* parser_;
-    };
+    Duration since_epoch{0};
 
-    template <typename... Ts>
-    [[nodiscard]] auto iterate() {
-        return iterable<false, Ts...>{this};
+    [[nodiscard]] time_point_type time_point() const {
+        return time_point_type{since_epoch};
     }
 
-    template <typename... Ts>
-    [[nodiscard]] auto iterate_object() {
-        return iterable<true, Ts...>{this};
+    [[nodiscard]] friend bool operator==(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch == rhs.since_epoch;
     }
 
-    ////////////////
-    // composite conversion
-    ////////////////
-    template <typename... Ts>
-    class composite {
-    public:
-        composite(std::tuple<Ts...>&& values, parser& parser)
-            : values_{std::move(values)}, parser_{parser} {
-        }
+    [[nodiscard]] friend bool operator!=(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch != rhs.since_epoch;
+    }
 
-        // tries to convert the same line with a different output type
-        // only if the previous conversion was not successful,
-        // returns composite containing itself and the new output
-        // as optional, additionally, if a parameter is passed, and
-        // that parameter can be invoked using the converted value,
-        // than it will be invoked in the case of a valid conversion
-        template <typename... Us, typename Fun = none>
-        composite<Ts..., std::optional<no_void_validator_tup_t<Us...>>> or_else(
-            Fun&& fun = none{}) {
-            using Value = no_void_validator_tup_t<Us...>;
-            std::optional<Value> value;
-            try_convert_and_invoke<Value, Us...>(value, std::forward<Fun>(fun));
-            return composite_with(std::move(value));
-        }
+    [[nodiscard]] friend bool operator<(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch < rhs.since_epoch;
+    }
 
-        // same as or_else, but saves the result into a 'U' object
-        // instead of a tuple
-        template <typename U, typename... Us, typename Fun = none>
-        composite<Ts..., std::optional<U>> or_object(Fun&& fun = none{}) {
-            std::optional<U> value;
-            try_convert_and_invoke<U, Us...>(value, std::forward<Fun>(fun));
-            return composite_with(std::move(value));
-        }
+    [[nodiscard]] friend bool operator<=(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch <= rhs.since_epoch;
+    }
 
-        [[nodiscard]] std::tuple<Ts...> values() {
-            return values_;
-        }
+    [[nodiscard]] friend bool operator>(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch > rhs.since_epoch;
+    }
 
-        template <typename Fun>
-        auto on_error(Fun&& fun) {
-            assert_throw_on_error_not_defined<throw_on_error>();
-            if (!parser_.valid()) {
-                if constexpr (std::is_invocable_v<Fun>) {
-                    fun();
-                } else {
-                    static_assert(string_error,
-                                  "to enable error messages within the "
-                                  "on_error method "
-                                  "callback string_error needs to be enabled");
-                    std::invoke(std::forward<Fun>(fun), parser_.error_msg());
-                }
-            }
-            return *this;
-        }
+    [[nodiscard]] friend bool operator>=(const epoch& lhs, const epoch& rhs) {
+        return lhs.since_epoch >= rhs.since_epoch;
+    }
+};
 
-    private:
-        template <typename T>
-        [[nodiscard]] composite<Ts..., T> composite_with(T&& new_value) {
-            auto merged_values =
-                std::tuple_cat(std::move(values_),
-                               std::tuple<T>{parser_.valid()
-                                                 ? std::forward<T>(new_value)
-                                                 : std::nullopt});
-            return {std::move(merged_values), parser_};
-        }
+using epoch_seconds = epoch<std::chrono::seconds>;
+using epoch_milliseconds = epoch<std::chrono::milliseconds>;
+using epoch_microseconds = epoch<std::chrono::microseconds>;
+using epoch_nanoseconds = epoch<std::chrono::nanoseconds>;
 
-        template <typename U, typename... Us, typename Fun = none>
-        void try_convert_and_invoke(std::optional<U>& value, Fun&& fun) {
-            if (parser_.valid()) {
-                return;
-            }
+// parses 'YYYY-MM-DD', the year, month and day digits are gathered into
+// one word and converted at once
+[[nodiscard]] inline bool parse_date(const char* const begin, date& value) {
+    if (begin[4] != '-' || begin[7] != '-') {
+        return false;
+    }
 
-            auto tuple_output = try_same<Us...>();
-            if (!parser_.valid()) {
-                return;
-            }
+    char digits[8];
+    std::memcpy(digits, begin, 4);
+    std::memcpy(digits + 4, begin + 5, 2);
+    std::memcpy(digits + 6, begin + 8, 2);
 
-            if constexpr (!std::is_same_v<U, decltype(tuple_output)>) {
-                value = to_object<U>(std::move(tuple_output));
-            } else {
-                value = std::move(tuple_output);
-            }
+    const uint64_t word = load_eight_bytes(digits);
+    if (!is_eight_digits(word)) {
+        return false;
+    }
 
-            parser_.try_invoke(*value, std::forward<Fun>(fun));
+    const uint32_t ymd = parse_eight_digits(word);
+    const uint32_t year = ymd / 10000;
+    const uint32_t month = ymd / 100 % 100;
+    const uint32_t day = ymd % 100;
+
+    if (month < 1 || month > 12 || day < 1 ||
+        day > days_in_month(year, month)) {
+        return false;
+    }
+
+    value = date{static_cast<int32_t>(year), static_cast<uint8_t>(month),
+                 static_cast<uint8_t>(day)};
+    return true;
+}
+
+// parses 'HH:MM:SS', returns the number of seconds since midnight
+[[nodiscard]] inline bool parse_time_of_day(const char* const begin,
+                                            int64_t& seconds) {
+    if (begin[2] != ':' || begin[5] != ':') {
+        return false;
+    }
+
+    uint32_t hours = 0;
+    uint32_t minutes = 0;
+    uint32_t secs = 0;
+    if (!parse_digits<2>(begin, hours) || !parse_digits<2>(begin + 3, minutes) ||
+        !parse_digits<2>(begin + 6, secs)) {
+        return false;
+    }
+
+    if (hours > 23 || minutes > 59 || secs > 59) {
+        return false;
+    }
+
+    seconds = hours * 3600 + minutes * 60 + secs;
+    return true;
+}
+
+// parses up to nine fraction digits, returns the number of nanoseconds
+[[nodiscard]] inline bool parse_fraction(const char*& begin,
+                                         const char* const end,
+                                         int64_t& nanoseconds) {
+    constexpr static uint32_t scale[] = {1000000000, 100000000, 10000000,
+                                         1000000,    100000,    10000,
+                                         1000,       100,       10,
+                                         1};
+
+    const char* curr = begin;
+    uint32_t value = 0;
+
+    if (end - curr >= 8) {
+        if (const uint64_t word = load_eight_bytes(curr);
+            is_eight_digits(word)) {
+            value = parse_eight_digits(word);
+            curr += 8;
         }
+    }
 
-        template <typename U, typename... Us>
-        [[nodiscard]] no_void_validator_tup_t<U, Us...> try_same() {
-            parser_.clear_error();
-            auto value =
-                parser_.reader_.converter_.template convert<U, Us...>();
-            if (!parser_.reader_.converter_.valid()) {
-                parser_.handle_error_invalid_conversion();
-            }
-            return value;
+    while (curr != end && curr - begin < 9) {
+        const auto digit = static_cast<unsigned char>(*curr - '0');
+        if (digit > 9) {
+            break;
         }
+        value = value * 10 + digit;
+        ++curr;
+    }
 
-        ////////////////
-        // members
-        ////////////////
+    const auto digits = curr - begin;
+    if (digits == 0) {
+        return false;
+    }
 
-        std::tuple<Ts...> values_;
-        parser& parser_;
-    };
+    nanoseconds = static_cast<int64_t>(value) * scale[digits];
+    begin = curr;
+    return true;
+}
 
-    // tries to convert a line and returns a composite which is
-    // able to try additional conversions in case of failure
-    template <typename... Ts, typename Fun = none>
-    [[nodiscard]] composite<std::optional<no_void_validator_tup_t<Ts...>>>
-    try_next(Fun&& fun = none{}) {
-        assert_throw_on_error_not_defined<throw_on_error>();
-        using Ret = no_void_validator_tup_t<Ts...>;
-        return try_invoke_and_make_composite<
-            std::optional<Ret>>(get_next<Ts...>(), std::forward<Fun>(fun));
+// parses 'Z', '+hh:mm', '-hh:mm', '+hhmm', '-hhmm', '+hh' or '-hh', returns
+// the offset from utc in seconds
+[[nodiscard]] inline bool parse_utc_offset(const char* begin,
+                                           const char* const end,
+                                           int64_t& seconds) {
+    const auto size = end - begin;
+    if (size == 1 && (*begin == 'Z' || *begin == 'z')) {
+        seconds = 0;
+        return true;
     }
 
-    // identical to try_next but returns composite with object instead of a
-    // tuple
-    template <typename T, typename... Ts, typename Fun = none>
-    [[nodiscard]] composite<std::optional<T>> try_object(Fun&& fun = none{}) {
-        assert_throw_on_error_not_defined<throw_on_error>();
-        return try_invoke_and_make_composite<
-            std::optional<T>>(get_object<T, Ts...>(), std::forward<Fun>(fun));
+    if (size != 3 && size != 5 && size != 6) {
+        return false;
     }
 
-private:
-    // tries to invoke the given function (see below), if the function
-    // returns a value which can be used as a conditional, and it returns
-    // false, the function sets an error, and allows the invoke of the
-    // next possible conversion as if the validation of the current one
-    // failed
-    template <typename Arg, typename Fun = none>
-    void try_invoke(Arg&& arg, Fun&& fun) {
-        constexpr bool is_none = std::is_same_v<std::decay_t<Fun>, none>;
-        if constexpr (!is_none) {
-            using Ret = decltype(try_invoke_impl(arg, std::forward<Fun>(fun)));
-            constexpr bool returns_void = std::is_same_v<Ret, void>;
-            if constexpr (!returns_void) {
-                if (!try_invoke_impl(std::forward<Arg>(arg),
-                                     std::forward<Fun>(fun))) {
-                    handle_error_failed_check();
-                }
-            } else {
-                try_invoke_impl(arg, std::forward<Fun>(fun));
+    if (*begin != '+' && *begin != '-') {
+        return false;
+    }
+    const bool negative = (*begin == '-');
+    ++begin;
+
+    uint32_t hours = 0;
+    uint32_t minutes = 0;
+    if (!parse_digits<2>(begin, hours)) {
+        return false;
+    }
+
+    if (size == 5 && !parse_digits<2>(begin + 2, minutes)) {
+        return false;
+    }
+
+    if (size == 6 && (begin[2] != ':' || !parse_digits<2>(begin + 3, minutes))) {
+        return false;
+    }
+
+    if (hours > 23 || minutes > 59) {
+        return false;
+    }
+
+    seconds = hours * 3600 + minutes * 60;
+    if (negative) {
+        seconds = -seconds;
+    }
+    return true;
+}
+
+[[nodiscard]] inline bool parse_timestamp(const char* begin,
+                                          const char* const end,
+                                          timestamp& value) {
+    constexpr static auto date_size = 10;
+    constexpr static auto time_size = 8;
+    constexpr static int64_t min_year = 1678;
+    constexpr static int64_t max_year = 2261;
+    constexpr static int64_t seconds_per_day = 86400;
+    constexpr static int64_t nanoseconds_per_second = 1000000000;
+
+    if (end - begin < date_size) {
+        return false;
+    }
+
+    date d;
+    if (!parse_date(begin, d) || d.year < min_year || d.year > max_year) {
+        return false;
+    }
+    begin += date_size;
+
+    int64_t seconds = 0;
+    int64_t nanoseconds = 0;
+    int64_t offset = 0;
+
+    if (begin != end) {
+        if (*begin != 'T' && *begin != 't' && *begin != ' ') {
+            return false;
+        }
+        ++begin;
+
+        if (end - begin < time_size || !parse_time_of_day(begin, seconds)) {
+            return false;
+        }
+        begin += time_size;
+
+        if (begin != end && (*begin == '.' || *begin == ',')) {
+            ++begin;
+            if (!parse_fraction(begin, end, nanoseconds)) {
+                return false;
             }
         }
+
+        if (begin != end && !parse_utc_offset(begin, end, offset)) {
+            return false;
+        }
     }
 
-    // tries to invoke the function if not none
-    // it first tries to invoke the function without arguments,
-    // than with one argument if the function accepts the whole tuple
-    // as an argument, and finally tries to invoke it with the tuple
-    // laid out as a parameter pack
-    template <typename Arg, typename Fun = none>
-    auto try_invoke_impl(Arg&& arg, Fun&& fun) {
-        constexpr bool is_none = std::is_same_v<std::decay_t<Fun>, none>;
-        if constexpr (!is_none) {
-            if constexpr (std::is_invocable_v<Fun>) {
-                return fun();
-            } else if constexpr (std::is_invocable_v<Fun, Arg>) {
-                return std::invoke(std::forward<Fun>(fun),
-                                   std::forward<Arg>(arg));
-            } else {
-                return std::apply(std::forward<Fun>(fun),
-                                  std::forward<Arg>(arg));
+    seconds += d.days_since_epoch() * seconds_per_day - offset;
+    value.since_epoch = std::chrono::nanoseconds{
+        seconds * nanoseconds_per_second + nanoseconds};
+    return true;
+}
+
+////////////////
+// decimal
+////////////////
+
+// digits beyond the scale are rounded half away from zero
+class decimal_round {};
+
+// digits beyond the scale are dropped
+class decimal_truncate {};
+
+// allows the integral digits to be grouped by the given character,
+// eg. '1,234,567.89', each group after the first needs to have 3 digits
+template <char C>
+class thousands_separator {};
+
+template <typename T>
+struct is_decimal_round : std::is_same<T, decimal_round> {};
+
+template <typename T>
+struct is_decimal_truncate : std::is_same<T, decimal_truncate> {};
+
+template <typename T>
+struct is_thousands_separator : std::false_type {};
+
+template <char C>
+struct is_thousands_separator<thousands_separator<C>> : std::true_type {};
+
+template <typename... Options>
+struct get_thousands_separator {
+    constexpr static bool enabled = false;
+    constexpr static char value = '\0';
+};
+
+template <char C, typename... Options>
+struct get_thousands_separator<thousands_separator<C>, Options...> {
+    constexpr static bool enabled = true;
+    constexpr static char value = C;
+};
+
+template <typename T, typename... Options>
+struct get_thousands_separator<T, Options...>
+    : get_thousands_separator<Options...> {};
+
+// fixed point number holding 'value / 10^Scale', converted exactly from its
+// decimal representation, by default conversions of values with more
+// non zero fraction digits than 'Scale' fail, 'decimal_round' or
+// 'decimal_truncate' can be given as options to change that
+template <size_t Scale, typename Rep = int64_t, typename... Options>
+struct decimal {
+    static_assert(std::is_integral_v<Rep> && !std::is_same_v<Rep, bool>,
+                  "decimal representation needs to be an integral type");
+    static_assert(Scale <= std::numeric_limits<Rep>::digits10,
+                  "decimal scale too big for the representation");
+
+    using rep = Rep;
+    constexpr static size_t scale = Scale;
+
+    constexpr static bool round = count_v<is_decimal_round, Options...> == 1;
+    constexpr static bool truncate =
+        count_v<is_decimal_truncate, Options...> == 1;
+    constexpr static bool thousands_separator =
+        get_thousands_separator<Options...>::enabled;
+    constexpr static char separator =
+        get_thousands_separator<Options...>::value;
+
+    static_assert(count_v<is_decimal_round, Options...> +
+                          count_v<is_decimal_truncate, Options...> <=
+                      1,
+                  "decimal rounding defined multiple times");
+    static_assert(count_v<is_thousands_separator, Options...> <= 1,
+                  "thousands separator defined multiple times");
+    static_assert(count_v<is_decimal_round, Options...> +
+                          count_v<is_decimal_truncate, Options...> +
+                          count_v<is_thousands_separator, Options...> ==
+                      sizeof...(Options),
+                  "one or multiple invalid decimal options defined");
+
+    constexpr static Rep denominator = [] {
+        Rep ret = 1;
+        for (size_t i = 0; i < Scale; ++i) {
+            ret *= 10;
+        }
+        return ret;
+    }();
+
+    Rep value{0};
+
+    [[nodiscard]] Rep integral_part() const {
+        return value / denominator;
+    }
+
+    [[nodiscard]] Rep fractional_part() const {
+        return value % denominator;
+    }
+
+    [[nodiscard]] double to_double() const {
+        return static_cast<double>(value) / static_cast<double>(denominator);
+    }
+
+    [[nodiscard]] friend bool operator==(const decimal& lhs,
+                                         const decimal& rhs) {
+        return lhs.value == rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator!=(const decimal& lhs,
+                                         const decimal& rhs) {
+        return lhs.value != rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator<(const decimal& lhs,
+                                        const decimal& rhs) {
+        return lhs.value < rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator<=(const decimal& lhs,
+                                         const decimal& rhs) {
+        return lhs.value <= rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator>(const decimal& lhs,
+                                        const decimal& rhs) {
+        return lhs.value > rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator>=(const decimal& lhs,
+                                         const decimal& rhs) {
+        return lhs.value >= rhs.value;
+    }
+
+};
+
+template <typename T>
+struct is_decimal : std::false_type {};
+
+template <size_t Scale, typename Rep, typename... Options>
+struct is_decimal<decimal<Scale, Rep, Options...>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_decimal_v = is_decimal<T>::value;
+
+// appends one digit to the value, fails on overflow
+template <typename U>
+[[nodiscard]] bool push_digit(U& value, unsigned digit, const U max) {
+    if (value > (max - digit) / 10) {
+        return false;
+    }
+    value = value * 10 + digit;
+    return true;
+}
+
+// appends a run of digits to the value, eight digits are converted at once
+// while possible, returns the end of the run or nullptr on overflow
+template <typename U>
+[[nodiscard]] const char* push_digit_run(const char* begin,
+                                         const char* const end, U& value,
+                                         const U max) {
+    if constexpr (std::numeric_limits<U>::digits10 >= 8) {
+        constexpr static U eight_digits_scale = 100000000;
+        while (end - begin >= 8) {
+            const uint64_t word = load_eight_bytes(begin);
+            if (!is_eight_digits(word)) {
+                break;
             }
+
+            const U chunk = parse_eight_digits(word);
+            if (value > (max - chunk) / eight_digits_scale) {
+                return nullptr;
+            }
+            value = value * eight_digits_scale + chunk;
+            begin += 8;
         }
     }
 
-    template <typename T, typename Fun = none>
-    [[nodiscard]] composite<T> try_invoke_and_make_composite(T&& value,
-                                                             Fun&& fun) {
-        if (valid()) {
-            try_invoke(*value, std::forward<Fun>(fun));
+    for (; begin != end; ++begin) {
+        const auto digit = static_cast<unsigned char>(*begin - '0');
+        if (digit > 9) {
+            break;
+        }
+        if (!push_digit(value, digit, max)) {
+            return nullptr;
         }
-        return {valid() ? std::forward<T>(value) : std::nullopt, *this};
     }
 
-    ////////////////
-    // header
-    ////////////////
+    return begin;
+}
 
-    void assert_ignore_header_not_defined() const {
-        static_assert(!ignore_header,
-                      "cannot use this method when 'ignore_header' is defined");
+template <typename T>
+[[nodiscard]] bool parse_decimal(const char* begin, const char* const end,
+                                 T& dst) {
+    using rep = typename T::rep;
+    using U = std::make_unsigned_t<rep>;
+
+    if (begin == end) {
+        return false;
     }
 
-    [[nodiscard]] bool strict_split(header_splitter& splitter,
-                                    std::string& header) {
-        if constexpr (throw_on_error) {
-            try {
-                splitter.split(header.data(), reader_.delim_);
-            } catch (const ss::exception& e) {
-                decorate_rethrow_invalid_header_split(e);
+    bool negative = false;
+    if (*begin == '-' || *begin == '+') {
+        negative = (*begin == '-');
+        ++begin;
+        if constexpr (std::is_unsigned_v<rep>) {
+            if (negative) {
+                return false;
             }
-        } else {
-            splitter.split(header.data(), reader_.delim_);
-            if (!splitter.valid()) {
-                handle_error_invalid_header_split(splitter);
+        }
+    }
+
+    // the magnitude of the minimum value is one bigger than the maximum
+    const U max = static_cast<U>(std::numeric_limits<rep>::max()) +
+                  static_cast<U>(negative);
+    U value = 0;
+
+    const char* const integral_begin = begin;
+    begin = push_digit_run(begin, end, value, max);
+    if (!begin) {
+        return false;
+    }
+
+    if constexpr (T::thousands_separator) {
+        if (begin != end && *begin == T::separator) {
+            const auto first_group_size = begin - integral_begin;
+            if (first_group_size == 0 || first_group_size > 3) {
+                return false;
+            }
+
+            while (begin != end && *begin == T::separator) {
+                ++begin;
+                const char* const group_end =
+                    push_digit_run(begin, end, value, max);
+                if (!group_end || group_end - begin != 3) {
+                    return false;
+                }
+                begin = group_end;
+            }
+        }
+    }
+
+    bool has_digits = (begin != integral_begin);
+    size_t fraction_digits = 0;
+    bool round_up = false;
+
+    if (begin != end && *begin == '.') {
+        ++begin;
+        const char* const fraction_begin = begin;
+
+        const auto scaled_size =
+            std::min(T::scale, static_cast<size_t>(end - begin));
+        begin = push_digit_run(begin, begin + scaled_size, value, max);
+        if (!begin) {
+            return false;
+        }
+        fraction_digits = static_cast<size_t>(begin - fraction_begin);
+
+        // digits beyond the scale
+        for (const char* curr = begin; curr != end; ++curr) {
+            const auto digit = static_cast<unsigned char>(*curr - '0');
+            if (digit > 9) {
                 return false;
             }
+            if constexpr (T::round) {
+                round_up = round_up || (curr == begin && digit >= 5);
+            } else if constexpr (!T::truncate) {
+                if (digit != 0) {
+                    return false;
+                }
+            }
+        }
+        begin = end;
+
+        has_digits = has_digits || (fraction_begin != end);
+    }
+
+    if (begin != end || !has_digits) {
+        return false;
+    }
+
+    for (; fraction_digits < T::scale; ++fraction_digits) {
+        if (!push_digit(value, 0, max)) {
+            return false;
+        }
+    }
+
+    if (round_up) {
+        if (value == max) {
+            return false;
         }
+        ++value;
+    }
+
+    if (negative) {
+        // computed within the unsigned type to support the minimum value
+        dst.value = static_cast<rep>(U{0} - value);
+    } else {
+        dst.value = static_cast<rep>(value);
+    }
+    return true;
+}
+
+////////////////
+// enum map
+////////////////
+
+// maps strings to enum values, needs to be specialized for an enum with a
+// static constexpr array of name and value pairs named 'values', eg.
+// template <>
+// struct ss::enum_map<side> {
+//     constexpr static std::pair<std::string_view, side> values[] = {
+//         {"BUY", side::buy}, {"SELL", side::sell}};
+// };
+template <typename E>
+struct enum_map {};
+
+template <typename T, typename = void>
+struct has_enum_map : std::false_type {};
+
+template <typename T>
+struct has_enum_map<T, std::void_t<decltype(enum_map<T>::values)>>
+    : std::true_type {};
+
+template <typename T>
+constexpr bool has_enum_map_v = has_enum_map<T>::value;
+
+constexpr inline uint16_t enum_hash_empty_slot = 0xFFFF;
+constexpr inline uint32_t enum_hash_max_seeds = 64;
+
+[[nodiscard]] constexpr uint32_t enum_hash(std::string_view key,
+                                           uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (const char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// at least four slots per key, the number of slots is a power of two
+[[nodiscard]] constexpr size_t enum_hash_slots(size_t size) {
+    size_t slots = 1;
+    while (slots < size * 4) {
+        slots *= 2;
+    }
+    return slots;
+}
+
+template <size_t Slots>
+struct enum_hash_table {
+    uint32_t seed{0};
+    size_t max_probe{0};
+    std::array<uint16_t, Slots> slots{};
+};
+
+template <typename E>
+[[nodiscard]] constexpr bool enum_map_unique() {
+    constexpr size_t size = std::size(enum_map<E>::values);
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t j = i + 1; j < size; ++j) {
+            if (enum_map<E>::values[i].first == enum_map<E>::values[j].first) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// open addressing table built at compile time, the seed with the shortest
+// maximum probe length is chosen, with a probe length of zero the table is
+// a perfect hash and each lookup needs at most one string comparison
+template <typename E>
+[[nodiscard]] constexpr auto make_enum_hash_table() {
+    constexpr size_t size = std::size(enum_map<E>::values);
+    constexpr size_t slots = enum_hash_slots(size);
+    constexpr size_t mask = slots - 1;
+    static_assert(size < enum_hash_empty_slot, "enum map too big");
+
+    enum_hash_table<slots> best{};
+    best.max_probe = slots;
+
+    for (uint32_t seed = 0; seed < enum_hash_max_seeds && best.max_probe > 0;
+         ++seed) {
+        enum_hash_table<slots> table{};
+        table.seed = seed;
+        for (auto& slot : table.slots) {
+            slot = enum_hash_empty_slot;
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            size_t slot = enum_hash(enum_map<E>::values[i].first, seed) & mask;
+            size_t probe = 0;
+            while (table.slots[slot] != enum_hash_empty_slot) {
+                slot = (slot + 1) & mask;
+                ++probe;
+            }
+            table.slots[slot] = static_cast<uint16_t>(i);
+            table.max_probe = std::max(table.max_probe, probe);
+        }
+
+        if (table.max_probe < best.max_probe) {
+            best = table;
+        }
+    }
+
+    return best;
+}
+
+template <typename E>
+constexpr inline auto enum_hash_table_v = make_enum_hash_table<E>();
+
+template <typename E>
+[[nodiscard]] bool extract_enum(const char* begin, const char* end,
+                                E& value) {
+    static_assert(enum_map_unique<E>(), "enum map has duplicate names");
+
+    constexpr auto& table = enum_hash_table_v<E>;
+    constexpr size_t mask = table.slots.size() - 1;
+
+    const std::string_view key{begin, static_cast<size_t>(end - begin)};
+    size_t slot = enum_hash(key, table.seed) & mask;
+
+    for (size_t probe = 0; probe <= table.max_probe; ++probe) {
+        const auto index = table.slots[slot];
+        if (index == enum_hash_empty_slot) {
+            return false;
+        }
+
+        const auto& [name, enum_value] = enum_map<E>::values[index];
+        if (name == key) {
+            value = enum_value;
+            return true;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return false;
+}
+
+////////////////
+// string pool
+////////////////
+
+// stores each distinct string only once, the stored strings are never moved
+// so views to them stay valid until the pool is cleared, the code of a
+// string is the order in which it was first interned
+class string_pool {
+public:
+    [[nodiscard]] std::pair<std::string_view, size_t> intern(
+        const char* begin, const char* end) {
+        const std::string_view value{begin, static_cast<size_t>(end - begin)};
+        if (auto it = codes_.find(value); it != codes_.end()) {
+            return {it->first, it->second};
+        }
+
+        const size_t code = strings_.size();
+        const std::string_view stored = strings_.emplace_back(value);
+        codes_.emplace(stored, code);
+        return {stored, code};
+    }
+
+    [[nodiscard]] std::string_view at(size_t code) const {
+        return strings_.at(code);
+    }
+
+    [[nodiscard]] size_t size() const {
+        return strings_.size();
+    }
+
+    void clear() {
+        codes_.clear();
+        strings_.clear();
+    }
+
+private:
+    std::deque<std::string> strings_;
+    std::unordered_map<std::string_view, size_t> codes_;
+};
+
+////////////////
+// arena
+////////////////
+
+// bump allocator for string data, bytes are copied into large blocks which
+// are never moved, so views to them stay valid until the arena is reset,
+// reset blocks are reused instead of being freed
+class arena {
+public:
+    explicit arena(size_t block_size = default_arena_block_size)
+        : block_size_{block_size > 0 ? block_size : 1} {
+    }
+
+    arena(arena&& other) = default;
+    arena& operator=(arena&& other) = default;
+
+    arena(const arena& other) = delete;
+    arena& operator=(const arena& other) = delete;
+
+    [[nodiscard]] std::string_view store(const char* begin, const char* end) {
+        const auto size = static_cast<size_t>(end - begin);
+        if (size == 0) {
+            return {};
+        }
+
+        if (curr_ == blocks_.size() || blocks_[curr_].size - used_ < size) {
+            next_block(size);
+        }
+
+        char* const dst = blocks_[curr_].data.get() + used_;
+        std::memcpy(dst, begin, size);
+        used_ += size;
+        size_ += size;
+        return {dst, size};
+    }
+
+    [[nodiscard]] std::string_view store(std::string_view value) {
+        return store(value.data(), value.data() + value.size());
+    }
+
+    // invalidates all stored views, keeps the allocated blocks
+    void reset() {
+        curr_ = blocks_.size();
+        used_ = 0;
+        size_ = 0;
+        reused_ = 0;
+    }
+
+    // invalidates all stored views, frees the allocated blocks
+    void release() {
+        blocks_.clear();
+        curr_ = 0;
+        used_ = 0;
+        size_ = 0;
+        reused_ = 0;
+    }
+
+    // number of bytes stored since the last reset
+    [[nodiscard]] size_t size() const {
+        return size_;
+    }
+
+    // number of bytes allocated
+    [[nodiscard]] size_t capacity() const {
+        size_t capacity = 0;
+        for (const auto& block : blocks_) {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+
+private:
+    struct block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    void next_block(size_t size) {
+        // after a reset the blocks are reused in the same order
+        while (reused_ < blocks_.size()) {
+            const size_t i = reused_++;
+            if (blocks_[i].size >= size) {
+                curr_ = i;
+                used_ = 0;
+                return;
+            }
+        }
+
+        const size_t block_size = std::max(block_size_, size);
+        blocks_.push_back(block{std::unique_ptr<char[]>{new char[block_size]},
+                                block_size});
+        curr_ = blocks_.size() - 1;
+        reused_ = blocks_.size();
+        used_ = 0;
+    }
+
+    size_t block_size_;
+    std::vector<block> blocks_;
+    size_t curr_{0};
+    size_t used_{0};
+    size_t size_{0};
+    size_t reused_{0};
+};
+
+////////////////
+// category
+////////////////
+
+// interned string, holds a view to the string stored within a pool and
+// its code which is unique within that pool
+struct category {
+    std::string_view value;
+    size_t code{0};
+
+    operator std::string_view() const {
+        return value;
+    }
+
+    [[nodiscard]] friend bool operator==(const category& lhs,
+                                         const category& rhs) {
+        return lhs.value == rhs.value;
+    }
+
+    [[nodiscard]] friend bool operator!=(const category& lhs,
+                                         const category& rhs) {
+        return !(lhs == rhs);
+    }
+};
+
+////////////////
+// extract
+////////////////
+
+namespace error {
+template <typename T>
+struct unsupported_type {
+    constexpr static bool value = false;
+};
+} /* namespace errors */
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<!std::is_integral_v<T> &&
+                                   !std::is_floating_point_v<T> &&
+                                   !is_instance_of_v<std::optional, T> &&
+                                   !is_instance_of_v<std::variant, T> &&
+                                   !is_instance_of_v<numeric_wrapper, T> &&
+                                   !is_instance_of_v<epoch, T> &&
+                                   !is_decimal_v<T> && !has_enum_map_v<T>,
+                               bool>
+extract(const char*, const char*, T&) {
+    static_assert(error::unsupported_type<T>::value,
+                  "Conversion for given type is not defined, an "
+                  "\'extract\' function needs to be defined!");
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_integral_v<T> ||
+                                   std::is_floating_point_v<T> ||
+                                   is_instance_of_v<numeric_wrapper, T>,
+                               bool>
+extract(const char* begin, const char* end, T& value) {
+    auto optional_value = to_num<T>(begin, end);
+    if (!optional_value) {
+        return false;
+    }
+    value = optional_value.value();
+    return true;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<epoch, T>, bool> extract(
+    const char* begin, const char* end, T& value) {
+    auto count = to_num<typename T::duration::rep>(begin, end);
+    if (!count) {
+        return false;
+    }
+    value.since_epoch = typename T::duration{count.value()};
+    return true;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_decimal_v<T>, bool> extract(
+    const char* begin, const char* end, T& value) {
+    return parse_decimal(begin, end, value);
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<has_enum_map_v<T>, bool> extract(
+    const char* begin, const char* end, T& value) {
+    return extract_enum(begin, end, value);
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<std::optional, T>, bool>
+extract(const char* begin, const char* end, T& value) {
+    typename T::value_type raw_value;
+    if (extract(begin, end, raw_value)) {
+        value = raw_value;
+    } else {
+        value = std::nullopt;
+    }
+    return true;
+}
+
+// result of a single scan of a field, used to skip the numeric variant
+// alternatives which can not be converted
+struct field_class {
+    // optional minus followed by digits only
+    bool integer{false};
+    // has a digit or could be 'inf' or 'nan'
+    bool floating_point{false};
+};
+
+[[nodiscard]] inline field_class classify_field(const char* const begin,
+                                                const char* const end) {
+    if (begin == end) {
+        return {};
+    }
+
+    const char* curr = begin + (*begin == '-');
+    bool all_digits = (curr != end);
+    bool has_digit = false;
+    bool may_be_special = false;
+
+    // bitwise operations instead of logical ones keep the loop branchless
+    for (; curr != end; ++curr) {
+        const bool digit = static_cast<unsigned char>(*curr - '0') <= 9;
+        const char lower = static_cast<char>(*curr | 0x20);
+        all_digits &= digit;
+        has_digit |= digit;
+        may_be_special |= (lower == 'i') | (lower == 'n');
+    }
+
+    return {all_digits, has_digit || may_be_special};
+}
+
+// false only if the conversion of the field to T would certainly fail
+template <typename T>
+[[nodiscard]] bool may_extract(const field_class& field) {
+    if constexpr ((std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                   !std::is_same_v<T, char>) ||
+                  is_instance_of_v<numeric_wrapper, T>) {
+        return field.integer;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return field.floating_point;
+    } else {
+        return true;
+    }
+}
+
+template <typename T, size_t I>
+[[nodiscard]] bool extract_variant(const char* begin, const char* end,
+                                   T& value, const field_class& field) {
+    using IthType = std::variant_alternative_t<I, std::decay_t<T>>;
+    if (may_extract<IthType>(field)) {
+        IthType ithValue;
+        if (extract<IthType>(begin, end, ithValue)) {
+            value.template emplace<I>(std::move(ithValue));
+            return true;
+        }
+    }
+
+    if constexpr (I + 1 < std::variant_size_v<T>) {
+        return extract_variant<T, I + 1>(begin, end, value, field);
+    }
+    return false;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<std::variant, T>, bool> extract(
+    const char* begin, const char* end, T& value) {
+    return extract_variant<T, 0>(begin, end, value,
+                                 classify_field(begin, end));
+}
+
+////////////////
+// extract specialization
+////////////////
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  bool& value) {
+    if (end == begin + 1) {
+        if (*begin == '1') {
+            value = true;
+        } else if (*begin == '0') {
+            value = false;
+        } else {
+            return false;
+        }
+    } else {
+        constexpr static auto true_size = 4;
+        constexpr static auto false_size = 5;
+        const size_t size = end - begin;
+        if (size == true_size && std::strncmp(begin, "true", size) == 0) {
+            value = true;
+        } else if (size == false_size &&
+                   std::strncmp(begin, "false", size) == 0) {
+            value = false;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  char& value) {
+    value = *begin;
+    return (end == begin + 1);
+}
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  std::string& value) {
+    value.assign(begin, end);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  std::pmr::string& value) {
+    value.assign(begin, end);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  std::string_view& value) {
+    value = std::string_view{begin, static_cast<size_t>(end - begin)};
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  date& value) {
+    constexpr static auto date_size = 10;
+    return end - begin == date_size && parse_date(begin, value);
+}
+
+template <>
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  timestamp& value) {
+    return parse_timestamp(begin, end, value);
+}
+
+[[nodiscard]] inline bool extract(const char* begin, const char* end,
+                                  category& value, string_pool& pool) {
+    std::tie(value.value, value.code) = pool.intern(begin, end);
+    return true;
+}
+
+} /* namespace ss */
+
+namespace ss {
+INIT_HAS_METHOD(tied)
+INIT_HAS_METHOD(ss_valid)
+INIT_HAS_METHOD(error)
+
+////////////////
+// replace validator
+////////////////
+
+// replace 'validator' types with elements they operate on
+// eg. no_validator_tup_t<int, ss::nx<char, 'A', 'B'>> <=> std::tuple<int, char>
+// where ss::nx<char, 'A', 'B'> is a validator '(n)one e(x)cept' which
+// checks if the returned character is either 'A' or 'B', returns error if not
+// additionally if one element is left in the pack, it will be unwrapped from
+// the tuple eg. no_void_validator_tup_t<int> <=> int instead of std::tuple<int>
+template <typename T, typename U = void>
+struct no_validator;
+
+template <typename T>
+struct no_validator<T, typename std::enable_if_t<has_m_ss_valid_t<T>>> {
+    using type = typename member_wrapper<decltype(&T::ss_valid)>::arg_type;
+};
+
+template <typename T, typename U>
+struct no_validator {
+    using type = T;
+};
+
+template <typename T>
+using no_validator_t = typename no_validator<T>::type;
+
+template <typename... Ts>
+struct no_validator_tup : apply_trait<no_validator, std::tuple<Ts...>> {};
+
+template <typename... Ts>
+struct no_validator_tup<std::tuple<Ts...>> : no_validator_tup<Ts...> {};
+
+template <typename T>
+struct no_validator_tup<std::tuple<T>> : no_validator<T> {};
+
+template <typename... Ts>
+using no_validator_tup_t = typename no_validator_tup<Ts...>::type;
+
+////////////////
+// no void tuple
+////////////////
+
+template <typename... Ts>
+struct no_void_tup : filter_not<std::is_void, no_validator_tup_t<Ts...>> {};
+
+template <typename... Ts>
+using no_void_tup_t = filter_not_t<std::is_void, Ts...>;
+
+////////////////
+// no void or validator
+////////////////
+
+// replace 'validators' and remove void from tuple
+template <typename... Ts>
+struct no_void_validator_tup : no_validator_tup<no_void_tup_t<Ts...>> {};
+
+template <typename... Ts>
+struct no_void_validator_tup<std::tuple<Ts...>>
+    : no_validator_tup<no_void_tup_t<Ts...>> {};
+
+template <typename... Ts>
+using no_void_validator_tup_t = typename no_void_validator_tup<Ts...>::type;
+
+////////////////
+// tied class
+////////////////
+
+// check if the parameter pack is only one element which is a class and has
+// the 'tied' method which is to be used for type deduction when converting
+template <typename T, typename... Ts>
+struct tied_class {
+    constexpr static bool value =
+        (sizeof...(Ts) == 0 && std::is_class_v<T> && has_m_tied<T>::value);
+};
+
+template <typename... Ts>
+constexpr bool tied_class_v = tied_class<Ts...>::value;
+
+////////////////
+// column types
+////////////////
+
+// each type has a unique address, used to compare column types at runtime
+template <typename T>
+struct type_tag {
+    constexpr static char id{};
+};
+
+template <typename... Ts>
+constexpr inline const void* column_type_ids[] = {&type_tag<Ts>::id...};
+
+////////////////
+// pmr string
+////////////////
+
+template <typename T>
+struct is_pmr_string : std::is_same<T, std::pmr::string> {};
+
+template <typename T>
+constexpr bool is_pmr_string_v = is_pmr_string<T>::value;
+
+////////////////
+// category
+////////////////
+
+// categories need the string pool of the converter, also when they are
+// wrapped into an optional or a variant
+template <typename T>
+struct has_category : std::is_same<T, category> {};
+
+template <typename T>
+struct has_category<std::optional<T>> : has_category<T> {};
+
+template <typename... Ts>
+struct has_category<std::variant<Ts...>>
+    : std::disjunction<has_category<Ts>...> {};
+
+template <typename T>
+constexpr bool has_category_v = has_category<T>::value;
+
+////////////////
+// converter
+////////////////
+
+template <typename... Options>
+class converter {
+    using line_ptr_type = typename splitter<Options...>::line_ptr_type;
+
+    constexpr static auto string_error = setup<Options...>::string_error;
+    constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
+    constexpr static auto arena_views = setup<Options...>::arena_views;
+    constexpr static auto default_delimiter = ",";
+
+    using error_type = std::conditional_t<string_error, std::string, bool>;
+
+public:
+    converter() = default;
+
+    // the split data and the converted 'std::pmr::string' values are
+    // allocated from the given memory resource
+    explicit converter(std::pmr::memory_resource* resource)
+        : splitter_{resource}, resource_{resource_or_default(resource)} {
+    }
+
+    // parses line with given delimiter, returns a 'T' object created with
+    // extracted values of type 'Ts'
+    template <typename T, typename... Ts>
+    [[nodiscard]] T convert_object(
+        line_ptr_type line, const std::string& delim = default_delimiter) {
+        return to_object<T>(convert<Ts...>(line, delim));
+    }
+
+    // parses line with given delimiter, returns tuple of objects with
+    // extracted values of type 'Ts'
+    template <typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<Ts...> convert(
+        line_ptr_type line, const std::string& delim = default_delimiter) {
+        split(line, delim);
+        if (splitter_.valid()) {
+            return convert<Ts...>(splitter_.get_split_data());
+        } else {
+            handle_error_bad_split();
+            return {};
+        }
+    }
+
+    // parses already split line, returns 'T' object with extracted values
+    template <typename T, typename... Ts>
+    [[nodiscard]] T convert_object(const split_data& elems) {
+        return to_object<T>(convert<Ts...>(elems));
+    }
+
+    // same as above, but uses cached split line
+    template <typename T, typename... Ts>
+    [[nodiscard]] T convert_object() {
+        return to_object<T>(convert<Ts...>());
+    }
+
+    // parses already split line, returns either a tuple of objects with
+    // parsed values (returns raw element (no tuple) if Ts is empty), or if
+    // one argument is given which is a class which has a tied
+    // method which returns a tuple, returns that type
+    template <typename T, typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<T, Ts...> convert(
+        const split_data& elems) {
+        if constexpr (sizeof...(Ts) == 0 && is_instance_of_v<std::tuple, T>) {
+            return convert_impl(elems, static_cast<T*>(nullptr));
+        } else if constexpr (tied_class_v<T, Ts...>) {
+            using arg_ref_tuple = std::invoke_result_t<decltype(&T::tied), T>;
+            using arg_tuple = apply_trait_t<std::decay, arg_ref_tuple>;
+
+            return to_object<T>(
+                convert_impl(elems, static_cast<arg_tuple*>(nullptr)));
+        } else {
+            return convert_impl<T, Ts...>(elems);
+        }
+    }
+
+    // same as above, but uses cached split line
+    template <typename T, typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<T, Ts...> convert() {
+        return convert<T, Ts...>(splitter_.get_split_data());
+    }
+
+    [[nodiscard]] bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else if constexpr (throw_on_error) {
+            return true;
+        } else {
+            return !error_;
+        }
+    }
+
+    [[nodiscard]] const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    [[nodiscard]] bool unterminated_quote() const {
+        return splitter_.unterminated_quote();
+    }
+
+    // pool used to store the values converted to 'ss::category'
+    [[nodiscard]] ss::string_pool& get_string_pool() {
+        if (!string_pool_) {
+            string_pool_ = std::make_shared<ss::string_pool>();
+        }
+        return *string_pool_;
+    }
+
+    // the given pool is not owned by the converter, it needs to outlive it
+    void set_string_pool(ss::string_pool& pool) {
+        string_pool_ = std::shared_ptr<ss::string_pool>{
+            std::shared_ptr<ss::string_pool>{}, &pool};
+    }
+
+    // arena used to store the converted 'std::string_view' values if
+    // 'arena_views' is enabled
+    [[nodiscard]] ss::arena& get_arena() {
+        if (!arena_) {
+            arena_ = std::make_shared<ss::arena>();
+        }
+        return *arena_;
+    }
+
+    // the given arena is not owned by the converter, it needs to outlive it
+    void set_arena(ss::arena& arena) {
+        arena_ = std::shared_ptr<ss::arena>{std::shared_ptr<ss::arena>{},
+                                            &arena};
+    }
+
+    // 'splits' string by given delimiter, returns vector of pairs which
+    // contain the beginnings and the ends of each column of the string
+    const split_data& split(line_ptr_type line,
+                            const std::string& delim = default_delimiter) {
+        clear_conversions();
+        splitter_.clear_split_data();
+        if (line[0] == '\0') {
+            return splitter_.get_split_data();
+        }
+
+        return splitter_.split(line, delim);
+    }
+
+private:
+    ////////////////
+    // resplit
+    ////////////////
+
+    const split_data& resplit(line_ptr_type new_line, ssize_t new_size,
+                              const std::string& delim) {
+        clear_conversions();
+        return splitter_.resplit(new_line, new_size, delim);
+    }
+
+    [[nodiscard]] size_t size_shifted() {
+        return splitter_.size_shifted();
+    }
+
+    ////////////////
+    // error
+    ////////////////
+
+    void clear_error() {
+        if constexpr (string_error) {
+            error_.clear();
+        } else {
+            error_ = false;
+        }
+    }
+
+    [[nodiscard]] std::string error_sufix(const string_range msg,
+                                          size_t pos) const {
+        constexpr static auto reserve_size = 32;
+        std::string error;
+        error.reserve(reserve_size);
+        error.append("at column ")
+            .append(std::to_string(pos + 1))
+            .append(": \'")
+            .append(msg.first, msg.second)
+            .append("\'");
+        return error;
+    }
+
+    void handle_error_bad_split() {
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(splitter_.error_msg());
+        } else if constexpr (!throw_on_error) {
+            error_ = true;
+        }
+    }
+
+    void handle_error_unterminated_escape() {
+        if constexpr (string_error) {
+            error_.clear();
+            splitter_.handle_error_unterminated_escape();
+            error_.append(splitter_.error_msg());
+        } else if constexpr (throw_on_error) {
+            splitter_.handle_error_unterminated_escape();
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_unterminated_quote() {
+        if constexpr (string_error) {
+            error_.clear();
+            splitter_.handle_error_unterminated_quote();
+            error_.append(splitter_.error_msg());
+        } else if constexpr (throw_on_error) {
+            splitter_.handle_error_unterminated_quote();
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_multiline_limit_reached() {
+        constexpr static auto error_msg = "multiline limit reached";
+        splitter_.unterminated_quote_ = false;
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_record_size_limit_reached() {
+        constexpr static auto error_msg = "record size limit reached";
+        splitter_.unterminated_quote_ = false;
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_invalid_conversion(const string_range msg, size_t pos) {
+        constexpr static auto error_msg = "invalid conversion for parameter ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg).append(error_sufix(msg, pos));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg + error_sufix(msg, pos)};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_validation_failed(const char* const error,
+                                        const string_range msg, size_t pos) {
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error).append(" ").append(error_sufix(msg, pos));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error + (" " + error_sufix(msg, pos))};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_number_of_columns(size_t expected_pos, size_t pos) {
+        constexpr static auto error_msg1 =
+            "invalid number of columns, expected: ";
+        constexpr static auto error_msg2 = ", got: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg1)
+                .append(std::to_string(expected_pos))
+                .append(error_msg2)
+                .append(std::to_string(pos));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg1 + std::to_string(expected_pos) +
+                                error_msg2 + std::to_string(pos)};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_incompatible_mapping(size_t argument_size,
+                                           size_t mapping_size) {
+        constexpr static auto error_msg1 =
+            "number of arguments does not match mapping, expected: ";
+        constexpr static auto error_msg2 = ", got: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg1)
+                .append(std::to_string(mapping_size))
+                .append(error_msg2)
+                .append(std::to_string(argument_size));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg1 + std::to_string(mapping_size) +
+                                error_msg2 + std::to_string(argument_size)};
+        } else {
+            error_ = true;
+        }
+    }
+
+    ////////////////
+    // convert implementation
+    ////////////////
+
+    template <typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<Ts...> convert_impl(
+        const split_data& elems) {
+        clear_error();
+
+        if (!splitter_.valid()) {
+            handle_error_bad_split();
+            return {};
+        }
+
+        if (!columns_mapped()) {
+            if (sizeof...(Ts) != elems.size()) {
+                handle_error_number_of_columns(sizeof...(Ts), elems.size());
+                return {};
+            }
+        } else {
+            if (sizeof...(Ts) != column_mappings_.size()) {
+                handle_error_incompatible_mapping(sizeof...(Ts),
+                                                  column_mappings_.size());
+                return {};
+            }
+
+            if (elems.size() != number_of_columns_) {
+                handle_error_number_of_columns(number_of_columns_,
+                                               elems.size());
+                return {};
+            }
+        }
+
+        // the cached split data may have already failed to convert with
+        // the same column types, in which case only the failed column is
+        // converted again to report the same error, the columns which were
+        // converted successfully may be remembered (see below)
+        const bool cached = (&elems == &splitter_.get_split_data());
+        remembering_values_ = cached && remember_values_;
+        if (cached) {
+            if (const auto column = known_failed_column<Ts...>();
+                column != no_column) {
+                return extract_tuple<Ts...>(elems, column);
+            }
+        }
+
+        failed_column_ = no_column;
+        auto value = extract_tuple<Ts...>(elems);
+        if (cached && failed_column_ != no_column) {
+            remember_failed_conversion<Ts...>(failed_column_);
+        }
+        return value;
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<std::tuple<Ts...>> convert_impl(
+        const split_data& elems, const std::tuple<Ts...>*) {
+        return convert_impl<Ts...>(elems);
+    }
+
+    ////////////////
+    // column mapping
+    ////////////////
+
+    [[nodiscard]] bool columns_mapped() const {
+        return !column_mappings_.empty();
+    }
+
+    [[nodiscard]] size_t column_position(size_t tuple_position) const {
+        if (!columns_mapped()) {
+            return tuple_position;
+        }
+        return column_mappings_[tuple_position];
+    }
+
+    // assumes positions are valid and the vector is not empty
+    void set_column_mapping(std::vector<size_t> positions,
+                            size_t number_of_columns) {
+        clear_conversions();
+        column_mappings_ = std::move(positions);
+        number_of_columns_ = number_of_columns;
+    }
+
+    void clear_column_positions() {
+        clear_conversions();
+        column_mappings_.clear();
+        number_of_columns_ = 0;
+    }
+
+    ////////////////
+    // failed conversions
+    ////////////////
+
+    // a conversion which failed at 'column', the conversion of the same
+    // split data fails at the same column if the types of all the columns
+    // up to and including it are the same
+    struct failed_conversion {
+        const void* const* column_types;
+        size_t column;
+    };
+
+    template <typename... Ts>
+    [[nodiscard]] size_t known_failed_column() const {
+        const void* const* column_types = column_type_ids<Ts...>;
+        for (size_t i = 0; i < failed_conversions_size_; ++i) {
+            const auto& failed = failed_conversions_[i];
+            if (failed.column < sizeof...(Ts) &&
+                std::equal(failed.column_types,
+                           failed.column_types + failed.column + 1,
+                           column_types)) {
+                return failed.column;
+            }
+        }
+        return no_column;
+    }
+
+    template <typename... Ts>
+    void remember_failed_conversion(size_t column) {
+        if (failed_conversions_size_ < failed_conversions_.size()) {
+            failed_conversions_[failed_conversions_size_++] = {
+                column_type_ids<Ts...>, column};
+        }
+    }
+
+    void clear_conversions() {
+        failed_conversions_size_ = 0;
+        converted_values_.clear();
+    }
+
+    ////////////////
+    // converted values
+    ////////////////
+
+    constexpr static size_t max_converted_value_size = 32;
+
+    // a value converted from a column of the cached split data, only values
+    // which can be copied as bytes and fit into 'data' are remembered
+    struct converted_value {
+        const void* type{nullptr};
+        alignas(std::max_align_t) unsigned char data[max_converted_value_size];
+    };
+
+    template <typename T>
+    constexpr static bool can_remember_value =
+        std::is_trivially_copyable_v<no_validator_t<T>> &&
+        sizeof(no_validator_t<T>) <= max_converted_value_size &&
+        alignof(no_validator_t<T>) <= alignof(std::max_align_t);
+
+    // the value is looked up by the type given to the conversion, including
+    // its validator, so the validation of the value is not repeated either
+    template <typename T>
+    [[nodiscard]] bool converted_value_of(no_validator_t<T>& dst,
+                                          size_t pos) const {
+        const size_t column = column_position(pos);
+        if (column >= converted_values_.size() ||
+            converted_values_[column].type != &type_tag<T>::id) {
+            return false;
+        }
+
+        std::memcpy(&dst, converted_values_[column].data, sizeof(dst));
+        return true;
+    }
+
+    template <typename T>
+    void remember_converted_value(const no_validator_t<T>& value, size_t pos) {
+        const size_t column = column_position(pos);
+        if (column >= converted_values_.size()) {
+            converted_values_.resize(column + 1);
+        }
+
+        converted_values_[column].type = &type_tag<T>::id;
+        std::memcpy(converted_values_[column].data, &value, sizeof(value));
+    }
+
+    // the values converted from the cached split data are remembered, so
+    // a later conversion of the same line with a column of the same type
+    // copies its value instead of converting it again, used by the parser
+    // while it tries the alternative conversions of a line
+    void remember_converted_values(bool remember) {
+        remember_values_ = remember;
+    }
+
+    ////////////////
+    // conversion
+    ////////////////
+
+    template <typename T>
+    void extract_one(no_validator_t<T>& dst, const string_range msg,
+                     size_t pos) {
+        if (!valid()) {
+            return;
+        }
+
+        if constexpr (std::is_same_v<T, std::string> || is_pmr_string_v<T>) {
+            static_cast<void>(extract(msg.first, msg.second, dst));
+            return;
+        }
+
+        if constexpr (can_remember_value<T>) {
+            if (remembering_values_ && converted_value_of<T>(dst, pos)) {
+                return;
+            }
+        }
+
+        if (!extract_value(msg, dst)) {
+            failed_column_ = pos;
+            handle_error_invalid_conversion(msg, pos);
+            return;
+        }
+
+        if constexpr (arena_views) {
+            store_in_arena(dst);
+        }
+
+        if constexpr (has_m_ss_valid_t<T>) {
+            if (T validator; !validator.ss_valid(dst)) {
+                failed_column_ = pos;
+                if constexpr (has_m_error_t<T>) {
+                    handle_error_validation_failed(validator.error(), msg, pos);
+                } else {
+                    handle_error_validation_failed("validation error", msg,
+                                                   pos);
+                }
+                return;
+            }
+        }
+
+        if constexpr (can_remember_value<T>) {
+            if (remembering_values_) {
+                remember_converted_value<T>(dst, pos);
+            }
+        }
+    }
+
+    // some types need additional resources owned by the converter, the
+    // optionals and variants containing them are unwrapped the same way
+    // 'extract' unwraps them
+    template <typename T>
+    [[nodiscard]] bool extract_value(const string_range msg, T& dst) {
+        if constexpr (std::is_same_v<T, category>) {
+            return extract(msg.first, msg.second, dst, get_string_pool());
+        } else if constexpr (has_category_v<T> &&
+                             is_instance_of_v<std::optional, T>) {
+            typename T::value_type value;
+            if (extract_value(msg, value)) {
+                dst = std::move(value);
+            } else {
+                dst = std::nullopt;
+            }
+            return true;
+        } else if constexpr (has_category_v<T>) {
+            return extract_variant_value<T, 0>(msg, dst,
+                                               classify_field(msg.first,
+                                                              msg.second));
+        } else {
+            return extract(msg.first, msg.second, dst);
+        }
+    }
+
+    template <typename T, size_t I>
+    [[nodiscard]] bool extract_variant_value(const string_range msg, T& dst,
+                                             const field_class& field) {
+        using IthType = std::variant_alternative_t<I, T>;
+        if (may_extract<IthType>(field)) {
+            IthType value;
+            if (extract_value(msg, value)) {
+                dst.template emplace<I>(std::move(value));
+                return true;
+            }
+        }
+
+        if constexpr (I + 1 < std::variant_size_v<T>) {
+            return extract_variant_value<T, I + 1>(msg, dst, field);
+        }
+        return false;
+    }
+
+    // moves the views pointing to the line into the arena
+    template <typename T>
+    void store_in_arena(T& value) {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            value = get_arena().store(value);
+        } else if constexpr (is_instance_of_v<std::optional, T>) {
+            if (value.has_value()) {
+                store_in_arena(*value);
+            }
+        } else if constexpr (is_instance_of_v<std::variant, T>) {
+            std::visit(
+                [this](auto& alternative) { store_in_arena(alternative); },
+                value);
+        }
+    }
+
+    // extracts all the columns, or only the given one
+    template <size_t ArgN, size_t TupN, typename... Ts>
+    void extract_multiple(no_void_validator_tup_t<Ts...>& tup,
+                          const split_data& elems, size_t only_column) {
+        using elem_t = std::tuple_element_t<ArgN, std::tuple<Ts...>>;
+
+        constexpr bool not_void = !std::is_void_v<elem_t>;
+        constexpr bool one_element = count_not_v<std::is_void, Ts...> == 1;
+
+        if constexpr (not_void) {
+            if (only_column == no_column || only_column == ArgN) {
+                if constexpr (one_element) {
+                    extract_one<elem_t>(tup, elems[column_position(ArgN)],
+                                        ArgN);
+                } else {
+                    auto& el = std::get<TupN>(tup);
+                    extract_one<elem_t>(el, elems[column_position(ArgN)],
+                                        ArgN);
+                }
+            }
+        }
+
+        if constexpr (sizeof...(Ts) > ArgN + 1) {
+            constexpr size_t NewTupN = (not_void) ? TupN + 1 : TupN;
+            extract_multiple<ArgN + 1, NewTupN, Ts...>(tup, elems,
+                                                      only_column);
+        }
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<Ts...> extract_tuple(
+        const split_data& elems, size_t only_column = no_column) {
+        static_assert(!all_of_v<std::is_void, Ts...>,
+                      "at least one parameter must be non void");
+        auto ret = make_result<no_void_validator_tup_t<Ts...>>();
+        extract_multiple<0, 0, Ts...>(ret, elems, only_column);
+        return ret;
+    }
+
+    // the 'std::pmr::string' values are created with the memory resource of
+    // the converter, assigning to them keeps their resource
+    template <typename T>
+    [[nodiscard]] T make_result() const {
+        if constexpr (is_pmr_string_v<T>) {
+            return T{resource_};
+        } else if constexpr (is_instance_of_v<std::tuple, T>) {
+            if constexpr (any_of_v<is_pmr_string, T>) {
+                return T{std::allocator_arg,
+                         std::pmr::polymorphic_allocator<char>{resource_}};
+            } else {
+                return T{};
+            }
+        } else {
+            return T{};
+        }
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    error_type error_{};
+    splitter<Options...> splitter_;
+
+    template <typename...>
+    friend class parser;
+
+    std::vector<size_t> column_mappings_;
+    size_t number_of_columns_{0};
+
+    constexpr static auto no_column = std::numeric_limits<size_t>::max();
+    constexpr static auto max_failed_conversions = 8;
+
+    size_t failed_column_{no_column};
+    std::array<failed_conversion, max_failed_conversions> failed_conversions_{};
+    size_t failed_conversions_size_{0};
+
+    std::vector<converted_value> converted_values_;
+    bool remember_values_{false};
+    bool remembering_values_{false};
+
+    // shared between the converters of the same parser
+    std::shared_ptr<ss::string_pool> string_pool_;
+    std::shared_ptr<ss::arena> arena_;
+
+    std::pmr::memory_resource* resource_{std::pmr::get_default_resource()};
+};
+
+} /* namespace ss */
+
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define SSP_COROUTINES_ENABLED
+#endif
+
+#ifdef SSP_COROUTINES_ENABLED
+
+namespace ss {
+
+////////////////
+// generator
+////////////////
+
+// a lazy sequence of values produced by a coroutine, the coroutine is only
+// resumed when the next value is requested, so the consumer decides when the
+// next value is produced, the yielded value is valid until then
+template <typename T>
+class generator {
+public:
+    struct promise_type {
+        [[nodiscard]] generator get_return_object() {
+            return generator{handle::from_promise(*this)};
+        }
+
+        [[nodiscard]] std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        [[nodiscard]] std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always yield_value(T& value) noexcept {
+            value_ = std::addressof(value);
+            return {};
+        }
+
+        // the temporary lives within the coroutine frame until the
+        // coroutine is resumed
+        std::suspend_always yield_value(T&& value) noexcept {
+            value_ = std::addressof(value);
+            return {};
+        }
+
+        void return_void() noexcept {
+        }
+
+        void unhandled_exception() {
+            exception_ = std::current_exception();
+        }
+
+        // coroutines which only produce values may not await anything
+        template <typename U>
+        std::suspend_never await_transform(U&& value) = delete;
+
+        void rethrow_if_exception() {
+            if (exception_) {
+                std::rethrow_exception(std::exchange(exception_, nullptr));
+            }
+        }
+
+        T* value_{nullptr};
+        std::exception_ptr exception_;
+    };
+
+    using handle = std::coroutine_handle<promise_type>;
+
+    struct sentinel {};
+
+    class iterator {
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using reference = T&;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::input_iterator_tag;
+
+        iterator() = default;
+
+        explicit iterator(handle coroutine) : coroutine_{coroutine} {
+        }
+
+        [[nodiscard]] reference operator*() const {
+            return *coroutine_.promise().value_;
+        }
+
+        [[nodiscard]] T* operator->() const {
+            return coroutine_.promise().value_;
+        }
+
+        iterator& operator++() {
+            coroutine_.resume();
+            coroutine_.promise().rethrow_if_exception();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        [[nodiscard]] friend bool operator==(const iterator& it, sentinel) {
+            return !it.coroutine_ || it.coroutine_.done();
+        }
+
+    private:
+        handle coroutine_{nullptr};
+    };
+
+    generator() = default;
+
+    generator(const generator& other) = delete;
+    generator& operator=(const generator& other) = delete;
+
+    generator(generator&& other) noexcept
+        : coroutine_{std::exchange(other.coroutine_, nullptr)} {
+    }
+
+    generator& operator=(generator&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            coroutine_ = std::exchange(other.coroutine_, nullptr);
+        }
+        return *this;
+    }
+
+    ~generator() {
+        destroy();
+    }
+
+    // the first value is produced when 'begin' is called, the sequence can
+    // only be iterated once
+    [[nodiscard]] iterator begin() {
+        if (coroutine_) {
+            coroutine_.resume();
+            coroutine_.promise().rethrow_if_exception();
+        }
+        return iterator{coroutine_};
+    }
+
+    [[nodiscard]] sentinel end() const noexcept {
+        return {};
+    }
+
+private:
+    explicit generator(handle coroutine) : coroutine_{coroutine} {
+    }
+
+    void destroy() {
+        if (coroutine_) {
+            coroutine_.destroy();
+            coroutine_ = nullptr;
+        }
+    }
+
+    handle coroutine_{nullptr};
+};
+
+} /* namespace ss */
+
+#endif
+
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#define SSP_RANGES_ENABLED
+#endif
+
+namespace ss {
+
+////////////////
+// record handler
+////////////////
+
+// converts a record using the types 'Ts' and invokes 'fun' with the result,
+// used by 'parser::dispatch' for records whose discriminator equals 'key'
+template <typename Fun, typename... Ts>
+struct record_handler {
+    static_assert(sizeof...(Ts) > 0, "at least one type must be given");
+
+    std::string_view key;
+    Fun fun;
+};
+
+template <typename... Ts, typename Fun>
+[[nodiscard]] record_handler<std::decay_t<Fun>, Ts...> handler(
+    std::string_view key, Fun&& fun) {
+    return {key, std::forward<Fun>(fun)};
+}
+
+////////////////
+// column condition
+////////////////
+
+// condition on the value of a column before it is converted, created by
+// comparing an 'ss::column' with a string, used by 'parser::where'
+struct column_condition {
+    enum class comparison { equal, not_equal, prefix };
+
+    std::optional<std::string> field;
+    size_t index{0};
+    comparison op{comparison::equal};
+    std::string value;
+
+    [[nodiscard]] bool matches(const split_data& fields) const {
+        if (index >= fields.size()) {
+            return false;
+        }
+
+        const auto& [begin, end] = fields[index];
+        const std::string_view field_value{begin,
+                                           static_cast<size_t>(end - begin)};
+
+        switch (op) {
+        case comparison::equal:
+            return field_value == value;
+        case comparison::not_equal:
+            return field_value != value;
+        case comparison::prefix:
+            return field_value.substr(0, value.size()) == value;
+        }
+        return false;
+    }
+};
+
+// column given by its header field or by its index
+class column {
+public:
+    column(std::string field) : field_{std::move(field)} {
+    }
+
+    column(size_t index) : index_{index} {
+    }
+
+    [[nodiscard]] column_condition operator==(std::string_view value) const {
+        return make_condition(column_condition::comparison::equal, value);
+    }
+
+    [[nodiscard]] column_condition operator!=(std::string_view value) const {
+        return make_condition(column_condition::comparison::not_equal, value);
+    }
+
+    [[nodiscard]] column_condition starts_with(std::string_view value) const {
+        return make_condition(column_condition::comparison::prefix, value);
+    }
+
+private:
+    [[nodiscard]] column_condition make_condition(
+        column_condition::comparison op, std::string_view value) const {
+        return {field_, index_, op, std::string{value}};
+    }
+
+    std::optional<std::string> field_;
+    size_t index_{0};
+};
+
+////////////////
+// follow
+////////////////
+
+// wait time between two checks for new data in follow mode, it is doubled
+// after each check which found nothing
+struct follow_backoff {
+    std::chrono::milliseconds min{10};
+    std::chrono::milliseconds max{1000};
+};
+
+////////////////
+// checkpoint
+////////////////
+
+// state needed to continue reading a file from the record after the last
+// one which was read, see 'parser::checkpoint'
+struct checkpoint {
+    size_t position{0};
+    size_t line{0};
+    bool crlf{false};
+    std::string raw_header;
+    std::vector<std::string> header;
+    std::vector<size_t> column_mapping;
+    size_t number_of_columns{0};
+
+    // the checkpoint as one line of text, numbers are separated by spaces
+    // and strings are prefixed by their length
+    [[nodiscard]] std::string to_string() const {
+        std::string out;
+        auto append_number = [&out](size_t value) {
+            out.append(std::to_string(value)).push_back(' ');
+        };
+        auto append_string = [&](const std::string& value) {
+            append_number(value.size());
+            out.append(value).push_back(' ');
+        };
+
+        append_number(position);
+        append_number(line);
+        append_number(crlf);
+        append_string(raw_header);
+        append_number(header.size());
+        for (const auto& field : header) {
+            append_string(field);
+        }
+        append_number(column_mapping.size());
+        for (const auto column : column_mapping) {
+            append_number(column);
+        }
+        append_number(number_of_columns);
+
+        out.pop_back();
+        return out;
+    }
+
+    [[nodiscard]] static std::optional<checkpoint> from_string(
+        std::string_view in) {
+        const char* curr = in.data();
+        const char* const end = in.data() + in.size();
+
+        auto read_number = [&](size_t& value) {
+            auto [ptr, ec] = std::from_chars(curr, end, value);
+            if (ec != std::errc() || (ptr != end && *ptr != ' ')) {
+                return false;
+            }
+            curr = (ptr == end) ? end : ptr + 1;
+            return true;
+        };
+        auto read_string = [&](std::string& value) {
+            size_t size = 0;
+            if (!read_number(size) || static_cast<size_t>(end - curr) < size) {
+                return false;
+            }
+            value.assign(curr, size);
+            curr += size;
+            if (curr != end) {
+                ++curr;
+            }
+            return true;
+        };
+
+        checkpoint result;
+        size_t crlf = 0;
+        size_t header_size = 0;
+        size_t column_mapping_size = 0;
+
+        if (!read_number(result.position) || !read_number(result.line) ||
+            !read_number(crlf) || crlf > 1 ||
+            !read_string(result.raw_header) || !read_number(header_size) ||
+            header_size > in.size()) {
+            return std::nullopt;
+        }
+
+        result.crlf = crlf;
+        result.header.resize(header_size);
+        for (auto& field : result.header) {
+            if (!read_string(field)) {
+                return std::nullopt;
+            }
+        }
+
+        if (!read_number(column_mapping_size) ||
+            column_mapping_size > in.size()) {
+            return std::nullopt;
+        }
+
+        result.column_mapping.resize(column_mapping_size);
+        for (auto& column : result.column_mapping) {
+            if (!read_number(column)) {
+                return std::nullopt;
+            }
+        }
+
+        if (!read_number(result.number_of_columns) || curr != end) {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+};
+
+////////////////
+// byte range
+////////////////
+
+// part of a file, [begin, end), read by a parser, each record belongs to the
+// range in which it begins, so adjacent ranges read every record once
+struct byte_range {
+    size_t begin{0};
+    size_t end{0};
+};
+
+////////////////
+// file descriptor
+////////////////
+
+// an open file descriptor, such as one end of a pipe, read by a parser
+struct file_descriptor {
+    int value{-1};
+};
+
+inline constexpr file_descriptor standard_input{0};
+
+template <typename... Options>
+class parser {
+    constexpr static auto string_error = setup<Options...>::string_error;
+    constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
+
+    using multiline = typename setup<Options...>::multiline;
+    using error_type = std::conditional_t<string_error, std::string, bool>;
+
+    constexpr static bool escaped_multiline_enabled =
+        multiline::enabled && setup<Options...>::escape::enabled;
+
+    constexpr static bool quoted_multiline_enabled =
+        multiline::enabled && setup<Options...>::quote::enabled;
+
+    constexpr static bool ignore_header = setup<Options...>::ignore_header;
+
+    constexpr static bool ignore_empty = setup<Options...>::ignore_empty;
+
+    constexpr static bool arena_views = setup<Options...>::arena_views;
+    constexpr static bool sequential_scan =
+        setup<Options...>::sequential_scan;
+    constexpr static size_t max_record_bytes =
+        setup<Options...>::max_record_bytes;
+
+    using header_splitter = ss::splitter<
+        ss::filter_not_t<ss::is_instance_of_multiline, Options...>>;
+
+public:
+    parser(std::string file_name, std::string delim = ss::default_delimiter)
+        : parser{std::move(file_name), nullptr, std::move(delim)} {
+    }
+
+    parser(const char* const csv_data_buffer, size_t csv_data_size,
+           const std::string& delim = ss::default_delimiter)
+        : parser{csv_data_buffer, csv_data_size, nullptr, delim} {
+    }
+
+    // reads from an open file which is not closed by the parser, the file
+    // does not need to support seeking
+    parser(FILE* file, std::string delim = ss::default_delimiter)
+        : parser{file, nullptr, std::move(delim)} {
+    }
+
+    // reads from a duplicate of the file descriptor using large reads, so
+    // pipes and 'ss::standard_input' can be read directly
+    parser(ss::file_descriptor fd, std::string delim = ss::default_delimiter)
+        : parser{fd, nullptr, std::move(delim)} {
+    }
+
+    // reads the data given by the source, such as 'ss::gzip_source', the
+    // source is not assumed to support seeking
+    parser(ss::byte_source source, std::string delim = ss::default_delimiter)
+        : parser{std::move(source), nullptr, std::move(delim)} {
+    }
+
+    // same as above, but the line buffers, the split data, the header and
+    // the converted 'std::pmr::string' values are allocated from the given
+    // memory resource, which needs to outlive the parser, the line buffers
+    // are allocated with 'std::realloc' if it is null
+    parser(std::string file_name, std::pmr::memory_resource* resource,
+           std::string delim = ss::default_delimiter)
+        : file_name_{std::move(file_name)},
+          reader_{file_name_, delim, resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
+        if (reader_.file_) {
+            read_header();
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    parser(const char* const csv_data_buffer, size_t csv_data_size,
+           std::pmr::memory_resource* resource,
+           const std::string& delim = ss::default_delimiter)
+        : file_name_{"CSV data buffer"},
+          reader_{csv_data_buffer, csv_data_size, delim, resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
+        if (csv_data_buffer) {
+            read_header();
+        } else {
+            handle_error_null_buffer();
+            eof_ = true;
+        }
+    }
+
+    parser(FILE* file, std::pmr::memory_resource* resource,
+           std::string delim = ss::default_delimiter)
+        : file_name_{"file stream"},
+          reader_{file, false, std::move(delim), resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
+        if (reader_.file_) {
+            read_header();
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    parser(ss::file_descriptor fd, std::pmr::memory_resource* resource,
+           std::string delim = ss::default_delimiter)
+        : file_name_{"file descriptor " + std::to_string(fd.value)},
+          reader_{open_file_descriptor(fd.value), true, std::move(delim),
+                  resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
+        if (reader_.file_) {
+            read_header();
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    parser(ss::byte_source source, std::pmr::memory_resource* resource,
+           std::string delim = ss::default_delimiter)
+        : file_name_{source.name},
+          reader_{std::move(source), std::move(delim), resource},
+          header_{resource_or_default(resource)},
+          raw_header_{resource_or_default(resource)} {
+        if (reader_.source_) {
+            read_header();
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    // continues reading from the given checkpoint, the header is not read
+    // again
+    parser(std::string file_name, const ss::checkpoint& checkpoint,
+           std::string delim = ss::default_delimiter)
+        : file_name_{std::move(file_name)},
+          reader_{file_name_, delim, nullptr} {
+        if (reader_.file_) {
+            resume(checkpoint);
+        } else {
+            handle_error_file_not_open();
+            eof_ = true;
+        }
+    }
+
+    parser(const char* const csv_data_buffer, size_t csv_data_size,
+           const ss::checkpoint& checkpoint,
+           const std::string& delim = ss::default_delimiter)
+        : file_name_{"CSV data buffer"},
+          reader_{csv_data_buffer, csv_data_size, delim, nullptr} {
+        if (csv_data_buffer) {
+            resume(checkpoint);
+        } else {
+            handle_error_null_buffer();
+            eof_ = true;
+        }
+    }
+
+    // reads only the records which begin within the given range, the
+    // header is still read from the beginning of the file
+    parser(std::string file_name, const ss::byte_range& range,
+           std::string delim = ss::default_delimiter)
+        : parser{std::move(file_name), std::move(delim)} {
+        if (reader_.file_) {
+            read_range(range);
+        }
+    }
+
+    parser(const char* const csv_data_buffer, size_t csv_data_size,
+           const ss::byte_range& range,
+           const std::string& delim = ss::default_delimiter)
+        : parser{csv_data_buffer, csv_data_size, delim} {
+        if (csv_data_buffer) {
+            read_range(range);
+        }
+    }
+
+    parser(parser&& other) noexcept = default;
+    parser& operator=(parser&& other) noexcept = default;
+    ~parser() = default;
+
+    parser() = delete;
+    parser(const parser& other) = delete;
+    parser& operator=(const parser& other) = delete;
+
+    [[nodiscard]] bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else if constexpr (throw_on_error) {
+            return true;
+        } else {
+            return !error_;
+        }
+    }
+
+    [[nodiscard]] const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    [[nodiscard]] bool eof() const {
+        return eof_;
+    }
+
+    // in follow mode the next line is read only once it is needed, so this
+    // waits until it is written
+    [[nodiscard]] bool eof() {
+        read_deferred_line();
+        return eof_;
+    }
+
+    bool ignore_next() {
+        if (next_line_deferred_) {
+            next_line_deferred_ = false;
+            std::ignore = reader_.read_next();
+        }
+
+        next_line_parsed_ = false;
+        next_line_error_.reset();
+        const bool read = reader_.read_next();
+        line_number_ = reader_.line_number_;
+        eof_ = eof_ || !read;
+        return read;
+    }
+
+    // skips the next 'n' records without splitting them unless conditions
+    // are given to 'where', the ends of multiline records are found by
+    // scanning only the quotes and escapes, returns the number of skipped
+    // records
+    size_t skip(size_t n) {
+        size_t skipped = 0;
+        while (skipped < n) {
+            skip_filtered_lines();
+            if (eof_) {
+                break;
+            }
+
+            if (!next_line_parsed_) {
+                reader_.skip_continuation();
+            }
+
+            next_line();
+            ++skipped;
+        }
+        return skipped;
+    }
+
+    // at most 'n' more records are read, 'eof' is reached afterwards
+    void limit(size_t n) {
+        records_left_ = n;
+        if (n == 0) {
+            eof_ = true;
+        }
+    }
+
+    // continues reading from the first line which begins at or after the
+    // given byte offset, the offset needs not be at a line boundary,
+    // 'position' returns the offset of the next line
+    void skip_to(size_t position) {
+        if (!reader_.file_ && !reader_.csv_data_buffer_) {
+            return;
+        }
+
+        reader_.seek(position);
+        next_line();
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] T get_object() {
+        return to_object<T>(get_next<Ts...>());
+    }
+
+    [[nodiscard]] size_t line() const {
+        return line_number_ > 0 ? line_number_ - 1 : line_number_;
+    }
+
+    [[nodiscard]] size_t position() const {
+        return next_line_deferred_ ? reader_.curr_char_ : reader_.chars_read_;
+    }
+
+    // the state needed to continue reading from the next record, together
+    // with the header and the fields given to 'use_fields', the conditions
+    // given to 'where' and the limit are not included
+    [[nodiscard]] ss::checkpoint checkpoint() const {
+        const auto& converter = reader_.converter_;
+        return {next_line_deferred_ || eof_ ? reader_.curr_char_
+                                            : reader_.record_begin_,
+                line(),
+                reader_.crlf_,
+                std::string{raw_header_},
+                std::vector<std::string>(header_.begin(), header_.end()),
+                converter.column_mappings_,
+                converter.number_of_columns_};
+    }
+
+    // instead of reaching eof, the parser waits for new lines to be
+    // appended to the file, a line is held until its new line character is
+    // written, as is a multiline record until it is terminated, 'eof' is
+    // reached once 'stop' returns true and no more data is found, has no
+    // effect in buffer mode
+    template <typename Stop>
+    void follow(Stop&& stop, follow_backoff backoff = {}) {
+        if (!reader_.file_) {
+            return;
+        }
+
+        reader_.follow_stop_ = std::forward<Stop>(stop);
+        reader_.follow_backoff_ = backoff;
+
+        if (eof_ && !records_left_) {
+            // the failed read counted a line
+            --reader_.line_number_;
+            eof_ = false;
+            next_line_deferred_ = true;
+        }
+    }
+
+    // pool used to store the values converted to 'ss::category'
+    [[nodiscard]] ss::string_pool& get_string_pool() {
+        return reader_.converter_.get_string_pool();
+    }
+
+    // uses the given pool instead of the one owned by the parser, the pool
+    // needs to outlive the parser and the values converted to it
+    void set_string_pool(ss::string_pool& pool) {
+        reader_.converter_.set_string_pool(pool);
+        reader_.next_line_converter_.set_string_pool(pool);
+    }
+
+    // arena used to store the converted 'std::string_view' values, the
+    // values stay valid until the arena is reset
+    [[nodiscard]] ss::arena& get_arena() {
+        assert_arena_views_defined();
+        return reader_.converter_.get_arena();
+    }
+
+    // uses the given arena instead of the one owned by the parser, the
+    // arena needs to outlive the parser
+    void set_arena(ss::arena& arena) {
+        assert_arena_views_defined();
+        reader_.converter_.set_arena(arena);
+        reader_.next_line_converter_.set_arena(arena);
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<T, Ts...> get_next() {
+        if (!eof_) {
+            parse_next_line();
+        }
+
+        reader_.update();
+        if (!reader_.converter_.valid()) {
+            handle_error_invalid_conversion();
+            read_line();
+            return {};
+        }
+
+        clear_error();
+
+        if (eof_) {
+            handle_error_eof_reached();
+            return {};
+        }
+
+        if constexpr (throw_on_error) {
+            try {
+                auto value = reader_.converter_.template convert<T, Ts...>();
+                read_line();
+                return value;
+            } catch (const ss::exception& e) {
+                read_line();
+                decorate_rethrow(e);
+            }
+        }
+
+        auto value = reader_.converter_.template convert<T, Ts...>();
+
+        if (!reader_.converter_.valid()) {
+            handle_error_invalid_conversion();
+        }
+
+        read_line();
+        return value;
+    }
+
+    // reads the next line and converts it with the types of the handler
+    // whose key equals the value of the given column, the function of the
+    // handler is invoked with the converted values, returns false if no
+    // handler matched, or the conversion or the invocation failed
+    template <typename... Handlers>
+    bool dispatch(size_t column, Handlers&&... handlers) {
+        static_assert(sizeof...(Handlers) > 0,
+                      "at least one handler must be given");
+
+        if (!eof_) {
+            parse_next_line();
+        }
+
+        reader_.update();
+        if (!reader_.converter_.valid()) {
+            handle_error_invalid_conversion();
+            read_line();
+            return false;
+        }
+
+        clear_error();
+
+        if (eof_) {
+            handle_error_eof_reached();
+            return false;
+        }
+
+        const auto& elems = reader_.converter_.splitter_.get_split_data();
+        if (column >= elems.size()) {
+            read_line();
+            handle_error_invalid_discriminator_column(column);
+            return false;
+        }
+
+        const auto& [begin, end] = elems[column];
+        const std::string_view key{begin, static_cast<size_t>(end - begin)};
+
+        if (!(try_handler(key, handlers) || ...)) {
+            read_line();
+            handle_error_no_handler(key);
+            return false;
+        }
+
+        return valid();
+    }
+
+    // lines whose split values do not satisfy the given condition are
+    // skipped without being converted, the condition can be made using
+    // 'ss::column', eg. 'ss::column("status") == "active"', or it can be
+    // anything callable with the split values of a line, 'ss::split_data',
+    // multiple conditions all need to be satisfied
+    template <typename Condition>
+    void where(Condition&& condition) {
+        clear_error();
+
+        if constexpr (std::is_same_v<std::decay_t<Condition>,
+                                     column_condition>) {
+            column_condition resolved = std::forward<Condition>(condition);
+            if (resolved.field) {
+                if (header_.empty() && !eof_) {
+                    split_header_data();
+                }
+
+                if (!valid()) {
+                    return;
+                }
+
+                auto index = header_index(*resolved.field);
+                if (!index) {
+                    handle_error_invalid_field(*resolved.field);
+                    return;
+                }
+                resolved.index = *index;
+            }
+
+            filters_.emplace_back(
+                [resolved = std::move(resolved)](const split_data& fields) {
+                    return resolved.matches(fields);
+                });
+        } else {
+            static_assert(std::is_invocable_r_v<bool, Condition,
+                                                const split_data&>,
+                          "the condition needs to be callable with "
+                          "'ss::split_data' and return a boolean");
+            filters_.emplace_back(std::forward<Condition>(condition));
+        }
+
+        // the next line may have already been accepted by the previous
+        // conditions
+        const auto& next = reader_.next_line_converter_;
+        if (next_line_parsed_ && !next_line_error_ && next.valid() &&
+            next.splitter_.valid() &&
+            !filters_.back()(next.splitter_.get_split_data())) {
+            next_line();
+        }
+    }
+
+    // removes all the conditions given to 'where'
+    void clear_filters() {
+        filters_.clear();
+    }
+
+    [[nodiscard]] std::string raw_header() const {
+        assert_ignore_header_not_defined();
+        return std::string{raw_header_};
+    }
+
+    [[nodiscard]] std::vector<std::string> header() {
+        assert_ignore_header_not_defined();
+        clear_error();
+
+        header_splitter splitter{reader_.resource_};
+        std::pmr::string raw_header_copy{raw_header_,
+                                         raw_header_.get_allocator()};
+
+        if (!strict_split(splitter, raw_header_copy)) {
+            return {};
+        }
+
+        std::vector<std::string> split_header;
+        for (const auto& [begin, end] : splitter.get_split_data()) {
+            split_header.emplace_back(begin, end);
+        }
+
+        return split_header;
+    }
+
+    [[nodiscard]] bool field_exists(const std::string& field) {
+        assert_ignore_header_not_defined();
+        clear_error();
+
+        if (header_.empty()) {
+            split_header_data();
+        }
+
+        if (!valid()) {
+            return false;
+        }
+
+        return header_index(field).has_value();
+    }
+
+    template <typename... Ts>
+    void use_fields(const Ts&... fields_args) {
+        assert_ignore_header_not_defined();
+        clear_error();
+
+        if (header_.empty() && !eof()) {
+            split_header_data();
+        }
+
+        if (!valid()) {
+            return;
+        }
+
+        auto fields = std::vector<std::string>{fields_args...};
+
+        if (fields.empty()) {
+            handle_error_invalid_use_fields_argument();
+            return;
+        }
+
+        std::vector<size_t> column_mappings;
+
+        for (const auto& field : fields) {
+            if (std::count(fields.begin(), fields.end(), field) != 1) {
+                handle_error_field_used_multiple_times(field);
+                return;
+            }
+
+            auto index = header_index(field);
+
+            if (!index) {
+                handle_error_invalid_field(field);
+                return;
+            }
+
+            column_mappings.push_back(*index);
+        }
+
+        reader_.converter_.set_column_mapping(column_mappings, header_.size());
+        reader_.next_line_converter_.set_column_mapping(column_mappings,
+                                                        header_.size());
+
+        if (line() == 0) {
+            ignore_next();
+        }
+    }
+
+    ////////////////
+    // iterator
+    ////////////////
+
+    template <bool get_object, typename T, typename... Ts>
+    struct iterable {
+        struct iterator {
+            using value = std::conditional_t<get_object, T,
+                                             no_void_validator_tup_t<T, Ts...>>;
+
+            iterator() : parser_{nullptr}, value_{} {
+            }
+
+            // the value is assigned for each record, so it is created with
+            // the memory resource of the parser
+            iterator(parser<Options...>* parser)
+                : parser_{parser},
+                  value_{parser->reader_.converter_
+                             .template make_result<value>()} {
+            }
+
+            iterator(const iterator& other) = default;
+            iterator(iterator&& other) noexcept = default;
+            ~iterator() = default;
+
+            iterator& operator=(const iterator& other) = delete;
+            iterator& operator=(iterator&& other) noexcept = delete;
+
+            [[nodiscard]] value& operator*() {
+                return value_;
+            }
+
+            [[nodiscard]] value* operator->() {
+                return &value_;
+            }
+
+            iterator& operator++() {
+                if (!parser_ || parser_->eof()) {
+                    parser_ = nullptr;
+                } else {
+                    if constexpr (get_object) {
+                        value_ =
+                            std::move(parser_->template get_object<T, Ts...>());
+                    } else {
+                        value_ =
+                            std::move(parser_->template get_next<T, Ts...>());
+                    }
+                }
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            [[nodiscard]] friend bool operator==(const iterator& lhs,
+                                                 const iterator& rhs) {
+                return (lhs.parser_ == nullptr && rhs.parser_ == nullptr) ||
+                       (lhs.parser_ == rhs.parser_ &&
+                        &lhs.value_ == &rhs.value_);
+            }
+
+            [[nodiscard]] friend bool operator!=(const iterator& lhs,
+                                                 const iterator& rhs) {
+                return !(lhs == rhs);
+            }
+
+        private:
+            parser<Options...>* parser_;
+            value value_;
+        };
+
+        iterable(parser<Options...>* parser) : parser_{parser} {
+        }
+
+        // the iterator is moved instead of copied, so its value keeps the
+        // memory resource
+        [[nodiscard]] iterator begin() {
+            iterator it{parser_};
+            ++it;
+            return it;
+        }
+
+        [[nodiscard]] iterator end() {
+            return iterator{};
+        }
+
+    private:
+        parser<Options...>* parser_;
+    };
+
+    template <typename... Ts>
+    [[nodiscard]] auto iterate() {
+        return iterable<false, Ts...>{this};
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] auto iterate_object() {
+        return iterable<true, Ts...>{this};
+    }
+
+#ifdef SSP_RANGES_ENABLED
+    ////////////////
+    // view
+    ////////////////
+
+    // an input range of the remaining records, a record is only converted
+    // once its iterator is dereferenced, records which are passed without
+    // being dereferenced are skipped without being split, and no record is
+    // read before it is needed, the value is kept within the range and is
+    // valid until the iterator is incremented
+    template <bool get_object, typename T, typename... Ts>
+    class record_range
+        : public std::ranges::view_interface<
+              record_range<get_object, T, Ts...>> {
+    public:
+        using value = std::conditional_t<get_object, T,
+                                         no_void_validator_tup_t<T, Ts...>>;
+
+        class iterator {
+        public:
+            using value_type = value;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(record_range* range) : range_{range} {
+            }
+
+            [[nodiscard]] value& operator*() const {
+                return range_->current();
+            }
+
+            [[nodiscard]] value* operator->() const {
+                return &range_->current();
+            }
+
+            iterator& operator++() {
+                range_->next();
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            [[nodiscard]] friend bool operator==(const iterator& it,
+                                                 std::default_sentinel_t) {
+                return it.done();
+            }
+
+        private:
+            [[nodiscard]] bool done() const {
+                return !range_ || range_->done();
+            }
+
+            record_range* range_{nullptr};
+        };
+
+        record_range() = default;
+
+        explicit record_range(parser<Options...>* parser)
+            : parser_{parser},
+              value_{parser->reader_.converter_
+                         .template make_result<value>()} {
+        }
+
+        [[nodiscard]] iterator begin() {
+            return iterator{this};
+        }
+
+        [[nodiscard]] std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+    private:
+        value& current() {
+            if (!loaded_) {
+                if constexpr (get_object) {
+                    value_ = parser_->template get_object<T, Ts...>();
+                } else {
+                    value_ = parser_->template get_next<T, Ts...>();
+                }
+                loaded_ = true;
+            }
+            return value_;
+        }
+
+        void next() {
+            if (!loaded_) {
+                std::ignore = parser_->skip(1);
+            }
+            loaded_ = false;
+        }
+
+        [[nodiscard]] bool done() {
+            return !loaded_ && parser_->eof();
+        }
+
+        parser<Options...>* parser_{nullptr};
+        value value_{};
+        bool loaded_{false};
+    };
+
+    template <typename... Ts>
+    [[nodiscard]] auto view() {
+        return record_range<false, Ts...>{this};
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] auto view_object() {
+        return record_range<true, Ts...>{this};
+    }
+#endif
+
+#ifdef SSP_COROUTINES_ENABLED
+    ////////////////
+    // rows
+    ////////////////
+
+    // same as 'iterate', but the records are produced by a coroutine which
+    // reads the next record only once it is requested
+    template <typename... Ts>
+    [[nodiscard]] generator<no_void_validator_tup_t<Ts...>> rows() {
+        while (!eof()) {
+            co_yield get_next<Ts...>();
+        }
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] generator<T> rows_object() {
+        while (!eof()) {
+            co_yield get_object<T, Ts...>();
+        }
+    }
+#endif
+
+    ////////////////
+    // composite conversion
+    ////////////////
+    template <typename... Ts>
+    class composite {
+    public:
+        composite(std::tuple<Ts...>&& values, parser& parser)
+            : values_{std::move(values)}, parser_{parser} {
+        }
+
+        // tries to convert the same line with a different output type
+        // only if the previous conversion was not successful,
+        // returns composite containing itself and the new output
+        // as optional, additionally, if a parameter is passed, and
+        // that parameter can be invoked using the converted value,
+        // than it will be invoked in the case of a valid conversion
+        template <typename... Us, typename Fun = none>
+        composite<Ts..., std::optional<no_void_validator_tup_t<Us...>>> or_else(
+            Fun&& fun = none{}) {
+            using Value = no_void_validator_tup_t<Us...>;
+            std::optional<Value> value;
+            try_convert_and_invoke<Value, Us...>(value, std::forward<Fun>(fun));
+            return composite_with(std::move(value));
+        }
+
+        // same as or_else, but saves the result into a 'U' object
+        // instead of a tuple
+        template <typename U, typename... Us, typename Fun = none>
+        composite<Ts..., std::optional<U>> or_object(Fun&& fun = none{}) {
+            std::optional<U> value;
+            try_convert_and_invoke<U, Us...>(value, std::forward<Fun>(fun));
+            return composite_with(std::move(value));
+        }
+
+        [[nodiscard]] std::tuple<Ts...> values() {
+            return values_;
+        }
+
+        template <typename Fun>
+        auto on_error(Fun&& fun) {
+            assert_throw_on_error_not_defined<throw_on_error>();
+            if (!parser_.valid()) {
+                if constexpr (std::is_invocable_v<Fun>) {
+                    fun();
+                } else {
+                    static_assert(string_error,
+                                  "to enable error messages within the "
+                                  "on_error method "
+                                  "callback string_error needs to be enabled");
+                    std::invoke(std::forward<Fun>(fun), parser_.error_msg());
+                }
+            }
+            return *this;
+        }
+
+    private:
+        template <typename T>
+        [[nodiscard]] composite<Ts..., T> composite_with(T&& new_value) {
+            auto merged_values =
+                std::tuple_cat(std::move(values_),
+                               std::tuple<T>{parser_.valid()
+                                                 ? std::forward<T>(new_value)
+                                                 : std::nullopt});
+            return {std::move(merged_values), parser_};
+        }
+
+        template <typename U, typename... Us, typename Fun = none>
+        void try_convert_and_invoke(std::optional<U>& value, Fun&& fun) {
+            if (parser_.valid()) {
+                return;
+            }
+
+            auto tuple_output = try_same<Us...>();
+            if (!parser_.valid()) {
+                return;
+            }
+
+            if constexpr (!std::is_same_v<U, decltype(tuple_output)>) {
+                value = to_object<U>(std::move(tuple_output));
+            } else {
+                value = std::move(tuple_output);
+            }
+
+            parser_.try_invoke(*value, std::forward<Fun>(fun));
+        }
+
+        template <typename U, typename... Us>
+        [[nodiscard]] no_void_validator_tup_t<U, Us...> try_same() {
+            parser_.clear_error();
+            parser_.remember_converted_values(true);
+            auto value =
+                parser_.reader_.converter_.template convert<U, Us...>();
+            parser_.remember_converted_values(false);
+            if (!parser_.reader_.converter_.valid()) {
+                parser_.handle_error_invalid_conversion();
+            }
+            return value;
+        }
+
+        ////////////////
+        // members
+        ////////////////
+
+        std::tuple<Ts...> values_;
+        parser& parser_;
+    };
+
+    // tries to convert a line and returns a composite which is
+    // able to try additional conversions in case of failure
+    template <typename... Ts, typename Fun = none>
+    [[nodiscard]] composite<std::optional<no_void_validator_tup_t<Ts...>>>
+    try_next(Fun&& fun = none{}) {
+        assert_throw_on_error_not_defined<throw_on_error>();
+        using Ret = no_void_validator_tup_t<Ts...>;
+        remember_converted_values(true);
+        auto value = get_next<Ts...>();
+        remember_converted_values(false);
+        return try_invoke_and_make_composite<std::optional<Ret>>(
+            std::move(value), std::forward<Fun>(fun));
+    }
+
+    // identical to try_next but returns composite with object instead of a
+    // tuple
+    template <typename T, typename... Ts, typename Fun = none>
+    [[nodiscard]] composite<std::optional<T>> try_object(Fun&& fun = none{}) {
+        assert_throw_on_error_not_defined<throw_on_error>();
+        remember_converted_values(true);
+        auto value = get_object<T, Ts...>();
+        remember_converted_values(false);
+        return try_invoke_and_make_composite<std::optional<T>>(
+            std::move(value), std::forward<Fun>(fun));
+    }
+
+    ////////////////
+    // sampling
+    ////////////////
+
+    // converts every 'stride'-th record until the end of file, the records
+    // in between are skipped, records which could not be converted are not
+    // sampled
+    template <typename T, typename... Ts>
+    [[nodiscard]] std::vector<no_void_validator_tup_t<T, Ts...>> sample_stride(
+        size_t stride) {
+        std::vector<no_void_validator_tup_t<T, Ts...>> samples;
+        while (!eof_) {
+            if (auto value = try_get_next<T, Ts...>()) {
+                samples.push_back(std::move(*value));
+            }
+            std::ignore = skip(std::max<size_t>(stride, 1) - 1);
+        }
+
+        clear_error();
+        return samples;
+    }
+
+    // converts 'count' records chosen uniformly from all the records until
+    // the end of file, the gaps between the chosen records are computed
+    // up front (algorithm L) so the rest of the records are only skipped
+    template <typename T, typename... Ts, typename Generator>
+    [[nodiscard]] std::vector<no_void_validator_tup_t<T, Ts...>>
+    sample_reservoir(size_t count, Generator&& generator) {
+        std::vector<no_void_validator_tup_t<T, Ts...>> samples;
+        if (count == 0) {
+            return samples;
+        }
+
+        while (!eof_ && samples.size() < count) {
+            if (auto value = try_get_next<T, Ts...>()) {
+                samples.push_back(std::move(*value));
+            }
+        }
+
+        std::uniform_real_distribution<double> uniform{
+            std::nextafter(0.0, 1.0), 1.0};
+        std::uniform_int_distribution<size_t> slot{0, count - 1};
+
+        auto weight = std::exp(std::log(uniform(generator)) / count);
+        while (!eof_) {
+            const auto gap =
+                std::floor(std::log(uniform(generator)) / std::log1p(-weight));
+            constexpr static auto max_gap =
+                static_cast<double>(std::numeric_limits<size_t>::max() / 2);
+            std::ignore = skip(static_cast<size_t>(std::min(gap, max_gap)));
+
+            if (eof_) {
+                break;
+            }
+
+            if (auto value = try_get_next<T, Ts...>()) {
+                samples[slot(generator)] = std::move(*value);
+                weight *= std::exp(std::log(uniform(generator)) / count);
+            }
+        }
+
+        clear_error();
+        return samples;
+    }
+
+    // converts the records found after up to 'count' random byte offsets
+    // between the current position and the end of file, the reading
+    // continues from the first record after each offset, lines which could
+    // not be converted are dropped until a valid record is found, the
+    // records are returned in the order of the file, each one at most
+    // once, longer records are more likely to precede an offset
+    template <typename T, typename... Ts, typename Generator>
+    [[nodiscard]] std::vector<no_void_validator_tup_t<T, Ts...>>
+    sample_offsets(size_t count, Generator&& generator) {
+        std::vector<no_void_validator_tup_t<T, Ts...>> samples;
+
+        const size_t begin = position();
+        const size_t end = reader_.data_size();
+        if (eof_ || count == 0 || begin >= end) {
+            return samples;
+        }
+
+        std::uniform_int_distribution<size_t> uniform{begin, end - 1};
+        std::vector<size_t> offsets(count);
+        for (auto& offset : offsets) {
+            offset = uniform(generator);
+        }
+        std::sort(offsets.begin(), offsets.end());
+
+        size_t sampled_end = 0;
+        for (const auto offset : offsets) {
+            if (offset < sampled_end) {
+                continue;
+            }
+
+            skip_to(offset);
+            if constexpr (quoted_multiline_enabled) {
+                skip_quoted_continuation();
+            }
+
+            while (!eof_) {
+                if (auto value = try_get_next<T, Ts...>()) {
+                    samples.push_back(std::move(*value));
+                    break;
+                }
+            }
+            sampled_end = position();
+        }
+
+        clear_error();
+        return samples;
+    }
+
+private:
+    // tries to invoke the given function (see below), if the function
+    // returns a value which can be used as a conditional, and it returns
+    // false, the function sets an error, and allows the invoke of the
+    // next possible conversion as if the validation of the current one
+    // failed
+    template <typename Arg, typename Fun = none>
+    void try_invoke(Arg&& arg, Fun&& fun) {
+        constexpr bool is_none = std::is_same_v<std::decay_t<Fun>, none>;
+        if constexpr (!is_none) {
+            using Ret = decltype(try_invoke_impl(arg, std::forward<Fun>(fun)));
+            constexpr bool returns_void = std::is_same_v<Ret, void>;
+            if constexpr (!returns_void) {
+                if (!try_invoke_impl(std::forward<Arg>(arg),
+                                     std::forward<Fun>(fun))) {
+                    handle_error_failed_check();
+                }
+            } else {
+                try_invoke_impl(arg, std::forward<Fun>(fun));
+            }
+        }
+    }
+
+    // tries to invoke the function if not none
+    // it first tries to invoke the function without arguments,
+    // than with one argument if the function accepts the whole tuple
+    // as an argument, and finally tries to invoke it with the tuple
+    // laid out as a parameter pack
+    template <typename Arg, typename Fun = none>
+    auto try_invoke_impl(Arg&& arg, Fun&& fun) {
+        constexpr bool is_none = std::is_same_v<std::decay_t<Fun>, none>;
+        if constexpr (!is_none) {
+            if constexpr (std::is_invocable_v<Fun>) {
+                return fun();
+            } else if constexpr (std::is_invocable_v<Fun, Arg>) {
+                return std::invoke(std::forward<Fun>(fun),
+                                   std::forward<Arg>(arg));
+            } else {
+                return std::apply(std::forward<Fun>(fun),
+                                  std::forward<Arg>(arg));
+            }
+        }
+    }
+
+    void read_header() {
+        read_line();
+        if constexpr (ignore_header) {
+            ignore_next();
+        } else {
+            raw_header_ = reader_.get_buffer();
+        }
+    }
+
+    ////////////////
+    // checkpoint
+    ////////////////
+
+    void resume(const ss::checkpoint& checkpoint) {
+        raw_header_ = checkpoint.raw_header;
+        header_.assign(checkpoint.header.begin(), checkpoint.header.end());
+
+        if (!checkpoint.column_mapping.empty()) {
+            reader_.converter_.set_column_mapping(
+                checkpoint.column_mapping, checkpoint.number_of_columns);
+            reader_.next_line_converter_.set_column_mapping(
+                checkpoint.column_mapping, checkpoint.number_of_columns);
+        }
+
+        reader_.crlf_ = checkpoint.crlf;
+        reader_.line_number_ = checkpoint.line;
+        reader_.seek(checkpoint.position);
+        next_line();
+    }
+
+    ////////////////
+    // byte range
+    ////////////////
+
+    void read_range(const ss::byte_range& range) {
+        reader_.range_end_ = range.end;
+
+        if (range.begin == 0) {
+            eof_ = eof_ || reader_.record_begin_ >= range.end;
+            return;
+        }
+
+        skip_to(range.begin);
+        if constexpr (quoted_multiline_enabled) {
+            skip_quoted_continuation();
+        }
+    }
+
+    // the line found after an offset may continue a quoted field of a
+    // multiline record, all the lines up to the end of such a record are
+    // skipped
+    void skip_quoted_continuation() {
+        if (eof_ || !continues_quoted_field()) {
+            return;
+        }
+
+        bool ignored = false;
+        bool in_quotes = reader_.scan_quotes(true, ignored).value_or(false);
+        while (in_quotes) {
+            next_line();
+            if (eof_) {
+                return;
+            }
+
+            const auto state = reader_.scan_quotes(true, ignored);
+            in_quotes = state.value_or(false);
+        }
+
+        next_line();
+    }
+
+    // the next line is scanned from both an unquoted and a quoted state, a
+    // state is rejected if a closing quote is not followed by a delimiter,
+    // or if a quote is found within an unquoted field, if neither state is
+    // rejected the following lines are scanned with both states until one
+    // of them is, after which the lines are read again from the first one,
+    // the line is assumed to begin a record if this cannot be decided
+    [[nodiscard]] bool continues_quoted_field() {
+        std::optional<bool> unquoted = false;
+        std::optional<bool> quoted = true;
+
+        auto scan = [&](std::optional<bool>& state) {
+            bool literal_quote = false;
+            state = reader_.scan_quotes(*state, literal_quote);
+            if (literal_quote) {
+                state.reset();
+            }
+        };
+
+        scan(unquoted);
+        scan(quoted);
+        if (!quoted || !unquoted || reader_.following()) {
+            return !unquoted && quoted;
+        }
+
+        const size_t begin = reader_.record_begin_;
+        const size_t line_number = reader_.line_number_;
+        const size_t range_end = std::exchange(
+            reader_.range_end_, std::numeric_limits<size_t>::max());
+
+        for (size_t i = 0; i < quote_resync_lines && quoted && unquoted; ++i) {
+            if (!reader_.read_next()) {
+                break;
+            }
+            scan(unquoted);
+            scan(quoted);
+        }
+
+        reader_.range_end_ = range_end;
+        reader_.seek(begin);
+        reader_.line_number_ = line_number - 1;
+        next_line();
+
+        return !unquoted && quoted;
+    }
+
+    ////////////////
+    // filter
+    ////////////////
+
+    void parse_line() {
+        if constexpr (throw_on_error) {
+            try {
+                reader_.parse();
+            } catch (const ss::exception& e) {
+                read_line();
+                decorate_rethrow(e);
+            }
+        } else {
+            reader_.parse();
+        }
+    }
+
+    // the next line may have already been parsed while skipping the lines
+    // rejected by the filters, in which case only the error of the parsing
+    // is reported
+    void parse_next_line() {
+        skip_filtered_lines();
+        if (eof_) {
+            return;
+        }
+
+        if (!next_line_parsed_) {
+            parse_line();
+            return;
+        }
+
+        next_line_parsed_ = false;
+        if constexpr (throw_on_error) {
+            if (next_line_error_) {
+                auto e = std::move(*next_line_error_);
+                next_line_error_.reset();
+                read_line();
+                decorate_rethrow(e);
+            }
+        }
+    }
+
+    // lines are parsed ahead so that 'eof' is known right after the last
+    // accepted line is read, lines which could not be parsed are not
+    // skipped, their error is reported when they are read
+    void skip_filtered_lines() {
+        read_deferred_line();
+
+        while (!eof_ && !filters_.empty() && !next_line_parsed_) {
+            next_line_parsed_ = true;
+
+            if constexpr (throw_on_error) {
+                try {
+                    reader_.parse();
+                } catch (const ss::exception& e) {
+                    next_line_error_ = e;
+                    return;
+                }
+            } else {
+                reader_.parse();
+            }
+
+            const auto& next = reader_.next_line_converter_;
+            if (!next.valid() || !next.splitter_.valid() ||
+                accepted(next.splitter_.get_split_data())) {
+                return;
+            }
+
+            next_line_parsed_ = false;
+            eof_ = !reader_.read_next();
+        }
+    }
+
+    void read_deferred_line() {
+        if (next_line_deferred_) {
+            next_line_deferred_ = false;
+            eof_ = !reader_.read_next();
+            skip_filtered_lines();
+        }
+    }
+
+    [[nodiscard]] bool accepted(const split_data& fields) const {
+        return std::all_of(filters_.begin(), filters_.end(),
+                           [&fields](const auto& filter) {
+                               return filter(fields);
+                           });
+    }
+
+    ////////////////
+    // dispatch
+    ////////////////
+
+    template <typename Handler>
+    [[nodiscard]] bool try_handler(std::string_view key, Handler& handler) {
+        if (handler.key != key) {
+            return false;
+        }
+
+        auto value = convert_for(handler);
+        read_line();
+
+        if (valid()) {
+            try_invoke(value, handler.fun);
+        }
+        return true;
+    }
+
+    template <typename Fun, typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<Ts...> convert_for(
+        const record_handler<Fun, Ts...>&) {
+        return convert_current<Ts...>();
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<Ts...> convert_current() {
+        if constexpr (throw_on_error) {
+            try {
+                return reader_.converter_.template convert<Ts...>();
+            } catch (const ss::exception& e) {
+                read_line();
+                decorate_rethrow(e);
+            }
+        }
+
+        auto value = reader_.converter_.template convert<Ts...>();
+        if (!reader_.converter_.valid()) {
+            handle_error_invalid_conversion();
+        }
+        return value;
+    }
+
+    ////////////////
+    // sampling
+    ////////////////
+
+    template <typename... Ts>
+    [[nodiscard]] std::optional<no_void_validator_tup_t<Ts...>> try_get_next() {
+        if constexpr (throw_on_error) {
+            try {
+                return get_next<Ts...>();
+            } catch (const ss::exception&) {
+                return std::nullopt;
+            }
+        } else {
+            auto value = get_next<Ts...>();
+            if (!valid()) {
+                return std::nullopt;
+            }
+            return value;
+        }
+    }
+
+    // the columns converted by the first conversion of a composite are
+    // remembered by the converter, so the alternative conversions of the
+    // same line do not convert the columns of the same type again
+    void remember_converted_values(bool remember) {
+        reader_.converter_.remember_converted_values(remember);
+        reader_.next_line_converter_.remember_converted_values(remember);
+    }
+
+    template <typename T, typename Fun = none>
+    [[nodiscard]] composite<T> try_invoke_and_make_composite(T&& value,
+                                                             Fun&& fun) {
+        if (valid()) {
+            try_invoke(*value, std::forward<Fun>(fun));
+        }
+        return {valid() ? std::forward<T>(value) : std::nullopt, *this};
+    }
+
+    ////////////////
+    // header
+    ////////////////
+
+    void assert_arena_views_defined() const {
+        static_assert(arena_views,
+                      "'arena_views' needs to be enabled to use the arena");
+    }
+
+    void assert_ignore_header_not_defined() const {
+        static_assert(!ignore_header,
+                      "cannot use this method when 'ignore_header' is defined");
+    }
+
+    [[nodiscard]] bool strict_split(header_splitter& splitter,
+                                    std::pmr::string& header) {
+        if constexpr (throw_on_error) {
+            try {
+                splitter.split(header.data(), reader_.delim_);
+            } catch (const ss::exception& e) {
+                decorate_rethrow_invalid_header_split(e);
+            }
+        } else {
+            splitter.split(header.data(), reader_.delim_);
+            if (!splitter.valid()) {
+                handle_error_invalid_header_split(splitter);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void split_header_data() {
+        header_splitter splitter{reader_.resource_};
+        std::pmr::string raw_header_copy{raw_header_,
+                                         raw_header_.get_allocator()};
+
+        if (!strict_split(splitter, raw_header_copy)) {
+            return;
+        }
+
+        for (const auto& [begin, end] : splitter.get_split_data()) {
+            const std::string_view field{begin,
+                                         static_cast<size_t>(end - begin)};
+            if (std::find(header_.begin(), header_.end(), field) !=
+                header_.end()) {
+                handle_error_duplicate_header_field(std::string{field});
+                header_.clear();
+                return;
+            }
+            header_.emplace_back(field);
+        }
+    }
+
+    [[nodiscard]] std::optional<size_t> header_index(std::string_view field) {
+        auto it = std::find(header_.begin(), header_.end(), field);
+
+        if (it == header_.end()) {
+            return std::nullopt;
+        }
+
+        return std::distance(header_.begin(), it);
+    }
+
+    ////////////////
+    // error
+    ////////////////
+
+    void clear_error() {
+        if constexpr (string_error) {
+            error_.clear();
+        } else {
+            error_ = false;
+        }
+    }
+
+    void handle_error_failed_check() {
+        constexpr static auto error_msg = ": failed check";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_null_buffer() {
+        constexpr static auto error_msg = ": received null data buffer";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_file_not_open() {
+        constexpr static auto error_msg = ": could not be opened";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_source_not_readable() {
+        constexpr static auto error_msg = ": could not be read";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_eof_reached() {
+        constexpr static auto error_msg = ": read on end of file";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_invalid_conversion() {
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_)
+                .append(" ")
+                .append(std::to_string(reader_.line_number_))
+                .append(": ")
+                .append(reader_.converter_.error_msg());
+        } else if constexpr (!throw_on_error) {
+            error_ = true;
+        }
+    }
+
+    void handle_error_invalid_discriminator_column(size_t column) {
+        constexpr static auto error_msg =
+            ": invalid discriminator column, number of columns: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_)
+                .append(" ")
+                .append(std::to_string(line()))
+                .append(error_msg)
+                .append(std::to_string(
+                    reader_.converter_.splitter_.get_split_data().size()))
+                .append(", given column: ")
+                .append(std::to_string(column + 1));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{
+                file_name_ + " " + std::to_string(line()) + error_msg +
+                std::to_string(
+                    reader_.converter_.splitter_.get_split_data().size()) +
+                ", given column: " + std::to_string(column + 1)};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_no_handler(std::string_view key) {
+        constexpr static auto error_msg = ": no handler for discriminator: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_)
+                .append(" ")
+                .append(std::to_string(line()))
+                .append(error_msg)
+                .append("\'")
+                .append(key)
+                .append("\'");
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + " " + std::to_string(line()) +
+                                error_msg + "\'" + std::string{key} + "\'"};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_invalid_field(const std::string& field) {
+        constexpr static auto error_msg =
+            ": header does not contain given field: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg).append(field);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg + field};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_field_used_multiple_times(const std::string& field) {
+        constexpr static auto error_msg = ": given field used multiple times: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg).append(field);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg + field};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_invalid_use_fields_argument() {
+        constexpr static auto error_msg =
+            "received invalid argument for 'use_fields'";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_invalid_header_field() {
+        constexpr static auto error_msg = ": header contains empty field";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_duplicate_header_field(const std::string& field) {
+        constexpr static auto error_msg = ": header contains duplicate: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg).append(field);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg + field};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_invalid_header_split(const header_splitter& splitter) {
+        constexpr static auto error_msg = ": failed header parsing: ";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_)
+                .append(error_msg)
+                .append(splitter.error_msg());
+        } else {
+            error_ = true;
+        }
+    }
+
+    void decorate_rethrow_invalid_header_split(const ss::exception& e) const {
+        static_assert(throw_on_error,
+                      "throw_on_error needs to be enabled to use this method");
+        throw ss::exception{std::string{file_name_}
+                                .append(": failed header parsing: ")
+                                .append(e.what())};
+    }
+
+    void decorate_rethrow(const ss::exception& e) const {
+        static_assert(throw_on_error,
+                      "throw_on_error needs to be enabled to use this method");
+        throw ss::exception{std::string{file_name_}
+                                .append(" ")
+                                .append(std::to_string(line()))
+                                .append(": ")
+                                .append(e.what())};
+    }
+
+    ////////////////
+    // line reading
+    ////////////////
+
+    // the limit counts only the lines which were read, not the skipped
+    // ones
+    void read_line() {
+        if (records_left_ && --*records_left_ == 0) {
+            eof_ = true;
+            return;
+        }
+
+        next_line();
+    }
+
+    void next_line() {
+        next_line_parsed_ = false;
+        next_line_error_.reset();
+
+        // in follow mode the current line would otherwise be held back
+        // until the next one is written
+        if (reader_.following()) {
+            next_line_deferred_ = true;
+            line_number_ = reader_.line_number_ + 1;
+            return;
+        }
+
+        eof_ = !reader_.read_next();
+        line_number_ = reader_.line_number_;
+        if (eof_ && reader_.source_.take_error()) {
+            handle_error_source_not_readable();
+        }
+        skip_filtered_lines();
+    }
+
+    struct reader {
+        // the buffers are allocated from 'resource', or with 'std::realloc'
+        // if it is null
+        reader(const std::string& file_name_, std::string delim,
+               std::pmr::memory_resource* resource)
+            : reader{std::fopen(file_name_.c_str(), "rb"), true,
+                     std::move(delim), resource} {
+        }
+
+        // files which are not owned are read with their own buffering
+        reader(FILE* file, bool owns_file, std::string delim,
+               std::pmr::memory_resource* resource)
+            : converter_{resource}, next_line_converter_{resource},
+              delim_{std::move(delim)}, file_{file}, owns_file_{owns_file},
+              resource_{resource} {
+            share_converter_resources();
+
+            if (file_ && owns_file_) {
+                file_buffer_ = reallocate_buffer(nullptr, 0, file_buffer_size,
+                                                 resource_);
+                std::ignore = std::setvbuf(file_, file_buffer_, _IOFBF,
+                                           file_buffer_size);
+            }
+
+            if constexpr (sequential_scan) {
+                if (file_) {
+                    advise_sequential_file(file_);
+                }
+            }
+        }
+
+        reader(byte_source source, std::string delim,
+               std::pmr::memory_resource* resource)
+            : converter_{resource}, next_line_converter_{resource},
+              delim_{std::move(delim)}, source_{std::move(source)},
+              resource_{resource} {
+            share_converter_resources();
+        }
+
+        reader(const char* const buffer, size_t csv_data_size,
+               std::string delim, std::pmr::memory_resource* resource)
+            : converter_{resource}, next_line_converter_{resource},
+              delim_{std::move(delim)}, csv_data_buffer_{buffer},
+              csv_data_size_{csv_data_size}, resource_{resource} {
+            share_converter_resources();
+        }
+
+        reader(reader&& other) noexcept
+            : buffer_{other.buffer_},
+              next_line_buffer_{other.next_line_buffer_},
+              helper_buffer_{other.helper_buffer_},
+              file_buffer_{other.file_buffer_},
+              converter_{std::move(other.converter_)},
+              next_line_converter_{std::move(other.next_line_converter_)},
+              buffer_size_{other.buffer_size_},
+              next_line_buffer_size_{other.next_line_buffer_size_},
+              helper_buffer_size{other.helper_buffer_size},
+              delim_{std::move(other.delim_)}, file_{other.file_},
+              owns_file_{other.owns_file_}, source_{std::move(other.source_)},
+              csv_data_buffer_{other.csv_data_buffer_},
+              csv_data_size_{other.csv_data_size_},
+              resource_{other.resource_}, curr_char_{other.curr_char_},
+              dropped_until_{other.dropped_until_}, crlf_{other.crlf_},
+              line_number_{other.line_number_}, chars_read_{other.chars_read_},
+              record_begin_{other.record_begin_},
+              range_end_{other.range_end_},
+              next_line_size_{other.next_line_size_},
+              follow_stop_{std::move(other.follow_stop_)},
+              follow_backoff_{other.follow_backoff_} {
+            other.buffer_ = nullptr;
+            other.next_line_buffer_ = nullptr;
+            other.helper_buffer_ = nullptr;
+            other.file_buffer_ = nullptr;
+            other.file_ = nullptr;
+        }
+
+        reader& operator=(reader&& other) noexcept {
+            if (this != &other) {
+                buffer_ = other.buffer_;
+                next_line_buffer_ = other.next_line_buffer_;
+                helper_buffer_ = other.helper_buffer_;
+                file_buffer_ = other.file_buffer_;
+                converter_ = std::move(other.converter_);
+                next_line_converter_ = std::move(other.next_line_converter_);
+                buffer_size_ = other.buffer_size_;
+                next_line_buffer_size_ = other.next_line_buffer_size_;
+                helper_buffer_size = other.helper_buffer_size;
+                delim_ = std::move(other.delim_);
+                file_ = other.file_;
+                owns_file_ = other.owns_file_;
+                source_ = std::move(other.source_);
+                csv_data_buffer_ = other.csv_data_buffer_;
+                csv_data_size_ = other.csv_data_size_;
+                resource_ = other.resource_;
+                curr_char_ = other.curr_char_;
+                dropped_until_ = other.dropped_until_;
+                crlf_ = other.crlf_;
+                line_number_ = other.line_number_;
+                chars_read_ = other.chars_read_;
+                record_begin_ = other.record_begin_;
+                range_end_ = other.range_end_;
+                next_line_size_ = other.next_line_size_;
+                follow_stop_ = std::move(other.follow_stop_);
+                follow_backoff_ = other.follow_backoff_;
+
+                other.buffer_ = nullptr;
+                other.next_line_buffer_ = nullptr;
+                other.helper_buffer_ = nullptr;
+                other.file_buffer_ = nullptr;
+                other.file_ = nullptr;
+                other.csv_data_buffer_ = nullptr;
+            }
+
+            return *this;
+        }
+
+        ~reader() {
+            free_buffer(buffer_, buffer_size_, resource_);
+            free_buffer(next_line_buffer_, next_line_buffer_size_, resource_);
+            free_buffer(helper_buffer_, helper_buffer_size, resource_);
+
+            if (file_ && owns_file_) {
+                std::ignore = std::fclose(file_);
+            }
+            free_buffer(file_buffer_, file_buffer_size, resource_);
+        }
+
+        reader() = delete;
+        reader(const reader& other) = delete;
+        reader& operator=(const reader& other) = delete;
+
+        // the converters are swapped after each line, so they need to
+        // intern values into the same pool and store views into the same
+        // arena
+        void share_converter_resources() {
+            std::ignore = converter_.get_string_pool();
+            next_line_converter_.string_pool_ = converter_.string_pool_;
+
+            if constexpr (arena_views) {
+                std::ignore = converter_.get_arena();
+                next_line_converter_.arena_ = converter_.arena_;
+            }
+        }
+
+        // read next line each time in order to set eof_
+        [[nodiscard]] bool read_next() {
+            next_line_converter_.clear_error();
+            size_t size = 0;
+            while (size == 0) {
+                ++line_number_;
+                if (next_line_buffer_size_ > 0) {
+                    next_line_buffer_[0] = '\0';
+                }
+
+                chars_read_ = curr_char_;
+                record_begin_ = curr_char_;
+                if (record_begin_ >= range_end_) {
+                    return false;
+                }
+
+                auto [ssize, eof] =
+                    get_next_line(next_line_buffer_, next_line_buffer_size_);
+
+                if (eof) {
+                    return false;
+                }
+
+                size = remove_eol(next_line_buffer_, ssize);
+
+                if constexpr (!ignore_empty) {
+                    break;
+                }
+            }
+
+            next_line_size_ = size;
+            return true;
+        }
+
+        // reads the lines which belong to the record in the next line buffer
+        // without splitting it, the quotes are only counted, so the record
+        // is assumed to be well formed
+        void skip_continuation() {
+            if constexpr (multiline::enabled) {
+                using quote = typename setup<Options...>::quote;
+                using escape = typename setup<Options...>::escape;
+
+                bool quoted = false;
+                size_t limit = 0;
+
+                while (true) {
+                    bool escaped_eol = false;
+                    for (size_t i = 0; i < next_line_size_; ++i) {
+                        const char c = next_line_buffer_[i];
+                        if constexpr (escape::enabled) {
+                            if (escape::match(c)) {
+                                escaped_eol = (i + 1 == next_line_size_);
+                                ++i;
+                                continue;
+                            }
+                        }
+                        if constexpr (quote::enabled) {
+                            quoted ^= quote::match(c);
+                        }
+                    }
+
+                    if (!(quoted && quoted_multiline_enabled) &&
+                        !(escaped_eol && escaped_multiline_enabled)) {
+                        return;
+                    }
+
+                    if constexpr (multiline::size > 0) {
+                        if (limit++ >= multiline::size) {
+                            return;
+                        }
+                    }
+
+                    chars_read_ = curr_char_;
+                    auto [ssize, eof] = get_next_line(next_line_buffer_,
+                                                      next_line_buffer_size_);
+
+                    if (eof) {
+                        return;
+                    }
+
+                    ++line_number_;
+                    next_line_size_ = remove_eol(next_line_buffer_, ssize);
+                }
+            }
+        }
+
+        // scans the next line with the given initial quote state, returns
+        // whether the line ends within a quoted field, or nothing if a
+        // closing quote is not followed by a delimiter, quotes which are
+        // not at the beginning of a field are not treated as errors, but
+        // are reported through 'literal_quote'
+        [[nodiscard]] std::optional<bool> scan_quotes(
+            bool quoted, bool& literal_quote) const {
+            using quote = typename setup<Options...>::quote;
+            using escape = typename setup<Options...>::escape;
+            using trim_right = typename setup<Options...>::trim_right;
+
+            const char* curr = next_line_buffer_;
+            const char* const end = next_line_buffer_ + next_line_size_;
+            auto at_delimiter = [&] {
+                return static_cast<size_t>(end - curr) >= delim_.size() &&
+                       std::equal(delim_.begin(), delim_.end(), curr);
+            };
+
+            bool field_begin = !quoted;
+            while (curr != end) {
+                if constexpr (escape::enabled) {
+                    if (escape::match(*curr)) {
+                        curr += (end - curr > 1) ? 2 : 1;
+                        field_begin = false;
+                        continue;
+                    }
+                }
+
+                if (quoted) {
+                    if (quote::match(*curr)) {
+                        if (curr + 1 != end && quote::match(*(curr + 1))) {
+                            curr += 2;
+                            continue;
+                        }
+
+                        quoted = false;
+                        ++curr;
+                        if constexpr (trim_right::enabled) {
+                            while (curr != end && trim_right::match(*curr)) {
+                                ++curr;
+                            }
+                        }
+                        if (curr != end && !at_delimiter()) {
+                            return std::nullopt;
+                        }
+                        continue;
+                    }
+                    ++curr;
+                    continue;
+                }
+
+                if (at_delimiter()) {
+                    curr += delim_.size();
+                    field_begin = true;
+                    continue;
+                }
+
+                if (quote::match(*curr)) {
+                    if (field_begin) {
+                        quoted = true;
+                    } else {
+                        literal_quote = true;
+                    }
+                }
+
+                field_begin = false;
+                ++curr;
+            }
+
+            return quoted;
+        }
+
+        // lines longer than the record size limit are cut, the line ending
+        // is kept, so the cut lines are longer than the limit
+        constexpr static size_t line_size_limit =
+            max_record_bytes > 0 ? max_record_bytes + 2
+                                 : std::numeric_limits<size_t>::max();
+
+        // the line is written after the first 'offset' characters of the
+        // buffer, the returned size does not include them
+        [[nodiscard]] std::tuple<ssize_t, bool> get_data_line(
+            char*& buffer, size_t& buffer_size, size_t offset = 0) {
+            if (!source_) {
+                auto result = get_line(
+                    buffer, buffer_size, file_, csv_data_buffer_,
+                    csv_data_size_, curr_char_, offset, line_size_limit,
+                    resource_);
+                if constexpr (sequential_scan) {
+                    drop_read_pages();
+                }
+                return result;
+            }
+
+            size_t dropped = 0;
+            const auto ssize =
+                source_.get_line(buffer, buffer_size, offset,
+                                 line_size_limit, dropped, resource_);
+            if (ssize == -1) {
+                return {ssize, true};
+            }
+
+            curr_char_ += ssize + dropped;
+            return {ssize, false};
+        }
+
+        // the pages which were read are dropped in large steps, the page
+        // the reading position is in is kept since it is still buffered
+        void drop_read_pages() {
+            if (!file_ || curr_char_ < dropped_until_ + page_cache_drop_size) {
+                return;
+            }
+
+            const auto end = curr_char_ / page_cache_drop_size *
+                             page_cache_drop_size;
+            advise_dont_need_file(file_, dropped_until_, end);
+            dropped_until_ = end;
+        }
+
+        [[nodiscard]] bool following() const {
+            return file_ && follow_stop_;
+        }
+
+        // same as 'get_line', but in follow mode it waits until a whole
+        // line is written into the file
+        [[nodiscard]] std::tuple<ssize_t, bool> get_next_line(
+            char*& buffer, size_t& buffer_size, size_t offset = 0) {
+            auto [ssize, eof] = get_data_line(buffer, buffer_size, offset);
+            if (!following()) {
+                return {ssize, eof};
+            }
+
+            auto wait = follow_backoff_.min;
+            while (eof || buffer[offset + ssize - 1] != '\n') {
+                // the file is read once more after stopping, since the
+                // data may have been written before the stop
+                const bool stop = follow_stop_();
+                if (!stop) {
+                    std::this_thread::sleep_for(wait);
+                    wait = std::min(wait * 2, follow_backoff_.max);
+                }
+
+                // the rest of the line is appended to the part of it which
+                // was already read
+                std::clearerr(file_);
+                const size_t read = eof ? 0 : static_cast<size_t>(ssize);
+                auto [next_ssize, next_eof] =
+                    get_data_line(buffer, buffer_size, offset + read);
+
+                if (next_eof) {
+                    if (stop) {
+                        break;
+                    }
+                    continue;
+                }
+
+                wait = follow_backoff_.min;
+                ssize = static_cast<ssize_t>(read) + next_ssize;
+                eof = false;
+            }
+
+            return {ssize, eof};
+        }
+
+        [[nodiscard]] size_t data_size() const {
+            return file_ ? file_size(file_) : csv_data_size_;
+        }
+
+        // moves to the given byte offset and drops the rest of the line
+        // the offset is in, unless the offset is at the beginning of a line
+        void seek(size_t position) {
+            const size_t offset = position > 0 ? position - 1 : 0;
+            if (file_ && !seek_file(file_, offset)) {
+                return;
+            }
+
+            curr_char_ = file_ ? offset : std::min(offset, csv_data_size_);
+            dropped_until_ = curr_char_;
+            if (position == 0) {
+                return;
+            }
+
+            std::ignore = get_data_line(helper_buffer_, helper_buffer_size);
+        }
+
+        void parse() {
+            size_t limit = 0;
+
+            if (record_size_limit_reached()) {
+                return;
+            }
+
+            if constexpr (escaped_multiline_enabled) {
+                while (escaped_eol(next_line_size_)) {
+                    if (multiline_limit_reached(limit)) {
+                        return;
+                    }
+
+                    if (!append_next_line_to_buffer(next_line_buffer_,
+                                                    next_line_size_,
+                                                    next_line_buffer_size_)) {
+                        next_line_converter_.handle_error_unterminated_escape();
+                        return;
+                    }
+                }
+            }
+
+            next_line_converter_.split(next_line_buffer_, delim_);
+
+            if constexpr (quoted_multiline_enabled) {
+                while (unterminated_quote()) {
+                    next_line_size_ -= next_line_converter_.size_shifted();
+
+                    if (multiline_limit_reached(limit)) {
+                        return;
+                    }
+
+                    if (!append_next_line_to_buffer(next_line_buffer_,
+                                                    next_line_size_,
+                                                    next_line_buffer_size_)) {
+                        next_line_converter_.handle_error_unterminated_quote();
+                        return;
+                    }
+
+                    if constexpr (escaped_multiline_enabled) {
+                        while (escaped_eol(next_line_size_)) {
+                            if (multiline_limit_reached(limit)) {
+                                return;
+                            }
+
+                            if (!append_next_line_to_buffer(
+                                    next_line_buffer_, next_line_size_,
+                                    next_line_buffer_size_)) {
+                                next_line_converter_
+                                    .handle_error_unterminated_escape();
+                                return;
+                            }
+                        }
+                    }
+
+                    next_line_converter_.resplit(next_line_buffer_,
+                                                 next_line_size_, delim_);
+                }
+            }
+
+            std::ignore = record_size_limit_reached();
+        }
+
+        void update() {
+            std::swap(buffer_, next_line_buffer_);
+            std::swap(buffer_size_, next_line_buffer_size_);
+            std::swap(converter_, next_line_converter_);
+        }
+
+        [[nodiscard]] bool record_size_limit_reached() {
+            if constexpr (max_record_bytes > 0) {
+                if (next_line_size_ > max_record_bytes) {
+                    next_line_converter_
+                        .handle_error_record_size_limit_reached();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool multiline_limit_reached(size_t& limit) {
+            if (record_size_limit_reached()) {
+                return true;
+            }
+
+            if constexpr (multiline::size > 0) {
+                if (limit++ >= multiline::size) {
+                    next_line_converter_.handle_error_multiline_limit_reached();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool escaped_eol(size_t size) {
+            const char* curr = nullptr;
+            for (curr = next_line_buffer_ + size - 1;
+                 curr >= next_line_buffer_ &&
+                 setup<Options...>::escape::match(*curr);
+                 --curr) {
+            }
+            return (next_line_buffer_ - curr + size) % 2 == 0;
+        }
+
+        [[nodiscard]] bool unterminated_quote() {
+            return next_line_converter_.unterminated_quote();
+        }
+
+        void undo_remove_eol(char* buffer, size_t& line_size,
+                             size_t buffer_size) {
+            if (crlf_ && buffer_size >= line_size + 2) {
+                std::copy_n("\r\n", 2, buffer + line_size);
+                line_size += 2;
+            } else if (buffer_size > line_size) {
+                std::copy_n("\n", 1, buffer + line_size);
+                line_size += 1;
+            }
+        }
+
+        [[nodiscard]] size_t remove_eol(char*& buffer, size_t ssize) {
+            if (buffer[ssize - 1] != '\n') {
+                crlf_ = false;
+                return ssize;
+            }
+
+            size_t size = ssize - 1;
+            if (ssize >= 2 && buffer[ssize - 2] == '\r') {
+                crlf_ = true;
+                size--;
+            } else {
+                crlf_ = false;
+            }
+
+            buffer[size] = '\0';
+            return size;
+        }
+
+        // the next line is read directly after the record within the
+        // buffer, which grows geometrically, so a record of many lines is
+        // not copied again for each of them
+        [[nodiscard]] bool append_next_line_to_buffer(char*& buffer,
+                                                      size_t& line_size,
+                                                      size_t& buffer_size) {
+            undo_remove_eol(buffer, line_size, buffer_size);
+
+            chars_read_ = curr_char_;
+            auto [next_ssize, eof] =
+                get_next_line(buffer, buffer_size, line_size);
+
+            if (eof) {
+                return false;
+            }
+
+            ++line_number_;
+            line_size = remove_eol(buffer, line_size + next_ssize);
+            return true;
+        }
+
+        [[nodiscard]] std::string_view get_buffer() const {
+            return std::string_view{next_line_buffer_, next_line_size_};
+        }
+
+        ////////////////
+        // members
+        ////////////////
+        char* buffer_{nullptr};
+        char* next_line_buffer_{nullptr};
+        char* helper_buffer_{nullptr};
+        char* file_buffer_{nullptr};
+
+        converter<Options...> converter_;
+        converter<Options...> next_line_converter_;
+
+        size_t buffer_size_{0};
+        size_t next_line_buffer_size_{0};
+        size_t helper_buffer_size{0};
+
+        std::string delim_;
+        FILE* file_{nullptr};
+        bool owns_file_{true};
+        byte_source_reader source_;
+
+        const char* csv_data_buffer_{nullptr};
+        size_t csv_data_size_{0};
+        std::pmr::memory_resource* resource_{nullptr};
+        size_t curr_char_{0};
+        size_t dropped_until_{0};
+
+        bool crlf_{false};
+        size_t line_number_{0};
+        size_t chars_read_{0};
+        size_t record_begin_{0};
+        size_t range_end_{std::numeric_limits<size_t>::max()};
+
+        size_t next_line_size_{0};
+
+        std::function<bool()> follow_stop_;
+        follow_backoff follow_backoff_;
+    };
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::string file_name_;
+    error_type error_{};
+    reader reader_;
+    std::pmr::vector<std::pmr::string> header_;
+    std::pmr::string raw_header_;
+    std::vector<std::function<bool(const split_data&)>> filters_;
+    std::optional<ss::exception> next_line_error_;
+    std::optional<size_t> records_left_;
+    size_t line_number_{0};
+    bool next_line_parsed_{false};
+    bool next_line_deferred_{false};
+    bool eof_{false};
+};
+
+} /* namespace ss */
+
+
+namespace ss {
+
+// reads multiple files with the same header as if they were one, the header
+// of each file is skipped, the next file is opened while the current one is
+// being read
+template <typename... Options>
+class multi_parser {
+    using parser_type = parser<Options...>;
+
+    constexpr static auto string_error = setup<Options...>::string_error;
+    constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
+    constexpr static auto ignore_header = setup<Options...>::ignore_header;
+    constexpr static auto arena_views = setup<Options...>::arena_views;
+
+    using error_type = std::conditional_t<string_error, std::string, bool>;
+
+public:
+    // the first file is opened right away, each following one is opened in
+    // the background while the one before it is being read
+    multi_parser(std::vector<std::string> file_names,
+                 std::string delim = ss::default_delimiter)
+        : file_names_{std::move(file_names)}, delim_{std::move(delim)} {
+        open_first_file();
+    }
+
+    multi_parser(multi_parser&& other) = default;
+    multi_parser& operator=(multi_parser&& other) = default;
+    ~multi_parser() = default;
+
+    multi_parser() = delete;
+    multi_parser(const multi_parser& other) = delete;
+    multi_parser& operator=(const multi_parser& other) = delete;
+
+    [[nodiscard]] bool valid() const {
+        if constexpr (string_error) {
+            return error_.empty();
+        } else if constexpr (throw_on_error) {
+            return true;
+        } else {
+            return !error_;
+        }
+    }
+
+    [[nodiscard]] const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
+
+    [[nodiscard]] bool eof() const {
+        return eof_;
+    }
+
+    // name of the file the last record was read from, empty if no file
+    // was given
+    [[nodiscard]] const std::string& file_name() const {
+        const static std::string no_file;
+        return record_file_ < file_names_.size() ? file_names_[record_file_]
+                                                 : no_file;
+    }
+
+    // index of the file the last record was read from
+    [[nodiscard]] size_t file_index() const {
+        return record_file_;
+    }
+
+    // line of the last record within its file
+    [[nodiscard]] size_t line() const {
+        return record_line_;
+    }
+
+    // pool used by the parsers of all the files to store the values
+    // converted to 'ss::category', so the values stay valid after their
+    // file is closed, and equal values have equal codes in every file
+    [[nodiscard]] ss::string_pool& get_string_pool() {
+        return *string_pool_;
+    }
+
+    // arena used by the parsers of all the files to store the converted
+    // 'std::string_view' values, the values stay valid until it is reset
+    [[nodiscard]] ss::arena& get_arena() {
+        assert_arena_views_defined();
+        return *arena_;
+    }
+
+    // uses the given arena instead of the one owned by the multi_parser,
+    // the arena needs to outlive it
+    void set_arena(ss::arena& arena) {
+        assert_arena_views_defined();
+        arena_ = std::shared_ptr<ss::arena>{std::shared_ptr<ss::arena>{},
+                                            &arena};
+        if (parser_) {
+            parser_->set_arena(arena);
+        }
+    }
+
+    // header of the first file
+    [[nodiscard]] std::string raw_header() const {
+        assert_ignore_header_not_defined();
+        return raw_header_.value_or("");
+    }
+
+    // the fields are looked up in the header of every file, so the files
+    // do not need to have the same header, the files are opened again
+    // from the first one, so this should be called before reading
+    template <typename... Ts>
+    void use_fields(const Ts&... fields) {
+        assert_ignore_header_not_defined();
+        use_fields_ = [fields...](parser_type& p) { p.use_fields(fields...); };
+        open_first_file();
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] no_void_validator_tup_t<T, Ts...> get_next() {
+        clear_error();
+        if (eof_) {
+            handle_error_eof_reached();
+            return {};
+        }
+
+        record_file_ = file_ - 1;
+        if (!parser_) {
+            auto exception = std::exchange(file_exception_, nullptr);
+            auto error = std::exchange(file_error_, error_type{});
+            open_next_file();
+            handle_error_file_not_valid(exception, std::move(error));
+            return {};
+        }
+
+        auto value = parser_->template get_next<T, Ts...>();
+        record_line_ = parser_->line();
+        copy_error(*parser_);
+
+        if (parser_->eof()) {
+            open_next_file();
+        }
+        return value;
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] T get_object() {
+        return to_object<T>(get_next<Ts...>());
+    }
+
+    ////////////////
+    // iterator
+    ////////////////
+
+    template <bool get_object, typename T, typename... Ts>
+    struct iterable {
+        struct iterator {
+            using value = std::conditional_t<get_object, T,
+                                             no_void_validator_tup_t<T, Ts...>>;
+
+            iterator() : parser_{nullptr}, value_{} {
+            }
+
+            iterator(multi_parser<Options...>* parser)
+                : parser_{parser}, value_{} {
+            }
+
+            [[nodiscard]] value& operator*() {
+                return value_;
+            }
+
+            [[nodiscard]] value* operator->() {
+                return &value_;
+            }
+
+            iterator& operator++() {
+                if (!parser_ || parser_->eof()) {
+                    parser_ = nullptr;
+                } else {
+                    if constexpr (get_object) {
+                        value_ = parser_->template get_object<T, Ts...>();
+                    } else {
+                        value_ = parser_->template get_next<T, Ts...>();
+                    }
+                }
+                return *this;
+            }
+
+            [[nodiscard]] friend bool operator==(const iterator& lhs,
+                                                 const iterator& rhs) {
+                return (lhs.parser_ == nullptr && rhs.parser_ == nullptr) ||
+                       (lhs.parser_ == rhs.parser_ &&
+                        &lhs.value_ == &rhs.value_);
+            }
+
+            [[nodiscard]] friend bool operator!=(const iterator& lhs,
+                                                 const iterator& rhs) {
+                return !(lhs == rhs);
+            }
+
+        private:
+            multi_parser<Options...>* parser_;
+            value value_;
+        };
+
+        iterable(multi_parser<Options...>* parser) : parser_{parser} {
+        }
+
+        [[nodiscard]] iterator begin() {
+            return ++iterator{parser_};
+        }
+
+        [[nodiscard]] iterator end() {
+            return iterator{};
+        }
+
+    private:
+        multi_parser<Options...>* parser_;
+    };
+
+    template <typename... Ts>
+    [[nodiscard]] auto iterate() {
+        return iterable<false, Ts...>{this};
+    }
+
+    template <typename... Ts>
+    [[nodiscard]] auto iterate_object() {
+        return iterable<true, Ts...>{this};
+    }
+
+#ifdef SSP_COROUTINES_ENABLED
+    ////////////////
+    // rows
+    ////////////////
+
+    // same as 'iterate', but the records are produced by a coroutine which
+    // reads the next record only once it is requested
+    template <typename... Ts>
+    [[nodiscard]] generator<no_void_validator_tup_t<Ts...>> rows() {
+        while (!eof()) {
+            co_yield get_next<Ts...>();
+        }
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] generator<T> rows_object() {
+        while (!eof()) {
+            co_yield get_object<T, Ts...>();
+        }
+    }
+#endif
+
+    ////////////////
+    // concurrent reading
+    ////////////////
+
+    // reads the remaining files on the given number of threads, each file
+    // is read by a single thread, 'fun' is invoked with the converted values
+    // of every record, either as a whole or unpacked, and may be invoked
+    // concurrently for records of different files, records which could not
+    // be converted are skipped, the error of the first one is kept, in
+    // 'throw_on_error' mode the first exception is rethrown after all the
+    // threads have stopped, the files read by the other threads use their
+    // own string pool and arena, so the values converted to 'ss::category'
+    // and the views stored in the arena are only valid within 'fun'
+    template <typename T, typename... Ts, typename Fun>
+    void for_each_concurrent(Fun&& fun, size_t threads) {
+        clear_error();
+        if (eof_) {
+            return;
+        }
+
+        std::atomic<size_t> next_file{file_};
+        if (next_parser_.valid()) {
+            // the prefetched file is opened again by one of the threads
+            next_parser_.wait();
+            next_parser_ = {};
+        }
+
+        std::mutex mutex;
+        std::exception_ptr exception;
+
+        if (!parser_) {
+            exception = std::exchange(file_exception_, nullptr);
+            error_ = std::exchange(file_error_, error_type{});
+            if (exception) {
+                next_file = file_names_.size();
+            }
+        }
+
+        auto read_file = [&](parser_type& p) {
+            while (!p.eof()) {
+                auto value = p.template get_next<T, Ts...>();
+                if (!p.valid()) {
+                    std::lock_guard lock{mutex};
+                    if (valid()) {
+                        copy_error(p);
+                    }
+                    continue;
+                }
+                invoke(fun, value);
+            }
+        };
+
+        auto read_files = [&] {
+            try {
+                for (auto i = next_file++; i < file_names_.size();
+                     i = next_file++) {
+                    parser_type p{file_names_[i], delim_};
+
+                    std::unique_lock lock{mutex};
+                    if (!prepare(p, file_names_[i])) {
+                        if (valid()) {
+                            error_ = file_error_;
+                        }
+                        continue;
+                    }
+                    lock.unlock();
+
+                    read_file(p);
+                }
+            } catch (...) {
+                std::lock_guard lock{mutex};
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+                next_file = file_names_.size();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < threads; ++i) {
+            workers.emplace_back(read_files);
+        }
+
+        try {
+            if (parser_) {
+                read_file(*parser_);
+            }
+        } catch (...) {
+            std::lock_guard lock{mutex};
+            if (!exception) {
+                exception = std::current_exception();
+            }
+            next_file = file_names_.size();
+        }
+        read_files();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        parser_.reset();
+        file_ = file_names_.size();
+        eof_ = true;
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    template <typename Fun, typename Value>
+    static void invoke(Fun& fun, Value& value) {
+        if constexpr (std::is_invocable_v<Fun&, Value&>) {
+            fun(value);
+        } else {
+            std::apply(fun, value);
+        }
+    }
+
+    ////////////////
+    // files
+    ////////////////
+
+    void prefetch(size_t index) {
+        if (index >= file_names_.size()) {
+            return;
+        }
+
+        next_parser_ = std::async(std::launch::async,
+                                  [name = file_names_[index], delim = delim_] {
+                                      return std::optional<parser_type>{
+                                          std::in_place, name, delim};
+                                  });
+    }
+
+    void open_first_file() {
+        if (next_parser_.valid()) {
+            next_parser_.wait();
+        }
+
+        clear_error();
+        parser_.reset();
+        file_error_ = error_type{};
+        file_exception_ = nullptr;
+        file_ = 0;
+        eof_ = false;
+
+        prefetch(0);
+        open_next_file();
+    }
+
+    // opens the next file which has records, if a file could not be
+    // opened or its header is not valid the error is reported by the
+    // next call to 'get_next'
+    void open_next_file() {
+        parser_.reset();
+
+        while (file_ < file_names_.size()) {
+            const auto& name = file_names_[file_];
+            std::optional<parser_type> next;
+
+            try {
+                next = next_parser_.get();
+            } catch (...) {
+                file_exception_ = std::current_exception();
+            }
+
+            ++file_;
+            prefetch(file_);
+
+            if (file_exception_) {
+                return;
+            }
+
+            share_resources(*next);
+
+            try {
+                if (!prepare(*next, name)) {
+                    return;
+                }
+            } catch (...) {
+                file_exception_ = std::current_exception();
+                return;
+            }
+
+            if (!next->eof()) {
+                parser_ = std::move(next);
+                return;
+            }
+        }
+
+        eof_ = true;
+    }
+
+    // the parsers read one after another use the same pool and arena
+    void share_resources(parser_type& p) {
+        p.set_string_pool(*string_pool_);
+        if constexpr (arena_views) {
+            p.set_arena(*arena_);
+        }
+    }
+
+    // the header is checked against the header of the first file and
+    // skipped, or used to map the fields given to 'use_fields'
+    [[nodiscard]] bool prepare(parser_type& p, const std::string& name) {
+        if (!p.valid()) {
+            copy_file_error(p);
+            return false;
+        }
+
+        if constexpr (!ignore_header) {
+            if (p.eof()) {
+                // empty file, there is no header
+                return true;
+            }
+
+            if (!raw_header_) {
+                raw_header_ = p.raw_header();
+            }
+
+            if (use_fields_) {
+                use_fields_(p);
+                if (!p.valid()) {
+                    copy_file_error(p);
+                    return false;
+                }
+                return true;
+            }
+
+            if (p.raw_header() != *raw_header_) {
+                handle_error_header_mismatch(name);
+                return false;
+            }
+
+            p.ignore_next();
+        }
+
+        return true;
+    }
+
+    ////////////////
+    // error
+    ////////////////
+
+    void assert_ignore_header_not_defined() const {
+        static_assert(!ignore_header,
+                      "cannot use this method when 'ignore_header' is defined");
+    }
+
+    void assert_arena_views_defined() const {
+        static_assert(arena_views,
+                      "'arena_views' needs to be enabled to use the arena");
+    }
+
+    void clear_error() {
+        if constexpr (string_error) {
+            error_.clear();
+        } else {
+            error_ = false;
+        }
+    }
+
+    void copy_error(const parser_type& p) {
+        if constexpr (string_error) {
+            if (!p.valid()) {
+                error_ = p.error_msg();
+            }
+        } else if constexpr (!throw_on_error) {
+            error_ = !p.valid();
+        }
+    }
+
+    void copy_file_error(const parser_type& p) {
+        if constexpr (string_error) {
+            file_error_ = p.error_msg();
+        } else {
+            file_error_ = true;
+        }
+    }
+
+    // reports the error of a file which could not be opened
+    void handle_error_file_not_valid(std::exception_ptr exception,
+                                     error_type error) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        error_ = std::move(error);
+    }
+
+    void handle_error_eof_reached() {
+        constexpr static auto error_msg = "read on end of all files";
+
+        if constexpr (string_error) {
+            error_ = error_msg;
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg};
+        } else {
+            error_ = true;
+        }
+    }
+
+    void handle_error_header_mismatch(const std::string& name) {
+        constexpr static auto error_msg =
+            ": header does not match the header of the first file";
+
+        if constexpr (string_error) {
+            file_error_.clear();
+            file_error_.append(name).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{name + error_msg};
+        } else {
+            file_error_ = true;
+        }
+    }
+
+    ////////////////
+    // members
+    ////////////////
+
+    std::vector<std::string> file_names_;
+    std::string delim_;
+    std::optional<parser_type> parser_;
+    std::future<std::optional<parser_type>> next_parser_;
+    std::function<void(parser_type&)> use_fields_;
+    std::optional<std::string> raw_header_;
+    std::shared_ptr<ss::string_pool> string_pool_{
+        std::make_shared<ss::string_pool>()};
+    std::shared_ptr<ss::arena> arena_{std::make_shared<ss::arena>()};
+    error_type error_{};
+    error_type file_error_{};
+    std::exception_ptr file_exception_;
+    size_t file_{0};
+    size_t record_file_{0};
+    size_t record_line_{0};
+    bool eof_{false};
+};
+
+} /* namespace ss */
+
+
+namespace ss {
+
+////////////////
+// number formatters
+////////////////
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_integral_v<T>, bool> from_num(
+    std::string& out, T value) {
+    constexpr static auto buff_max = std::numeric_limits<T>::digits10 + 3;
+    std::array<char, buff_max> buff;
+
+    auto [ptr, ec] = std::to_chars(buff.data(), buff.data() + buff_max, value);
+    if (ec != std::errc()) {
+        return false;
+    }
+
+    out.append(buff.data(), ptr);
+    return true;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_floating_point_v<T>, bool> from_num(
+    std::string& out, T value) {
+    constexpr static auto buff_max = 128;
+    std::array<char, buff_max> buff;
+
+#ifdef __cpp_lib_to_chars
+    auto [ptr, ec] = std::to_chars(buff.data(), buff.data() + buff_max, value);
+    if (ec != std::errc()) {
+        return false;
+    }
+
+    out.append(buff.data(), ptr);
+#else
+    // floating point std::to_chars is not supported by older standard
+    // libraries, max_digits10 guarantees the value survives a round trip
+    constexpr static auto digits = std::numeric_limits<T>::max_digits10;
+
+    int size = 0;
+    if constexpr (std::is_same_v<T, long double>) {
+        size = std::snprintf(buff.data(), buff_max, "%.*Lg", digits, value);
+    } else {
+        size = std::snprintf(buff.data(), buff_max, "%.*g", digits,
+                             static_cast<double>(value));
+    }
+
+    if (size < 0 || size >= buff_max) {
+        return false;
+    }
+
+    out.append(buff.data(), size);
+#endif
+
+    return true;
+}
+
+template <size_t N>
+void append_digits(std::string& out, uint64_t value) {
+    char buff[N];
+    for (size_t i = N; i > 0; --i) {
+        buff[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    out.append(buff, N);
+}
+
+////////////////
+// insert
+////////////////
+
+namespace error {
+template <typename T>
+struct unsupported_insert_type {
+    constexpr static bool value = false;
+};
+} /* namespace error */
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<!std::is_integral_v<T> &&
+                                   !std::is_floating_point_v<T> &&
+                                   !is_instance_of_v<std::optional, T> &&
+                                   !is_instance_of_v<std::variant, T> &&
+                                   !is_instance_of_v<numeric_wrapper, T> &&
+                                   !is_instance_of_v<epoch, T> &&
+                                   !is_decimal_v<T> && !has_enum_map_v<T>,
+                               bool>
+insert(std::string&, const T&) {
+    static_assert(error::unsupported_insert_type<T>::value,
+                  "Conversion for given type is not defined, an "
+                  "\'insert\' function needs to be defined!");
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<std::is_integral_v<T> ||
+                                   std::is_floating_point_v<T>,
+                               bool>
+insert(std::string& out, const T& value) {
+    return from_num(out, value);
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<numeric_wrapper, T>, bool>
+insert(std::string& out, const T& value) {
+    return from_num(out, value.value);
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<epoch, T>, bool> insert(
+    std::string& out, const T& value) {
+    return from_num(out, value.since_epoch.count());
+}
+
+// all 'Scale' fraction digits are written, eg. 'decimal<2>' as '-12.50'
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_decimal_v<T>, bool> insert(std::string& out,
+                                                            const T& value) {
+    using U = std::make_unsigned_t<typename T::rep>;
+
+    U magnitude = static_cast<U>(value.value);
+    if constexpr (std::is_signed_v<typename T::rep>) {
+        if (value.value < 0) {
+            out.push_back('-');
+            magnitude = static_cast<U>(U{0} - magnitude);
+        }
+    }
+
+    const auto denominator = static_cast<U>(T::denominator);
+    if (!from_num(out, static_cast<U>(magnitude / denominator))) {
+        return false;
+    }
+
+    if constexpr (T::scale > 0) {
+        out.push_back('.');
+        const size_t fraction_begin = out.size();
+        out.append(T::scale, '0');
+
+        U fraction = magnitude % denominator;
+        for (size_t i = out.size(); i > fraction_begin; --i) {
+            out[i - 1] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<has_enum_map_v<T>, bool> insert(
+    std::string& out, const T& value) {
+    for (const auto& [name, enum_value] : enum_map<T>::values) {
+        if (enum_value == value) {
+            out.append(name);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<std::optional, T>, bool>
+insert(std::string& out, const T& value) {
+    if (!value.has_value()) {
+        return true;
+    }
+    return insert(out, value.value());
+}
+
+template <typename T>
+[[nodiscard]] std::enable_if_t<is_instance_of_v<std::variant, T>, bool> insert(
+    std::string& out, const T& value) {
+    return std::visit(
+        [&out](const auto& alternative) { return insert(out, alternative); },
+        value);
+}
+
+////////////////
+// insert specialization
+////////////////
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const bool& value) {
+    out.append(value ? "true" : "false");
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const char& value) {
+    out.push_back(value);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const std::string& value) {
+    out.append(value);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out,
+                                 const std::string_view& value) {
+    out.append(value);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const char* const& value) {
+    out.append(value);
+    return true;
+}
+
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const category& value) {
+    out.append(value.value);
+    return true;
+}
+
+// YYYY-MM-DD
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const date& value) {
+    if (value.year < 0 || value.year > 9999) {
+        return false;
+    }
+
+    append_digits<4>(out, value.year);
+    out.push_back('-');
+    append_digits<2>(out, value.month);
+    out.push_back('-');
+    append_digits<2>(out, value.day);
+    return true;
+}
 
-        return true;
+// YYYY-MM-DDTHH:MM:SS[.fffffffff]Z, trailing zeros of the fraction are
+// omitted
+template <>
+[[nodiscard]] inline bool insert(std::string& out, const timestamp& value) {
+    constexpr static int64_t seconds_per_day = 86400;
+    constexpr static int64_t nanoseconds_per_second = 1000000000;
+
+    const auto count = value.since_epoch.count();
+    int64_t seconds = count / nanoseconds_per_second;
+    int64_t nanoseconds = count % nanoseconds_per_second;
+    if (nanoseconds < 0) {
+        nanoseconds += nanoseconds_per_second;
+        --seconds;
     }
 
-    void split_header_data() {
-        header_splitter splitter;
-        std::string raw_header_copy = raw_header_;
+    int64_t days = seconds / seconds_per_day;
+    int64_t seconds_of_day = seconds % seconds_per_day;
+    if (seconds_of_day < 0) {
+        seconds_of_day += seconds_per_day;
+        --days;
+    }
 
-        if (!strict_split(splitter, raw_header_copy)) {
-            return;
-        }
+    if (!insert(out, date::from_days_since_epoch(days))) {
+        return false;
+    }
 
-        for (const auto& [begin, end] : splitter.get_split_data()) {
-            std::string field{begin, end};
-            if (std::find(header_.begin(), header_.end(), field) !=
-                header_.end()) {
-                handle_error_duplicate_header_field(field);
-                header_.clear();
-                return;
-            }
-            header_.push_back(std::move(field));
+    out.push_back('T');
+    append_digits<2>(out, seconds_of_day / 3600);
+    out.push_back(':');
+    append_digits<2>(out, seconds_of_day / 60 % 60);
+    out.push_back(':');
+    append_digits<2>(out, seconds_of_day % 60);
+
+    if (nanoseconds != 0) {
+        out.push_back('.');
+        append_digits<9>(out, nanoseconds);
+        while (out.back() == '0') {
+            out.pop_back();
         }
     }
 
-    [[nodiscard]] std::optional<size_t> header_index(const std::string& field) {
-        auto it = std::find(header_.begin(), header_.end(), field);
+    out.push_back('Z');
+    return true;
+}
 
-        if (it == header_.end()) {
-            return std::nullopt;
-        }
+} /* namespace ss */
 
-        return std::distance(header_.begin(), it);
-    }
 
-    ////////////////
-    // error
-    ////////////////
+namespace ss {
 
-    void clear_error() {
-        if constexpr (string_error) {
-            error_.clear();
-        } else {
-            error_ = false;
+template <typename... Options>
+class writer {
+    using quote = typename setup<Options...>::quote;
+    using escape = typename setup<Options...>::escape;
+    using trim_left = typename setup<Options...>::trim_left;
+    using trim_right = typename setup<Options...>::trim_right;
+
+    constexpr static auto string_error = setup<Options...>::string_error;
+    constexpr static auto throw_on_error = setup<Options...>::throw_on_error;
+    constexpr static auto crlf = setup<Options...>::crlf;
+
+    using error_type = std::conditional_t<string_error, std::string, bool>;
+
+public:
+    writer(std::string file_name, std::string delim = ss::default_delimiter)
+        : file_name_{std::move(file_name)}, delim_{std::move(delim)},
+          file_{std::fopen(file_name_.c_str(), "wb")} {
+        if (!file_) {
+            handle_error_file_not_open();
+            return;
         }
-    }
 
-    void handle_error_failed_check() {
-        constexpr static auto error_msg = ": failed check";
+        buffer_.reserve(writer_buffer_size);
+        check_delimiter();
+    }
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(file_name_).append(error_msg);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{file_name_ + error_msg};
-        } else {
-            error_ = true;
+    // rows are appended to the given string instead of a file
+    writer(std::string* csv_data_buffer,
+           std::string delim = ss::default_delimiter)
+        : file_name_{"CSV data buffer"}, delim_{std::move(delim)},
+          csv_data_buffer_{csv_data_buffer} {
+        if (!csv_data_buffer_) {
+            handle_error_null_buffer();
+            return;
         }
+
+        check_delimiter();
     }
 
-    void handle_error_null_buffer() {
-        constexpr static auto error_msg = ": received null data buffer";
+    writer(writer&& other) noexcept
+        : file_name_{std::move(other.file_name_)},
+          error_{std::move(other.error_)}, delim_{std::move(other.delim_)},
+          file_{other.file_}, csv_data_buffer_{other.csv_data_buffer_},
+          buffer_{std::move(other.buffer_)},
+          field_buffer_{std::move(other.field_buffer_)} {
+        other.file_ = nullptr;
+        other.csv_data_buffer_ = nullptr;
+    }
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(file_name_).append(error_msg);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{file_name_ + error_msg};
-        } else {
-            error_ = true;
+    writer& operator=(writer&& other) noexcept {
+        if (this != &other) {
+            close();
+            file_name_ = std::move(other.file_name_);
+            error_ = std::move(other.error_);
+            delim_ = std::move(other.delim_);
+            file_ = other.file_;
+            csv_data_buffer_ = other.csv_data_buffer_;
+            buffer_ = std::move(other.buffer_);
+            field_buffer_ = std::move(other.field_buffer_);
+
+            other.file_ = nullptr;
+            other.csv_data_buffer_ = nullptr;
         }
+
+        return *this;
     }
 
-    void handle_error_file_not_open() {
-        constexpr static auto error_msg = ": could not be opened";
+    ~writer() {
+        close();
+    }
+
+    writer() = delete;
+    writer(const writer& other) = delete;
+    writer& operator=(const writer& other) = delete;
 
+    [[nodiscard]] bool valid() const {
         if constexpr (string_error) {
-            error_.clear();
-            error_.append(file_name_).append(error_msg);
+            return error_.empty();
         } else if constexpr (throw_on_error) {
-            throw ss::exception{file_name_ + error_msg};
+            return true;
         } else {
-            error_ = true;
+            return !error_;
         }
     }
 
-    void handle_error_eof_reached() {
-        constexpr static auto error_msg = ": read on end of file";
+    [[nodiscard]] const std::string& error_msg() const {
+        assert_string_error_defined<string_error>();
+        return error_;
+    }
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(file_name_).append(error_msg);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{file_name_ + error_msg};
+    // writes one row, the values can be given as separate arguments, as
+    // a tuple, or as one object which has a 'tied' method, the row is not
+    // written if any of the values could not be inserted
+    template <typename T, typename... Ts>
+    void write(T&& value, Ts&&... values) {
+        using U = std::decay_t<T>;
+
+        if constexpr (sizeof...(Ts) == 0 && is_instance_of_v<std::tuple, U>) {
+            std::apply([this](auto&&... elems) { write_row(elems...); },
+                       std::forward<T>(value));
+        } else if constexpr (tied_class_v<U, Ts...>) {
+            std::apply([this](auto&&... elems) { write_row(elems...); },
+                       value.tied());
         } else {
-            error_ = true;
+            write_row(value, values...);
         }
     }
 
-    void handle_error_invalid_conversion() {
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(file_name_)
-                .append(" ")
-                .append(std::to_string(reader_.line_number_))
-                .append(": ")
-                .append(reader_.converter_.error_msg());
-        } else if constexpr (!throw_on_error) {
-            error_ = true;
+    // writes the buffered rows into the file
+    void flush() {
+        if (!file_ || buffer_.empty()) {
+            return;
         }
-    }
 
-    void handle_error_invalid_field(const std::string& field) {
-        constexpr static auto error_msg =
-            ": header does not contain given field: ";
+        const auto written =
+            std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        const auto size = buffer_.size();
+        buffer_.clear();
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(file_name_).append(error_msg).append(field);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{file_name_ + error_msg + field};
-        } else {
-            error_ = true;
+        if (written != size) {
+            handle_error_write_failed();
         }
     }
 
-    void handle_error_field_used_multiple_times(const std::string& field) {
-        constexpr static auto error_msg = ": given field used multiple times: ";
+private:
+    ////////////////
+    // output
+    ////////////////
 
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(file_name_).append(error_msg).append(field);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{file_name_ + error_msg + field};
-        } else {
-            error_ = true;
+    [[nodiscard]] std::string& output() {
+        return file_ ? buffer_ : *csv_data_buffer_;
+    }
+
+    void close() {
+        if (file_) {
+            try {
+                flush();
+            } catch (...) {
+            }
+            std::ignore = std::fclose(file_);
+            file_ = nullptr;
         }
     }
 
-    void handle_error_invalid_use_fields_argument() {
-        constexpr static auto error_msg =
-            "received invalid argument for 'use_fields'";
+    ////////////////
+    // error
+    ////////////////
 
+    void clear_error() {
         if constexpr (string_error) {
             error_.clear();
-            error_.append(error_msg);
-        } else if constexpr (throw_on_error) {
-            throw ss::exception{error_msg};
         } else {
-            error_ = true;
+            error_ = false;
         }
     }
 
-    void handle_error_invalid_header_field() {
-        constexpr static auto error_msg = ": header contains empty field";
+    void handle_error_file_not_open() {
+        constexpr static auto error_msg = ": could not be opened";
 
         if constexpr (string_error) {
             error_.clear();
@@ -2983,345 +8679,267 @@ private:
         }
     }
 
-    void handle_error_duplicate_header_field(const std::string& field) {
-        constexpr static auto error_msg = ": header contains duplicate: ";
+    void handle_error_null_buffer() {
+        constexpr static auto error_msg = ": received null data buffer";
 
         if constexpr (string_error) {
             error_.clear();
-            error_.append(file_name_).append(error_msg).append(field);
+            error_.append(file_name_).append(error_msg);
         } else if constexpr (throw_on_error) {
-            throw ss::exception{file_name_ + error_msg + field};
-        } else {
-            error_ = true;
-        }
-    }
-
-    void handle_error_invalid_header_split(const header_splitter& splitter) {
-        constexpr static auto error_msg = ": failed header parsing: ";
-
-        if constexpr (string_error) {
-            error_.clear();
-            error_.append(file_name_)
-                .append(error_msg)
-                .append(splitter.error_msg());
+            throw ss::exception{file_name_ + error_msg};
         } else {
             error_ = true;
-        }
-    }
-
-    void decorate_rethrow_invalid_header_split(const ss::exception& e) const {
-        static_assert(throw_on_error,
-                      "throw_on_error needs to be enabled to use this method");
-        throw ss::exception{std::string{file_name_}
-                                .append(": failed header parsing: ")
-                                .append(e.what())};
-    }
-
-    void decorate_rethrow(const ss::exception& e) const {
-        static_assert(throw_on_error,
-                      "throw_on_error needs to be enabled to use this method");
-        throw ss::exception{std::string{file_name_}
-                                .append(" ")
-                                .append(std::to_string(line()))
-                                .append(": ")
-                                .append(e.what())};
-    }
-
-    ////////////////
-    // line reading
-    ////////////////
-
-    void read_line() {
-        eof_ = !reader_.read_next();
-    }
-
-    struct reader {
-        reader(const std::string& file_name_, std::string delim)
-            : delim_{std::move(delim)},
-              file_{std::fopen(file_name_.c_str(), "rb")} {
-        }
-
-        reader(const char* const buffer, size_t csv_data_size,
-               std::string delim)
-            : delim_{std::move(delim)}, csv_data_buffer_{buffer},
-              csv_data_size_{csv_data_size} {
-        }
-
-        reader(reader&& other) noexcept
-            : buffer_{other.buffer_},
-              next_line_buffer_{other.next_line_buffer_},
-              helper_buffer_{other.helper_buffer_},
-              converter_{std::move(other.converter_)},
-              next_line_converter_{std::move(other.next_line_converter_)},
-              buffer_size_{other.buffer_size_},
-              next_line_buffer_size_{other.next_line_buffer_size_},
-              helper_buffer_size{other.helper_buffer_size},
-              delim_{std::move(other.delim_)}, file_{other.file_},
-              csv_data_buffer_{other.csv_data_buffer_},
-              csv_data_size_{other.csv_data_size_},
-              curr_char_{other.curr_char_}, crlf_{other.crlf_},
-              line_number_{other.line_number_}, chars_read_{other.chars_read_},
-              next_line_size_{other.next_line_size_} {
-            other.buffer_ = nullptr;
-            other.next_line_buffer_ = nullptr;
-            other.helper_buffer_ = nullptr;
-            other.file_ = nullptr;
-        }
-
-        reader& operator=(reader&& other) noexcept {
-            if (this != &other) {
-                buffer_ = other.buffer_;
-                next_line_buffer_ = other.next_line_buffer_;
-                helper_buffer_ = other.helper_buffer_;
-                converter_ = std::move(other.converter_);
-                next_line_converter_ = std::move(other.next_line_converter_);
-                buffer_size_ = other.buffer_size_;
-                next_line_buffer_size_ = other.next_line_buffer_size_;
-                helper_buffer_size = other.helper_buffer_size;
-                delim_ = std::move(other.delim_);
-                file_ = other.file_;
-                csv_data_buffer_ = other.csv_data_buffer_;
-                csv_data_size_ = other.csv_data_size_;
-                curr_char_ = other.curr_char_;
-                crlf_ = other.crlf_;
-                line_number_ = other.line_number_;
-                chars_read_ = other.chars_read_;
-                next_line_size_ = other.next_line_size_;
-
-                other.buffer_ = nullptr;
-                other.next_line_buffer_ = nullptr;
-                other.helper_buffer_ = nullptr;
-                other.file_ = nullptr;
-                other.csv_data_buffer_ = nullptr;
-            }
+        }
+    }
 
-            return *this;
+    void handle_error_write_failed() {
+        constexpr static auto error_msg = ": failed writing to file";
+
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(file_name_).append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{file_name_ + error_msg};
+        } else {
+            error_ = true;
         }
+    }
 
-        ~reader() {
-            std::free(buffer_);
-            std::free(next_line_buffer_);
-            std::free(helper_buffer_);
+    void handle_error_empty_delimiter() {
+        constexpr static auto error_msg = "empty delimiter";
 
-            if (file_) {
-                std::ignore = std::fclose(file_);
-            }
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg);
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg};
+        } else {
+            error_ = true;
         }
+    }
 
-        reader() = delete;
-        reader(const reader& other) = delete;
-        reader& operator=(const reader& other) = delete;
+    void handle_error_invalid_insertion(size_t pos) {
+        constexpr static auto error_msg =
+            "invalid insertion for parameter at column ";
 
-        // read next line each time in order to set eof_
-        [[nodiscard]] bool read_next() {
-            next_line_converter_.clear_error();
-            size_t size = 0;
-            while (size == 0) {
-                ++line_number_;
-                if (next_line_buffer_size_ > 0) {
-                    next_line_buffer_[0] = '\0';
-                }
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg).append(std::to_string(pos + 1));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg + std::to_string(pos + 1)};
+        } else {
+            error_ = true;
+        }
+    }
 
-                chars_read_ = curr_char_;
-                auto [ssize, eof] =
-                    get_line(next_line_buffer_, next_line_buffer_size_, file_,
-                             csv_data_buffer_, csv_data_size_, curr_char_);
+    void handle_error_unescapable_field(size_t pos) {
+        constexpr static auto error_msg =
+            "field needs to be quoted or escaped, but neither quote nor "
+            "escape is enabled, at column ";
 
-                if (eof) {
-                    return false;
-                }
+        if constexpr (string_error) {
+            error_.clear();
+            error_.append(error_msg).append(std::to_string(pos + 1));
+        } else if constexpr (throw_on_error) {
+            throw ss::exception{error_msg + std::to_string(pos + 1)};
+        } else {
+            error_ = true;
+        }
+    }
 
-                size = remove_eol(next_line_buffer_, ssize);
+    void check_delimiter() {
+        if (delim_.empty()) {
+            handle_error_empty_delimiter();
+        }
+    }
 
-                if constexpr (!ignore_empty) {
-                    break;
-                }
-            }
+    ////////////////
+    // writing
+    ////////////////
 
-            next_line_size_ = size;
-            return true;
+    template <typename... Ts>
+    void write_row(const Ts&... values) {
+        static_assert(sizeof...(Ts) > 0, "at least one value must be given");
+
+        if (!file_ && !csv_data_buffer_) {
+            handle_error_file_not_open();
+            return;
         }
 
-        void parse() {
-            size_t limit = 0;
+        clear_error();
+        if (delim_.empty()) {
+            handle_error_empty_delimiter();
+            return;
+        }
 
-            if constexpr (escaped_multiline_enabled) {
-                while (escaped_eol(next_line_size_)) {
-                    if (multiline_limit_reached(limit)) {
-                        return;
-                    }
+        auto& out = output();
+        const size_t row_begin = out.size();
 
-                    if (!append_next_line_to_buffer(next_line_buffer_,
-                                                    next_line_size_,
-                                                    next_line_buffer_size_)) {
-                        next_line_converter_.handle_error_unterminated_escape();
-                        return;
-                    }
-                }
+        // rows are written whole or not at all
+        if constexpr (throw_on_error) {
+            try {
+                size_t pos = 0;
+                std::ignore = (write_field(out, values, pos++) && ...);
+            } catch (const ss::exception&) {
+                out.resize(row_begin);
+                throw;
+            }
+        } else {
+            size_t pos = 0;
+            if (!(write_field(out, values, pos++) && ...)) {
+                out.resize(row_begin);
+                return;
             }
+        }
 
-            next_line_converter_.split(next_line_buffer_, delim_);
+        if constexpr (crlf) {
+            out.append("\r\n");
+        } else {
+            out.push_back('\n');
+        }
 
-            if constexpr (quoted_multiline_enabled) {
-                while (unterminated_quote()) {
-                    next_line_size_ -= next_line_converter_.size_shifted();
+        if (file_ && buffer_.size() >= writer_buffer_size) {
+            flush();
+        }
+    }
 
-                    if (multiline_limit_reached(limit)) {
-                        return;
-                    }
+    template <typename T>
+    [[nodiscard]] bool write_field(std::string& out, const T& value,
+                                   size_t pos) {
+        if (pos != 0) {
+            out.append(delim_);
+        }
 
-                    if (!append_next_line_to_buffer(next_line_buffer_,
-                                                    next_line_size_,
-                                                    next_line_buffer_size_)) {
-                        next_line_converter_.handle_error_unterminated_quote();
-                        return;
-                    }
+        const size_t field_begin = out.size();
 
-                    if constexpr (escaped_multiline_enabled) {
-                        while (escaped_eol(next_line_size_)) {
-                            if (multiline_limit_reached(limit)) {
-                                return;
-                            }
+        bool inserted = false;
+        if constexpr (std::is_array_v<T>) {
+            inserted = insert(out, std::string_view{value});
+        } else {
+            inserted = insert(out, value);
+        }
 
-                            if (!append_next_line_to_buffer(
-                                    next_line_buffer_, next_line_size_,
-                                    next_line_buffer_size_)) {
-                                next_line_converter_
-                                    .handle_error_unterminated_escape();
-                                return;
-                            }
-                        }
-                    }
+        if (!inserted) {
+            handle_error_invalid_insertion(pos);
+            return false;
+        }
 
-                    next_line_converter_.resplit(next_line_buffer_,
-                                                 next_line_size_, delim_);
-                }
+        if (needs_escaping(out.data() + field_begin, out.data() + out.size())) {
+            if (!escape_field(out, field_begin)) {
+                handle_error_unescapable_field(pos);
+                return false;
             }
         }
 
-        void update() {
-            std::swap(buffer_, next_line_buffer_);
-            std::swap(buffer_size_, next_line_buffer_size_);
-            std::swap(converter_, next_line_converter_);
-        }
+        return true;
+    }
 
-        [[nodiscard]] bool multiline_limit_reached(size_t& limit) {
-            if constexpr (multiline::size > 0) {
-                if (limit++ >= multiline::size) {
-                    next_line_converter_.handle_error_multiline_limit_reached();
-                    return true;
-                }
+    ////////////////
+    // quoting and escaping
+    ////////////////
+
+    [[nodiscard]] bool is_special(char c) const {
+        // bitwise or instead of logical or, keeps the loop branchless
+        bool special = (c == delim_.front()) | (c == '\n') | (c == '\r');
+        if constexpr (quote::enabled) {
+            for (const char q : quote::matches) {
+                special |= (c == q);
             }
-            return false;
         }
-
-        [[nodiscard]] bool escaped_eol(size_t size) {
-            const char* curr = nullptr;
-            for (curr = next_line_buffer_ + size - 1;
-                 curr >= next_line_buffer_ &&
-                 setup<Options...>::escape::match(*curr);
-                 --curr) {
+        if constexpr (escape::enabled) {
+            for (const char e : escape::matches) {
+                special |= (c == e);
             }
-            return (next_line_buffer_ - curr + size) % 2 == 0;
         }
+        return special;
+    }
 
-        [[nodiscard]] bool unterminated_quote() {
-            return next_line_converter_.unterminated_quote();
+    // a field needs to be quoted or escaped if it contains the delimiter,
+    // a new line, a quote or an escape character, or if it has leading or
+    // trailing characters which would be trimmed
+    [[nodiscard]] bool needs_escaping(const char* begin,
+                                      const char* end) const {
+        if (begin == end) {
+            return false;
         }
 
-        void undo_remove_eol(char* buffer, size_t& line_size,
-                             size_t buffer_size) {
-            if (crlf_ && buffer_size >= line_size + 2) {
-                std::copy_n("\r\n", 2, buffer + line_size);
-                line_size += 2;
-            } else if (buffer_size > line_size) {
-                std::copy_n("\n", 1, buffer + line_size);
-                line_size += 1;
+        if constexpr (trim_left::enabled) {
+            if (trim_left::match(*begin)) {
+                return true;
             }
         }
 
-        [[nodiscard]] size_t remove_eol(char*& buffer, size_t ssize) {
-            if (buffer[ssize - 1] != '\n') {
-                crlf_ = false;
-                return ssize;
-            }
-
-            size_t size = ssize - 1;
-            if (ssize >= 2 && buffer[ssize - 2] == '\r') {
-                crlf_ = true;
-                size--;
-            } else {
-                crlf_ = false;
+        if constexpr (trim_right::enabled) {
+            if (trim_right::match(*(end - 1))) {
+                return true;
             }
-
-            buffer[size] = '\0';
-            return size;
         }
 
-        void realloc_concat(char*& first, size_t& first_size,
-                            size_t& buffer_size, const char* const second,
-                            size_t second_size) {
-            buffer_size = first_size + second_size + 3;
-            auto* new_first = static_cast<char*>(
-                strict_realloc(static_cast<void*>(first), buffer_size));
-
-            first = new_first;
-            std::copy_n(second, second_size + 1, first + first_size);
-            first_size += second_size;
+        // the scan has no early exit so it can be vectorized
+        bool special = false;
+        for (const char* curr = begin; curr != end; ++curr) {
+            special |= is_special(*curr);
         }
+        return special;
+    }
 
-        [[nodiscard]] bool append_next_line_to_buffer(char*& buffer,
-                                                      size_t& line_size,
-                                                      size_t buffer_size) {
-            undo_remove_eol(buffer, line_size, buffer_size);
-
-            chars_read_ = curr_char_;
-            auto [next_ssize, eof] =
-                get_line(helper_buffer_, helper_buffer_size, file_,
-                         csv_data_buffer_, csv_data_size_, curr_char_);
+    [[nodiscard]] bool escape_field(std::string& out, size_t field_begin) {
+        field_buffer_.assign(out, field_begin);
+        out.resize(field_begin);
 
-            if (eof) {
-                return false;
+        if constexpr (quote::enabled) {
+            // "a"b\c -> """a""b\\c"
+            out.push_back(quote::matches[0]);
+            for (const char c : field_buffer_) {
+                if constexpr (escape::enabled) {
+                    if (escape::match(c)) {
+                        out.push_back(c);
+                    }
+                }
+                if (quote::match(c)) {
+                    out.push_back(c);
+                }
+                out.push_back(c);
+            }
+            out.push_back(quote::matches[0]);
+            return true;
+        } else if constexpr (escape::enabled) {
+            const char* const begin = field_buffer_.data();
+            const char* const end = begin + field_buffer_.size();
+            for (const char* curr = begin; curr != end; ++curr) {
+                if (is_special(*curr) || is_trimmed(begin, end, curr)) {
+                    out.push_back(escape::matches[0]);
+                }
+                out.push_back(*curr);
             }
-
-            ++line_number_;
-            size_t next_size = remove_eol(helper_buffer_, next_ssize);
-            realloc_concat(buffer, line_size, next_line_buffer_size_,
-                           helper_buffer_, next_size);
             return true;
+        } else {
+            return false;
         }
+    }
 
-        [[nodiscard]] std::string get_buffer() {
-            return std::string{next_line_buffer_, next_line_size_};
+    [[nodiscard]] bool is_trimmed(const char* begin, const char* end,
+                                  const char* curr) const {
+        if constexpr (trim_left::enabled) {
+            if (trim_left::match(*curr) &&
+                std::all_of(begin, curr, [](char c) {
+                    return trim_left::match(c);
+                })) {
+                return true;
+            }
         }
 
-        ////////////////
-        // members
-        ////////////////
-        char* buffer_{nullptr};
-        char* next_line_buffer_{nullptr};
-        char* helper_buffer_{nullptr};
-
-        converter<Options...> converter_;
-        converter<Options...> next_line_converter_;
-
-        size_t buffer_size_{0};
-        size_t next_line_buffer_size_{0};
-        size_t helper_buffer_size{0};
-
-        std::string delim_;
-        FILE* file_{nullptr};
-
-        const char* csv_data_buffer_{nullptr};
-        size_t csv_data_size_{0};
-        size_t curr_char_{0};
-
-        bool crlf_{false};
-        size_t line_number_{0};
-        size_t chars_read_{0};
+        if constexpr (trim_right::enabled) {
+            if (trim_right::match(*curr) &&
+                std::all_of(curr, end, [](char c) {
+                    return trim_right::match(c);
+                })) {
+                return true;
+            }
+        }
 
-        size_t next_line_size_{0};
-    };
+        return false;
+    }
 
     ////////////////
     // members
@@ -3329,10 +8947,11 @@ private:
 
     std::string file_name_;
     error_type error_{};
-    reader reader_;
-    std::vector<std::string> header_;
-    std::string raw_header_;
-    bool eof_{false};
+    std::string delim_;
+    FILE* file_{nullptr};
+    std::string* csv_data_buffer_{nullptr};
+    std::string buffer_;
+    std::string field_buffer_;
 };
 
 } /* namespace ss */
@@ -0,0 +1,294 @@
+#include "test_helpers.hpp"
+#include <ss/parser.hpp>
+#include <stdexcept>
+
+namespace {
+std::string make_data(size_t records) {
+    std::string data = "a,b,c\n";
+    for (size_t i = 0; i < records; ++i) {
+        data += std::to_string(i) + ",\"x" + std::to_string(i) + "\ny\"," +
+                std::to_string(i * 0.5) + "\n";
+    }
+    return data;
+}
+
+// gives the data in chunks of the given size, and optionally fails after
+// giving the whole data
+ss::byte_source string_source(std::string data, size_t chunk,
+                              bool fail = false) {
+    auto position = std::make_shared<size_t>(0);
+    return {[data = std::move(data), chunk, fail,
+             position](char* buffer, size_t size) -> ssize_t {
+                if (*position == data.size()) {
+                    return fail ? -1 : 0;
+                }
+
+                const auto n =
+                    std::min({size, chunk, data.size() - *position});
+                std::memcpy(buffer, data.data() + *position, n);
+                *position += n;
+                return static_cast<ssize_t>(n);
+            },
+            "string source"};
+}
+
+template <typename... Ts>
+void expect_records(ss::byte_source source, size_t records) {
+    ss::parser<ss::quote<'"'>, ss::multiline, Ts...> p{std::move(source)};
+    CHECK_EQ(p.raw_header(), "a,b,c");
+    p.ignore_next();
+
+    size_t i = 0;
+    while (!p.eof()) {
+        auto [a, b, c] = p.template get_next<size_t, std::string, double>();
+        REQUIRE(p.valid());
+        CHECK_EQ(a, i);
+        CHECK_EQ(b, "x" + std::to_string(i) + "\ny");
+        CHECK_EQ(c, i * 0.5);
+        ++i;
+    }
+    CHECK_EQ(i, records);
+}
+
+template <typename... Ts, typename Parser>
+void read_all(Parser& p) {
+    p.ignore_next();
+    while (!p.eof()) {
+        std::ignore = p.template get_next<Ts...>();
+    }
+}
+
+template <typename... Ts>
+void expect_source_error(ss::byte_source source) {
+    using parser = ss::parser<ss::quote<'"'>, ss::multiline, Ts...>;
+    constexpr auto throw_on_error = ss::setup<Ts...>::throw_on_error;
+
+    // the error may be found while the header is read
+    if constexpr (throw_on_error) {
+        auto read = [&source] {
+            parser p{std::move(source)};
+            read_all<int, std::string, double>(p);
+        };
+        CHECK_THROWS(read());
+    } else {
+        parser p{std::move(source)};
+        read_all<int, std::string, double>(p);
+        CHECK_FALSE(p.valid());
+        if constexpr (ss::setup<Ts...>::string_error) {
+            CHECK_NE(p.error_msg().find("could not be read"),
+                     std::string::npos);
+        }
+    }
+}
+
+template <typename... Ts>
+void expect_not_opened(ss::byte_source source) {
+    using parser = ss::parser<Ts...>;
+    if constexpr (ss::setup<Ts...>::throw_on_error) {
+        CHECK_THROWS(parser{std::move(source)});
+    } else {
+        parser p{std::move(source)};
+        CHECK_FALSE(p.valid());
+        CHECK(p.eof());
+    }
+}
+
+template <typename... Ts>
+void test_byte_source() {
+    const size_t records = 5000;
+    const auto data = make_data(records);
+
+    for (size_t chunk : {size_t{1}, size_t{7}, size_t{4096}, data.size()}) {
+        expect_records<Ts...>(string_source(data, chunk), records);
+        expect_records<Ts...>(ss::read_ahead(string_source(data, chunk), 1000),
+                              records);
+    }
+
+    expect_records<Ts...>(string_source("a,b,c\n", 3), 0);
+    expect_records<Ts...>(string_source("a,b,c", 3), 0);
+    expect_not_opened<Ts...>(ss::byte_source{});
+
+    expect_source_error<Ts...>(string_source(data, 100, true));
+    expect_source_error<Ts...>(
+        ss::read_ahead(string_source(data, 100, true), 1000));
+}
+} /* anonymous namespace */
+
+TEST_CASE("test byte source") {
+    test_byte_source<>();
+    test_byte_source<ss::string_error>();
+    test_byte_source<ss::throw_on_error>();
+}
+
+TEST_CASE("test read ahead exception") {
+    size_t calls = 0;
+    auto source = ss::read_ahead(
+        {[&](char* data, size_t) -> ssize_t {
+             if (calls++ == 0) {
+                 std::memcpy(data, "a,b\n1,2\n", 8);
+                 return 8;
+             }
+             throw std::runtime_error{"source error"};
+         },
+         "throwing source"});
+
+    ss::parser p{std::move(source)};
+    CHECK_EQ(p.raw_header(), "a,b");
+    bool thrown = false;
+    try {
+        read_all<int, int>(p);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+TEST_CASE("test byte source max record bytes") {
+    const std::string data = "1,x\n2," + std::string(10000, 'x') +
+                             "\n3,y\n4," + std::string(10000, 'x');
+
+    for (size_t chunk : {size_t{1}, size_t{7}, data.size()}) {
+        ss::parser<ss::string_error, ss::max_record_bytes<8>> p{
+            string_source(data, chunk)};
+
+        std::vector<int> values;
+        size_t errors = 0;
+        while (!p.eof()) {
+            auto [a, b] = p.get_next<int, std::string>();
+            if (p.valid()) {
+                values.push_back(a);
+            } else {
+                ++errors;
+            }
+        }
+
+        CHECK_EQ(values, std::vector<int>{1, 3});
+        CHECK_EQ(errors, 2);
+    }
+}
+
+#ifdef SSP_ZLIB_ENABLED
+TEST_CASE("test gzip source") {
+    const size_t records = 5000;
+    const auto data = make_data(records);
+
+    unique_file_name f{"gzip_source"};
+    {
+        gzFile file = gzopen(f.name.c_str(), "wb");
+        REQUIRE(file);
+        CHECK_EQ(gzwrite(file, data.data(), data.size()), data.size());
+        CHECK_EQ(gzclose(file), Z_OK);
+    }
+
+    expect_records<>(ss::gzip_source(f.name), records);
+    expect_records<ss::string_error>(ss::gzip_source(f.name), records);
+    expect_records<ss::throw_on_error>(ss::gzip_source(f.name), records);
+
+    // uncompressed files are read as they are
+    unique_file_name plain{"gzip_source"};
+    {
+        std::ofstream out{plain.name};
+        out << data;
+    }
+    expect_records<>(ss::gzip_source(plain.name), records);
+
+    // truncated data
+    std::filesystem::resize_file(f.name,
+                                 std::filesystem::file_size(f.name) / 2);
+    expect_source_error<>(ss::gzip_source(f.name));
+    expect_source_error<ss::string_error>(ss::gzip_source(f.name));
+    expect_source_error<ss::throw_on_error>(ss::gzip_source(f.name));
+
+    unique_file_name missing{"gzip_source"};
+    expect_not_opened<>(ss::gzip_source(missing.name));
+    expect_not_opened<ss::string_error>(ss::gzip_source(missing.name));
+    expect_not_opened<ss::throw_on_error>(ss::gzip_source(missing.name));
+}
+#endif
+
+#ifdef SSP_ZSTD_ENABLED
+TEST_CASE("test zstd source") {
+    const size_t records = 5000;
+    const auto data = make_data(records);
+
+    std::string compressed(ZSTD_compressBound(data.size()), '\0');
+    const auto size = ZSTD_compress(compressed.data(), compressed.size(),
+                                    data.data(), data.size(), 3);
+    REQUIRE_FALSE(ZSTD_isError(size));
+    compressed.resize(size);
+
+    unique_file_name f{"zstd_source"};
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << compressed;
+    }
+
+    expect_records<>(ss::zstd_source(f.name), records);
+    expect_records<ss::string_error>(ss::zstd_source(f.name), records);
+    expect_records<ss::throw_on_error>(ss::zstd_source(f.name), records);
+
+    // truncated data
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << compressed.substr(0, compressed.size() / 2);
+    }
+    expect_source_error<>(ss::zstd_source(f.name));
+    expect_source_error<ss::string_error>(ss::zstd_source(f.name));
+    expect_source_error<ss::throw_on_error>(ss::zstd_source(f.name));
+
+    unique_file_name missing{"zstd_source"};
+    expect_not_opened<>(ss::zstd_source(missing.name));
+}
+#endif
+
+#ifdef SSP_IO_URING_ENABLED
+TEST_CASE("test uring source") {
+    const size_t records = 20000;
+    const auto data = make_data(records);
+
+    unique_file_name f{"uring_source"};
+    {
+        std::ofstream out{f.name};
+        out << data;
+    }
+
+    for (unsigned depth : {0, 1, 4}) {
+        for (size_t block_size : {size_t{1}, size_t{4096}, size_t{1 << 20}}) {
+            for (bool direct : {false, true}) {
+                ss::uring_options options{block_size, depth, direct};
+                expect_records<>(ss::uring_source(f.name, options), records);
+                expect_records<ss::string_error>(
+                    ss::uring_source(f.name, options), records);
+                expect_records<ss::throw_on_error>(
+                    ss::uring_source(f.name, options), records);
+            }
+        }
+    }
+
+    for (unsigned depth : {0, 4}) {
+        ss::uring_options options{4096, depth, false, true};
+        expect_records<>(ss::uring_source(f.name, options), records);
+    }
+
+    // the source is destroyed while reads are in flight
+    {
+        ss::parser p{ss::uring_source(f.name, {4096, 8, false})};
+        CHECK_EQ(p.raw_header(), "a,b,c");
+    }
+
+    unique_file_name empty{"uring_source"};
+    {
+        std::ofstream out{empty.name};
+    }
+    {
+        ss::parser<ss::string_error> p{ss::uring_source(empty.name)};
+        CHECK(p.valid());
+        CHECK(p.eof());
+    }
+
+    unique_file_name missing{"uring_source"};
+    expect_not_opened<>(ss::uring_source(missing.name));
+    expect_not_opened<ss::string_error>(ss::uring_source(missing.name));
+    expect_not_opened<ss::throw_on_error>(ss::uring_source(missing.name));
+}
+#endif
@@ -995,3 +995,144 @@ TEST_CASE("converter test invalid split conversions with exceptions") {
             buff(R"(just,some,2,"strings\")")));
     CHECK(c.unterminated_quote());
 }
+
+namespace {
+struct single_char_category {
+    [[nodiscard]] bool ss_valid(const ss::category& value) const {
+        return value.value.size() == 1;
+    }
+};
+} /* anonymous namespace */
+
+TEST_CASE("converter test category conversions") {
+    ss::converter c;
+
+    auto [a, b] = c.convert<ss::category, ss::category>("x,y");
+    REQUIRE(c.valid());
+    auto [d, e] = c.convert<ss::category, single_char_category>("y,x");
+    REQUIRE(c.valid());
+
+    CHECK_EQ(std::string_view{a}, "x");
+    CHECK_EQ(std::string_view{b}, "y");
+    CHECK_EQ(a.code, e.code);
+    CHECK_EQ(b.code, d.code);
+    CHECK_EQ(c.get_string_pool().size(), 2);
+
+    std::ignore = c.convert<ss::category, single_char_category>("y,xx");
+    CHECK_FALSE(c.valid());
+
+    using variant_type = std::variant<int, ss::category>;
+    auto [f, g, h] =
+        c.convert<std::optional<ss::category>, variant_type, variant_type>(
+            "x,1,z");
+    REQUIRE(c.valid());
+
+    REQUIRE(f.has_value());
+    CHECK_EQ(f->code, a.code);
+    CHECK_EQ(std::get<int>(g), 1);
+    REQUIRE(std::holds_alternative<ss::category>(h));
+    CHECK_EQ(std::string_view{std::get<ss::category>(h)}, "z");
+    CHECK_EQ(c.get_string_pool().at(std::get<ss::category>(h).code), "z");
+}
+
+namespace {
+struct date_in_2024 {
+    [[nodiscard]] bool ss_valid(const ss::date& value) const {
+        return value >= ss::date{2024, 1, 1} && value < ss::date{2025, 1, 1};
+    }
+};
+} /* anonymous namespace */
+
+TEST_CASE("converter test date and time conversions") {
+    ss::converter c;
+
+    auto [d, t, e] = c.convert<date_in_2024, ss::timestamp, ss::epoch_seconds>(
+        "2024-02-29,2024-02-29T13:45:30Z,1709214330");
+    REQUIRE(c.valid());
+
+    CHECK_EQ(d, ss::date{2024, 2, 29});
+    CHECK_EQ(t.time_point(), e.time_point());
+
+    std::ignore = c.convert<date_in_2024, ss::timestamp, ss::epoch_seconds>(
+        "2023-02-28,2024-02-29T13:45:30Z,1709214330");
+    CHECK_FALSE(c.valid());
+
+    std::ignore = c.convert<date_in_2024, ss::timestamp, ss::epoch_seconds>(
+        "2024-02-29,2024-02-29T13:45:30Q,1709214330");
+    CHECK_FALSE(c.valid());
+}
+
+namespace {
+enum class side { buy, sell };
+} /* anonymous namespace */
+
+template <>
+struct ss::enum_map<side> {
+    constexpr static std::pair<std::string_view, side> values[] = {
+        {"BUY", side::buy}, {"SELL", side::sell}};
+};
+
+TEST_CASE("converter test enum conversions") {
+    ss::converter<ss::string_error> c;
+
+    auto [a, b] = c.convert<side, side>("SELL,BUY");
+    REQUIRE(c.valid());
+    CHECK(a == side::sell);
+    CHECK(b == side::buy);
+
+    std::ignore = c.convert<side, side>("SELL,HOLD");
+    CHECK_FALSE(c.valid());
+    CHECK_NE(c.error_msg().find("invalid conversion"), std::string::npos);
+}
+
+namespace {
+size_t counted_extractions = 0;
+
+struct counted {
+    int value;
+};
+} /* anonymous namespace */
+
+template <>
+inline bool ss::extract(const char* begin, const char* end, counted& dst) {
+    ++counted_extractions;
+    return ss::extract(begin, end, dst.value);
+}
+
+TEST_CASE("converter test repeated conversions of the same split data") {
+    ss::converter<ss::string_error> c;
+    counted_extractions = 0;
+
+    std::ignore = c.split("5,abc,7");
+    std::ignore = c.convert<counted, int, int>();
+    REQUIRE_FALSE(c.valid());
+    const auto error = c.error_msg();
+    CHECK_EQ(counted_extractions, 1);
+
+    // fails at the same column, the first column is not converted again
+    std::ignore = c.convert<counted, int, double>();
+    REQUIRE_FALSE(c.valid());
+    CHECK_EQ(c.error_msg(), error);
+    CHECK_EQ(counted_extractions, 1);
+
+    // different type at the failed column
+    auto [a, b, d] = c.convert<counted, std::string, int>();
+    REQUIRE(c.valid());
+    CHECK_EQ(a.value, 5);
+    CHECK_EQ(b, "abc");
+    CHECK_EQ(d, 7);
+    CHECK_EQ(counted_extractions, 2);
+
+    // new split data
+    const ss::split_data elems = c.split("6,abc,7");
+    std::ignore = c.convert<counted, int, int>();
+    REQUIRE_FALSE(c.valid());
+    CHECK_EQ(counted_extractions, 3);
+
+    // split data not owned by the converter is always converted
+    std::ignore = c.convert<counted, int, int>(elems);
+    REQUIRE_FALSE(c.valid());
+    CHECK_EQ(counted_extractions, 4);
+    std::ignore = c.convert<counted, int, int>(elems);
+    CHECK_EQ(counted_extractions, 5);
+}
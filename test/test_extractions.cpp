@@ -300,6 +300,40 @@ TEST_CASE_TEMPLATE("extract test functions for std::variant", T, int,
     }
 }
 
+TEST_CASE("extract test field classification for std::variant") {
+    for (const auto& [s, integer, floating_point] :
+         {std::tuple<std::string, bool, bool>{"", false, false},
+          {"-", false, false},
+          {"123", true, true},
+          {"-123", true, true},
+          {"+123", false, true},
+          {"1.5", false, true},
+          {"1e5", false, true},
+          {"inf", false, true},
+          {"-NaN", false, true},
+          {"abc", false, false},
+          {"12a", false, true}}) {
+        const auto field = ss::classify_field(s.c_str(), s.c_str() + s.size());
+        CHECK_EQ(field.integer, integer);
+        CHECK_EQ(field.floating_point, floating_point);
+    }
+
+    using variant = std::variant<int, double, std::string>;
+    for (const auto& [s, index] :
+         {std::pair<std::string, size_t>{"123", 0},
+          {"-1.5", 1},
+          {"1e5", 1},
+          {"inf", 1},
+          {"99999999999", 1},
+          {"abc", 2},
+          {"", 2},
+          {"12a", 2}}) {
+        variant var;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), var));
+        CHECK_EQ(var.index(), index);
+    }
+}
+
 TEST_CASE("extract test with long number string") {
     {
         std::string string_num =
@@ -316,3 +350,365 @@ TEST_CASE("extract test with long number string") {
         CHECK_FLOATING_CONVERSION_LONG_NUMBER(string_num, double, stod);
     }
 }
+
+TEST_CASE("extract test functions for ss::category") {
+    ss::string_pool pool;
+    std::vector<std::string> inputs = {"US", "DE", "US", "", "FR", "DE"};
+    std::vector<ss::category> values;
+
+    for (const auto& s : inputs) {
+        ss::category value;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), value, pool));
+        CHECK_EQ(value.value, s);
+        values.push_back(value);
+    }
+
+    CHECK_EQ(pool.size(), 4);
+    CHECK_EQ(values[0].code, values[2].code);
+    CHECK_EQ(values[1].code, values[5].code);
+    CHECK_NE(values[0].code, values[1].code);
+    CHECK_EQ(values[0], values[2]);
+    CHECK_NE(values[0], values[1]);
+
+    // the views point to the pool, not to the input
+    CHECK_EQ(values[0].value.data(), values[2].value.data());
+    CHECK_NE(values[0].value.data(), inputs[0].data());
+
+    for (const auto& value : values) {
+        CHECK_EQ(pool.at(value.code), value.value);
+    }
+
+    pool.clear();
+    CHECK_EQ(pool.size(), 0);
+}
+
+TEST_CASE("arena test store and reset") {
+    ss::arena arena{8};
+    std::vector<std::string> inputs = {"abc", "defgh", "", "0123456789", "x"};
+    std::vector<std::string_view> values;
+
+    for (const auto& s : inputs) {
+        values.push_back(arena.store(s.c_str(), s.c_str() + s.size()));
+    }
+
+    CHECK_EQ(arena.size(), 19);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        CHECK_EQ(values[i], inputs[i]);
+        if (!inputs[i].empty()) {
+            CHECK_NE(values[i].data(), inputs[i].data());
+        }
+    }
+
+    // values fitting into the same block are stored contiguously
+    CHECK_EQ(values[0].data() + values[0].size(), values[1].data());
+
+    const auto capacity = arena.capacity();
+    CHECK(capacity >= arena.size());
+
+    // the blocks are reused after a reset
+    arena.reset();
+    CHECK_EQ(arena.size(), 0);
+    for (const auto& s : inputs) {
+        CHECK_EQ(arena.store(s), s);
+    }
+    CHECK_EQ(arena.capacity(), capacity);
+
+    arena.release();
+    CHECK_EQ(arena.size(), 0);
+    CHECK_EQ(arena.capacity(), 0);
+    CHECK_EQ(arena.store("str"), "str");
+}
+
+TEST_CASE("extract test functions for ss::date") {
+    for (const auto& [s, year, month, day, days] :
+         {std::tuple<std::string, int, int, int, int64_t>{"1970-01-01", 1970,
+                                                          1, 1, 0},
+          {"2024-02-29", 2024, 2, 29, 19782},
+          {"1969-12-31", 1969, 12, 31, -1},
+          {"2000-03-01", 2000, 3, 1, 11017},
+          {"0000-01-01", 0, 1, 1, -719528}}) {
+        ss::date v;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK_EQ(v.year, year);
+        CHECK_EQ(v.month, month);
+        CHECK_EQ(v.day, day);
+        CHECK_EQ(v.days_since_epoch(), days);
+        CHECK_EQ(ss::date::from_days_since_epoch(days), v);
+    }
+
+    for (const std::string s :
+         {"", "2024-1-01", "2024-01-1", "2024/01/01", "2024-01-01 ",
+          "2024-00-10", "2024-13-10", "2024-01-00", "2024-01-32",
+          "2023-02-29", "1900-02-29", "20a4-01-01", "2024-0x-01"}) {
+        ss::date v;
+        CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+    }
+
+    CHECK(ss::date{2024, 1, 31} < ss::date{2024, 2, 1});
+    CHECK(ss::date{2023, 12, 31} < ss::date{2024, 1, 1});
+    CHECK(ss::date{2024, 1, 1} >= ss::date{2024, 1, 1});
+}
+
+TEST_CASE("extract test functions for ss::timestamp") {
+    constexpr int64_t ns = 1000000000;
+
+    for (const auto& [s, value] :
+         {std::pair<std::string, int64_t>{"1970-01-01", 0},
+          {"2024-02-29", 19782 * 86400 * ns},
+          {"2024-02-29T13:45:30", 1709214330 * ns},
+          {"2024-02-29 13:45:30", 1709214330 * ns},
+          {"2024-02-29T13:45:30Z", 1709214330 * ns},
+          {"2024-02-29T13:45:30.5Z", 1709214330 * ns + 500000000},
+          {"2024-02-29T13:45:30,123", 1709214330 * ns + 123000000},
+          {"2024-02-29T13:45:30.12345678", 1709214330 * ns + 123456780},
+          {"2024-02-29T13:45:30.123456789Z", 1709214330 * ns + 123456789},
+          {"2024-02-29T13:45:30+02:30", 1709205330 * ns},
+          {"2024-02-29T13:45:30+0230", 1709205330 * ns},
+          {"2024-02-29T13:45:30.000000001+02", 1709207130 * ns + 1},
+          {"2024-02-29T13:45:30-01:00", (1709214330 + 3600) * ns},
+          {"1969-12-31T23:59:59.5Z", -ns / 2}}) {
+        ss::timestamp v;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK_EQ(v.since_epoch.count(), value);
+        CHECK_EQ(v.time_point().time_since_epoch().count(), value);
+    }
+
+    for (const std::string s :
+         {"", "2024-02-29T", "2024-02-29T13:45", "2024-02-29T24:00:00",
+          "2024-02-29T13:60:00", "2024-02-29T13:45:60",
+          "2024-02-29X13:45:30", "2024-02-29T13:45:30.",
+          "2024-02-29T13:45:30.1234567890", "2024-02-29T13:45:30+2",
+          "2024-02-29T13:45:30+02:3", "2024-02-29T13:45:30ZZ",
+          "2024-02-29T13:45:30+25:00", "2262-01-01", "1677-12-31",
+          "2024-02-30T00:00:00"}) {
+        ss::timestamp v;
+        CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+    }
+}
+
+TEST_CASE("extract test functions for ss::epoch") {
+    {
+        const std::string s = "1709214330";
+        ss::epoch_seconds v;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK_EQ(v.since_epoch, std::chrono::seconds{1709214330});
+    }
+
+    {
+        const std::string s = "-1709214330123";
+        ss::epoch_milliseconds v;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK_EQ(v.since_epoch.count(), -1709214330123);
+        CHECK(v < ss::epoch_milliseconds{});
+    }
+
+    for (const std::string s : {"", "1.5", "12a", "2024-02-29"}) {
+        ss::epoch_seconds v;
+        CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+    }
+}
+
+TEST_CASE("extract test functions for ss::decimal") {
+    using price = ss::decimal<4>;
+
+    for (const auto& [s, value] :
+         {std::pair<std::string, int64_t>{"123.4500", 1234500},
+          {"123.45", 1234500},
+          {"123", 1230000},
+          {"-123.45", -1234500},
+          {"+0.0001", 1},
+          {".5", 5000},
+          {"5.", 50000},
+          {"-0", 0},
+          {"12345678901234.5678", 123456789012345678},
+          {"922337203685477.5807", std::numeric_limits<int64_t>::max()},
+          {"-922337203685477.5808", std::numeric_limits<int64_t>::min()},
+          {"1.234500000000000000", 12345}}) {
+        price v;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK_EQ(v.value, value);
+    }
+
+    for (const std::string s :
+         {"", "-", ".", "1.23456", "1..2", "1.2.3", "1e5", "12a", " 1",
+          "1,000", "922337203685477.5808", "-922337203685477.5809",
+          "99999999999999999999"}) {
+        price v;
+        CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+    }
+
+    {
+        ss::decimal<2> v;
+        const std::string s = "-12.5";
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK_EQ(v.integral_part(), -12);
+        CHECK_EQ(v.fractional_part(), -50);
+        CHECK_EQ(v.to_double(), -12.5);
+        CHECK(v < ss::decimal<2>{});
+    }
+}
+
+TEST_CASE("extract test functions for ss::decimal options") {
+    using rounded = ss::decimal<2, int64_t, ss::decimal_round>;
+    using truncated = ss::decimal<2, int64_t, ss::decimal_truncate>;
+
+    for (const auto& [s, round_value, truncate_value] :
+         {std::tuple<std::string, int64_t, int64_t>{"1.234", 123, 123},
+          {"1.235", 124, 123},
+          {"1.2349999", 123, 123},
+          {"-1.235", -124, -123},
+          {"0.999", 100, 99},
+          {"7", 700, 700}}) {
+        rounded r;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), r));
+        CHECK_EQ(r.value, round_value);
+
+        truncated t;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), t));
+        CHECK_EQ(t.value, truncate_value);
+    }
+
+    {
+        rounded r;
+        const std::string s = "92233720368547758.075";
+        CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), r));
+    }
+
+    using grouped = ss::decimal<2, int64_t, ss::thousands_separator<','>>;
+
+    for (const auto& [s, value] :
+         {std::pair<std::string, int64_t>{"1,234,567.89", 123456789},
+          {"-12,345", -1234500},
+          {"999", 99900},
+          {"1234567.89", 123456789}}) {
+        grouped g;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), g));
+        CHECK_EQ(g.value, value);
+    }
+
+    for (const std::string s :
+         {",123", "1,23", "1,2345", "1234,567", "1,,234", "1,234,", "1.2,3"}) {
+        grouped g;
+        CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), g));
+    }
+
+    {
+        ss::decimal<1, uint8_t> u;
+        const std::string max = "25.5";
+        REQUIRE(ss::extract(max.c_str(), max.c_str() + max.size(), u));
+        CHECK_EQ(u.value, 255);
+
+        for (const std::string s : {"25.6", "-1", "100"}) {
+            CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), u));
+        }
+    }
+
+    {
+        ss::decimal<0, int32_t> i;
+        const std::string s = "-2147483648.0";
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), i));
+        CHECK_EQ(i.value, std::numeric_limits<int32_t>::min());
+    }
+}
+
+namespace {
+enum class side { buy, sell, short_sell };
+
+enum class code {
+    c00, c01, c02, c03, c04, c05, c06, c07,
+    c08, c09, c10, c11, c12, c13, c14, c15,
+    c16, c17, c18, c19, c20, c21, c22, c23,
+    c24, c25, c26, c27, c28, c29, c30, c31,
+    c32, c33, c34, c35, c36, c37, c38, c39
+};
+} /* anonymous namespace */
+
+template <>
+struct ss::enum_map<side> {
+    constexpr static std::pair<std::string_view, side> values[] = {
+        {"BUY", side::buy}, {"SELL", side::sell}, {"SHORT", side::short_sell}};
+};
+
+template <>
+struct ss::enum_map<code> {
+    constexpr static std::pair<std::string_view, code> values[] = {
+        {"C00", code::c00},
+        {"C01", code::c01},
+        {"C02", code::c02},
+        {"C03", code::c03},
+        {"C04", code::c04},
+        {"C05", code::c05},
+        {"C06", code::c06},
+        {"C07", code::c07},
+        {"C08", code::c08},
+        {"C09", code::c09},
+        {"C10", code::c10},
+        {"C11", code::c11},
+        {"C12", code::c12},
+        {"C13", code::c13},
+        {"C14", code::c14},
+        {"C15", code::c15},
+        {"C16", code::c16},
+        {"C17", code::c17},
+        {"C18", code::c18},
+        {"C19", code::c19},
+        {"C20", code::c20},
+        {"C21", code::c21},
+        {"C22", code::c22},
+        {"C23", code::c23},
+        {"C24", code::c24},
+        {"C25", code::c25},
+        {"C26", code::c26},
+        {"C27", code::c27},
+        {"C28", code::c28},
+        {"C29", code::c29},
+        {"C30", code::c30},
+        {"C31", code::c31},
+        {"C32", code::c32},
+        {"C33", code::c33},
+        {"C34", code::c34},
+        {"C35", code::c35},
+        {"C36", code::c36},
+        {"C37", code::c37},
+        {"C38", code::c38},
+        {"C39", code::c39},
+    };
+};
+
+TEST_CASE("extract test functions for enums with ss::enum_map") {
+    for (const auto& [s, value] :
+         {std::pair<std::string, side>{"BUY", side::buy},
+          {"SELL", side::sell},
+          {"SHORT", side::short_sell}}) {
+        side v;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK(v == value);
+    }
+
+    // small maps are expected to get a perfect hash
+    CHECK_EQ(ss::enum_hash_table_v<side>.max_probe, 0);
+
+    for (const std::string s : {"", "buy", "BUYY", "BU", "SELL ", "C00"}) {
+        side v;
+        CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+    }
+
+    for (size_t i = 0; i < 40; ++i) {
+        const std::string s = (i < 10 ? "C0" : "C") + std::to_string(i);
+        code v;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK_EQ(static_cast<size_t>(v), i);
+    }
+
+    for (const std::string s : {"C40", "C0", "c01", "BUY", "C001"}) {
+        code v;
+        CHECK_FALSE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+    }
+
+    {
+        std::optional<side> v;
+        const std::string s = "HOLD";
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), v));
+        CHECK_FALSE(v.has_value());
+    }
+}
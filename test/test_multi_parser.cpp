@@ -0,0 +1,273 @@
+#include "test_helpers.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ss/multi_parser.hpp>
+
+namespace {
+#define ErrorModes                                                             \
+    config<std::false_type>, config<std::false_type, ss::string_error>,        \
+        config<std::false_type, ss::throw_on_error>
+
+template <typename ErrorMode, typename... Ts>
+using multi_parser_t =
+    std::conditional_t<std::is_same_v<ErrorMode, bool_error>,
+                       ss::multi_parser<Ts...>,
+                       ss::multi_parser<ErrorMode, Ts...>>;
+
+struct record {
+    int a;
+    double b;
+};
+
+struct shards {
+    std::vector<std::unique_ptr<unique_file_name>> files;
+
+    const std::string& add(const std::string& data) {
+        files.push_back(std::make_unique<unique_file_name>("multi_parser"));
+        std::ofstream out{files.back()->name};
+        out << data;
+        return files.back()->name;
+    }
+
+    std::vector<std::string> names() const {
+        std::vector<std::string> result;
+        for (const auto& f : files) {
+            result.push_back(f->name);
+        }
+        return result;
+    }
+};
+
+template <typename ErrorMode, typename... Ts, typename Parser>
+void expect_invalid_next(Parser& p) {
+    if constexpr (std::is_same_v<ErrorMode, ss::throw_on_error>) {
+        CHECK_THROWS(std::ignore = p.template get_next<Ts...>());
+    } else {
+        std::ignore = p.template get_next<Ts...>();
+        CHECK_FALSE(p.valid());
+        if constexpr (std::is_same_v<ErrorMode, ss::string_error>) {
+            CHECK_FALSE(p.error_msg().empty());
+        }
+    }
+}
+} /* anonymous namespace */
+
+TEST_CASE_TEMPLATE("test multi_parser", T, ErrorModes) {
+    using ErrorMode = typename T::ErrorMode;
+
+    shards s;
+    s.add("a,b\n1,1.5\n2,2.5\n");
+    s.add("a,b\n");
+    s.add("");
+    s.add("a,b\n3,3.5\n4,4.5\n5,5.5");
+
+    {
+        multi_parser_t<ErrorMode> p{s.names(), ","};
+        CHECK_EQ(p.raw_header(), "a,b");
+
+        std::vector<std::tuple<int, double, size_t, size_t>> data;
+        while (!p.eof()) {
+            auto [a, b] = p.template get_next<int, double>();
+            REQUIRE(p.valid());
+            data.emplace_back(a, b, p.file_index(), p.line());
+            CHECK_EQ(p.file_name(), s.names()[p.file_index()]);
+        }
+
+        std::vector<std::tuple<int, double, size_t, size_t>> expected{
+            {1, 1.5, 0, 2}, {2, 2.5, 0, 3}, {3, 3.5, 3, 2},
+            {4, 4.5, 3, 3}, {5, 5.5, 3, 4}};
+        CHECK_EQ(data, expected);
+    }
+
+    {
+        multi_parser_t<ErrorMode> p{s.names(), ","};
+        int sum = 0;
+        for (const auto& r : p.template iterate_object<record, int, double>()) {
+            sum += r.a;
+        }
+        CHECK_EQ(sum, 15);
+        CHECK(p.eof());
+    }
+
+    {
+        multi_parser_t<ErrorMode, ss::ignore_header> p{{s.names()[0]}, ","};
+        std::vector<std::string> data;
+        for (const auto& a : p.template iterate<std::string, void>()) {
+            data.push_back(a);
+        }
+        CHECK_EQ(data, std::vector<std::string>{"1", "2"});
+    }
+
+    {
+        multi_parser_t<ErrorMode> p{{}, ","};
+        CHECK(p.eof());
+        CHECK(p.file_name().empty());
+    }
+}
+
+TEST_CASE_TEMPLATE("test multi_parser invalid files", T, ErrorModes) {
+    using ErrorMode = typename T::ErrorMode;
+
+    shards s;
+    s.add("a,b\n1,1.5\n");
+    s.add("a,c\n2,2.5\n");
+    s.add("a,b\n3,3.5\n");
+
+    auto names = s.names();
+    names.insert(names.begin() + 2, "ssp_test_multi_parser_missing_file.csv");
+
+    multi_parser_t<ErrorMode> p{names, ","};
+
+    auto [a, b] = p.template get_next<int, double>();
+    CHECK(p.valid());
+    CHECK_EQ(a, 1);
+
+    // header mismatch
+    expect_invalid_next<ErrorMode, int, double>(p);
+    CHECK_EQ(p.file_index(), 1);
+    CHECK_FALSE(p.eof());
+
+    // missing file
+    expect_invalid_next<ErrorMode, int, double>(p);
+    CHECK_EQ(p.file_index(), 2);
+    CHECK_FALSE(p.eof());
+
+    auto [c, d] = p.template get_next<int, double>();
+    CHECK(p.valid());
+    CHECK_EQ(c, 3);
+    CHECK_EQ(p.file_index(), 3);
+    CHECK(p.eof());
+
+    expect_invalid_next<ErrorMode, int, double>(p);
+}
+
+TEST_CASE_TEMPLATE("test multi_parser use_fields", T, ErrorModes) {
+    using ErrorMode = typename T::ErrorMode;
+
+    shards s;
+    s.add("a,b\n1,1.5\n");
+    s.add("b,x,a\n2.5,x,2\n");
+    s.add("a,x,b\n3,x,3.5\n");
+
+    multi_parser_t<ErrorMode> p{s.names(), ","};
+    p.use_fields("b", "a");
+
+    std::vector<std::tuple<double, int>> data;
+    while (!p.eof()) {
+        auto value = p.template get_next<double, int>();
+        REQUIRE(p.valid());
+        data.push_back(value);
+    }
+
+    std::vector<std::tuple<double, int>> expected{
+        {1.5, 1}, {2.5, 2}, {3.5, 3}};
+    CHECK_EQ(data, expected);
+}
+
+TEST_CASE_TEMPLATE("test multi_parser shared resources", T, ErrorModes) {
+    using ErrorMode = typename T::ErrorMode;
+
+    shards s;
+    s.add("a,b\nx,one\ny,two\n");
+    s.add("a,b\ny,three\nz,four\n");
+    s.add("a,b\nx,five\n");
+
+    std::vector<std::tuple<ss::category, std::string_view>> data;
+    {
+        multi_parser_t<ErrorMode, ss::arena_views> p{s.names(), ","};
+        while (!p.eof()) {
+            data.push_back(
+                p.template get_next<ss::category, std::string_view>());
+            REQUIRE(p.valid());
+        }
+        CHECK_EQ(p.get_string_pool().size(), 3);
+
+        // the values stay valid after the files they were read from are
+        // closed, equal values have equal codes in every file
+        std::vector<std::string> categories;
+        std::vector<std::string> views;
+        for (const auto& [category, view] : data) {
+            categories.emplace_back(category.value);
+            views.emplace_back(view);
+        }
+        CHECK_EQ(categories,
+                 std::vector<std::string>{"x", "y", "y", "z", "x"});
+        CHECK_EQ(views, std::vector<std::string>{"one", "two", "three",
+                                                 "four", "five"});
+
+        const auto code = [&](size_t i) { return std::get<0>(data[i]).code; };
+        CHECK_EQ(code(0), code(4));
+        CHECK_EQ(code(1), code(2));
+        CHECK_NE(code(0), code(1));
+        CHECK_NE(code(1), code(3));
+    }
+
+    ss::arena arena;
+    multi_parser_t<ErrorMode, ss::arena_views> p{s.names(), ","};
+    p.set_arena(arena);
+
+    std::vector<std::string_view> views;
+    for (const auto& [_, view] :
+         p.template iterate<std::string, std::string_view>()) {
+        views.push_back(view);
+    }
+    CHECK_EQ(views.size(), 5);
+    CHECK_EQ(views.front(), "one");
+    CHECK_EQ(views.back(), "five");
+}
+
+TEST_CASE_TEMPLATE("test multi_parser concurrent", T, ErrorModes) {
+    using ErrorMode = typename T::ErrorMode;
+
+    shards s;
+    int expected = 0;
+    for (int i = 0; i < 16; ++i) {
+        std::string data = "a,b\n";
+        for (int j = 0; j < 100; ++j) {
+            data += std::to_string(i * 100 + j) + ",0.5\n";
+            expected += i * 100 + j;
+        }
+        s.add(data);
+    }
+
+    for (size_t threads : {1, 4}) {
+        multi_parser_t<ErrorMode> p{s.names(), ","};
+
+        // the first record is read before the rest are read concurrently
+        auto [first, _] = p.template get_next<int, double>();
+        std::atomic<int> sum{first};
+        std::atomic<int> count{1};
+        p.template for_each_concurrent<int, double>(
+            [&](int a, double) {
+                sum += a;
+                ++count;
+            },
+            threads);
+
+        CHECK(p.eof());
+        CHECK(p.valid());
+        CHECK_EQ(count, 1600);
+        CHECK_EQ(sum, expected);
+    }
+
+    s.add("a,b\n1,x\n");
+    multi_parser_t<ErrorMode> p{s.names(), ","};
+
+    std::mutex mutex;
+    std::vector<record> records;
+    auto add_record = [&](const std::tuple<int, double>& value) {
+        std::lock_guard lock{mutex};
+        records.push_back(ss::to_object<record>(value));
+    };
+
+    if constexpr (std::is_same_v<ErrorMode, ss::throw_on_error>) {
+        CHECK_THROWS(
+            (p.template for_each_concurrent<int, double>(add_record, 3)));
+    } else {
+        p.template for_each_concurrent<int, double>(add_record, 3);
+        CHECK_FALSE(p.valid());
+        CHECK_EQ(records.size(), 1600);
+    }
+    CHECK(p.eof());
+}
@@ -0,0 +1,194 @@
+#include "test_parser1.hpp"
+
+TEST_CASE_TEMPLATE("test category conversions", T, ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"category"};
+    const std::vector<std::string> countries = {"US", "DE", "FR"};
+
+    {
+        std::ofstream out{f.name};
+        for (size_t i = 0; i < 300; ++i) {
+            out << i << ',' << countries[i % countries.size()] << '\n';
+        }
+    }
+
+    struct Z {
+        int i;
+        ss::category country;
+    };
+
+    auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+
+    std::vector<Z> values;
+    for (const auto& z : p.template iterate_object<Z, int, ss::category>()) {
+        values.push_back(z);
+    }
+
+    REQUIRE_EQ(values.size(), 300);
+    CHECK_EQ(p.get_string_pool().size(), countries.size());
+
+    // the values stay valid after the line has been overwritten
+    for (size_t i = 0; i < values.size(); ++i) {
+        CHECK_EQ(values[i].i, i);
+        CHECK_EQ(values[i].country.value, countries[i % countries.size()]);
+        CHECK_EQ(values[i].country.code, i % countries.size());
+        CHECK_EQ(p.get_string_pool().at(values[i].country.code),
+                 countries[i % countries.size()]);
+    }
+
+    // categories wrapped into an optional or a variant use the same pool
+    auto [q, __] = make_parser<buffer_mode, ErrorMode>(f.name);
+
+    size_t i = 0;
+    for (const auto& [id, country] :
+         q.template iterate<std::variant<int, ss::category>,
+                            std::optional<ss::category>>()) {
+        CHECK_EQ(std::get<int>(id), i);
+        REQUIRE(country.has_value());
+        CHECK_EQ(country->value, countries[i % countries.size()]);
+        CHECK_EQ(q.get_string_pool().at(country->code), country->value);
+        ++i;
+    }
+    CHECK_EQ(i, 300);
+    CHECK_EQ(q.get_string_pool().size(), countries.size());
+}
+
+TEST_CASE_TEMPLATE("test arena views", T, ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"arena"};
+
+    auto make_value = [](size_t i) {
+        return "value" + std::to_string(i);
+    };
+
+    {
+        std::ofstream out{f.name};
+        for (size_t i = 0; i < 300; ++i) {
+            out << make_value(i) << ',' << (i % 2 ? make_value(i) : "") << ','
+                << (i % 3 ? make_value(i) : std::to_string(i)) << '\n';
+        }
+    }
+
+    using variant_type = std::variant<int, std::string_view>;
+
+    auto check_values = [&](const auto& values) {
+        REQUIRE_EQ(values.size(), 300);
+        for (size_t i = 0; i < values.size(); ++i) {
+            const auto& [a, b, c] = values[i];
+            CHECK_EQ(a, make_value(i));
+            REQUIRE(b.has_value());
+            CHECK_EQ(*b, (i % 2 ? make_value(i) : ""));
+            if (i % 3) {
+                REQUIRE(std::holds_alternative<std::string_view>(c));
+                CHECK_EQ(std::get<std::string_view>(c), make_value(i));
+            } else {
+                REQUIRE(std::holds_alternative<int>(c));
+                CHECK_EQ(std::get<int>(c), i);
+            }
+        }
+    };
+
+    using tuple_type = std::tuple<std::string_view,
+                                  std::optional<std::string_view>, variant_type>;
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode, ss::arena_views>(
+            f.name);
+
+        std::vector<tuple_type> values;
+        for (const auto& v :
+             p.template iterate<std::string_view,
+                                std::optional<std::string_view>,
+                                variant_type>()) {
+            values.push_back(v);
+        }
+
+        // the values stay valid after the line has been overwritten
+        check_values(values);
+        CHECK(p.get_arena().size() > 0);
+
+        p.get_arena().reset();
+        CHECK_EQ(p.get_arena().size(), 0);
+    }
+
+    {
+        ss::arena arena;
+        std::vector<tuple_type> values;
+
+        {
+            auto [p, _] = make_parser<buffer_mode, ErrorMode, ss::arena_views>(
+                f.name);
+            p.set_arena(arena);
+
+            while (!p.eof()) {
+                values.push_back(
+                    p.template get_next<std::string_view,
+                                        std::optional<std::string_view>,
+                                        variant_type>());
+            }
+        }
+
+        // the values stay valid after the parser has been destroyed
+        check_values(values);
+        CHECK(arena.size() > 0);
+    }
+}
+
+namespace {
+size_t counted_extractions = 0;
+
+struct counted {
+    int value;
+};
+} /* anonymous namespace */
+
+template <>
+inline bool ss::extract(const char* begin, const char* end, counted& dst) {
+    ++counted_extractions;
+    return ss::extract(begin, end, dst.value);
+}
+
+TEST_CASE("test substitute conversions of the same prefix") {
+    const std::string data = "1,2,3\n1,x,3\n1,x,y\n";
+    ss::parser<ss::string_error> p{data.data(), data.size()};
+    counted_extractions = 0;
+
+    std::vector<size_t> matched;
+    auto match = [&](size_t i) {
+        return [&matched, i] { matched.push_back(i); };
+    };
+
+    while (!p.eof()) {
+        std::ignore = p.try_next<counted, int, int>(match(0))
+                          .or_else<counted, int, double>(match(1))
+                          .or_else<counted, std::string, int>(match(2))
+                          .or_else<counted, std::string, std::string>(match(3));
+    }
+
+    CHECK_EQ(matched, std::vector<size_t>{0, 2, 3});
+    // the first column is converted once for each line instead of
+    // 1 + 3 + 4 times
+    CHECK_EQ(counted_extractions, 3);
+
+    // values are only remembered within the alternatives of the same line
+    const std::string other_data = "1,x\n2,y\n";
+    ss::parser<ss::string_error> q{other_data.data(), other_data.size()};
+    counted_extractions = 0;
+
+    std::vector<std::pair<int, std::string>> values;
+    while (!q.eof()) {
+        std::ignore = q.try_next<counted, int>()
+                          .or_else<counted, std::string>(
+                              [&](counted c, const std::string& s) {
+                                  values.emplace_back(c.value, s);
+                              });
+    }
+
+    CHECK_EQ(values, std::vector<std::pair<int, std::string>>{{1, "x"},
+                                                              {2, "y"}});
+    CHECK_EQ(counted_extractions, 2);
+}
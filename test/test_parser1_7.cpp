@@ -0,0 +1,1244 @@
+#include "test_parser1.hpp"
+#include <memory_resource>
+#include <random>
+#include <thread>
+
+#if __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+struct header {
+    std::string name;
+    int version;
+};
+
+struct detail {
+    int id;
+    double amount;
+};
+} /* anonymous namespace */
+
+TEST_CASE_TEMPLATE("test dispatch by discriminator column", T,
+                   ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"dispatch"};
+    {
+        std::ofstream out{f.name};
+        out << "H,file,2\n";
+        for (int i = 0; i < 10; ++i) {
+            out << "D," << i << ',' << i * 1.5 << '\n';
+        }
+        out << "T,10\n";
+    }
+
+    auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+
+    std::vector<header> headers;
+    std::vector<detail> details;
+    std::vector<int> trailers;
+
+    while (!p.eof()) {
+        const bool handled = p.dispatch(
+            0,
+            ss::handler<void, std::string, int>(
+                "H",
+                [&](const std::string& name, int version) {
+                    headers.push_back({name, version});
+                }),
+            ss::handler<void, int, double>(
+                "D", [&](int id, double amount) {
+                    details.push_back({id, amount});
+                }),
+            ss::handler<void, int>("T", [&](int count) {
+                trailers.push_back(count);
+            }));
+        REQUIRE(handled);
+        REQUIRE(p.valid());
+    }
+
+    REQUIRE_EQ(headers.size(), 1);
+    CHECK_EQ(headers[0].name, "file");
+    CHECK_EQ(headers[0].version, 2);
+
+    REQUIRE_EQ(details.size(), 10);
+    for (size_t i = 0; i < details.size(); ++i) {
+        CHECK_EQ(details[i].id, i);
+        CHECK_EQ(details[i].amount, i * 1.5);
+    }
+
+    CHECK_EQ(trailers, std::vector<int>{10});
+}
+
+TEST_CASE_TEMPLATE("test dispatch with invalid records", T,
+                   ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"dispatch"};
+    {
+        std::ofstream out{f.name};
+        out << "D,1,2.5\n"
+            << "X,1,2.5\n"
+            << "D,x,2.5\n"
+            << "D\n"
+            << "D,2,3.5\n";
+    }
+
+    auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+
+    std::vector<detail> details;
+    auto dispatch = [&] {
+        std::ignore = p.dispatch(1, ss::handler<void, int, double>(
+                                        "1", [&](int id, double amount) {
+                                            details.push_back({id, amount});
+                                        }));
+    };
+
+    auto dispatch_first = [&] {
+        std::ignore = p.dispatch(0, ss::handler<void, int, double>(
+                                        "D", [&](int id, double amount) {
+                                            details.push_back({id, amount});
+                                        }));
+    };
+
+    dispatch();
+    if (!std::is_same_v<ErrorMode, ss::throw_on_error>) {
+        CHECK(p.valid());
+    }
+
+    // no handler for 'X'
+    expect_error_on_command(p, dispatch_first);
+    // invalid conversion
+    expect_error_on_command(p, dispatch_first);
+    // missing column
+    expect_error_on_command(p, dispatch);
+
+    // the handler can reject the record
+    if (!std::is_same_v<ErrorMode, ss::throw_on_error>) {
+        const bool handled = p.dispatch(
+            0, ss::handler<void, int, double>("D", [](int, double) {
+                return false;
+            }));
+        CHECK_FALSE(handled);
+    } else {
+        dispatch_first();
+        details.pop_back();
+    }
+
+    REQUIRE_EQ(details.size(), 1);
+    CHECK_EQ(details[0].id, 1);
+    CHECK_EQ(details[0].amount, 2.5);
+    CHECK(p.eof());
+}
+
+TEST_CASE_TEMPLATE("test where", T, ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"where"};
+    {
+        std::ofstream out{f.name};
+        out << "id,status,name\n";
+        for (int i = 0; i < 20; ++i) {
+            out << i << ',' << (i % 3 == 0 ? "ACTIVE" : "INACTIVE") << ",n"
+                << i << '\n';
+        }
+        out << "x,INACTIVE,n\n";
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        p.where(ss::column("status") == "ACTIVE");
+        REQUIRE(p.valid());
+        p.ignore_next();
+
+        std::vector<int> ids;
+        for (const auto& [id, status, name] :
+             p.template iterate<int, std::string, std::string>()) {
+            REQUIRE(p.valid());
+            CHECK_EQ(status, "ACTIVE");
+            CHECK_EQ(name, "n" + std::to_string(id));
+            ids.push_back(id);
+        }
+
+        // the last lines are rejected so eof is reached with the last
+        // accepted line
+        CHECK_EQ(ids, std::vector<int>{0, 3, 6, 9, 12, 15, 18});
+        CHECK(p.eof());
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        p.ignore_next();
+        p.where(ss::column(1).starts_with("IN"));
+        p.where(ss::column("id") != "x");
+        p.where([](const ss::split_data& fields) {
+            return fields.size() == 3 && *fields[0].first != '1';
+        });
+        REQUIRE(p.valid());
+
+        std::vector<int> ids;
+        while (!p.eof()) {
+            auto id = p.template get_next<int, void, void>();
+            REQUIRE(p.valid());
+            ids.push_back(id);
+        }
+        CHECK_EQ(ids, std::vector<int>{2, 4, 5, 7, 8});
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        p.ignore_next();
+        p.where(ss::column(1) == "ACTIVE");
+
+        auto id = p.template get_next<int, void, void>();
+        REQUIRE(p.valid());
+        CHECK_EQ(id, 0);
+        CHECK_EQ(p.line(), 2);
+
+        id = p.template get_next<int, void, void>();
+        REQUIRE(p.valid());
+        CHECK_EQ(id, 3);
+        CHECK_EQ(p.line(), 5);
+
+        // the next line was already accepted
+        p.clear_filters();
+        id = p.template get_next<int, void, void>();
+        REQUIRE(p.valid());
+        CHECK_EQ(id, 6);
+
+        id = p.template get_next<int, void, void>();
+        REQUIRE(p.valid());
+        CHECK_EQ(id, 7);
+    }
+}
+
+TEST_CASE_TEMPLATE("test where with invalid lines", T,
+                   ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"where"};
+    {
+        std::ofstream out{f.name};
+        out << "a,b\n"
+            << "1,keep\n"
+            << "2,drop\n"
+            << "x,keep\n"
+            << "3,\"keep\n"
+            << "4,drop\n"
+            << "5,keep\n"
+            << "6,drop\n";
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        auto command = [&p = p] { p.where(ss::column("c") == "keep"); };
+        expect_error_on_command(p, command);
+    }
+
+    auto [p, _] =
+        make_parser<buffer_mode, ErrorMode, ss::quote<'"'>>(f.name);
+    p.where(ss::column("b") == "keep");
+    p.ignore_next();
+
+    auto get_next = [&p = p] { std::ignore = p.template get_next<int, std::string>(); };
+
+    auto value = p.template get_next<int, std::string>();
+    REQUIRE(p.valid());
+    CHECK_EQ(value, std::tuple{1, "keep"});
+
+    // invalid conversion of an accepted line
+    expect_error_on_command(p, get_next);
+    // invalid split lines are not skipped
+    expect_error_on_command(p, get_next);
+
+    value = p.template get_next<int, std::string>();
+    REQUIRE(p.valid());
+    CHECK_EQ(value, std::tuple{5, "keep"});
+    CHECK(p.eof());
+}
+
+TEST_CASE_TEMPLATE("test skip and limit", T, ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"skip"};
+    {
+        std::ofstream out{f.name};
+        for (int i = 0; i < 10; ++i) {
+            if (i % 2 == 0) {
+                out << i << ",\"a\nb\"\n";
+            } else {
+                out << i << ",\"x\\\"\"\n";
+            }
+        }
+    }
+
+    {
+        auto [p, _] =
+            make_parser<buffer_mode, ErrorMode, ss::quote<'"'>,
+                        ss::escape<'\\'>, ss::multiline>(f.name);
+
+        CHECK_EQ(p.skip(3), 3);
+        CHECK_EQ(p.line(), 5);
+
+        auto [i, s] = p.template get_next<int, std::string>();
+        REQUIRE(p.valid());
+        CHECK_EQ(i, 3);
+        CHECK_EQ(s, "x\"");
+
+        CHECK_EQ(p.skip(0), 0);
+        CHECK_EQ(p.skip(1), 1);
+
+        auto [j, t] = p.template get_next<int, std::string>();
+        REQUIRE(p.valid());
+        CHECK_EQ(j, 5);
+        CHECK_EQ(t, "x\"");
+
+        p.limit(2);
+        std::vector<int> values;
+        while (!p.eof()) {
+            auto k = std::get<0>(p.template get_next<int, std::string>());
+            REQUIRE(p.valid());
+            values.push_back(k);
+        }
+        CHECK_EQ(values, std::vector<int>{6, 7});
+        CHECK_EQ(p.skip(1), 0);
+    }
+
+    {
+        auto [p, _] =
+            make_parser<buffer_mode, ErrorMode, ss::quote<'"'>,
+                        ss::escape<'\\'>, ss::multiline>(f.name);
+        p.where([](const ss::split_data& fields) {
+            return *fields[1].first == 'a';
+        });
+
+        // only the accepted records are skipped
+        CHECK_EQ(p.skip(2), 2);
+        auto i = std::get<0>(p.template get_next<int, std::string>());
+        REQUIRE(p.valid());
+        CHECK_EQ(i, 4);
+
+        CHECK_EQ(p.skip(10), 2);
+        CHECK(p.eof());
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        p.limit(0);
+        CHECK(p.eof());
+    }
+}
+
+TEST_CASE_TEMPLATE("test skip to position", T, ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"skip"};
+    std::vector<size_t> positions;
+    {
+        std::ofstream out{f.name};
+        size_t position = 0;
+        for (int i = 0; i < 100; ++i) {
+            positions.push_back(position);
+            const auto line = std::to_string(i) + ",value" + std::to_string(i);
+            out << line << '\n';
+            position += line.size() + 1;
+        }
+    }
+
+    auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+
+    // at the beginning of a line
+    p.skip_to(positions[50]);
+    auto [i, s] = p.template get_next<int, std::string>();
+    REQUIRE(p.valid());
+    CHECK_EQ(i, 50);
+    CHECK_EQ(s, "value50");
+    CHECK_EQ(p.position(), positions[51]);
+
+    // within a line
+    p.skip_to(positions[20] + 1);
+    i = std::get<0>(p.template get_next<int, std::string>());
+    REQUIRE(p.valid());
+    CHECK_EQ(i, 21);
+
+    // backwards
+    p.skip_to(0);
+    i = std::get<0>(p.template get_next<int, std::string>());
+    REQUIRE(p.valid());
+    CHECK_EQ(i, 0);
+
+    // resume from a saved position
+    std::ignore = p.template get_next<int, std::string>();
+    const auto position = p.position();
+    std::ignore = p.template get_next<int, std::string>();
+    p.skip_to(position);
+    i = std::get<0>(p.template get_next<int, std::string>());
+    REQUIRE(p.valid());
+    CHECK_EQ(i, 2);
+
+    p.skip_to(positions.back() + 3);
+    CHECK(p.eof());
+}
+
+TEST_CASE_TEMPLATE("test sampling", T, ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"sample"};
+    constexpr int size = 1000;
+    {
+        std::ofstream out{f.name};
+        out << "id,value\n";
+        for (int i = 0; i < size; ++i) {
+            // every 100th record is invalid
+            out << (i % 100 == 99 ? "x" : std::to_string(i)) << ",value" << i
+                << '\n';
+        }
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        p.ignore_next();
+
+        auto samples = p.template sample_stride<int, std::string>(10);
+        CHECK(p.eof());
+        REQUIRE_EQ(samples.size(), size / 10);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            CHECK_EQ(std::get<0>(samples[i]), i * 10);
+            CHECK_EQ(std::get<1>(samples[i]), "value" + std::to_string(i * 10));
+        }
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        p.ignore_next();
+
+        std::mt19937 generator{42};
+        auto samples = p.template sample_reservoir<int, void>(100, generator);
+        CHECK(p.eof());
+        REQUIRE_EQ(samples.size(), 100);
+
+        std::sort(samples.begin(), samples.end());
+        CHECK(std::adjacent_find(samples.begin(), samples.end()) ==
+              samples.end());
+        CHECK(samples.front() >= 0);
+        CHECK(samples.back() < size);
+        CHECK(samples.back() > size / 2);
+        CHECK(std::none_of(samples.begin(), samples.end(),
+                           [](int i) { return i % 100 == 99; }));
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        p.ignore_next();
+
+        std::mt19937 generator{42};
+        auto samples =
+            p.template sample_reservoir<int, std::string>(2 * size, generator);
+        CHECK_EQ(samples.size(), size - size / 100);
+    }
+
+    {
+        auto [p, _] = make_parser<buffer_mode, ErrorMode>(f.name);
+        p.ignore_next();
+
+        std::mt19937 generator{42};
+        auto samples =
+            p.template sample_offsets<int, std::string>(50, generator);
+        REQUIRE_FALSE(samples.empty());
+        CHECK(samples.size() <= 50);
+
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const auto& [id, value] = samples[i];
+            CHECK_EQ(value, "value" + std::to_string(id));
+            if (i > 0) {
+                CHECK(std::get<0>(samples[i - 1]) < id);
+            }
+        }
+    }
+}
+
+TEST_CASE_TEMPLATE("test sampling multiline records", T,
+                   ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"sample"};
+    {
+        std::ofstream out{f.name};
+        for (int i = 0; i < 500; ++i) {
+            out << i << ",\"first\nsecond\"," << i << '\n';
+        }
+    }
+
+    auto [p, _] = make_parser<buffer_mode, ErrorMode, ss::quote<'"'>,
+                              ss::multiline>(f.name);
+
+    std::mt19937 generator{7};
+    auto samples =
+        p.template sample_offsets<int, std::string, int>(100, generator);
+    REQUIRE_FALSE(samples.empty());
+
+    for (const auto& [a, s, b] : samples) {
+        CHECK_EQ(a, b);
+        CHECK_EQ(s, "first\nsecond");
+    }
+
+    // lines within quoted fields which look like records are not sampled
+    unique_file_name g{"sample"};
+    {
+        std::ofstream out{g.name};
+        for (int i = 0; i < 500; ++i) {
+            out << "row " << i << ",\"note\nfake,row " << i
+                << "\nfake,row " << i << "\nend\"\n";
+        }
+    }
+
+    auto [q, __] = make_parser<buffer_mode, ErrorMode, ss::quote<'"'>,
+                               ss::multiline>(g.name);
+
+    auto fake_samples = q.template sample_offsets<std::string, std::string>(
+        20, std::mt19937{42});
+    REQUIRE_FALSE(fake_samples.empty());
+
+    for (const auto& [a, s] : fake_samples) {
+        CHECK_EQ(a.rfind("row ", 0), 0);
+        CHECK_EQ(s, "note\nfake," + a + "\nfake," + a + "\nend");
+    }
+}
+
+template <typename... Options>
+void test_follow() {
+    unique_file_name f{"follow"};
+    const std::vector<std::string> chunks = {"2,", "b\n3,\"multi", "\nline\"",
+                                             "\n", "", "4,d"};
+    {
+        std::ofstream out{f.name};
+        out << "1,a\n";
+    }
+
+    ss::parser<ss::quote<'"'>, ss::multiline, Options...> p{f.name};
+
+    // each check for new data appends the next chunk to the file
+    size_t checks = 0;
+    p.follow(
+        [&] {
+            if (checks < chunks.size()) {
+                std::ofstream out{f.name, std::ios::app};
+                out << chunks[checks];
+            }
+            return checks++ >= chunks.size();
+        },
+        ss::follow_backoff{std::chrono::milliseconds{0},
+                           std::chrono::milliseconds{1}});
+
+    // the first line is returned without waiting for the next one
+    auto [i, s] = p.template get_next<int, std::string>();
+    REQUIRE(p.valid());
+    CHECK_EQ(i, 1);
+    CHECK_EQ(s, "a");
+    CHECK_EQ(checks, 0);
+
+    std::vector<std::pair<int, std::string>> values;
+    while (!p.eof()) {
+        auto [j, t] = p.template get_next<int, std::string>();
+        REQUIRE(p.valid());
+        values.emplace_back(j, t);
+    }
+
+    const std::vector<std::pair<int, std::string>> expected = {
+        {2, "b"}, {3, "multi\nline"}, {4, "d"}};
+    CHECK_EQ(values, expected);
+    CHECK(checks > chunks.size());
+}
+
+TEST_CASE("test follow") {
+    test_follow<>();
+    test_follow<ss::string_error>();
+    test_follow<ss::throw_on_error>();
+}
+
+TEST_CASE("test follow empty file") {
+    unique_file_name f{"follow"};
+    {
+        std::ofstream out{f.name};
+    }
+
+    ss::parser p{f.name};
+    CHECK(p.eof());
+
+    bool written = false;
+    p.follow([&] {
+        if (!written) {
+            std::ofstream out{f.name, std::ios::app};
+            out << "1,2\n";
+            written = true;
+            return false;
+        }
+        return true;
+    });
+
+    CHECK_FALSE(p.eof());
+    auto [a, b] = p.get_next<int, int>();
+    REQUIRE(p.valid());
+    CHECK_EQ(a, 1);
+    CHECK_EQ(b, 2);
+    CHECK_EQ(p.line(), 1);
+    CHECK(p.eof());
+}
+
+template <typename... Options>
+void test_checkpoint() {
+    unique_file_name f{"checkpoint"};
+    std::string data = "a,b,c\r\n";
+    for (int i = 0; i < 30; ++i) {
+        data += std::to_string(i) + ",\"x\r\ny" + std::to_string(i) +
+                "\"," + std::to_string(i * 2) + "\r\n";
+    }
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << data;
+    }
+
+    using setup = ss::setup<ss::quote<'"'>, ss::multiline, Options...>;
+    using value = std::tuple<int, std::string>;
+
+    auto read_rest = [](auto& p) {
+        std::vector<value> values;
+        while (!p.eof()) {
+            values.push_back(p.template get_next<int, std::string>());
+            REQUIRE(p.valid());
+        }
+        return values;
+    };
+
+    std::vector<value> all;
+    {
+        ss::parser<setup> p{f.name};
+        p.use_fields("c", "b");
+        all = read_rest(p);
+        REQUIRE_EQ(all.size(), 30);
+    }
+
+    for (const size_t n : {size_t{0}, size_t{7}, size_t{29}, size_t{30}}) {
+        ss::parser<setup> p{f.name};
+        p.use_fields("c", "b");
+        for (size_t i = 0; i < n; ++i) {
+            std::ignore = p.template get_next<int, std::string>();
+        }
+
+        const auto checkpoint = p.checkpoint();
+        auto restored = ss::checkpoint::from_string(checkpoint.to_string());
+        REQUIRE(restored.has_value());
+        CHECK_EQ(restored->to_string(), checkpoint.to_string());
+
+        const std::vector<value> expected{all.begin() + n, all.end()};
+
+        ss::parser<setup> from_file{f.name, *restored};
+        CHECK_EQ(from_file.line(), p.line());
+        CHECK_EQ(from_file.header(), std::vector<std::string>{"a", "b", "c"});
+        CHECK_EQ(from_file.eof(), n == all.size());
+        CHECK_EQ(read_rest(from_file), expected);
+
+        ss::parser<setup> from_buffer{data.data(), data.size(), *restored};
+        CHECK_EQ(read_rest(from_buffer), expected);
+    }
+
+    CHECK_FALSE(ss::checkpoint::from_string("").has_value());
+    CHECK_FALSE(ss::checkpoint::from_string("1 2").has_value());
+    CHECK_FALSE(ss::checkpoint::from_string("1 2 0 3 abc 0 0 0 x")
+                    .has_value());
+    CHECK(ss::checkpoint::from_string("1 2 0 3 abc 0 0 0").has_value());
+}
+
+TEST_CASE("test checkpoint") {
+    test_checkpoint<>();
+    test_checkpoint<ss::string_error>();
+    test_checkpoint<ss::throw_on_error>();
+}
+
+template <typename... Options>
+void test_byte_ranges(const std::string& data) {
+    using setup = ss::setup<Options...>;
+    using value = std::tuple<int, std::string, int>;
+
+    unique_file_name f{"byte_range"};
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << data;
+    }
+
+    auto read_all = [](auto& p) {
+        std::vector<value> values;
+        while (!p.eof()) {
+            values.push_back(p.template get_next<int, std::string, int>());
+            REQUIRE(p.valid());
+        }
+        return values;
+    };
+
+    std::vector<value> expected;
+    {
+        ss::parser<setup> p{f.name};
+        p.ignore_next();
+        expected = read_all(p);
+    }
+
+    auto check_split = [&](const std::vector<size_t>& offsets) {
+        std::vector<value> from_file;
+        std::vector<value> from_buffer;
+        for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+            const ss::byte_range range{offsets[i], offsets[i + 1]};
+
+            ss::parser<setup> p{f.name, range};
+            CHECK_EQ(p.raw_header(), "a,b,c");
+            if (range.begin == 0 && !p.eof()) {
+                p.ignore_next();
+            }
+            auto values = read_all(p);
+            from_file.insert(from_file.end(), values.begin(), values.end());
+
+            ss::parser<setup> q{data.data(), data.size(), range};
+            if (range.begin == 0 && !q.eof()) {
+                q.ignore_next();
+            }
+            values = read_all(q);
+            from_buffer.insert(from_buffer.end(), values.begin(), values.end());
+        }
+        CHECK_EQ(from_file, expected);
+        CHECK_EQ(from_buffer, expected);
+    };
+
+    for (size_t parts = 1; parts < 20; ++parts) {
+        std::vector<size_t> offsets;
+        for (size_t i = 0; i <= parts; ++i) {
+            offsets.push_back(data.size() * i / parts);
+        }
+        check_split(offsets);
+    }
+
+    std::mt19937 generator{3};
+    std::uniform_int_distribution<size_t> uniform{0, data.size() + 10};
+    for (size_t i = 0; i < 20; ++i) {
+        std::vector<size_t> offsets{0, data.size() + 10};
+        for (size_t j = 0; j < 5; ++j) {
+            offsets.push_back(uniform(generator));
+        }
+        std::sort(offsets.begin(), offsets.end());
+        check_split(offsets);
+    }
+}
+
+TEST_CASE("test byte range") {
+    std::string data = "a,b,c\n";
+    for (int i = 0; i < 40; ++i) {
+        data += std::to_string(i) + ",value" + std::to_string(i) + "," +
+                std::to_string(i * i) + "\n";
+    }
+
+    test_byte_ranges<>(data);
+    test_byte_ranges<ss::string_error>(data);
+    test_byte_ranges<ss::throw_on_error>(data);
+}
+
+TEST_CASE("test byte range multiline") {
+    std::string data = "a,b,c\n";
+    for (int i = 0; i < 40; ++i) {
+        data += std::to_string(i) + ",";
+        switch (i % 4) {
+        case 0:
+            data += "\"x\ny\"\"\nz\"";
+            break;
+        case 1:
+            data += "\"x,\n" + std::to_string(i) + ",y\"";
+            break;
+        case 2:
+            data += "\"\"";
+            break;
+        default:
+            data += "w";
+        }
+        data += "," + std::to_string(i * i) + "\n";
+    }
+
+    test_byte_ranges<ss::quote<'"'>, ss::multiline>(data);
+    test_byte_ranges<ss::quote<'"'>, ss::multiline, ss::string_error>(data);
+    test_byte_ranges<ss::quote<'"'>, ss::multiline, ss::throw_on_error>(data);
+}
+
+template <typename... Ts>
+void test_file_stream(const std::string& data, size_t records) {
+    unique_file_name f{"file_stream"};
+    {
+        std::ofstream out{f.name};
+        out << data;
+    }
+
+    FILE* file = std::fopen(f.name.c_str(), "rb");
+    REQUIRE(file);
+    {
+        ss::parser<Ts...> p{file, ","};
+        CHECK_EQ(p.raw_header(), "a,b");
+        p.ignore_next();
+
+        size_t i = 0;
+        for (const auto& [a, b] : p.template iterate<size_t, std::string>()) {
+            CHECK_EQ(a, i);
+            CHECK_EQ(b, "value" + std::to_string(i));
+            ++i;
+        }
+        CHECK_EQ(i, records);
+    }
+    // the file is not closed by the parser
+    CHECK_EQ(std::fclose(file), 0);
+
+    if constexpr (ss::setup<Ts...>::throw_on_error) {
+        CHECK_THROWS(ss::parser<Ts...>{static_cast<FILE*>(nullptr)});
+    } else {
+        ss::parser<Ts...> invalid{static_cast<FILE*>(nullptr)};
+        CHECK_FALSE(invalid.valid());
+        CHECK(invalid.eof());
+    }
+}
+
+#if __unix__
+template <typename... Ts>
+void test_file_descriptor(const std::string& data, size_t records) {
+    int fds[2];
+    REQUIRE_EQ(pipe(fds), 0);
+
+    // the data is larger than the pipe buffer, so it is written while
+    // being read
+    std::thread writer{[&] {
+        size_t written = 0;
+        while (written < data.size()) {
+            auto n = write(fds[1], data.data() + written, data.size() - written);
+            if (n <= 0) {
+                break;
+            }
+            written += n;
+        }
+        close(fds[1]);
+    }};
+
+    {
+        ss::parser<Ts...> p{ss::file_descriptor{fds[0]}, ","};
+        CHECK_EQ(p.raw_header(), "a,b");
+        p.ignore_next();
+
+        size_t i = 0;
+        while (!p.eof()) {
+            auto [a, b] = p.template get_next<size_t, std::string>();
+            CHECK_EQ(a, i);
+            CHECK_EQ(b, "value" + std::to_string(i));
+            ++i;
+        }
+        CHECK_EQ(i, records);
+    }
+
+    writer.join();
+    // the descriptor is not closed by the parser
+    CHECK_EQ(close(fds[0]), 0);
+
+    if constexpr (ss::setup<Ts...>::throw_on_error) {
+        CHECK_THROWS(ss::parser<Ts...>{ss::file_descriptor{-1}});
+    } else {
+        ss::parser<Ts...> invalid{ss::file_descriptor{-1}};
+        CHECK_FALSE(invalid.valid());
+        CHECK(invalid.eof());
+    }
+}
+#endif
+
+TEST_CASE("test file stream and file descriptor") {
+    std::string data = "a,b\n";
+    const size_t records = 20000;
+    for (size_t i = 0; i < records; ++i) {
+        data += std::to_string(i) + ",value" + std::to_string(i) + "\n";
+    }
+
+    test_file_stream<>(data, records);
+    test_file_stream<ss::string_error>(data, records);
+    test_file_stream<ss::throw_on_error>(data, records);
+
+#if __unix__
+    test_file_descriptor<>(data, records);
+    test_file_descriptor<ss::string_error>(data, records);
+    test_file_descriptor<ss::throw_on_error>(data, records);
+#endif
+}
+
+template <typename... Ts>
+void expect_sequential_scan(ss::parser<ss::sequential_scan, Ts...>& p,
+                            size_t records) {
+    CHECK_EQ(p.raw_header(), "a,b");
+    p.ignore_next();
+
+    // the records are compared without a check per record, since there
+    // are too many of them
+    size_t i = 0;
+    size_t mismatches = 0;
+    while (!p.eof()) {
+        auto [a, b] = p.template get_next<size_t, std::string>();
+        REQUIRE(p.valid());
+        if (a != i || b != "value" + std::to_string(i)) {
+            ++mismatches;
+        }
+        ++i;
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(i, records);
+}
+
+template <typename... Ts>
+void test_sequential_scan(const std::string& data, size_t records) {
+    unique_file_name f{"sequential_scan"};
+    {
+        std::ofstream out{f.name};
+        out << data;
+    }
+
+    {
+        ss::parser<ss::sequential_scan, Ts...> p{f.name};
+        expect_sequential_scan(p, records);
+    }
+
+    {
+        FILE* file = std::fopen(f.name.c_str(), "rb");
+        REQUIRE(file);
+        {
+            ss::parser<ss::sequential_scan, Ts...> p{file, ","};
+            expect_sequential_scan(p, records);
+        }
+        CHECK_EQ(std::fclose(file), 0);
+    }
+
+    {
+        ss::parser<ss::sequential_scan, Ts...> p{data.data(), data.size()};
+        expect_sequential_scan(p, records);
+    }
+
+#if __unix__
+    // the pages of a memory mapped file are only advised explicitly
+    {
+        const int fd = open(f.name.c_str(), O_RDONLY);
+        REQUIRE(fd >= 0);
+        void* mapped =
+            mmap(nullptr, data.size(), PROT_READ, MAP_PRIVATE, fd, 0);
+        REQUIRE(mapped != MAP_FAILED);
+
+        const auto* buffer = static_cast<const char*>(mapped);
+        ss::advise_sequential_buffer(buffer, data.size());
+        {
+            ss::parser<ss::sequential_scan, Ts...> p{buffer, data.size()};
+            expect_sequential_scan(p, records);
+        }
+
+        CHECK_EQ(munmap(mapped, data.size()), 0);
+        CHECK_EQ(close(fd), 0);
+    }
+#endif
+}
+
+TEST_CASE("test sequential scan") {
+    // the file is larger than the step in which the read pages are dropped
+    std::string data = "a,b\n";
+    size_t records = 0;
+    while (data.size() < 2 * ss::page_cache_drop_size) {
+        data += std::to_string(records) + ",value" + std::to_string(records) +
+                "\n";
+        ++records;
+    }
+
+    test_sequential_scan<>(data, records);
+    test_sequential_scan<ss::string_error>(data, records);
+    test_sequential_scan<ss::throw_on_error>(data, records);
+}
+
+template <typename T>
+void test_max_record_bytes(const std::string& eol) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    unique_file_name f{"max_record_bytes"};
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << "1,xx" << eol;
+        out << "2," << std::string(5000, 'x') << eol;
+        out << "3,yy" << eol;
+        out << "4,12345678" << eol;
+        out << "5,123456789" << eol;
+        out << "6,\"ab" << eol << "cd\"" << eol;
+        out << "7,\"abcdef" << eol << "ghijkl\"" << eol;
+        out << "8," << std::string(5000, 'x') << eol;
+        out << "9,zz" << eol;
+        out << "10," << std::string(5000, 'x');
+    }
+
+    auto [p, _] = make_parser<buffer_mode, ErrorMode, ss::quote<'"'>,
+                              ss::multiline, ss::max_record_bytes<10>>(f.name);
+
+    std::vector<std::pair<int, std::string>> values;
+    size_t errors = 0;
+    while (!p.eof()) {
+        try {
+            auto [a, b] = p.template get_next<int, std::string>();
+            if (p.valid()) {
+                values.emplace_back(a, b);
+            } else {
+                ++errors;
+                if constexpr (T::StringError) {
+                    CHECK_NE(p.error_msg().find("record size limit reached"),
+                             std::string::npos);
+                }
+            }
+        } catch (const ss::exception& e) {
+            ++errors;
+            CHECK_NE(std::string{e.what()}.find("record size limit reached"),
+                     std::string::npos);
+        }
+    }
+
+    std::vector<std::pair<int, std::string>> expected{
+        {1, "xx"}, {3, "yy"}, {4, "12345678"}, {6, "ab" + eol + "cd"},
+        {9, "zz"}};
+    CHECK_EQ(values, expected);
+    CHECK_EQ(errors, 5);
+}
+
+TEST_CASE_TEMPLATE("test max record bytes", T, ParserOptionCombinations) {
+    test_max_record_bytes<T>("\n");
+    test_max_record_bytes<T>("\r\n");
+}
+
+template <typename... Ts>
+void test_null_character(const std::string& data, bool buffer_mode,
+                         std::pmr::memory_resource* resource) {
+    unique_file_name f{"null_character"};
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << data;
+    }
+
+    auto p = buffer_mode
+                 ? ss::parser<Ts...>{data.data(), data.size(), resource}
+                 : ss::parser<Ts...>{f.name, resource};
+    p.ignore_next();
+
+    // the line with the null character is not joined with the next one
+    std::vector<std::pair<std::string, int>> values;
+    size_t errors = 0;
+    while (!p.eof()) {
+        try {
+            auto [a, b] = p.template get_next<std::string, int>();
+            if (p.valid()) {
+                values.emplace_back(a, b);
+            } else {
+                ++errors;
+            }
+        } catch (const ss::exception&) {
+            ++errors;
+        }
+    }
+
+    CHECK_EQ(errors, 1);
+    CHECK_EQ(values, std::vector<std::pair<std::string, int>>{{"c", 2}});
+}
+
+template <typename... Ts>
+void test_null_character_all(const std::string& data) {
+    for (bool buffer_mode : {false, true}) {
+        for (auto* resource : {static_cast<std::pmr::memory_resource*>(nullptr),
+                               std::pmr::new_delete_resource()}) {
+            test_null_character<Ts...>(data, buffer_mode, resource);
+            test_null_character<ss::quote<'"'>, ss::multiline, Ts...>(
+                data, buffer_mode, resource);
+            test_null_character<ss::max_record_bytes<100>, Ts...>(
+                data, buffer_mode, resource);
+        }
+    }
+}
+
+TEST_CASE("test null character within line") {
+    const std::string data{"s,n\na\0b,1\nc,2\n", 14};
+    test_null_character_all<>(data);
+    test_null_character_all<ss::string_error>(data);
+    test_null_character_all<ss::throw_on_error>(data);
+}
+
+TEST_CASE_TEMPLATE("test multiline records of many lines", T,
+                   ParserOptionCombinations) {
+    constexpr auto buffer_mode = T::BufferMode::value;
+    using ErrorMode = typename T::ErrorMode;
+
+    // the records are assembled from many lines, with quotes which are
+    // removed from them and escaped new lines
+    std::vector<std::string> notes;
+    unique_file_name f{"multiline_records"};
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        for (size_t i = 0; i < 20; ++i) {
+            std::string note;
+            out << i << ",\"";
+            for (size_t j = 0; j < i * 50; ++j) {
+                out << "line \"\"" << j << "\"\"\n";
+                note += "line \"" + std::to_string(j) + "\"\n";
+            }
+            out << "end\",x\\\n" << std::string(i * 10, 'y') << "\n";
+            notes.push_back(note + "end");
+        }
+    }
+
+    auto [p, _] = make_parser<buffer_mode, ErrorMode, ss::quote<'"'>,
+                              ss::escape<'\\'>, ss::multiline>(f.name);
+
+    size_t i = 0;
+    while (!p.eof()) {
+        auto [a, b, c] =
+            p.template get_next<size_t, std::string, std::string>();
+        REQUIRE(p.valid());
+        CHECK_EQ(a, i);
+        CHECK_EQ(b, notes[i]);
+        CHECK_EQ(c, "x\n" + std::string(i * 10, 'y'));
+        ++i;
+    }
+    CHECK_EQ(i, notes.size());
+}
+
+namespace {
+// counts the allocations made through it and the bytes still allocated
+class counting_resource : public std::pmr::memory_resource {
+public:
+    size_t allocations{0};
+    size_t allocated{0};
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        allocated -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+} /* anonymous namespace */
+
+template <typename... Ts>
+void test_memory_resource(bool buffer_mode, const std::string& data,
+                          const std::vector<std::string>& notes) {
+    unique_file_name f{"memory_resource"};
+    {
+        std::ofstream out{f.name, std::ios::binary};
+        out << data;
+    }
+
+    counting_resource resource;
+    {
+        auto p = buffer_mode ? ss::parser<Ts...>{data.data(), data.size(),
+                                                 &resource}
+                             : ss::parser<Ts...>{f.name, &resource};
+        CHECK_EQ(p.header(), std::vector<std::string>{"id", "note"});
+        p.use_fields("note", "id");
+
+        size_t i = 0;
+        while (!p.eof()) {
+            auto [note, id] = p.template get_next<std::pmr::string, size_t>();
+            REQUIRE(p.valid());
+            CHECK_EQ(id, i);
+            CHECK_EQ(std::string_view{note}, notes[i]);
+            CHECK_EQ(note.get_allocator().resource(), &resource);
+            ++i;
+        }
+        CHECK_EQ(i, notes.size());
+        CHECK(resource.allocations > 0);
+    }
+    CHECK_EQ(resource.allocated, 0);
+
+    // the buffers of the moved parser are freed by the one it is moved to
+    {
+        ss::parser<Ts...> p{data.data(), data.size(), &resource};
+        ss::parser<Ts...> moved{std::move(p)};
+        moved.ignore_next();
+        auto note = moved.template get_next<size_t, std::pmr::string>();
+        REQUIRE(moved.valid());
+        CHECK_EQ(std::string_view{std::get<1>(note)}, notes[0]);
+    }
+    CHECK_EQ(resource.allocated, 0);
+
+    // the value of the iterator is assigned for each record and keeps the
+    // resource
+    {
+        ss::parser<Ts...> p{f.name, &resource};
+        p.ignore_next();
+
+        size_t i = 0;
+        for (const auto& [id, note] :
+             p.template iterate<size_t, std::pmr::string>()) {
+            CHECK_EQ(id, i);
+            CHECK_EQ(std::string_view{note}, notes[i]);
+            CHECK_EQ(note.get_allocator().resource(), &resource);
+            ++i;
+        }
+        CHECK_EQ(i, notes.size());
+    }
+    CHECK_EQ(resource.allocated, 0);
+
+    // the values are stored in the arena of the resource, and remain valid
+    // after the parser is destroyed
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<std::pmr::string> stored{&arena};
+    {
+        ss::parser<Ts...> p{f.name, &arena};
+        p.ignore_next();
+        while (!p.eof()) {
+            stored.push_back(
+                std::get<1>(p.template get_next<size_t, std::pmr::string>()));
+            REQUIRE(p.valid());
+        }
+    }
+    CHECK_EQ(stored.size(), notes.size());
+    for (size_t i = 0; i < stored.size(); ++i) {
+        CHECK_EQ(std::string_view{stored[i]}, notes[i]);
+    }
+}
+
+TEST_CASE("test memory resource") {
+    // the notes are longer than the buffer of a small string, and the
+    // records span multiple lines, so their buffers are reallocated
+    std::string data = "id,note\n";
+    std::vector<std::string> notes;
+    for (size_t i = 0; i < 50; ++i) {
+        std::string note = "note number " + std::to_string(i);
+        for (size_t j = 0; j < i % 5; ++j) {
+            note += "\n" + std::string(i * 10, 'x');
+        }
+        data += std::to_string(i) + ",\"" + note + "\"\n";
+        notes.push_back(note);
+    }
+
+    for (bool buffer_mode : {false, true}) {
+        test_memory_resource<ss::quote<'"'>, ss::multiline>(buffer_mode, data,
+                                                            notes);
+        test_memory_resource<ss::quote<'"'>, ss::multiline, ss::string_error>(
+            buffer_mode, data, notes);
+        test_memory_resource<ss::quote<'"'>, ss::multiline,
+                             ss::throw_on_error>(buffer_mode, data, notes);
+    }
+}
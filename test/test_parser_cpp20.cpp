@@ -0,0 +1,240 @@
+#include "test_helpers.hpp"
+#include <ss/multi_parser.hpp>
+#include <ss/parser.hpp>
+
+namespace {
+#define ErrorModes                                                             \
+    config<std::true_type>, config<std::true_type, ss::string_error>,          \
+        config<std::true_type, ss::throw_on_error>
+
+template <typename ErrorMode, typename... Ts>
+using parser_t = std::conditional_t<std::is_same_v<ErrorMode, bool_error>,
+                                    ss::parser<Ts...>,
+                                    ss::parser<ErrorMode, Ts...>>;
+
+struct record {
+    int a;
+    std::string b;
+
+    bool operator==(const record& other) const {
+        return a == other.a && b == other.b;
+    }
+};
+
+const std::string data = "a,b\n1,x\n2,y\n3,z\n";
+} /* anonymous namespace */
+
+#ifdef SSP_COROUTINES_ENABLED
+TEST_CASE_TEMPLATE("test rows", T, ErrorModes) {
+    using ErrorMode = typename T::ErrorMode;
+
+    {
+        parser_t<ErrorMode> p{data.data(), data.size()};
+        p.ignore_next();
+
+        std::vector<std::tuple<int, std::string>> values;
+        for (auto& [a, b] : p.template rows<int, std::string>()) {
+            values.emplace_back(a, std::move(b));
+        }
+
+        std::vector<std::tuple<int, std::string>> expected{{1, "x"},
+                                                           {2, "y"},
+                                                           {3, "z"}};
+        CHECK_EQ(values, expected);
+        CHECK(p.eof());
+    }
+
+    {
+        parser_t<ErrorMode> p{data.data(), data.size()};
+        p.ignore_next();
+
+        std::vector<int> values;
+        for (int a : p.template rows<int, void>()) {
+            values.push_back(a);
+        }
+        CHECK_EQ(values, std::vector<int>{1, 2, 3});
+    }
+
+    {
+        parser_t<ErrorMode> p{data.data(), data.size()};
+        p.ignore_next();
+
+        std::vector<record> values;
+        for (auto& r : p.template rows_object<record, int, std::string>()) {
+            values.push_back(std::move(r));
+        }
+
+        std::vector<record> expected{{1, "x"}, {2, "y"}, {3, "z"}};
+        CHECK_EQ(values, expected);
+    }
+
+    {
+        // the header is not ignored, so the first record is invalid
+        parser_t<ErrorMode> p{data.data(), data.size()};
+        auto rows = p.template rows<int, std::string>();
+        if constexpr (T::ThrowOnError) {
+            REQUIRE_EXCEPTION(std::ignore = rows.begin());
+        } else {
+            auto it = rows.begin();
+            CHECK_FALSE(p.valid());
+            ++it;
+            CHECK(p.valid());
+            CHECK_EQ(std::get<0>(*it), 1);
+        }
+    }
+}
+
+TEST_CASE("test rows are read lazily") {
+    ss::parser<ss::string_error> p0{data.data(), data.size()};
+    ss::parser<ss::string_error> p1{data.data(), data.size()};
+    p0.ignore_next();
+    p1.ignore_next();
+
+    auto rows0 = p0.rows<int, std::string>();
+    auto rows1 = p1.rows<int, std::string>();
+
+    // the records are only read once they are requested, so the reading of
+    // the parsers can be interleaved
+    CHECK_EQ(p0.line(), 1);
+    auto it0 = rows0.begin();
+    CHECK_EQ(p0.line(), 2);
+    CHECK_EQ(p1.line(), 1);
+
+    auto it1 = rows1.begin();
+    ++it1;
+    CHECK_EQ(std::get<0>(*it0), 1);
+    CHECK_EQ(std::get<0>(*it1), 2);
+    CHECK_EQ(p1.line(), 3);
+
+    ++it0;
+    CHECK_EQ(std::get<1>(*it0), "y");
+    CHECK_FALSE(it0 == rows0.end());
+
+    // the rest is read by the parser once the rows are dropped
+    {
+        auto rows = std::move(rows0);
+    }
+    auto [a, b] = p0.get_next<int, std::string>();
+    CHECK(p0.valid());
+    CHECK_EQ(a, 3);
+    CHECK_EQ(b, "z");
+    CHECK(p0.eof());
+
+    ++it1;
+    CHECK_FALSE(it1 == rows1.end());
+    ++it1;
+    CHECK(it1 == rows1.end());
+}
+
+TEST_CASE("test multi_parser rows") {
+    unique_file_name f0{"parser_cpp20"};
+    unique_file_name f1{"parser_cpp20"};
+    {
+        std::ofstream out0{f0.name};
+        out0 << data;
+        std::ofstream out1{f1.name};
+        out1 << "a,b\n4,w\n";
+    }
+
+    ss::multi_parser<ss::string_error> p{{f0.name, f1.name}, ","};
+
+    std::vector<record> values;
+    for (auto& r : p.rows_object<record, int, std::string>()) {
+        REQUIRE(p.valid());
+        values.push_back(std::move(r));
+    }
+
+    std::vector<record> expected{{1, "x"}, {2, "y"}, {3, "z"}, {4, "w"}};
+    CHECK_EQ(values, expected);
+}
+#endif
+
+#ifdef SSP_RANGES_ENABLED
+namespace {
+using view_t =
+    decltype(std::declval<ss::parser<>&>().view<int, std::string>());
+static_assert(std::ranges::input_range<view_t>);
+static_assert(std::ranges::view<view_t>);
+
+const std::string numbers = "a,b\n1,x\n2,y\n3,z\n4,w\n5,v\n6,u\n";
+} /* anonymous namespace */
+
+TEST_CASE_TEMPLATE("test view", T, ErrorModes) {
+    using ErrorMode = typename T::ErrorMode;
+
+    {
+        parser_t<ErrorMode> p{numbers.data(), numbers.size()};
+        p.ignore_next();
+
+        auto even = [](const auto& value) {
+            return std::get<0>(value) % 2 == 0;
+        };
+
+        std::vector<std::tuple<int, std::string>> values;
+        for (auto& value : p.template view<int, std::string>() |
+                               std::views::filter(even) |
+                               std::views::take(2)) {
+            values.push_back(value);
+        }
+
+        std::vector<std::tuple<int, std::string>> expected{{2, "y"},
+                                                           {4, "w"}};
+        CHECK_EQ(values, expected);
+    }
+
+    {
+        parser_t<ErrorMode> p{numbers.data(), numbers.size()};
+        p.ignore_next();
+
+        std::vector<record> values;
+        for (auto& r : p.template view_object<record, int, std::string>() |
+                           std::views::take(3)) {
+            values.push_back(std::move(r));
+        }
+
+        std::vector<record> expected{{1, "x"}, {2, "y"}, {3, "z"}};
+        CHECK_EQ(values, expected);
+
+        // no record is read after the last taken one
+        CHECK_EQ(p.line(), 4);
+        auto [a, b] = p.template get_next<int, std::string>();
+        CHECK(p.valid());
+        CHECK_EQ(a, 4);
+    }
+
+    {
+        // records which are not dereferenced are not converted, so the
+        // header does not cause an error
+        parser_t<ErrorMode> p{numbers.data(), numbers.size()};
+        auto view = p.template view<int, std::string>();
+        auto it = view.begin();
+        ++it;
+        ++it;
+        CHECK_EQ(std::get<0>(*it), 2);
+        CHECK(p.valid());
+
+        size_t count = 0;
+        for (; it != view.end(); ++it) {
+            ++count;
+        }
+        CHECK_EQ(count, 5);
+        CHECK(p.eof());
+    }
+
+    {
+        // records can be filtered on their fields before being converted
+        parser_t<ErrorMode> p{numbers.data(), numbers.size()};
+        p.where([](const ss::split_data& fields) {
+            return *fields[1].first >= 'w';
+        });
+        p.ignore_next();
+
+        std::vector<int> values;
+        for (int a : p.template view<int, void>() |
+                         std::views::transform([](int a) { return a * 10; })) {
+            values.push_back(a);
+        }
+        CHECK_EQ(values, std::vector<int>{10, 20, 30, 40});
+    }
+}
+#endif
@@ -0,0 +1,278 @@
+#include "test_helpers.hpp"
+#include <optional>
+#include <ss/parser.hpp>
+#include <ss/writer.hpp>
+#include <variant>
+
+namespace {
+
+struct Y {
+    int i;
+    double d;
+    std::string s;
+
+    [[nodiscard]] auto tied() const {
+        return std::tie(i, d, s);
+    }
+};
+
+enum class shape { circle, square };
+
+} /* anonymous namespace */
+
+template <>
+inline bool ss::insert(std::string& out, const shape& value) {
+    out.append(value == shape::circle ? "circle" : "square");
+    return true;
+}
+
+TEST_CASE("writer test basic types") {
+    std::string out;
+    ss::writer w{&out};
+
+    w.write(1, 2.5, 'c', std::string{"str"}, "literal", true);
+    CHECK(w.valid());
+    w.write(std::string_view{"view"}, ss::uint8{7}, ss::int8{-7}, false);
+    CHECK(w.valid());
+
+    CHECK_EQ(out, "1,2.5,c,str,literal,true\nview,7,-7,false\n");
+}
+
+TEST_CASE("writer test tuples, tied objects, optional and variant") {
+    std::string out;
+    ss::writer w{&out, ";"};
+
+    w.write(std::tuple{1, std::string{"x"}});
+    w.write(Y{2, 0.5, "y"});
+    w.write(std::optional<int>{}, std::optional<int>{3});
+    w.write(std::variant<int, std::string>{4},
+            std::variant<int, std::string>{"z"});
+    w.write(shape::circle, shape::square);
+    CHECK(w.valid());
+
+    CHECK_EQ(out, "1;x\n2;0.5;y\n;3\n4;z\ncircle;square\n");
+}
+
+TEST_CASE("writer test date and time types") {
+    const std::vector<std::string> timestamps = {
+        "1970-01-01T00:00:00Z", "2024-02-29T13:45:30.5Z",
+        "1969-12-31T23:59:59.999999999Z", "2261-12-31T23:59:59.000001Z"};
+
+    std::string out;
+    ss::writer w{&out};
+    for (const auto& s : timestamps) {
+        ss::timestamp t;
+        REQUIRE(ss::extract(s.c_str(), s.c_str() + s.size(), t));
+        w.write(ss::date{2024, 1, 2}, t,
+                ss::epoch_milliseconds{std::chrono::milliseconds{-5}});
+    }
+    CHECK(w.valid());
+
+    ss::parser p{out.data(), out.size()};
+    for (const auto& s : timestamps) {
+        auto [d, t, e] =
+            p.get_next<ss::date, std::string, ss::epoch_milliseconds>();
+        REQUIRE(p.valid());
+        CHECK_EQ(d, ss::date{2024, 1, 2});
+        CHECK_EQ(t, s);
+        CHECK_EQ(e.since_epoch.count(), -5);
+    }
+}
+
+TEST_CASE("writer test decimal") {
+    std::string out;
+    ss::writer w{&out};
+
+    w.write(ss::decimal<2>{-1250}, ss::decimal<4>{5}, ss::decimal<0>{7},
+            ss::decimal<2, int64_t>{std::numeric_limits<int64_t>::min()},
+            ss::decimal<1, uint8_t>{255});
+    CHECK(w.valid());
+    CHECK_EQ(out, "-12.50,0.0005,7,-92233720368547758.08,25.5\n");
+
+    ss::parser p{out.data(), out.size()};
+    auto [a, b, c, d, e] =
+        p.get_next<ss::decimal<2>, ss::decimal<4>, ss::decimal<0>,
+                   ss::decimal<2>, ss::decimal<1, uint8_t>>();
+    REQUIRE(p.valid());
+    CHECK_EQ(a.value, -1250);
+    CHECK_EQ(b.value, 5);
+    CHECK_EQ(c.value, 7);
+    CHECK_EQ(d.value, std::numeric_limits<int64_t>::min());
+    CHECK_EQ(e.value, 255);
+}
+
+TEST_CASE("writer test crlf") {
+    std::string out;
+    ss::writer<ss::crlf> w{&out};
+
+    w.write(1, 2);
+    w.write(3, 4);
+    CHECK_EQ(out, "1,2\r\n3,4\r\n");
+}
+
+TEST_CASE("writer test quoting") {
+    std::string out;
+    ss::writer<ss::quote<'"'>, ss::trim<' '>> w{&out};
+
+    w.write("plain", "a,b", "say \"hi\"", "multi\nline", " spaced ", "");
+    CHECK(w.valid());
+
+    CHECK_EQ(out, "plain,\"a,b\",\"say \"\"hi\"\"\",\"multi\nline\","
+                  "\" spaced \",\n");
+}
+
+TEST_CASE("writer test escaping") {
+    {
+        std::string out;
+        ss::writer<ss::escape<'\\'>> w{&out};
+
+        w.write("a,b", "c\\d", "e");
+        CHECK(w.valid());
+        CHECK_EQ(out, "a\\,b,c\\\\d,e\n");
+    }
+
+    {
+        std::string out;
+        ss::writer<ss::quote<'"'>, ss::escape<'\\'>> w{&out};
+
+        w.write("a\\b", "c");
+        CHECK(w.valid());
+        CHECK_EQ(out, "\"a\\\\b\",c\n");
+    }
+
+    {
+        std::string out;
+        ss::writer<ss::escape<'\\'>, ss::trim<' '>> w{&out};
+
+        w.write("  a b  ");
+        CHECK(w.valid());
+        CHECK_EQ(out, "\\ \\ a b\\ \\ \n");
+    }
+}
+
+TEST_CASE("writer test multi character delimiter") {
+    std::string out;
+    ss::writer<ss::quote<'"'>> w{&out, "::"};
+
+    w.write(1, "a:b", 2);
+    CHECK(w.valid());
+    CHECK_EQ(out, "1::\"a:b\"::2\n");
+}
+
+TEST_CASE("writer test invalid writes") {
+    {
+        std::string out = "0\n";
+        ss::writer w{&out};
+
+        w.write(1, "a,b");
+        CHECK_FALSE(w.valid());
+        CHECK_EQ(out, "0\n");
+
+        w.write(1, 2);
+        CHECK(w.valid());
+        CHECK_EQ(out, "0\n1,2\n");
+    }
+
+    {
+        std::string out;
+        ss::writer<ss::string_error> w{&out};
+
+        w.write("a\nb");
+        CHECK_FALSE(w.valid());
+        CHECK_FALSE(w.error_msg().empty());
+        CHECK(out.empty());
+    }
+
+    {
+        std::string out;
+        ss::writer<ss::throw_on_error> w{&out};
+
+        REQUIRE_EXCEPTION(w.write(1, "a,b"));
+        CHECK(out.empty());
+    }
+
+    {
+        std::string out;
+        ss::writer<ss::string_error> w{&out, ""};
+        CHECK_FALSE(w.valid());
+    }
+
+    {
+        ss::writer<ss::string_error> w{static_cast<std::string*>(nullptr)};
+        CHECK_FALSE(w.valid());
+    }
+
+    {
+        ss::writer<ss::string_error> w{"./non/existing/dir/file.csv"};
+        CHECK_FALSE(w.valid());
+        CHECK_FALSE(w.error_msg().empty());
+
+        w.write(1);
+        CHECK_FALSE(w.valid());
+    }
+
+    REQUIRE_EXCEPTION(
+        ss::writer<ss::throw_on_error>{"./non/existing/dir/file.csv"});
+}
+
+TEST_CASE("writer test file mode round trip") {
+    unique_file_name f{"writer"};
+
+    std::vector<Y> data;
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back(
+            Y{i, i / 7.0, "s" + std::to_string(i) + (i % 3 ? "," : "\"\n")});
+    }
+
+    using setup = ss::setup<ss::quote<'"'>, ss::multiline>;
+
+    {
+        ss::writer<setup> w{f.name};
+        w.write("i", "d", "s");
+        for (const auto& y : data) {
+            w.write(y);
+        }
+        CHECK(w.valid());
+    }
+
+    ss::parser<setup> p{f.name};
+    CHECK_EQ(p.raw_header(), "i,d,s");
+    p.ignore_next();
+
+    size_t i = 0;
+    for (const auto& [a, b, c] : p.iterate<int, double, std::string>()) {
+        REQUIRE(p.valid());
+        REQUIRE(i < data.size());
+        CHECK_EQ(a, data[i].i);
+        CHECK_EQ(b, data[i].d);
+        CHECK_EQ(c, data[i].s);
+        ++i;
+    }
+    CHECK_EQ(i, data.size());
+}
+
+TEST_CASE("writer test buffer mode round trip") {
+    using setup = ss::setup<ss::quote<'"'>, ss::escape<'\\'>,
+                            ss::trim<' ', '\t'>, ss::multiline>;
+
+    const std::vector<std::string> values = {"",      " ",     "a",
+                                             "\"",    "\\",    ",",
+                                             " a ",   "\ta\t", "a\nb",
+                                             "\"\"a", "a\\\"", "\r\n"};
+
+    std::string out;
+    ss::writer<setup> w{&out, ","};
+    for (const auto& v : values) {
+        w.write(v, v);
+    }
+    CHECK(w.valid());
+
+    ss::parser<setup> p{out.data(), out.size()};
+    for (const auto& v : values) {
+        auto [a, b] = p.get_next<std::string, std::string>();
+        REQUIRE(p.valid());
+        CHECK_EQ(a, v);
+        CHECK_EQ(b, v);
+    }
+    CHECK(p.eof());
+}